@@ -4,6 +4,10 @@
 #include "Engine/Core/Application.h"
 #include "Engine/Core/Layer.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Allocator.h"
+#include "Engine/Core/Handle.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/VFS.h"
 
 #include "Engine/Core/Timestep.h"
 
@@ -19,6 +23,7 @@
 #include "Engine/Renderer/Renderer.h"
 #include "Engine/Renderer/Renderer2D.h"
 #include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/RenderThread.h"
 
 #include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/Shader.h"
@@ -29,4 +34,24 @@
 
 #include "Engine/Renderer/OrthographicCamera.h"
 #include "Engine/Renderer/PerspectiveCamera.h"
-#include "Engine/Renderer/Mesh.h"
\ No newline at end of file
+#include "Engine/Renderer/Mesh.h"
+#include "Engine/Renderer/Frustum.h"
+#include "Engine/Renderer/StaticMeshBatch.h"
+#include "Engine/Renderer/GPUProfiler.h"
+#include "Engine/Renderer/RenderCapture.h"
+
+// Headless runs read the call counts of the null API
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
+
+// Debug
+#include "Engine/Debug/MemoryTracker.h"
+
+// Scene
+#include "Engine/Scene/BVH.h"
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/TransformHierarchy.h"
+#include "Engine/Scene/Components.h"
+#include "Engine/Scene/AssetLibrary.h"
+#include "Engine/Scene/AssetDatabase.h"
+#include "Engine/Scene/SceneSerializer.h"
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "gepch.h"
+#include "Allocator.h"
+
+namespace Engine {
+
+	LinearAllocator::LinearAllocator(size_t chunkSize, MemoryTag tag)
+		: m_ChunkSize(chunkSize), m_Tag(tag)
+	{
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		for (Chunk& chunk : m_Chunks)
+			MemoryTracker::Free(chunk.Data);
+	}
+
+	void LinearAllocator::AddChunk(size_t size)
+	{
+		m_Chunks.push_back({ (uint8_t*)MemoryTracker::Allocate(size, m_Tag), size, 0 });
+		GE_CORE_ASSERT(m_Chunks.back().Data, "LinearAllocator is out of memory");
+	}
+
+	void* LinearAllocator::Allocate(size_t size, size_t alignment)
+	{
+		GE_CORE_ASSERT(alignment && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		// Chunks after m_ChunkIndex are always empty
+		while (m_ChunkIndex < m_Chunks.size())
+		{
+			Chunk& chunk = m_Chunks[m_ChunkIndex];
+			uintptr_t address = (uintptr_t)(chunk.Data + chunk.Used);
+			size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+			if (chunk.Size - chunk.Used >= padding + size)
+			{
+				chunk.Used += padding + size;
+				return (void*)(address + padding);
+			}
+
+			if (m_ChunkIndex + 1 == m_Chunks.size())
+				break;
+			m_ChunkIndex++;
+		}
+
+		// Oversized allocations get a chunk of their own
+		AddChunk(std::max(m_ChunkSize, size + alignment));
+		m_ChunkIndex = (uint32_t)m_Chunks.size() - 1;
+		return Allocate(size, alignment);
+	}
+
+	LinearAllocator::Marker LinearAllocator::GetMarker() const
+	{
+		if (m_Chunks.empty())
+			return { 0, 0 };
+		return { m_ChunkIndex, m_Chunks[m_ChunkIndex].Used };
+	}
+
+	void LinearAllocator::Rewind(const Marker& marker)
+	{
+		// Rewinding to the start is a Reset(), which gets the chance to merge the chunks
+		if (marker.Chunk == 0 && marker.Used == 0)
+		{
+			Reset();
+			return;
+		}
+
+		m_PeakBytes = std::max(m_PeakBytes, GetUsedBytes());
+
+		for (uint32_t i = marker.Chunk + 1; i <= m_ChunkIndex && i < m_Chunks.size(); i++)
+			m_Chunks[i].Used = 0;
+		m_Chunks[marker.Chunk].Used = marker.Used;
+		m_ChunkIndex = marker.Chunk;
+	}
+
+	void LinearAllocator::Reset()
+	{
+		m_PeakBytes = std::max(m_PeakBytes, GetUsedBytes());
+
+		if (m_Chunks.size() > 1)
+		{
+			size_t capacity = GetCapacity();
+			for (Chunk& chunk : m_Chunks)
+				MemoryTracker::Free(chunk.Data);
+			m_Chunks.clear();
+			AddChunk(capacity);
+		}
+
+		for (Chunk& chunk : m_Chunks)
+			chunk.Used = 0;
+		m_ChunkIndex = 0;
+	}
+
+	size_t LinearAllocator::GetUsedBytes() const
+	{
+		size_t used = 0;
+		for (uint32_t i = 0; i <= m_ChunkIndex && i < m_Chunks.size(); i++)
+			used += m_Chunks[i].Used;
+		return used;
+	}
+
+	size_t LinearAllocator::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (const Chunk& chunk : m_Chunks)
+			capacity += chunk.Size;
+		return capacity;
+	}
+
+	LinearAllocator& FrameAllocator::Get()
+	{
+		static LinearAllocator s_Allocator(ChunkSize);
+		return s_Allocator;
+	}
+
+	void FrameAllocator::Reset()
+	{
+		Get().Reset();
+	}
+
+	LinearAllocator& ScratchAllocator::Get()
+	{
+		static thread_local LinearAllocator s_Allocator(ChunkSize);
+		return s_Allocator;
+	}
+}
\ No newline at end of file
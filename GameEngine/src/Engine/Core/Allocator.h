@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+#include "Engine/Debug/MemoryTracker.h"
+
+#include <string>
+
+namespace Engine {
+
+	// Bump allocator over chunks that are never moved. Memory is released all at once by
+	// Reset(), or back to a marker by Rewind(), and nothing is destructed, so it is meant for
+	// trivially destructible data and containers that are gone before the memory is reused.
+	// When a Reset() finds more than one chunk they are merged into one, after that a steady
+	// workload allocates from a single chunk and never touches the heap.
+	class LinearAllocator
+	{
+	public:
+		struct Marker
+		{
+			uint32_t Chunk;
+			size_t Used;
+		};
+
+		LinearAllocator(size_t chunkSize, MemoryTag tag = MemoryTag::Transient);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		T* Allocate(size_t count = 1)
+		{
+			return (T*)Allocate(count * sizeof(T), alignof(T));
+		}
+
+		Marker GetMarker() const;
+		// Releases everything allocated after the marker was taken
+		void Rewind(const Marker& marker);
+		void Reset();
+
+		// Bytes handed out since the last Reset(), including alignment padding
+		size_t GetUsedBytes() const;
+		size_t GetCapacity() const;
+		// Most bytes in use at any Reset() or Rewind()
+		inline size_t GetPeakBytes() const { return m_PeakBytes; }
+	private:
+		struct Chunk
+		{
+			uint8_t* Data;
+			size_t Size;
+			size_t Used;
+		};
+
+		void AddChunk(size_t size);
+	private:
+		std::vector<Chunk> m_Chunks;
+		uint32_t m_ChunkIndex = 0;
+		size_t m_ChunkSize;
+		size_t m_PeakBytes = 0;
+		MemoryTag m_Tag;
+	};
+
+	// Standard allocator over a LinearAllocator, deallocate() does nothing
+	template<typename T>
+	class LinearStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		LinearStlAllocator(LinearAllocator& allocator)
+			: m_Allocator(&allocator) {}
+
+		template<typename U>
+		LinearStlAllocator(const LinearStlAllocator<U>& other)
+			: m_Allocator(other.GetAllocator()) {}
+
+		T* allocate(size_t count)
+		{
+			return m_Allocator->Allocate<T>(count);
+		}
+
+		void deallocate(T*, size_t) {}
+
+		inline LinearAllocator* GetAllocator() const { return m_Allocator; }
+
+		template<typename U>
+		bool operator==(const LinearStlAllocator<U>& other) const { return m_Allocator == other.GetAllocator(); }
+		template<typename U>
+		bool operator!=(const LinearStlAllocator<U>& other) const { return m_Allocator != other.GetAllocator(); }
+	private:
+		LinearAllocator* m_Allocator;
+	};
+
+	// e.g. LinearVector<uint32_t> indices(FrameAllocator::Get());
+	template<typename T>
+	using LinearVector = std::vector<T, LinearStlAllocator<T>>;
+	using LinearString = std::basic_string<char, std::char_traits<char>, LinearStlAllocator<char>>;
+
+	// Arena of the main thread that lives for one frame, the Application resets it at the end
+	// of every frame. Not for data the render thread reads, that goes through
+	// RenderThread::AllocateFrameData().
+	class FrameAllocator
+	{
+	public:
+		static const size_t ChunkSize = 1024 * 1024;
+
+		static LinearAllocator& Get();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) { return Get().Allocate(size, alignment); }
+
+		template<typename T>
+		static T* Allocate(size_t count = 1)
+		{
+			return Get().Allocate<T>(count);
+		}
+
+		static void Reset();
+	};
+
+	// Per-thread stack for temporaries of a single function, allocate inside a ScratchScope:
+	//   ScratchScope scratch;
+	//   glm::mat4* transforms = scratch.Allocate<glm::mat4>(nodeCount);
+	class ScratchAllocator
+	{
+	public:
+		static const size_t ChunkSize = 256 * 1024;
+
+		// The calling thread's allocator
+		static LinearAllocator& Get();
+	};
+
+	// Releases the scratch memory allocated during its lifetime, scopes nest like the stack
+	class ScratchScope
+	{
+	public:
+		ScratchScope()
+			: m_Allocator(ScratchAllocator::Get()), m_Marker(m_Allocator.GetMarker())
+		{
+		}
+
+		~ScratchScope()
+		{
+			m_Allocator.Rewind(m_Marker);
+		}
+
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+
+		template<typename T>
+		T* Allocate(size_t count = 1)
+		{
+			return m_Allocator.Allocate<T>(count);
+		}
+
+		// For LinearVector and LinearString
+		inline LinearAllocator& GetAllocator() { return m_Allocator; }
+	private:
+		LinearAllocator& m_Allocator;
+		LinearAllocator::Marker m_Marker;
+	};
+}
\ No newline at end of file
@@ -2,24 +2,36 @@
 #include "Application.h"
 
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Allocator.h"
+#include "Engine/Core/JobSystem.h"
 
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/GPUProfiler.h"
+#include "Engine/Renderer/RenderCapture.h"
+
+#include "Engine/Debug/FrameProfiler.h"
+#include "Engine/Debug/FlightRecorder.h"
+#include "Engine/Debug/MemoryTracker.h"
 
 #include "Input.h"
 
 #include "KeyCodes.h"
 
-#include <GLFW/glfw3.h>
+#include <chrono>
 
 namespace Engine {
 
-// "this" is a hidden parameter for Application::OnEvent()
-// e.g. app.OnEvent(e) == OnEvent(this, e)
-#define BIND_EVENT_FN(x) std::bind(&Application::x, this, std::placeholders::_1)
-
 	Application* Application::s_Instance = nullptr;
 
+	// Steady clock instead of glfwGetTime(), headless windows never initialize GLFW
+	static double GetTime()
+	{
+		using namespace std::chrono;
+		return duration<double>(steady_clock::now().time_since_epoch()).count();
+	}
+
 	Application::Application(const ApplicationProps& props)
+		: m_FixedTimestep(props.FixedTimestep), m_MaxFixedSteps(std::max(props.MaxFixedSteps, 1u)), m_Threading(props.Threading)
 	{
 		GE_PROFILE_FUNCTION();
 		std::string filepath = "testfilepath";
@@ -28,26 +40,44 @@ namespace Engine {
 		s_Instance = this;
 
 		m_Window = std::unique_ptr<Window>(Window::Create(WindowProps(props.Name, props.WindowWidth, props.WindowHeight)));
-		m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
+		m_Window->SetEventBus(&m_EventBus);
+
+		m_EventBus.Subscribe<Application, &Application::OnWindowClose>(EventType::WindowClose, this, ApplicationEventPriority);
+		m_EventBus.Subscribe<Application, &Application::OnWindowResize>(EventType::WindowResize, this, ApplicationEventPriority);
+		m_EventBus.Subscribe<Application, &Application::OnKeyPressed>(EventType::KeyPressed, this, ApplicationEventPriority);
 		m_Window->SetVSync(false);
 
+		JobSystem::Init();
 		Renderer::Init();
+		FrameProfiler::Init();
+		FlightRecorder::Init();
+#if GE_PROFILE
+		FlightRecorder::SetEnabled(true);
+#endif
 
 		m_ImGuiLayer = new ImGuiLayer();
 		PushOverlay(m_ImGuiLayer);
+
+		m_LastFrameTime = GetTime();
 	}
 
 	Application::~Application()
 	{
 		GE_PROFILE_FUNCTION();
 
+		FlightRecorder::Shutdown();
+		FrameProfiler::Shutdown();
 		Renderer::Shutdown();
+		JobSystem::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
 	{
 		GE_PROFILE_FUNCTION();
 
+		// Pushed layers go on top of the earlier ones
+		layer->m_EventBus = &m_EventBus;
+		layer->m_EventPriority = ++m_LayerCount;
 		m_LayerStack.PushLayer(layer);
 		layer->OnAttach();
 	}
@@ -56,6 +86,8 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
+		overlay->m_EventBus = &m_EventBus;
+		overlay->m_EventPriority = OverlayEventPriority + ++m_OverlayCount;
 		m_LayerStack.PushOverlay(overlay);
 		overlay->OnAttach();
 	}
@@ -65,47 +97,69 @@ namespace Engine {
 		m_Running = false;
 	}
 
-	void Application::OnEvent(Event& e)
-	{
-		GE_PROFILE_FUNCTION();
-
-		// If the event you are trying to dispatch e.GetEventType() 
-		// matches the type of the function <WindowCloseEvent>
-		// then it will run that function
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_FN(OnWindowClose));
-		dispatcher.Dispatch<WindowResizeEvent>(BIND_EVENT_FN(OnWindowResize));
-		dispatcher.Dispatch<KeyPressedEvent>(BIND_EVENT_FN(OnKeyPressed));
-
-		for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it)
-		{
-			if (e.Handled)
-				break;
-			(*it)->OnEvent(e);
-		}
-	}
-
 	void Application::Run()
 	{
 		GE_PROFILE_FUNCTION();
 
+		// Layers were attached with the context on this thread, from here on it belongs to the render thread
+		RenderThread::Init(m_Threading, m_Window->GetContext());
+
 		while (m_Running)
 		{
+			FrameProfiler::BeginFrame();
+			FlightRecorder::BeginFrame();
+			RenderThread::Submit([]() { GPUProfiler::BeginFrame(); });
+			MemoryTracker::BeginFrame();
+			RenderCapture::BeginFrame();
 			GE_PROFILE_SCOPE("RunLoop");
 
-			float time = (float)glfwGetTime(); // Platform::GetTime()
-			m_Timestep = time - m_LastFrameTime;
+			double time = GetTime();
+			// A long frame (breakpoint, loading, dragging the window) is clamped to the catch-up limit
+			double frameTime = std::min(time - m_LastFrameTime, m_FixedTimestep * m_MaxFixedSteps);
 			m_LastFrameTime = time;
 
+			uint32_t fixedSteps;
+			if (m_Unthrottled)
+			{
+				frameTime = m_FixedTimestep;
+				fixedSteps = 1;
+				m_Accumulator = 0.0;
+			}
+			else
+			{
+				m_Accumulator += frameTime;
+				fixedSteps = std::min((uint32_t)(m_Accumulator / m_FixedTimestep), m_MaxFixedSteps);
+				m_Accumulator = std::min(m_Accumulator - fixedSteps * m_FixedTimestep, m_FixedTimestep);
+			}
+			m_Timestep = (float)frameTime;
+
+			{
+				GE_PROFILE_SCOPE("LayerStack OnFixedUpdate");
+
+				// LayerStack has begin() and end() implementations
+				for (uint32_t step = 0; step < fixedSteps; step++)
+				{
+					for (Layer* layer : m_LayerStack)
+						layer->OnFixedUpdate((float)m_FixedTimestep);
+				}
+			}
+
 			if (!m_Minimized)
 			{
 				{
 					GE_PROFILE_SCOPE("LayerStack OnUpdate");
 
-					// LayerStack has begin() and end() implementations
 					for (Layer* layer : m_LayerStack)
 						layer->OnUpdate(m_Timestep);
 				}
+
+				{
+					GE_PROFILE_SCOPE("LayerStack OnRender");
+
+					float alpha = m_Unthrottled ? 1.0f : (float)(m_Accumulator / m_FixedTimestep);
+					for (Layer* layer : m_LayerStack)
+						layer->OnRender(alpha);
+				}
 			}
 
 			m_ImGuiLayer->Begin();
@@ -116,40 +170,62 @@ namespace Engine {
 			}
 			m_ImGuiLayer->End();
 
-			m_Window->OnUpdate();
+			m_Window->PollEvents();
+			m_EventBus.Dispatch();
+			RenderThread::Submit([window = m_Window.get()]() { window->SwapBuffers(); });
+			// Frame N executes while the loop records frame N + 1
+			RenderThread::NextFrame();
+			FrameAllocator::Reset();
 		}
+
+		RenderThread::Shutdown();
 	}
 
-	bool Application::OnWindowClose(WindowCloseEvent& e)
+	bool Application::OnWindowClose(const QueuedEvent& e)
 	{
 		m_Running = false;
 		return true;
 	}
 
-	bool Application::OnWindowResize(WindowResizeEvent& e)
+	bool Application::OnWindowResize(const QueuedEvent& e)
 	{
 		GE_PROFILE_FUNCTION();
 
-		if (e.GetWidth() == 0 || e.GetHeight() == 0)
+		if (e.WindowResize.Width == 0 || e.WindowResize.Height == 0)
 		{
 			m_Minimized = true;
 			return false;
 		}
 
 		m_Minimized = false;
-		Renderer::OnWindowResize(e.GetWidth(), e.GetHeight());
+		Renderer::OnWindowResize(e.WindowResize.Width, e.WindowResize.Height);
 		return false;
 	}
 
-	bool Application::OnKeyPressed(KeyPressedEvent& e)
+	bool Application::OnKeyPressed(const QueuedEvent& e)
 	{
-		switch (e.GetKeyCode())
+		switch (e.Key.KeyCode)
 		{
 			case GE_KEY_ESCAPE:
 			{
 				Close();
 				return true;
 			}
+			case GE_KEY_F3:
+			{
+				FrameProfiler::SetEnabled(!FrameProfiler::IsEnabled());
+				return true;
+			}
+			case GE_KEY_F4:
+			{
+				FlightRecorder::Trigger("Capture key");
+				return true;
+			}
+			case GE_KEY_F5:
+			{
+				RenderCapture::Request("RenderCapture.gecapture");
+				return true;
+			}
 		}
 		return false;
 	}
@@ -6,8 +6,10 @@
 #include "Engine/Core/LayerStack.h"
 #include "Engine/Events/Event.h"
 #include "Engine/Events/ApplicationEvent.h"
+#include "Engine/Events/EventBus.h"
 
 #include "Engine/Core/Timestep.h"
+#include "Engine/Renderer/RenderThread.h"
 
 #include "Engine/ImGui/ImGuiLayer.h"
 
@@ -17,6 +19,13 @@ namespace Engine {
 	{
 		std::string Name;
 		uint32_t WindowWidth, WindowHeight;
+		// Rate of Layer::OnFixedUpdate, in seconds
+		float FixedTimestep = 1.0f / 60.0f;
+		// Fixed updates a frame may run to catch up, time beyond that is dropped
+		uint32_t MaxFixedSteps = 8;
+		// MultiThreaded renders on its own thread, layers must then only draw through
+		// RenderCommand, Renderer2D and ImGui (see RenderThread)
+		ThreadingPolicy Threading = ThreadingPolicy::SingleThreaded;
 	};
 
 	class Application
@@ -27,27 +36,47 @@ namespace Engine {
 
 		void Run();
 
-		void OnEvent(Event& e);
-
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* overlay);
 
 		inline Window& GetWindow() { return *m_Window; }
+		// Listeners subscribed here run after the application's own handlers and the layers
+		inline EventBus& GetEventBus() { return m_EventBus; }
 		void Close();
+
+		inline float GetFixedTimestep() const { return (float)m_FixedTimestep; }
+		// Unthrottled frames run exactly one fixed update and don't wait for the clock,
+		// so benchmarks simulate the same amount per frame however fast they render
+		void SetUnthrottled(bool unthrottled) { m_Unthrottled = unthrottled; }
+		inline bool IsUnthrottled() const { return m_Unthrottled; }
 		
 		inline static Application& Get() { return *s_Instance; }
 	private:
-		bool OnWindowClose(WindowCloseEvent& e); 
-		bool OnWindowResize(WindowResizeEvent& e);
-		bool OnKeyPressed(KeyPressedEvent& e);
+		bool OnWindowClose(const QueuedEvent& e);
+		bool OnWindowResize(const QueuedEvent& e);
+		bool OnKeyPressed(const QueuedEvent& e);
+	private:
+		// EventBus priorities: the application's handlers, then overlays and layers top-down,
+		// then everything else subscribed with the default 0
+		static const int32_t ApplicationEventPriority = INT32_MAX;
+		static const int32_t OverlayEventPriority = 1 << 20;
 	private:
 		std::unique_ptr<Window> m_Window;
+		EventBus m_EventBus;
 		ImGuiLayer* m_ImGuiLayer;
 		Timestep m_Timestep;
 		bool m_Running = true;
 		bool m_Minimized = false;
+		bool m_Unthrottled = false;
 		LayerStack m_LayerStack;
-		float m_LastFrameTime = 0.0f;
+		int32_t m_LayerCount = 0;
+		int32_t m_OverlayCount = 0;
+		// Seconds, double so the clock keeps its precision in long sessions
+		double m_LastFrameTime = 0.0;
+		double m_FixedTimestep;
+		double m_Accumulator = 0.0;
+		uint32_t m_MaxFixedSteps;
+		ThreadingPolicy m_Threading;
 	private:
 		static Application* s_Instance;
 	};
@@ -12,8 +12,13 @@
 #else
 	#define GE_API
 #endif
+	#define GE_DEBUGBREAK() __debugbreak()
+#elif defined(GE_PLATFORM_LINUX)
+	#include <signal.h>
+	#define GE_API
+	#define GE_DEBUGBREAK() raise(SIGTRAP)
 #else
-	#error Engine only supports windows
+	#error Engine only supports Windows and Linux
 #endif
 
 #ifdef GE_DEBUG
@@ -21,8 +26,8 @@
 #endif
 
 #ifdef GE_ENABLE_ASSERTS
-	#define GE_ASSERT(x, ...) { if(!(x)) { GE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
-	#define GE_CORE_ASSERT(x, ...) { if(!(x)) { GE_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
+	#define GE_ASSERT(x, ...) { if(!(x)) { GE_ERROR("Assertion Failed: {0}", __VA_ARGS__); GE_DEBUGBREAK(); } }
+	#define GE_CORE_ASSERT(x, ...) { if(!(x)) { GE_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); GE_DEBUGBREAK(); } }
 #else
 	#define GE_ASSERT(x, ...)
 	#define GE_CORE_ASSERT(x, ...)
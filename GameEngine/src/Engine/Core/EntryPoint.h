@@ -1,6 +1,6 @@
 #pragma once
 
-#ifdef GE_PLATFORM_WINDOWS
+#if defined(GE_PLATFORM_WINDOWS) || defined(GE_PLATFORM_LINUX)
 
 extern Engine::Application* Engine::CreateApplication();
 
@@ -8,16 +8,16 @@ int main(int argc, char** argv)
 {
 	Engine::Log::Init();
 
-	GE_PROFILE_BEGIN_SESSION("Startup", "EngineProfile-Startup.json");
+	GE_PROFILE_BEGIN_SESSION("Startup", "EngineProfile-Startup.getrace");
 	Engine::Application* app = Engine::CreateApplication();
 	GE_PROFILE_END_SESSION();
 	GE_CORE_ASSERT(app, "Client Application is null!");
 
-	GE_PROFILE_BEGIN_SESSION("Runtime", "EngineProfile-Runtime.json");
+	GE_PROFILE_BEGIN_SESSION("Runtime", "EngineProfile-Runtime.getrace");
 	app->Run();
 	GE_PROFILE_END_SESSION();
 
-	GE_PROFILE_BEGIN_SESSION("Shutdown", "EngineProfile-Shutdown.json");
+	GE_PROFILE_BEGIN_SESSION("Shutdown", "EngineProfile-Shutdown.getrace");
 	delete app;
 	GE_PROFILE_END_SESSION();
 }
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+#include <vector>
+
+namespace Engine {
+
+	// 32 bit reference into a HandlePool: the low IndexBits hold the slot index + 1, the rest
+	// the generation the slot had when the handle was made. Destroying the object bumps the
+	// slot's generation, so a stale handle resolves to nothing instead of the slot's next
+	// occupant. The zero handle is null.
+	template<typename T>
+	class Handle
+	{
+	public:
+		static const uint32_t IndexBits = 20;
+		static const uint32_t GenerationBits = 32 - IndexBits;
+		static const uint32_t MaxIndex = (1u << IndexBits) - 2;
+		static const uint32_t MaxGeneration = (1u << GenerationBits) - 1;
+
+		Handle() = default;
+
+		Handle(uint32_t index, uint32_t generation)
+			: m_Value((index + 1) | (generation << IndexBits))
+		{
+		}
+
+		static Handle FromValue(uint32_t value)
+		{
+			Handle handle;
+			handle.m_Value = value;
+			return handle;
+		}
+
+		inline uint32_t GetIndex() const { return (m_Value & ((1u << IndexBits) - 1)) - 1; }
+		inline uint32_t GetGeneration() const { return m_Value >> IndexBits; }
+		inline uint32_t GetValue() const { return m_Value; }
+
+		inline bool IsNull() const { return m_Value == 0; }
+		explicit operator bool() const { return m_Value != 0; }
+
+		bool operator==(const Handle& other) const { return m_Value == other.m_Value; }
+		bool operator!=(const Handle& other) const { return m_Value != other.m_Value; }
+	private:
+		uint32_t m_Value = 0;
+	};
+
+	// Slot table addressed by Handle<Tag>. Values are stored by value in one contiguous array,
+	// freed slots are reused in LIFO order. A slot whose generation would wrap is retired, so
+	// a handle can never match a later occupant. Not thread safe.
+	template<typename T, typename Tag = T>
+	class HandlePool
+	{
+	public:
+		using HandleType = Handle<Tag>;
+
+		HandleType Create(T value = T())
+		{
+			uint32_t index;
+			if (!m_FreeList.empty())
+			{
+				index = m_FreeList.back();
+				m_FreeList.pop_back();
+				m_Values[index] = std::move(value);
+			}
+			else
+			{
+				GE_CORE_ASSERT(m_Values.size() <= HandleType::MaxIndex, "HandlePool is full");
+				index = (uint32_t)m_Values.size();
+				m_Values.push_back(std::move(value));
+				m_Slots.push_back({ 0, false });
+			}
+
+			m_Slots[index].Alive = true;
+			m_Count++;
+			return HandleType(index, m_Slots[index].Generation);
+		}
+
+		void Destroy(HandleType handle)
+		{
+			if (!IsValid(handle))
+			{
+				GE_CORE_ASSERT(handle.IsNull(), "Destroying a stale handle");
+				return;
+			}
+
+			uint32_t index = handle.GetIndex();
+			Slot& slot = m_Slots[index];
+			m_Values[index] = T();
+			slot.Alive = false;
+			m_Count--;
+
+			if (slot.Generation < HandleType::MaxGeneration)
+			{
+				slot.Generation++;
+				m_FreeList.push_back(index);
+			}
+		}
+
+		bool IsValid(HandleType handle) const
+		{
+			uint32_t index = handle.GetIndex();
+			return !handle.IsNull() && index < m_Slots.size() && m_Slots[index].Alive && m_Slots[index].Generation == handle.GetGeneration();
+		}
+
+		// nullptr when the handle is null or stale
+		T* Get(HandleType handle)
+		{
+			return IsValid(handle) ? &m_Values[handle.GetIndex()] : nullptr;
+		}
+
+		const T* Get(HandleType handle) const
+		{
+			return IsValid(handle) ? &m_Values[handle.GetIndex()] : nullptr;
+		}
+
+		inline uint32_t GetCount() const { return m_Count; }
+
+		// Makes room for count more live values without growing the arrays
+		void Reserve(uint32_t count)
+		{
+			size_t required = m_Values.size() + (count > m_FreeList.size() ? count - m_FreeList.size() : 0);
+			m_Values.reserve(required);
+			m_Slots.reserve(required);
+		}
+	private:
+		struct Slot
+		{
+			uint32_t Generation;
+			bool Alive;
+		};
+
+		std::vector<T> m_Values;
+		std::vector<Slot> m_Slots;
+		std::vector<uint32_t> m_FreeList;
+		uint32_t m_Count = 0;
+	};
+}
\ No newline at end of file
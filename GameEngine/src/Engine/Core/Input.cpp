@@ -0,0 +1,17 @@
+#include "gepch.h"
+#include "Input.h"
+
+#ifdef GE_PLATFORM_WINDOWS
+	#include "Platform/Windows/WindowsInput.h"
+#elif defined(GE_PLATFORM_LINUX)
+	#include "Platform/Linux/LinuxInput.h"
+#endif
+
+namespace Engine {
+
+#ifdef GE_PLATFORM_WINDOWS
+	Scope<Input> Input::s_Instance = CreateScope<WindowsInput>();
+#elif defined(GE_PLATFORM_LINUX)
+	Scope<Input> Input::s_Instance = CreateScope<LinuxInput>();
+#endif
+}
\ No newline at end of file
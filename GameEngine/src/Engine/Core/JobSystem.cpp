@@ -0,0 +1,140 @@
+#include "gepch.h"
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <thread>
+
+namespace Engine {
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Workers;
+
+		std::mutex Mutex;
+		std::condition_variable Kick;
+		std::condition_variable Done;
+		bool Quit = false;
+
+		// The current loop, changed under the mutex while no worker is inside it
+		uint64_t Generation = 0;
+		const std::function<void(uint32_t, uint32_t)>* Func = nullptr;
+		uint32_t Count = 0;
+		uint32_t GrainSize = 1;
+		uint32_t RangeCount = 0;
+		std::atomic<uint32_t> NextRange = 0;
+		// Workers that joined the current loop and have not left it
+		uint32_t ActiveWorkers = 0;
+	};
+
+	static JobSystemData* s_Data = nullptr;
+
+	static void RunRanges(const std::function<void(uint32_t, uint32_t)>& func, uint32_t count, uint32_t grainSize, uint32_t rangeCount)
+	{
+		for (uint32_t range = s_Data->NextRange++; range < rangeCount; range = s_Data->NextRange++)
+		{
+			uint32_t begin = range * grainSize;
+			func(begin, std::min(begin + grainSize, count));
+		}
+	}
+
+	static void WorkerMain()
+	{
+		uint64_t generation = 0;
+		for (;;)
+		{
+			const std::function<void(uint32_t, uint32_t)>* func;
+			uint32_t count, grainSize, rangeCount;
+			{
+				std::unique_lock lock(s_Data->Mutex);
+				s_Data->Kick.wait(lock, [&] { return s_Data->Quit || s_Data->Generation != generation; });
+				if (s_Data->Quit)
+					break;
+
+				generation = s_Data->Generation;
+				func = s_Data->Func;
+				count = s_Data->Count;
+				grainSize = s_Data->GrainSize;
+				rangeCount = s_Data->RangeCount;
+				s_Data->ActiveWorkers++;
+			}
+
+			RunRanges(*func, count, grainSize, rangeCount);
+
+			std::lock_guard lock(s_Data->Mutex);
+			if (--s_Data->ActiveWorkers == 0)
+				s_Data->Done.notify_all();
+		}
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		GE_PROFILE_FUNCTION();
+		GE_CORE_ASSERT(!s_Data, "JobSystem already initialized");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_Data = new JobSystemData();
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Data->Workers.emplace_back(WorkerMain);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (!s_Data)
+			return;
+
+		{
+			std::lock_guard lock(s_Data->Mutex);
+			s_Data->Quit = true;
+		}
+		s_Data->Kick.notify_all();
+		for (std::thread& worker : s_Data->Workers)
+			worker.join();
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return s_Data ? (uint32_t)s_Data->Workers.size() : 0;
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func)
+	{
+		GE_PROFILE_FUNCTION();
+
+		grainSize = std::max(grainSize, 1u);
+		uint32_t rangeCount = (count + grainSize - 1) / grainSize;
+
+		if (!s_Data || rangeCount <= 1)
+		{
+			for (uint32_t begin = 0; begin < count; begin += grainSize)
+				func(begin, std::min(begin + grainSize, count));
+			return;
+		}
+
+		{
+			// A worker that woke too late for the previous loop may still be checking for ranges
+			std::unique_lock lock(s_Data->Mutex);
+			s_Data->Done.wait(lock, [] { return s_Data->ActiveWorkers == 0; });
+
+			s_Data->Func = &func;
+			s_Data->Count = count;
+			s_Data->GrainSize = grainSize;
+			s_Data->RangeCount = rangeCount;
+			s_Data->NextRange = 0;
+			s_Data->Generation++;
+		}
+		s_Data->Kick.notify_all();
+
+		RunRanges(func, count, grainSize, rangeCount);
+
+		// Every range is taken, wait for the ones still running on workers
+		std::unique_lock lock(s_Data->Mutex);
+		s_Data->Done.wait(lock, [] { return s_Data->ActiveWorkers == 0; });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Engine {
+
+	// Pool of worker threads for data parallel loops on the main thread. One loop runs at a
+	// time and the calling thread works along, so ParallelFor() returns when every range is done.
+	// Without Init() loops run inline on the caller.
+	class JobSystem
+	{
+	public:
+		// 0 workers picks one less than the hardware threads, the caller is the last one
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		static uint32_t GetWorkerCount();
+
+		// Calls func(begin, end) for consecutive ranges of at most grainSize items covering
+		// [0, count). Ranges run concurrently, func must only touch data of its own range and
+		// must not start another loop.
+		static void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md) without the
+// frame around it, so pak entries stay readable by any LZ4 decoder. Header only and free of
+// engine dependencies so tools can compress without linking the engine.
+// The compressor is a plain greedy one: fast, but with ratios below the reference encoder.
+namespace Engine::LZ4 {
+
+	static const size_t MinMatch = 4;
+	// The format keeps the last bytes as literals and starts no match closer to the end
+	static const size_t LastLiterals = 5;
+	static const size_t MatchFindLimit = 12;
+	static const size_t MaxOffset = 65535;
+
+	inline size_t CompressBound(size_t size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	// Largest size compressedSize bytes can decompress to, a length byte adds at most 255 bytes
+	inline uint64_t DecompressBound(uint64_t compressedSize)
+	{
+		return compressedSize * 255 + 16;
+	}
+
+	inline uint32_t Read32(const uint8_t* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	// Returns the compressed size, 0 when it doesn't fit in capacity
+	inline size_t Compress(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity)
+	{
+		static const uint32_t HashBits = 12;
+		uint32_t table[1 << HashBits] = {};
+
+		uint8_t* out = destination;
+		uint8_t* outEnd = destination + capacity;
+
+		auto writeLength = [&](size_t length)
+		{
+			for (; length >= 255; length -= 255)
+				*out++ = 255;
+			*out++ = (uint8_t)length;
+		};
+
+		// Worst case of a sequence: token, literal length bytes, literals, offset, match length bytes
+		auto writeSequence = [&](const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+		{
+			size_t required = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+			if ((size_t)(outEnd - out) < required)
+				return false;
+
+			uint8_t* token = out++;
+			*token = (uint8_t)((literalLength < 15 ? literalLength : 15) << 4);
+			if (literalLength >= 15)
+				writeLength(literalLength - 15);
+			if (literalLength > 0)
+				memcpy(out, literals, literalLength);
+			out += literalLength;
+
+			// The last sequence has no match
+			if (matchLength == 0)
+				return true;
+
+			*out++ = (uint8_t)offset;
+			*out++ = (uint8_t)(offset >> 8);
+			size_t code = matchLength - MinMatch;
+			*token |= (uint8_t)(code < 15 ? code : 15);
+			if (code >= 15)
+				writeLength(code - 15);
+			return true;
+		};
+
+		size_t anchor = 0;
+		if (size > MatchFindLimit)
+		{
+			size_t matchLimit = size - LastLiterals;
+			for (size_t i = 0; i < size - MatchFindLimit;)
+			{
+				uint32_t sequence = Read32(source + i);
+				uint32_t hash = (sequence * 2654435761u) >> (32 - HashBits);
+				size_t candidate = table[hash];
+				table[hash] = (uint32_t)i;
+
+				if (candidate >= i || i - candidate > MaxOffset || Read32(source + candidate) != sequence)
+				{
+					i++;
+					continue;
+				}
+
+				size_t length = MinMatch;
+				while (i + length < matchLimit && source[candidate + length] == source[i + length])
+					length++;
+
+				if (!writeSequence(source + anchor, i - anchor, i - candidate, length))
+					return 0;
+				i += length;
+				anchor = i;
+			}
+		}
+
+		if (!writeSequence(source + anchor, size - anchor, 0, 0))
+			return 0;
+		return out - destination;
+	}
+
+	// Returns false when the data is corrupt or doesn't decompress to exactly size bytes
+	inline bool Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size)
+	{
+		const uint8_t* in = source;
+		const uint8_t* inEnd = source + sourceSize;
+		uint8_t* out = destination;
+		uint8_t* outEnd = destination + size;
+
+		auto readLength = [&](size_t& length)
+		{
+			uint8_t byte;
+			do
+			{
+				if (in == inEnd)
+					return false;
+				byte = *in++;
+				length += byte;
+			} while (byte == 255);
+			return true;
+		};
+
+		while (in < inEnd)
+		{
+			uint8_t token = *in++;
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15 && !readLength(literalLength))
+				return false;
+			if ((size_t)(inEnd - in) < literalLength || (size_t)(outEnd - out) < literalLength)
+				return false;
+			if (literalLength > 0)
+				memcpy(out, in, literalLength);
+			in += literalLength;
+			out += literalLength;
+
+			if (in == inEnd)
+				break;
+
+			if (inEnd - in < 2)
+				return false;
+			size_t offset = in[0] | (in[1] << 8);
+			in += 2;
+			if (offset == 0 || offset > (size_t)(out - destination))
+				return false;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !readLength(matchLength))
+				return false;
+			matchLength += MinMatch;
+			if ((size_t)(outEnd - out) < matchLength)
+				return false;
+
+			const uint8_t* match = out - offset;
+			if (offset >= matchLength)
+				memcpy(out, match, matchLength);
+			else
+			{
+				// Overlapping copies repeat the last offset bytes
+				for (size_t i = 0; i < matchLength; i++)
+					out[i] = match[i];
+			}
+			out += matchLength;
+		}
+		return out == outEnd;
+	}
+}
\ No newline at end of file
@@ -10,5 +10,7 @@ namespace Engine {
 
 	Layer::~Layer()
 	{
+		for (uint32_t listener : m_Listeners)
+			m_EventBus->Unsubscribe(listener);
 	}
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include "Engine/Core/Base.h"
 #include "Engine/Core/Timestep.h"
-#include "Engine/Events/Event.h"
+#include "Engine/Events/EventBus.h"
 
 namespace Engine {
 
@@ -14,12 +14,34 @@ namespace Engine {
 
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
+		// Once per frame with the variable frame time
 		virtual void OnUpdate(Timestep ts) {}
+		// Zero or more times per frame, always with the application's fixed timestep
+		virtual void OnFixedUpdate(Timestep ts) {}
+		// After OnUpdate. alpha is how far the clock is into the next fixed step (0 - 1),
+		// for drawing simulated state interpolated between the last two fixed updates
+		virtual void OnRender(float alpha) {}
 		virtual void OnImGuiRender() {}
-		virtual void OnEvent(Event& event) {}
 
 		inline const std::string& GetName() const { return m_DebugName; }
+	protected:
+		// Subscribes a member function to one event type on the application's EventBus, from
+		// OnAttach() on. Layers higher in the stack are called first, until one returns true.
+		// The subscriptions end with the layer.
+		template<typename T, bool(T::*Method)(const QueuedEvent&)>
+		void Subscribe(EventType type)
+		{
+			GE_CORE_ASSERT(m_EventBus, "Layer is not attached");
+			m_Listeners.push_back(m_EventBus->Subscribe<T, Method>(type, static_cast<T*>(this), m_EventPriority));
+		}
 	protected:
 		std::string m_DebugName;
+	private:
+		// Set by the Application before OnAttach()
+		EventBus* m_EventBus = nullptr;
+		int32_t m_EventPriority = 0;
+		std::vector<uint32_t> m_Listeners;
+
+		friend class Application;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "gepch.h"
+#include "MappedFile.h"
+
+#ifdef GE_PLATFORM_WINDOWS
+	#include "Platform/Windows/WindowsMappedFile.h"
+#elif defined(GE_PLATFORM_LINUX)
+	#include "Platform/Linux/LinuxMappedFile.h"
+#endif
+
+namespace Engine {
+
+	Ref<MappedFile> MappedFile::Open(const std::string& filepath)
+	{
+	#ifdef GE_PLATFORM_WINDOWS
+		Ref<WindowsMappedFile> file = CreateRef<WindowsMappedFile>();
+	#elif defined(GE_PLATFORM_LINUX)
+		Ref<LinuxMappedFile> file = CreateRef<LinuxMappedFile>();
+	#endif
+		if (!file->Map(filepath))
+			return nullptr;
+		return file;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+namespace Engine {
+
+	// A read only file mapped into memory. The data stays valid as long as the object lives,
+	// the OS pages it in on first access.
+	class MappedFile
+	{
+	public:
+		virtual ~MappedFile() = default;
+
+		inline const uint8_t* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+
+		// Returns nullptr when the file can't be opened. Empty files map to no data.
+		static Ref<MappedFile> Open(const std::string& filepath);
+	protected:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Engine/Core/LZ4.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Pak archive read by the VFS (.pak), written by PakWriter (see the PakTool project). Header
+// only like the other file formats, so tools don't need to link the engine.
+//
+// File:    Header, entry data, index
+// Header:  Magic[8], Version (uint32), EntryCount (uint32), IndexOffset (uint64), little endian
+// Data:    the stored bytes of every entry, each aligned to DataAlignment so an uncompressed
+//          entry can be used in place from a memory mapping
+// Index:   EntryCount entries sorted by path hash, so a lookup is a binary search:
+//          PathHash (uint64), Offset (uint64), StoredSize (uint64), Size (uint64),
+//          Compression (uint8), path length (uint16), path bytes
+//
+// Paths are relative to the directory the archive was made from, with '/' separators.
+namespace Engine::PakFormat {
+
+	static const char Magic[8] = { 'G', 'E', 'P', 'A', 'K', 'F', 'I', 'L' };
+	static const uint32_t Version = 1;
+	static const size_t HeaderSize = 24;
+	static const size_t IndexEntrySize = 35;
+	static const uint64_t DataAlignment = 16;
+	// Stored as a uint16 in the index
+	static const size_t MaxPathLength = 0xffff;
+
+	enum class CompressionType : uint8_t
+	{
+		None = 0,
+		LZ4 = 1
+	};
+
+	struct IndexEntry
+	{
+		uint64_t PathHash;
+		uint64_t Offset;
+		uint64_t StoredSize;
+		uint64_t Size;
+		CompressionType Compression;
+		std::string Path;
+	};
+
+	// FNV-1a
+	inline uint64_t HashPath(const char* path, size_t length)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < length; i++)
+		{
+			hash ^= (uint8_t)path[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	inline void WriteU64(std::string& out, uint64_t value)
+	{
+		for (uint32_t i = 0; i < 8; i++)
+			out.push_back((char)(value >> (i * 8)));
+	}
+
+	inline uint64_t ReadU64(const uint8_t* data)
+	{
+		uint64_t value = 0;
+		for (uint32_t i = 0; i < 8; i++)
+			value |= (uint64_t)data[i] << (i * 8);
+		return value;
+	}
+
+	inline uint32_t ReadU32(const uint8_t* data)
+	{
+		return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+	}
+
+	inline bool ReadHeader(const uint8_t* data, size_t size, uint32_t& version, uint32_t& entryCount, uint64_t& indexOffset)
+	{
+		if (size < HeaderSize || memcmp(data, Magic, sizeof(Magic)) != 0)
+			return false;
+
+		version = ReadU32(data + 8);
+		entryCount = ReadU32(data + 12);
+		indexOffset = ReadU64(data + 16);
+		return true;
+	}
+
+	// Writes the entries as they are added and the index on Finish()
+	class PakWriter
+	{
+	public:
+		bool Open(const std::string& filepath)
+		{
+			m_File.open(filepath, std::ios::binary);
+			if (!m_File.is_open())
+				return false;
+
+			// The header is rewritten by Finish()
+			m_File.write(std::string(HeaderSize, '\0').data(), HeaderSize);
+			m_Offset = HeaderSize;
+			return true;
+		}
+
+		// Compressed entries are only kept when they save at least a sixteenth.
+		// Returns false when the path doesn't fit the index, nothing is written then, or when
+		// writing the data failed.
+		bool Add(const std::string& path, const uint8_t* data, size_t size, bool compress)
+		{
+			if (path.size() > MaxPathLength)
+				return false;
+
+			IndexEntry entry = { HashPath(path.data(), path.size()), 0, size, size, CompressionType::None, path };
+			if (compress && size > 0)
+			{
+				m_Compressed.resize(LZ4::CompressBound(size));
+				size_t compressedSize = LZ4::Compress(data, size, m_Compressed.data(), m_Compressed.size());
+				if (compressedSize > 0 && compressedSize < size - size / 16)
+				{
+					data = m_Compressed.data();
+					entry.StoredSize = compressedSize;
+					entry.Compression = CompressionType::LZ4;
+				}
+			}
+
+			uint64_t padding = (DataAlignment - m_Offset % DataAlignment) % DataAlignment;
+			m_File.write(std::string((size_t)padding, '\0').data(), padding);
+			entry.Offset = m_Offset + padding;
+			m_File.write((const char*)data, entry.StoredSize);
+			if (!m_File)
+				return false;
+
+			m_Offset = entry.Offset + entry.StoredSize;
+			m_Entries.push_back(std::move(entry));
+			return true;
+		}
+
+		bool Finish()
+		{
+			std::sort(m_Entries.begin(), m_Entries.end(), [](const IndexEntry& a, const IndexEntry& b) { return a.PathHash < b.PathHash; });
+
+			std::string index;
+			for (const IndexEntry& entry : m_Entries)
+			{
+				WriteU64(index, entry.PathHash);
+				WriteU64(index, entry.Offset);
+				WriteU64(index, entry.StoredSize);
+				WriteU64(index, entry.Size);
+				index.push_back((char)entry.Compression);
+				index.push_back((char)entry.Path.size());
+				index.push_back((char)(entry.Path.size() >> 8));
+				index.append(entry.Path);
+			}
+			m_File.write(index.data(), index.size());
+
+			std::string header(Magic, sizeof(Magic));
+			uint32_t fields[2] = { Version, (uint32_t)m_Entries.size() };
+			for (uint32_t field : fields)
+			{
+				for (uint32_t i = 0; i < 4; i++)
+					header.push_back((char)(field >> (i * 8)));
+			}
+			WriteU64(header, m_Offset);
+			m_File.seekp(0);
+			m_File.write(header.data(), header.size());
+			m_File.close();
+			return !m_File.fail();
+		}
+
+		inline const std::vector<IndexEntry>& GetEntries() const { return m_Entries; }
+	private:
+		std::ofstream m_File;
+		uint64_t m_Offset = 0;
+		std::vector<IndexEntry> m_Entries;
+		std::vector<uint8_t> m_Compressed;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "gepch.h"
+#include "VFS.h"
+
+#include "Engine/Core/MappedFile.h"
+#include "Engine/Core/PakFormat.h"
+
+#include <filesystem>
+
+namespace Engine {
+
+	struct PakArchive
+	{
+		Ref<MappedFile> File;
+		// Sorted by path hash
+		std::vector<PakFormat::IndexEntry> Entries;
+
+		const PakFormat::IndexEntry* Find(const std::string& path) const
+		{
+			uint64_t hash = PakFormat::HashPath(path.data(), path.size());
+			auto it = std::lower_bound(Entries.begin(), Entries.end(), hash,
+				[](const PakFormat::IndexEntry& entry, uint64_t hash) { return entry.PathHash < hash; });
+			for (; it != Entries.end() && it->PathHash == hash; it++)
+			{
+				if (it->Path == path)
+					return &*it;
+			}
+			return nullptr;
+		}
+	};
+
+	struct MountPoint
+	{
+		// Normalized, empty for the root
+		std::string Point;
+		std::string Directory;
+		Ref<PakArchive> Pak;
+	};
+
+	struct VFSData
+	{
+		std::vector<MountPoint> Mounts;
+	};
+
+	static VFSData s_Data;
+
+	static Ref<PakArchive> OpenPak(const std::string& filepath)
+	{
+		Ref<MappedFile> file = MappedFile::Open(filepath);
+		if (!file)
+		{
+			GE_CORE_ERROR("Could not open pak '{0}'", filepath);
+			return nullptr;
+		}
+
+		const uint8_t* data = file->GetData();
+		size_t size = file->GetSize();
+		uint32_t version, entryCount;
+		uint64_t indexOffset;
+		if (!PakFormat::ReadHeader(data, size, version, entryCount, indexOffset) || version != PakFormat::Version || indexOffset > size)
+		{
+			GE_CORE_ERROR("'{0}' is not a pak of version {1}", filepath, PakFormat::Version);
+			return nullptr;
+		}
+
+		Ref<PakArchive> pak = CreateRef<PakArchive>();
+		pak->File = file;
+		pak->Entries.reserve(std::min<size_t>(entryCount, (size - indexOffset) / PakFormat::IndexEntrySize));
+
+		const uint8_t* cursor = data + indexOffset;
+		const uint8_t* end = data + size;
+		for (uint32_t i = 0; i < entryCount; i++)
+		{
+			if ((size_t)(end - cursor) < PakFormat::IndexEntrySize)
+				break;
+
+			PakFormat::IndexEntry entry;
+			entry.PathHash = PakFormat::ReadU64(cursor);
+			entry.Offset = PakFormat::ReadU64(cursor + 8);
+			entry.StoredSize = PakFormat::ReadU64(cursor + 16);
+			entry.Size = PakFormat::ReadU64(cursor + 24);
+			entry.Compression = (PakFormat::CompressionType)cursor[32];
+			size_t pathLength = cursor[33] | (cursor[34] << 8);
+			cursor += PakFormat::IndexEntrySize;
+			if ((size_t)(end - cursor) < pathLength)
+				break;
+			entry.Path.assign((const char*)cursor, pathLength);
+			cursor += pathLength;
+
+			bool valid = entry.Offset <= indexOffset && entry.StoredSize <= indexOffset - entry.Offset;
+			if (entry.Compression == PakFormat::CompressionType::None)
+				valid = valid && entry.StoredSize == entry.Size;
+			else if (entry.Compression == PakFormat::CompressionType::LZ4)
+				valid = valid && entry.Size <= LZ4::DecompressBound(entry.StoredSize);
+			else
+				valid = false;
+			if (!valid)
+				break;
+
+			pak->Entries.push_back(std::move(entry));
+		}
+
+		if (pak->Entries.size() != entryCount || !std::is_sorted(pak->Entries.begin(), pak->Entries.end(),
+			[](const PakFormat::IndexEntry& a, const PakFormat::IndexEntry& b) { return a.PathHash < b.PathHash; }))
+		{
+			GE_CORE_ERROR("Pak '{0}' has a corrupt index", filepath);
+			return nullptr;
+		}
+		return pak;
+	}
+
+	static FileBuffer ReadEntry(const Ref<PakArchive>& pak, const PakFormat::IndexEntry& entry)
+	{
+		const uint8_t* stored = pak->File->GetData() + entry.Offset;
+		if (entry.Compression == PakFormat::CompressionType::None)
+			return FileBuffer(stored, (size_t)entry.Size, pak->File);
+
+		GE_PROFILE_FUNCTION();
+
+		Ref<std::vector<uint8_t>> data = CreateRef<std::vector<uint8_t>>((size_t)entry.Size);
+		if (!LZ4::Decompress(stored, (size_t)entry.StoredSize, data->data(), data->size()))
+		{
+			GE_CORE_ERROR("Pak entry '{0}' is corrupt", entry.Path);
+			return FileBuffer();
+		}
+		return FileBuffer(data->data(), data->size(), data);
+	}
+
+	// Path relative to the mount point, false when the path is outside of it
+	static bool GetRelativePath(const MountPoint& mount, const std::string& path, std::string& relative)
+	{
+		if (mount.Point.empty())
+		{
+			relative = path;
+			return true;
+		}
+
+		if (path.compare(0, mount.Point.size(), mount.Point) != 0)
+			return false;
+		if (path.size() == mount.Point.size())
+		{
+			relative.clear();
+			return true;
+		}
+		if (path[mount.Point.size()] != '/')
+			return false;
+
+		relative = path.substr(mount.Point.size() + 1);
+		return true;
+	}
+
+	static bool IsFile(const std::string& filepath)
+	{
+		std::error_code error;
+		return std::filesystem::is_regular_file(filepath, error);
+	}
+
+	bool VFS::Mount(const std::string& mountPoint, const std::string& source)
+	{
+		GE_PROFILE_FUNCTION();
+
+		MountPoint mount;
+		mount.Point = NormalizePath(mountPoint);
+
+		std::error_code error;
+		if (std::filesystem::is_directory(source, error))
+			mount.Directory = source;
+		else if (!(mount.Pak = OpenPak(source)))
+			return false;
+
+		GE_CORE_INFO("Mounted '{0}' at '{1}'", source, mount.Point);
+		s_Data.Mounts.push_back(std::move(mount));
+		return true;
+	}
+
+	void VFS::UnmountAll()
+	{
+		s_Data.Mounts.clear();
+	}
+
+	bool VFS::Exists(const std::string& path)
+	{
+		std::string normalized = NormalizePath(path);
+		std::string relative;
+		for (auto it = s_Data.Mounts.rbegin(); it != s_Data.Mounts.rend(); it++)
+		{
+			if (!GetRelativePath(*it, normalized, relative))
+				continue;
+
+			if (it->Pak ? it->Pak->Find(relative) != nullptr : IsFile(it->Directory + "/" + relative))
+				return true;
+		}
+		return IsFile(path);
+	}
+
+	FileBuffer VFS::Read(const std::string& path)
+	{
+		GE_PROFILE_FUNCTION();
+
+		std::string normalized = NormalizePath(path);
+		std::string relative;
+		for (auto it = s_Data.Mounts.rbegin(); it != s_Data.Mounts.rend(); it++)
+		{
+			if (!GetRelativePath(*it, normalized, relative))
+				continue;
+
+			if (it->Pak)
+			{
+				if (const PakFormat::IndexEntry* entry = it->Pak->Find(relative))
+					return ReadEntry(it->Pak, *entry);
+			}
+			else if (Ref<MappedFile> file = MappedFile::Open(it->Directory + "/" + relative))
+				return FileBuffer(file->GetData(), file->GetSize(), file);
+		}
+
+		if (Ref<MappedFile> file = MappedFile::Open(path))
+			return FileBuffer(file->GetData(), file->GetSize(), file);
+		return FileBuffer();
+	}
+
+	std::string VFS::NormalizePath(const std::string& path)
+	{
+		std::string result;
+		result.reserve(path.size());
+
+		size_t start = 0;
+		while (start <= path.size())
+		{
+			size_t end = path.find_first_of("/\\", start);
+			if (end == std::string::npos)
+				end = path.size();
+
+			size_t length = end - start;
+			size_t slash = result.rfind('/');
+			size_t last = slash == std::string::npos ? 0 : slash + 1;
+			if (length == 2 && path.compare(start, 2, "..") == 0 && !result.empty() && result.compare(last, std::string::npos, "..") != 0)
+				result.erase(slash == std::string::npos ? 0 : slash);
+			else if (length > 0 && !(length == 1 && path[start] == '.'))
+			{
+				if (!result.empty())
+					result.push_back('/');
+				result.append(path, start, length);
+			}
+			start = end + 1;
+		}
+		return result;
+	}
+}
\ No newline at end of file
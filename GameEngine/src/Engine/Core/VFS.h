@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+namespace Engine {
+
+	// The bytes of a file read through the VFS. Points into a memory mapping when the file is
+	// stored uncompressed, so reading doesn't copy; the buffer keeps the mapping alive.
+	class FileBuffer
+	{
+	public:
+		FileBuffer() = default;
+		FileBuffer(const uint8_t* data, size_t size, const Ref<void>& owner)
+			: m_Data(data), m_Size(size), m_Owner(owner) {}
+
+		inline const uint8_t* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+		inline std::string ToString() const { return std::string((const char*)m_Data, m_Size); }
+
+		// False when the file couldn't be read, empty files are valid
+		inline bool IsValid() const { return m_Owner != nullptr; }
+		inline explicit operator bool() const { return IsValid(); }
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		Ref<void> m_Owner;
+	};
+
+	// Virtual file system the asset loaders read through. A mount point maps a path prefix to
+	// a directory of loose files (development) or to a pak archive (shipping, see
+	// PakFormat.h), so the same asset paths work with both:
+	//   VFS::Mount("res", "res.pak");   // "res/textures/a.png" is read from the archive
+	// Paths under no mount point, and paths a mount doesn't contain, are read as native files
+	// relative to the working directory.
+	//
+	// Mount before loading starts. Reads are thread safe as long as the mounts don't change.
+	class VFS
+	{
+	public:
+		// Mounts a directory, or a pak archive if source is a file. Later mounts are searched
+		// first, so a patch archive can override single files of an earlier one.
+		static bool Mount(const std::string& mountPoint, const std::string& source);
+		static void UnmountAll();
+
+		static bool Exists(const std::string& path);
+		// Returns an invalid buffer when the file doesn't exist or is corrupt
+		static FileBuffer Read(const std::string& path);
+
+		// Uses '/' separators and drops empty and "." segments and leading or trailing '/'.
+		// ".." removes the segment before it where there is one.
+		static std::string NormalizePath(const std::string& path);
+	};
+}
\ No newline at end of file
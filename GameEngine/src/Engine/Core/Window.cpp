@@ -0,0 +1,27 @@
+#include "gepch.h"
+#include "Window.h"
+
+#include "Engine/Renderer/RendererAPI.h"
+#include "Platform/Null/NullWindow.h"
+
+#ifdef GE_PLATFORM_WINDOWS
+	#include "Platform/Windows/WindowsWindow.h"
+#elif defined(GE_PLATFORM_LINUX)
+	#include "Platform/Linux/LinuxWindow.h"
+#endif
+
+namespace Engine {
+
+	Scope<Window> Window::Create(const WindowProps& props)
+	{
+		// The null and software APIs have no context to present, so there is no need for a native window
+		if (RendererAPI::GetAPI() == RendererAPI::API::Null || RendererAPI::GetAPI() == RendererAPI::API::Software)
+			return CreateScope<NullWindow>(props);
+
+	#ifdef GE_PLATFORM_WINDOWS
+		return CreateScope<WindowsWindow>(props);
+	#elif defined(GE_PLATFORM_LINUX)
+		return CreateScope<LinuxWindow>(props);
+	#endif
+	}
+}
\ No newline at end of file
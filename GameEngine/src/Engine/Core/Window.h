@@ -6,12 +6,17 @@
 #include "Engine/Events/Event.h"
 
 namespace Engine {
+
+	class GraphicsContext;
+	class EventBus;
 	
 	struct WindowProps
 	{
 		std::string Title;
 		unsigned int Width;
 		unsigned int Height;
+		// Hidden windows still own a context, used for headless runs
+		bool Visible = true;
 
 		WindowProps(const std::string& title = "Game Engine",
 					unsigned int width = 1280,
@@ -23,23 +28,28 @@ namespace Engine {
 	class GE_API Window
 	{
 	public:
-		using EventCallbackFn = std::function<void(Event&)>;
-
 		virtual ~Window() {}
 
+		// PollEvents() followed by SwapBuffers()
 		virtual void OnUpdate() = 0;
+		// Events have to be polled on the main thread, the swap goes wherever the context is current
+		virtual void PollEvents() = 0;
+		virtual void SwapBuffers() = 0;
 
 		virtual unsigned int GetWidth() const = 0;
 		virtual unsigned int GetHeight() const = 0;
 		virtual std::pair<float, float> GetWindowPos() const = 0;
 
 		// Window attributes
-		virtual void SetEventCallback(EventCallbackFn&& callback) = 0;
+		// Input and window events are posted to the bus, nullptr drops them
+		virtual void SetEventBus(EventBus* bus) = 0;
 		virtual void SetVSync(bool enabled) = 0;
 		virtual bool IsVSync() const = 0;
 
 		// Void so it can return any window (not just GLFWwindow)
 		virtual void* GetNativeWindow() const = 0;
+		// nullptr for windows without a context
+		virtual GraphicsContext* GetContext() const = 0;
 
 		static Scope<Window> Create(const WindowProps& props = WindowProps());
 	};
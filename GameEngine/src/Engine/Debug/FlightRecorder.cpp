@@ -0,0 +1,247 @@
+#include "gepch.h"
+#include "FlightRecorder.h"
+
+#include <deque>
+
+namespace Engine {
+
+	static const int64_t s_NanosecondsPerSecond = 1000 * 1000 * 1000;
+	// Time for the writer thread to drain the scopes that closed before the capture ends
+	static const int64_t s_DrainMargin = 50 * 1000 * 1000;
+	// Upper bound on memory use (24 bytes per event) when scopes are very dense
+	static const size_t s_MaxEvents = 1 << 22;
+
+	struct RecordedEvent
+	{
+		ProfileEvent Event;
+		uint32_t Thread;
+	};
+
+	class FlightRecorderListener : public ProfileEventListener
+	{
+	public:
+		virtual void OnProfileEvents(const ProfileThreadBuffer& track, const ProfileEvent* events, uint32_t count) override;
+
+		std::mutex Mutex;
+		std::deque<RecordedEvent> Events;
+		// Indexed by thread, owned by the Instrumentor
+		std::vector<const ProfileThreadBuffer*> Tracks;
+		int64_t Retention = 0;
+		int64_t LatestEnd = 0;
+	};
+
+	struct FlightRecorderData
+	{
+		FlightRecorderConfig Config;
+		bool Enabled = false;
+		FlightRecorderListener Listener;
+
+		int64_t LastFrameStart = 0;
+
+		bool CapturePending = false;
+		int64_t TriggerTime = 0;
+		uint32_t CaptureCount = 0;
+
+		// Captures are encoded and written off the main thread
+		std::thread CaptureWriter;
+	};
+
+	static FlightRecorderData* s_Data = nullptr;
+
+	// Counter samples are points in time, they have no duration
+	static int64_t GetEnd(const RecordedEvent& recorded, const std::vector<const ProfileThreadBuffer*>& tracks)
+	{
+		if (tracks[recorded.Thread]->GetType() == ProfileTrackType::Counters)
+			return recorded.Event.Start;
+		return recorded.Event.Start + recorded.Event.Duration;
+	}
+
+	void FlightRecorderListener::OnProfileEvents(const ProfileThreadBuffer& track, const ProfileEvent* events, uint32_t count)
+	{
+		std::lock_guard lock(Mutex);
+
+		uint32_t threadIndex = track.GetThreadIndex();
+		if (threadIndex >= Tracks.size())
+			Tracks.resize(threadIndex + 1, nullptr);
+		Tracks[threadIndex] = &track;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Events.push_back({ events[i], threadIndex });
+			LatestEnd = std::max(LatestEnd, GetEnd(Events.back(), Tracks));
+		}
+
+		// Threads are drained one after another, so the deque is only roughly in time order
+		while (!Events.empty())
+		{
+			if (Events.size() <= s_MaxEvents && GetEnd(Events.front(), Tracks) >= LatestEnd - Retention)
+				break;
+			Events.pop_front();
+		}
+	}
+
+	static int64_t ToNanoseconds(float seconds)
+	{
+		return (int64_t)(seconds * s_NanosecondsPerSecond);
+	}
+
+	static void WriteCapture(std::vector<RecordedEvent> events, std::vector<const ProfileThreadBuffer*> tracks, std::string name, std::string filepath)
+	{
+		GE_PROFILE_FUNCTION();
+
+		std::sort(events.begin(), events.end(), [](const RecordedEvent& a, const RecordedEvent& b)
+		{
+			return a.Event.Start < b.Event.Start;
+		});
+
+		TraceFormat::Writer writer;
+		writer.BeginSession(name);
+		for (const ProfileThreadBuffer* track : tracks)
+		{
+			if (track && track->GetName())
+				writer.NameTrack(track->GetThreadIndex(), track->GetName());
+		}
+		for (const RecordedEvent& recorded : events)
+		{
+			const ProfileEvent& event = recorded.Event;
+			if (tracks[recorded.Thread]->GetType() == ProfileTrackType::Counters)
+				writer.WriteCounter(recorded.Thread, event.Name, event.Start, event.Value);
+			else
+				writer.WriteEvent(recorded.Thread, event.Name, event.Start, event.Duration);
+		}
+
+		std::ofstream file(filepath, std::ios::binary);
+		if (!file.is_open())
+		{
+			GE_CORE_ERROR("FlightRecorder could not open capture file '{0}'.", filepath);
+			return;
+		}
+
+		const std::string& encoded = writer.GetBuffer();
+		file.write(encoded.data(), encoded.size());
+		GE_CORE_INFO("FlightRecorder: wrote {0} events to '{1}'", events.size(), filepath);
+	}
+
+	static void Capture()
+	{
+		GE_PROFILE_FUNCTION();
+
+		int64_t begin = s_Data->TriggerTime - ToNanoseconds(s_Data->Config.WindowSeconds);
+		int64_t end = s_Data->TriggerTime + ToNanoseconds(s_Data->Config.PostTriggerSeconds);
+
+		std::vector<RecordedEvent> events;
+		std::vector<const ProfileThreadBuffer*> tracks;
+		{
+			std::lock_guard lock(s_Data->Listener.Mutex);
+			events.reserve(s_Data->Listener.Events.size());
+			for (const RecordedEvent& recorded : s_Data->Listener.Events)
+			{
+				if (GetEnd(recorded, s_Data->Listener.Tracks) >= begin && recorded.Event.Start <= end)
+					events.push_back(recorded);
+			}
+			tracks = s_Data->Listener.Tracks;
+		}
+
+		uint32_t index = s_Data->CaptureCount++;
+		std::string name = "FlightRecorder " + std::to_string(index);
+		std::string filepath = s_Data->Config.FilePrefix + "-" + std::to_string(index) + ".getrace";
+
+		if (s_Data->CaptureWriter.joinable())
+			s_Data->CaptureWriter.join();
+		s_Data->CaptureWriter = std::thread(WriteCapture, std::move(events), std::move(tracks), std::move(name), std::move(filepath));
+	}
+
+	void FlightRecorder::Init(const FlightRecorderConfig& config)
+	{
+		s_Data = new FlightRecorderData();
+		SetConfig(config);
+	}
+
+	void FlightRecorder::Shutdown()
+	{
+		SetEnabled(false);
+		if (s_Data->CaptureWriter.joinable())
+			s_Data->CaptureWriter.join();
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void FlightRecorder::SetConfig(const FlightRecorderConfig& config)
+	{
+		s_Data->Config = config;
+
+		std::lock_guard lock(s_Data->Listener.Mutex);
+		s_Data->Listener.Retention = ToNanoseconds(config.WindowSeconds + config.PostTriggerSeconds) + s_DrainMargin;
+	}
+
+	const FlightRecorderConfig& FlightRecorder::GetConfig()
+	{
+		return s_Data->Config;
+	}
+
+	void FlightRecorder::SetEnabled(bool enabled)
+	{
+		if (!s_Data || s_Data->Enabled == enabled)
+			return;
+
+		s_Data->Enabled = enabled;
+		if (enabled)
+		{
+			Instrumentor::Get().AddListener(&s_Data->Listener);
+		}
+		else
+		{
+			Instrumentor::Get().RemoveListener(&s_Data->Listener);
+			s_Data->Listener.Events.clear();
+			s_Data->LastFrameStart = 0;
+			s_Data->CapturePending = false;
+		}
+	}
+
+	bool FlightRecorder::IsEnabled()
+	{
+		return s_Data && s_Data->Enabled;
+	}
+
+	void FlightRecorder::BeginFrame()
+	{
+		if (!IsEnabled())
+			return;
+
+		int64_t now = Instrumentor::Now();
+		float threshold = s_Data->Config.SpikeThresholdMs;
+		if (s_Data->LastFrameStart && threshold > 0.0f)
+		{
+			float frameTime = (now - s_Data->LastFrameStart) / 1000000.0f;
+			if (frameTime > threshold && !s_Data->CapturePending)
+			{
+				GE_CORE_WARN("FlightRecorder: frame took {0:.2f} ms (threshold {1:.2f} ms)", frameTime, threshold);
+				Trigger("Frame time spike");
+			}
+		}
+		s_Data->LastFrameStart = now;
+
+		if (s_Data->CapturePending && now >= s_Data->TriggerTime + ToNanoseconds(s_Data->Config.PostTriggerSeconds) + s_DrainMargin)
+		{
+			s_Data->CapturePending = false;
+			Capture();
+		}
+	}
+
+	void FlightRecorder::Trigger(const char* reason)
+	{
+		if (!IsEnabled() || s_Data->CapturePending)
+			return;
+
+		// The spike is the frame that just ended, it is inside the window either way
+		s_Data->CapturePending = true;
+		s_Data->TriggerTime = Instrumentor::Now();
+		GE_CORE_INFO("FlightRecorder: {0}, capturing in {1:.1f} s", reason, s_Data->Config.PostTriggerSeconds);
+	}
+
+	uint32_t FlightRecorder::GetCaptureCount()
+	{
+		return s_Data ? s_Data->CaptureCount : 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+
+	struct FlightRecorderConfig
+	{
+		// History kept in memory, the part of a capture before the trigger
+		float WindowSeconds = 5.0f;
+		// Recorded after the trigger, so the capture shows how the spike resolves
+		float PostTriggerSeconds = 1.0f;
+		// Frames slower than this trigger a capture, 0 disables the automatic trigger
+		float SpikeThresholdMs = 50.0f;
+		// Captures are written to <FilePrefix>-<n>.getrace
+		std::string FilePrefix = "FlightRecorder";
+	};
+
+	// Keeps the last few seconds of profile events of all threads in memory and dumps
+	// them to a trace file when a frame spikes or a capture is triggered by hand.
+	// Needs no open Instrumentor session, the events come in through a listener.
+	class FlightRecorder
+	{
+	public:
+		static void Init(const FlightRecorderConfig& config = FlightRecorderConfig());
+		static void Shutdown();
+
+		static void SetConfig(const FlightRecorderConfig& config);
+		static const FlightRecorderConfig& GetConfig();
+
+		// The Instrumentor records while the flight recorder is enabled
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		// Call at the start of every frame on the main thread, measures the frame time
+		static void BeginFrame();
+
+		// Captures the window around now, ignored while a capture is pending
+		static void Trigger(const char* reason);
+
+		static uint32_t GetCaptureCount();
+	};
+}
\ No newline at end of file
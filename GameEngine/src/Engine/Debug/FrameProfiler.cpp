@@ -0,0 +1,487 @@
+#include "gepch.h"
+#include "FrameProfiler.h"
+
+#include "Engine/Core/Allocator.h"
+#include "Engine/Renderer/GPUProfiler.h"
+#include "MemoryTracker.h"
+
+#include "imgui.h"
+
+#include <cfloat>
+#include <deque>
+
+namespace Engine {
+
+	// A frame is folded once it ended this long ago, covers a few writer drain intervals.
+	// GPU scopes also need the frames their timestamps take to be read back.
+	static const int64_t s_FrameSettleTime = 50 * 1000 * 1000;
+	static const uint32_t s_FrameSettleFrames = GPUProfiler::FramesInFlight + 1;
+	static const uint32_t s_Root = 0xffffffff;
+
+	enum class ProfilerTrack
+	{
+		CPU = 0, GPU, Count
+	};
+
+	static const char* s_TrackNames[] = { "CPU", "GPU" };
+	static const uint32_t s_TrackCount = (uint32_t)ProfilerTrack::Count;
+
+	struct ScopeNode
+	{
+		const char* Name;
+		uint32_t Parent;
+		uint32_t Depth;
+		std::vector<uint32_t> Children;
+
+		// Milliseconds spent per frame, indexed by frame % HistoryFrames
+		float History[FrameProfiler::HistoryFrames] = {};
+		uint32_t LastCalls = 0;
+	};
+
+	struct FlameEntry
+	{
+		const char* Name;
+		int64_t Start;
+		int64_t Duration;
+		uint32_t Depth;
+	};
+
+	struct ScopeStats
+	{
+		float Min, Avg, Max, P99;
+	};
+
+	// Main thread or GPU track: events from the Instrumentor thread index of the track
+	class FrameProfilerListener : public ProfileEventListener
+	{
+	public:
+		virtual void OnProfileEvents(const ProfileThreadBuffer& track, const ProfileEvent* events, uint32_t count) override;
+
+		std::mutex Mutex;
+		std::vector<ProfileEvent> Pending[s_TrackCount];
+		std::atomic<uint32_t> ThreadIndices[s_TrackCount] = { s_Root, s_Root };
+	};
+
+	struct TrackData
+	{
+		std::vector<ProfileEvent> Unassigned;
+		std::vector<uint32_t> RootNodes;
+		std::unordered_map<const char*, uint32_t> RootLookup;
+
+		// Last folded frame, for the flame graph
+		std::vector<FlameEntry> FlameEntries;
+	};
+
+	struct FrameProfilerData
+	{
+		bool Enabled = false;
+		FrameProfilerListener Listener;
+
+		std::deque<int64_t> FrameStarts;
+
+		// Nodes of all tracks, roots are per track
+		std::vector<ScopeNode> Nodes;
+		std::vector<std::unordered_map<const char*, uint32_t>> ChildLookup;
+		TrackData Tracks[s_TrackCount];
+
+		uint64_t FrameIndex = 0;
+		float FrameTimes[FrameProfiler::HistoryFrames] = {};
+
+		int64_t FlameFrameStart = 0;
+		int64_t FlameFrameDuration = 0;
+
+		// Scratch
+		std::vector<ProfileEvent> FrameEvents;
+		std::vector<float> FrameTotals;
+		std::vector<uint32_t> FrameCalls;
+		std::vector<float> SortScratch;
+	};
+
+	static FrameProfilerData* s_Data = nullptr;
+
+	void FrameProfilerListener::OnProfileEvents(const ProfileThreadBuffer& track, const ProfileEvent* events, uint32_t count)
+	{
+		for (uint32_t index = 0; index < s_TrackCount; index++)
+		{
+			if (track.GetThreadIndex() != ThreadIndices[index].load(std::memory_order_relaxed))
+				continue;
+
+			std::lock_guard lock(Mutex);
+			Pending[index].insert(Pending[index].end(), events, events + count);
+		}
+	}
+
+	static uint32_t FindOrAddNode(TrackData& track, uint32_t parent, const char* name)
+	{
+		auto& lookup = parent == s_Root ? track.RootLookup : s_Data->ChildLookup[parent];
+		auto it = lookup.find(name);
+		if (it != lookup.end())
+			return it->second;
+
+		uint32_t index = (uint32_t)s_Data->Nodes.size();
+		ScopeNode& node = s_Data->Nodes.emplace_back();
+		node.Name = name;
+		node.Parent = parent;
+		node.Depth = parent == s_Root ? 0 : s_Data->Nodes[parent].Depth + 1;
+		s_Data->ChildLookup.emplace_back();
+
+		// Lookup may have been invalidated by ChildLookup growing
+		(parent == s_Root ? track.RootLookup : s_Data->ChildLookup[parent]).emplace(name, index);
+		if (parent == s_Root)
+			track.RootNodes.push_back(index);
+		else
+			s_Data->Nodes[parent].Children.push_back(index);
+
+		return index;
+	}
+
+	// Adds the scopes of one track in a frame to the call tree and the per-frame totals
+	static void FoldTrack(TrackData& track, int64_t frameStart, int64_t frameEnd)
+	{
+		auto& events = s_Data->FrameEvents;
+		events.clear();
+
+		// Events are assigned to the frame their scope started in. GPU work runs
+		// behind the CPU, so its scopes can start in the next frame.
+		auto& unassigned = track.Unassigned;
+		auto keep = unassigned.begin();
+		for (auto it = unassigned.begin(); it != unassigned.end(); ++it)
+		{
+			if (it->Start >= frameEnd)
+				*keep++ = *it;
+			else if (it->Start >= frameStart)
+				events.push_back(*it);
+		}
+		unassigned.erase(keep, unassigned.end());
+
+		// Parents before children: earlier start first, longer first on ties
+		std::sort(events.begin(), events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+		{
+			return a.Start != b.Start ? a.Start < b.Start : a.Duration > b.Duration;
+		});
+
+		track.FlameEntries.clear();
+
+		struct OpenScope { int64_t End; uint32_t Node; };
+		LinearVector<OpenScope> stack(FrameAllocator::Get());
+		for (const ProfileEvent& event : events)
+		{
+			while (!stack.empty() && stack.back().End <= event.Start)
+				stack.pop_back();
+
+			uint32_t parent = stack.empty() ? s_Root : stack.back().Node;
+			uint32_t node = FindOrAddNode(track, parent, event.Name);
+			if (node >= s_Data->FrameTotals.size())
+			{
+				s_Data->FrameTotals.resize(node + 1, 0.0f);
+				s_Data->FrameCalls.resize(node + 1, 0);
+			}
+
+			s_Data->FrameTotals[node] += event.Duration / 1000000.0f;
+			s_Data->FrameCalls[node]++;
+			track.FlameEntries.push_back({ event.Name, event.Start, event.Duration, (uint32_t)stack.size() });
+			stack.push_back({ event.Start + event.Duration, node });
+		}
+	}
+
+	// Builds the call trees of one frame from its events and stores the times in the history
+	static void FoldFrame(int64_t frameStart, int64_t frameEnd)
+	{
+		GE_PROFILE_FUNCTION();
+
+		s_Data->FrameTotals.assign(s_Data->Nodes.size(), 0.0f);
+		s_Data->FrameCalls.assign(s_Data->Nodes.size(), 0);
+		for (TrackData& track : s_Data->Tracks)
+			FoldTrack(track, frameStart, frameEnd);
+
+		uint32_t slot = s_Data->FrameIndex % FrameProfiler::HistoryFrames;
+		for (uint32_t i = 0; i < s_Data->Nodes.size(); i++)
+		{
+			s_Data->Nodes[i].History[slot] = s_Data->FrameTotals[i];
+			s_Data->Nodes[i].LastCalls = s_Data->FrameCalls[i];
+		}
+		s_Data->FrameTimes[slot] = (frameEnd - frameStart) / 1000000.0f;
+		s_Data->FlameFrameStart = frameStart;
+		s_Data->FlameFrameDuration = frameEnd - frameStart;
+		s_Data->FrameIndex++;
+	}
+
+	static ScopeStats ComputeStats(const float* history)
+	{
+		uint32_t count = (uint32_t)std::min<uint64_t>(s_Data->FrameIndex, FrameProfiler::HistoryFrames);
+		if (count == 0)
+			return { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		auto& values = s_Data->SortScratch;
+		values.assign(history, history + count);
+
+		ScopeStats stats = { FLT_MAX, 0.0f, 0.0f, 0.0f };
+		for (float value : values)
+		{
+			stats.Min = std::min(stats.Min, value);
+			stats.Max = std::max(stats.Max, value);
+			stats.Avg += value;
+		}
+		stats.Avg /= count;
+
+		uint32_t p99 = (uint32_t)(0.99f * (count - 1));
+		std::nth_element(values.begin(), values.begin() + p99, values.end());
+		stats.P99 = values[p99];
+		return stats;
+	}
+
+	void FrameProfiler::Init()
+	{
+		s_Data = new FrameProfilerData();
+	}
+
+	void FrameProfiler::Shutdown()
+	{
+		SetEnabled(false);
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void FrameProfiler::SetEnabled(bool enabled)
+	{
+		if (!s_Data || s_Data->Enabled == enabled)
+			return;
+
+		s_Data->Enabled = enabled;
+		auto& threadIndices = s_Data->Listener.ThreadIndices;
+		if (enabled)
+		{
+			threadIndices[(uint32_t)ProfilerTrack::CPU] = Instrumentor::Get().GetCurrentThreadIndex();
+			threadIndices[(uint32_t)ProfilerTrack::GPU] = GPUProfiler::GetTrackIndex();
+			Instrumentor::Get().AddListener(&s_Data->Listener);
+		}
+		else
+		{
+			Instrumentor::Get().RemoveListener(&s_Data->Listener);
+			s_Data->FrameStarts.clear();
+			for (uint32_t track = 0; track < s_TrackCount; track++)
+			{
+				s_Data->Tracks[track].Unassigned.clear();
+				s_Data->Listener.Pending[track].clear();
+			}
+		}
+	}
+
+	bool FrameProfiler::IsEnabled()
+	{
+		return s_Data && s_Data->Enabled;
+	}
+
+	void FrameProfiler::BeginFrame()
+	{
+		if (!IsEnabled())
+			return;
+
+		int64_t now = Instrumentor::Now();
+		s_Data->FrameStarts.push_back(now);
+
+		{
+			std::lock_guard lock(s_Data->Listener.Mutex);
+			for (uint32_t track = 0; track < s_TrackCount; track++)
+			{
+				auto& pending = s_Data->Listener.Pending[track];
+				auto& unassigned = s_Data->Tracks[track].Unassigned;
+				unassigned.insert(unassigned.end(), pending.begin(), pending.end());
+				pending.clear();
+			}
+		}
+
+		auto& starts = s_Data->FrameStarts;
+		while (starts.size() >= s_FrameSettleFrames + 1 && now - starts[1] >= s_FrameSettleTime)
+		{
+			FoldFrame(starts[0], starts[1]);
+			starts.pop_front();
+		}
+	}
+
+	static void DrawFlameGraph(uint32_t trackIndex)
+	{
+		const TrackData& track = s_Data->Tracks[trackIndex];
+		if (track.FlameEntries.empty() || s_Data->FlameFrameDuration <= 0)
+			return;
+
+		ImGui::Text("%s", s_TrackNames[trackIndex]);
+
+		const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+		uint32_t maxDepth = 0;
+		for (const FlameEntry& entry : track.FlameEntries)
+			maxDepth = std::max(maxDepth, entry.Depth);
+
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		float width = ImGui::GetContentRegionAvail().x;
+		float height = (maxDepth + 1) * rowHeight;
+		ImGui::InvisibleButton(s_TrackNames[trackIndex], ImVec2(width, height));
+		bool hovered = ImGui::IsItemHovered();
+		ImVec2 mouse = ImGui::GetIO().MousePos;
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		drawList->PushClipRect(origin, ImVec2(origin.x + width, origin.y + height), true);
+
+		double scale = width / (double)s_Data->FlameFrameDuration;
+		for (const FlameEntry& entry : track.FlameEntries)
+		{
+			float x0 = origin.x + (float)((entry.Start - s_Data->FlameFrameStart) * scale);
+			float x1 = x0 + std::max(1.0f, (float)(entry.Duration * scale));
+			float y0 = origin.y + entry.Depth * rowHeight;
+			float y1 = y0 + rowHeight - 1.0f;
+
+			// Stable color per name
+			uint32_t hash = (uint32_t)(std::hash<const void*>()(entry.Name) * 2654435761u);
+			ImU32 color = IM_COL32(120 + (hash & 0x7f), 80 + ((hash >> 8) & 0x7f), 60 + ((hash >> 16) & 0x3f), 255);
+			drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), color);
+
+			if (x1 - x0 > 30.0f)
+			{
+				drawList->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+				drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(0, 0, 0, 255), entry.Name);
+				drawList->PopClipRect();
+			}
+
+			if (hovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+				ImGui::SetTooltip("%s\n%.3f ms", entry.Name, entry.Duration / 1000000.0);
+		}
+
+		drawList->PopClipRect();
+	}
+
+	static void DrawScopeNode(uint32_t index)
+	{
+		const ScopeNode& node = s_Data->Nodes[index];
+		ScopeStats stats = ComputeStats(node.History);
+
+		ImGuiTreeNodeFlags flags = 0;
+		if (node.Children.empty())
+			flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		if (node.Depth < 2)
+			flags |= ImGuiTreeNodeFlags_DefaultOpen;
+
+		bool open = ImGui::TreeNodeEx((void*)(intptr_t)index, flags, "%s", node.Name);
+		ImGui::NextColumn();
+		ImGui::Text("%.3f", stats.Avg);	ImGui::NextColumn();
+		ImGui::Text("%.3f", stats.Min);	ImGui::NextColumn();
+		ImGui::Text("%.3f", stats.Max);	ImGui::NextColumn();
+		ImGui::Text("%.3f", stats.P99);	ImGui::NextColumn();
+		ImGui::Text("%u", node.LastCalls);	ImGui::NextColumn();
+
+		if (open && !node.Children.empty())
+		{
+			for (uint32_t child : node.Children)
+				DrawScopeNode(child);
+			ImGui::TreePop();
+		}
+	}
+
+	static void MemoryText(int64_t bytes)
+	{
+		if (bytes >= 1024 * 1024)
+			ImGui::Text("%.2f MB", bytes / (1024.0 * 1024.0));
+		else if (bytes >= 1024)
+			ImGui::Text("%.2f KB", bytes / 1024.0);
+		else
+			ImGui::Text("%lld B", (long long)bytes);
+	}
+
+	static void DrawMemoryRow(const char* name, const MemoryStats& stats)
+	{
+		ImGui::Text("%s", name);	ImGui::NextColumn();
+		MemoryText(stats.LiveBytes);	ImGui::NextColumn();
+		MemoryText(stats.PeakBytes);	ImGui::NextColumn();
+		ImGui::Text("%lld", (long long)stats.LiveCount);	ImGui::NextColumn();
+		ImGui::Text("%lld", (long long)stats.FrameAllocations);	ImGui::NextColumn();
+	}
+
+	static void DrawMemory()
+	{
+		if (!MemoryTracker::IsTrackingAllocations())
+			ImGui::TextWrapped("Heap allocations are not hooked, set GE_TRACK_MEMORY to 1 in MemoryTracker.h. Only external and GPU memory is counted.");
+
+		ImGui::Columns(5, "ProfilerMemory");
+		ImGui::Text("Tag");	ImGui::NextColumn();
+		ImGui::Text("Live");		ImGui::NextColumn();
+		ImGui::Text("Peak");		ImGui::NextColumn();
+		ImGui::Text("Count");		ImGui::NextColumn();
+		ImGui::Text("Allocs/frame");	ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (uint32_t tag = 0; tag < (uint32_t)MemoryTag::Count; tag++)
+			DrawMemoryRow(MemoryTracker::GetTagName((MemoryTag)tag), MemoryTracker::GetStats((MemoryTag)tag));
+
+		ImGui::Separator();
+		for (uint32_t type = 0; type < (uint32_t)GPUMemoryType::Count; type++)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "GPU %s", MemoryTracker::GetGPUTypeName((GPUMemoryType)type));
+			DrawMemoryRow(name, MemoryTracker::GetGPUStats((GPUMemoryType)type));
+		}
+
+		ImGui::Columns(1);
+		ImGui::Separator();
+
+		if (MemoryTracker::IsTrackingAllocations())
+			ImGui::Text("Heap allocations last frame: %lld", (long long)MemoryTracker::GetFrameAllocationCount());
+
+		const LinearAllocator& frameAllocator = FrameAllocator::Get();
+		ImGui::Text("Frame allocator: peak");	ImGui::SameLine();
+		MemoryText((int64_t)frameAllocator.GetPeakBytes());	ImGui::SameLine();
+		ImGui::Text("of");	ImGui::SameLine();
+		MemoryText((int64_t)frameAllocator.GetCapacity());
+	}
+
+	void FrameProfiler::OnImGuiRender()
+	{
+		if (!IsEnabled())
+			return;
+
+		ImGui::Begin("Profiler");
+
+#if !GE_PROFILE
+		ImGui::TextWrapped("Profile scopes are compiled out, set GE_PROFILE to 1 in Instrumentor.h.");
+#endif
+
+		ScopeStats frame = ComputeStats(s_Data->FrameTimes);
+		ImGui::Text("Frame (last %u): avg %.3f ms  min %.3f  max %.3f  p99 %.3f", HistoryFrames, frame.Avg, frame.Min, frame.Max, frame.P99);
+
+		if (ImGui::CollapsingHeader("Flame Graph", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			for (uint32_t track = 0; track < s_TrackCount; track++)
+				DrawFlameGraph(track);
+		}
+
+		if (ImGui::CollapsingHeader("Scopes (ms)", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::Columns(6, "ProfilerScopes");
+			ImGui::Text("Scope");	ImGui::NextColumn();
+			ImGui::Text("Avg");		ImGui::NextColumn();
+			ImGui::Text("Min");		ImGui::NextColumn();
+			ImGui::Text("Max");		ImGui::NextColumn();
+			ImGui::Text("P99");		ImGui::NextColumn();
+			ImGui::Text("Calls");	ImGui::NextColumn();
+			ImGui::Separator();
+
+			for (uint32_t track = 0; track < s_TrackCount; track++)
+			{
+				if (s_Data->Tracks[track].RootNodes.empty())
+					continue;
+
+				ImGui::Text("%s", s_TrackNames[track]);
+				for (uint32_t column = 0; column < 6; column++)
+					ImGui::NextColumn();
+
+				for (uint32_t root : s_Data->Tracks[track].RootNodes)
+					DrawScopeNode(root);
+			}
+
+			ImGui::Columns(1);
+		}
+
+		if (ImGui::CollapsingHeader("Memory"))
+			DrawMemory();
+
+		ImGui::End();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine {
+
+	// Live per-scope statistics on top of GE_PROFILE_SCOPE.
+	// Scopes of the main thread are folded into a call tree every frame and each node
+	// keeps its time over the last HistoryFrames frames for min/avg/max/p99.
+	// Frames are only processed once all their events have been drained from the
+	// Instrumentor rings, so the panel lags a few frames behind.
+	class FrameProfiler
+	{
+	public:
+		static const uint32_t HistoryFrames = 240;
+
+		static void Init();
+		static void Shutdown();
+
+		// Starts aggregating, the Instrumentor records while the profiler is enabled
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		// Call at the start of every frame on the main thread
+		static void BeginFrame();
+
+		static void OnImGuiRender();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "gepch.h"
+#include "Instrumentor.h"
+#include "TraceFormat.h"
+#include "MemoryTracker.h"
+
+namespace Engine {
+
+	// How often the writer drains the rings and flushes the file
+	static const std::chrono::milliseconds s_DrainInterval(10);
+	static const uint32_t s_FlushEveryDrains = 10;
+
+	Instrumentor::~Instrumentor()
+	{
+		std::lock_guard lock(m_SessionMutex);
+		InternalEndSession();
+		m_Listeners.clear();
+		StopWriter();
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+	{
+		std::lock_guard lock(m_SessionMutex);
+		if (m_CurrentSession)
+		{
+			// If there is already a current session, then close it before beginning new one.
+			// Subsequent profiling output meant for the original session will end up in the
+			// newly opened session instead.  That's better than having badly formatted
+			// profiling output.
+			if (Engine::Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
+			{
+				GE_CORE_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_CurrentSession->Name);
+			}
+			InternalEndSession();
+		}
+
+		StopWriter();
+		m_OutputStream.open(filepath, std::ios::binary);
+
+		if (m_OutputStream.is_open())
+		{
+			m_CurrentSession = new InstrumentationSession({ name });
+			WriteHeader();
+
+			// Scopes that closed after the last session ended don't belong to this one
+			if (m_Listeners.empty())
+				DiscardBuffers();
+
+			if (Log::GetCoreLogger())
+				GE_CORE_INFO("Instrumentor: session '{0}', probe overhead {1:.1f} ns", name, MeasureProbeOverhead());
+		}
+		else
+		{
+			if (Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
+			{
+				GE_CORE_ERROR("Instrumentor could not open results file '{0}'.", filepath);
+			}
+		}
+		UpdateWriter();
+	}
+
+	void Instrumentor::EndSession()
+	{
+		std::lock_guard lock(m_SessionMutex);
+		InternalEndSession();
+	}
+
+	void Instrumentor::AddListener(ProfileEventListener* listener)
+	{
+		std::lock_guard lock(m_SessionMutex);
+		StopWriter();
+		m_Listeners.push_back(listener);
+		UpdateWriter();
+	}
+
+	void Instrumentor::RemoveListener(ProfileEventListener* listener)
+	{
+		std::lock_guard lock(m_SessionMutex);
+		StopWriter();
+		m_Listeners.erase(std::remove(m_Listeners.begin(), m_Listeners.end(), listener), m_Listeners.end());
+		UpdateWriter();
+	}
+
+	double Instrumentor::MeasureProbeOverhead(uint32_t iterations)
+	{
+		ProfileThreadBuffer buffer(0);
+
+		int64_t begin = Now();
+		for (uint32_t i = 0; i < iterations; i++)
+		{
+			// Same work as InstrumentationTimer: two clock reads and a push
+			int64_t start = Now();
+			int64_t end = Now();
+			buffer.Push({ "Probe", start, end - start });
+
+			if ((i & (ProfileThreadBuffer::Capacity - 1)) == ProfileThreadBuffer::Capacity - 1)
+				buffer.Drain([](const ProfileEvent&) {});
+		}
+		int64_t elapsed = Now() - begin;
+
+		return iterations ? (double)elapsed / iterations : 0.0;
+	}
+
+	ProfileThreadBuffer* Instrumentor::CreateTrack(const char* name, ProfileTrackType type)
+	{
+		return RegisterThread(name, type);
+	}
+
+	ProfileThreadBuffer* Instrumentor::RegisterThread(const char* name, ProfileTrackType type)
+	{
+		GE_MEMORY_TAG(MemoryTag::Profiler);
+
+		std::lock_guard lock(m_BuffersMutex);
+		m_Buffers.push_back(std::make_unique<ProfileThreadBuffer>((uint32_t)m_Buffers.size(), name, type));
+		return m_Buffers.back().get();
+	}
+
+	void Instrumentor::StartWriter()
+	{
+		if (m_Writer.joinable())
+			return;
+
+		m_WriterStop = false;
+		m_Writer = std::thread(&Instrumentor::WriterThread, this);
+		m_Recording.store(true, std::memory_order_release);
+	}
+
+	void Instrumentor::StopWriter()
+	{
+		if (!m_Writer.joinable())
+			return;
+
+		m_Recording.store(false, std::memory_order_release);
+		{
+			std::lock_guard lock(m_WriterMutex);
+			m_WriterStop = true;
+		}
+		m_WriterWakeup.notify_one();
+		m_Writer.join();
+
+		// Whatever was pushed before recording stopped
+		DrainBuffers();
+	}
+
+	void Instrumentor::UpdateWriter()
+	{
+		if (m_CurrentSession || !m_Listeners.empty())
+			StartWriter();
+	}
+
+	void Instrumentor::WriterThread()
+	{
+		GE_MEMORY_TAG(MemoryTag::Profiler);
+
+		uint32_t drains = 0;
+		std::unique_lock lock(m_WriterMutex);
+		while (!m_WriterStop)
+		{
+			m_WriterWakeup.wait_for(lock, s_DrainInterval, [this] { return m_WriterStop; });
+
+			lock.unlock();
+			DrainBuffers();
+			if (m_CurrentSession && ++drains % s_FlushEveryDrains == 0)
+				m_OutputStream.flush();
+			lock.lock();
+		}
+	}
+
+	uint32_t Instrumentor::DrainBuffers()
+	{
+		uint32_t count = 0;
+		uint32_t dropped = 0;
+		m_TraceWriter.ClearBuffer();
+
+		{
+			std::lock_guard lock(m_BuffersMutex);
+			for (auto& buffer : m_Buffers)
+			{
+				uint32_t threadIndex = buffer->GetThreadIndex();
+				m_DrainScratch.clear();
+				count += buffer->Drain([&](const ProfileEvent& event) { m_DrainScratch.push_back(event); });
+				dropped += buffer->TakeDroppedCount();
+
+				if (m_DrainScratch.empty())
+					continue;
+
+				if (m_CurrentSession)
+				{
+					// Named once per session, ahead of its first event
+					if (buffer->GetName())
+						m_TraceWriter.NameTrack(threadIndex, buffer->GetName());
+
+					if (buffer->GetType() == ProfileTrackType::Counters)
+					{
+						for (const ProfileEvent& event : m_DrainScratch)
+							m_TraceWriter.WriteCounter(threadIndex, event.Name, event.Start, event.Value);
+					}
+					else
+					{
+						for (const ProfileEvent& event : m_DrainScratch)
+							m_TraceWriter.WriteEvent(threadIndex, event.Name, event.Start, event.Duration);
+					}
+				}
+
+				for (ProfileEventListener* listener : m_Listeners)
+					listener->OnProfileEvents(*buffer, m_DrainScratch.data(), (uint32_t)m_DrainScratch.size());
+			}
+		}
+
+		const std::string& encoded = m_TraceWriter.GetBuffer();
+		if (m_CurrentSession && !encoded.empty())
+			m_OutputStream.write(encoded.data(), encoded.size());
+
+		if (dropped && Log::GetCoreLogger())
+			GE_CORE_WARN("Instrumentor: {0} events dropped, ring buffer full", dropped);
+
+		return count;
+	}
+
+	void Instrumentor::DiscardBuffers()
+	{
+		std::lock_guard lock(m_BuffersMutex);
+		for (auto& buffer : m_Buffers)
+		{
+			buffer->Drain([](const ProfileEvent&) {});
+			buffer->TakeDroppedCount();
+		}
+	}
+
+	void Instrumentor::WriteHeader()
+	{
+		m_TraceWriter.ClearBuffer();
+		m_TraceWriter.BeginSession(m_CurrentSession->Name);
+
+		const std::string& header = m_TraceWriter.GetBuffer();
+		m_OutputStream.write(header.data(), header.size());
+		m_OutputStream.flush();
+		m_TraceWriter.ClearBuffer();
+	}
+
+	void Instrumentor::InternalEndSession()
+	{
+		if (m_CurrentSession)
+		{
+			StopWriter();
+
+			m_OutputStream.close();
+			delete m_CurrentSession;
+			m_CurrentSession = nullptr;
+
+			UpdateWriter();
+		}
+	}
+}
\ No newline at end of file
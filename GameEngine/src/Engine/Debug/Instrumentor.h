@@ -1,23 +1,95 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
-#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "TraceFormat.h"
 
 namespace Engine {
 
-	using FloatingPointMicroseconds = std::chrono::duration<double, std::micro>;
+	// One closed scope, or one counter sample on counter tracks.
+	// Name has to outlive the session, the macros only pass string literals.
+	struct ProfileEvent
+	{
+		const char* Name;
+		// Nanoseconds on the steady clock
+		int64_t Start;
+		union
+		{
+			int64_t Duration;
+			int64_t Value;
+		};
+	};
 
-	struct ProfileResult
+	enum class ProfileTrackType : uint8_t
 	{
-		std::string Name;
+		Scopes = 0,
+		Counters
+	};
+
+	// Single producer / single consumer ring owned by one thread.
+	// The owning thread pushes without locks, the writer thread drains.
+	// Events are dropped (and counted) instead of blocking when the ring is full.
+	// Named buffers are tracks that are not tied to a thread (GPU timestamps).
+	class ProfileThreadBuffer
+	{
+	public:
+		static const uint32_t Capacity = 1 << 14;
+
+		ProfileThreadBuffer(uint32_t threadIndex, const char* name = nullptr, ProfileTrackType type = ProfileTrackType::Scopes)
+			: m_ThreadIndex(threadIndex), m_Name(name), m_Type(type), m_Events(new ProfileEvent[Capacity])
+		{
+		}
+
+		inline void Push(const ProfileEvent& event)
+		{
+			uint32_t head = m_Head.load(std::memory_order_relaxed);
+			if (head - m_Tail.load(std::memory_order_acquire) >= Capacity)
+			{
+				m_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			m_Events[head & (Capacity - 1)] = event;
+			m_Head.store(head + 1, std::memory_order_release);
+		}
+
+		// Calls fn for every pending event, only the writer thread may call this
+		template<typename Fn>
+		uint32_t Drain(Fn&& fn)
+		{
+			uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+			uint32_t head = m_Head.load(std::memory_order_acquire);
+			for (uint32_t i = tail; i != head; i++)
+				fn(m_Events[i & (Capacity - 1)]);
 
-		FloatingPointMicroseconds Start;
-		std::chrono::microseconds ElapsedTime;
-		std::thread::id ThreadID;
+			m_Tail.store(head, std::memory_order_release);
+			return head - tail;
+		}
+
+		inline uint32_t GetThreadIndex() const { return m_ThreadIndex; }
+		inline const char* GetName() const { return m_Name; }
+		inline ProfileTrackType GetType() const { return m_Type; }
+		inline uint32_t TakeDroppedCount() { return m_Dropped.exchange(0, std::memory_order_relaxed); }
+	private:
+		uint32_t m_ThreadIndex;
+		const char* m_Name;
+		ProfileTrackType m_Type;
+		std::unique_ptr<ProfileEvent[]> m_Events;
+
+		// Producer and consumer indices on separate cache lines
+		alignas(64) std::atomic<uint32_t> m_Head{ 0 };
+		alignas(64) std::atomic<uint32_t> m_Tail{ 0 };
+		std::atomic<uint32_t> m_Dropped{ 0 };
 	};
 
 	struct InstrumentationSession
@@ -25,112 +97,137 @@ namespace Engine {
 		std::string Name;
 	};
 
+	// Live consumer of profile events, called on the writer thread after every drain
+	class ProfileEventListener
+	{
+	public:
+		virtual ~ProfileEventListener() = default;
+
+		// track is the ring of a CPU thread or a named track, it stays valid as long as the Instrumentor
+		virtual void OnProfileEvents(const ProfileThreadBuffer& track, const ProfileEvent* events, uint32_t count) = 0;
+	};
+
+	// GPU side of GE_PROFILE_SCOPE, installed on the thread that owns the graphics context
+	struct GPUScopeHooks
+	{
+		uint32_t(*Begin)(const char* name);
+		void(*End)(uint32_t scope);
+	};
+
+	// Scopes are recorded into per-thread rings and written by a background thread,
+	// so a probe costs two clock reads and a ring push.
 	class Instrumentor
 	{
-	private:
-		std::mutex m_Mutex;
-		InstrumentationSession* m_CurrentSession;
-		std::ofstream m_OutputStream;
 	public:
-		Instrumentor()
-			: m_CurrentSession(nullptr)
+		Instrumentor() = default;
+		~Instrumentor();
+
+		// Writes the binary TraceFormat, convert it with TraceConvert for chrome://tracing or Perfetto
+		void BeginSession(const std::string& name, const std::string& filepath = "results.getrace");
+		void EndSession();
+
+		// Listeners keep recording on without a session
+		void AddListener(ProfileEventListener* listener);
+		void RemoveListener(ProfileEventListener* listener);
+
+		// Ring index of the calling thread, the thread index the events are reported with
+		inline uint32_t GetCurrentThreadIndex() { return GetThreadBuffer().GetThreadIndex(); }
+
+		// Adds a named track with its own thread index. Events are recorded into it with
+		// Record(track, ...) or RecordCounter(track, ...), from one thread at a time.
+		ProfileThreadBuffer* CreateTrack(const char* name, ProfileTrackType type = ProfileTrackType::Scopes);
+
+		inline bool IsRecording() const { return m_Recording.load(std::memory_order_relaxed); }
+
+		inline void Record(const char* name, int64_t start, int64_t duration)
 		{
+			if (!IsRecording())
+				return;
+
+			GetThreadBuffer().Push({ name, start, duration });
 		}
 
-		void BeginSession(const std::string& name, const std::string& filepath = "results.json")
+		inline void Record(ProfileThreadBuffer& track, const char* name, int64_t start, int64_t duration)
 		{
-			std::lock_guard lock(m_Mutex);
-			if (m_CurrentSession)
-			{
-				// If there is already a current session, then close it before beginning new one.
-				// Subsequent profiling output meant for the original session will end up in the
-				// newly opened session instead.  That's better than having badly formatted
-				// profiling output.
-				if (Engine::Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
-				{
-					GE_CORE_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_CurrentSession->Name);
-				}
-				InternalEndSession();
-			}
-			m_OutputStream.open(filepath);
+			if (!IsRecording())
+				return;
 
-			if (m_OutputStream.is_open())
-			{
-				m_CurrentSession = new InstrumentationSession({ name });
-				WriteHeader();
-			}
-			else
-			{
-				if (Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
-				{
-					GE_CORE_ERROR("Instrumentor could not open results file '{0}'.", filepath);
-				}
-			}
+			track.Push({ name, start, duration });
 		}
 
-		void EndSession()
+		inline void RecordCounter(ProfileThreadBuffer& track, const char* name, int64_t value)
 		{
-			std::lock_guard lock(m_Mutex);
-			InternalEndSession();
+			if (!IsRecording())
+				return;
+
+			track.Push({ name, Now(), value });
 		}
 
-		void WriteProfile(const ProfileResult& result)
+		inline static int64_t Now()
 		{
-			std::stringstream json;
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
 
-			json << std::setprecision(3) << std::fixed;
-			json << ",{";
-			json << "\"cat\":\"function\",";
-			json << "\"dur\":" << (result.ElapsedTime.count()) << ',';
-			json << "\"name\":\"" << result.Name << "\",";
-			json << "\"ph\":\"X\",";
-			json << "\"pid\":0,";
-			json << "\"tid\":" << result.ThreadID << ",";
-			json << "\"ts\":" << result.Start.count();
-			json << "}";
+		// Average cost of one scope probe in nanoseconds, measured on a private ring
+		static double MeasureProbeOverhead(uint32_t iterations = 100000);
 
-			std::lock_guard lock(m_Mutex);
-			if (m_CurrentSession)
-			{
-				m_OutputStream << json.str();
-				m_OutputStream.flush();
-			}
-		}
+		// Per thread, nullptr removes them. See GPUProfiler.
+		static void SetGPUScopeHooks(const GPUScopeHooks* hooks) { s_GPUScopeHooks = hooks; }
+		static const GPUScopeHooks* GetGPUScopeHooks() { return s_GPUScopeHooks; }
 
 		static Instrumentor& Get()
 		{
 			static Instrumentor instance;
 			return instance;
 		}
-
 	private:
+		static inline thread_local const GPUScopeHooks* s_GPUScopeHooks = nullptr;
 
-		void WriteHeader()
+		inline ProfileThreadBuffer& GetThreadBuffer()
 		{
-			m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
-			m_OutputStream.flush();
+			thread_local ProfileThreadBuffer* buffer = nullptr;
+			if (!buffer)
+				buffer = RegisterThread();
+			return *buffer;
 		}
 
-		void WriteFooter()
-		{
-			m_OutputStream << "]}";
-			m_OutputStream.flush();
-		}
+		ProfileThreadBuffer* RegisterThread(const char* name = nullptr, ProfileTrackType type = ProfileTrackType::Scopes);
+
+		// The writer only runs while there is a session or a listener. Anything it reads
+		// (session, stream, listeners) is only changed while it is stopped.
+		void StartWriter();
+		void StopWriter();
+		void UpdateWriter();
+		void WriterThread();
+		// Returns the number of events drained
+		uint32_t DrainBuffers();
+		void DiscardBuffers();
 
-		// Note: you must already own lock on m_Mutex before
+		void WriteHeader();
+		// Note: you must already own lock on m_SessionMutex before
 		// calling InternalEndSession()
-		void InternalEndSession()
-		{
-			if (m_CurrentSession)
-			{
-				WriteFooter();
-				m_OutputStream.close();
-				delete m_CurrentSession;
-				m_CurrentSession = nullptr;
-			}
-			}
+		void InternalEndSession();
+	private:
+		std::mutex m_SessionMutex;
+		InstrumentationSession* m_CurrentSession = nullptr;
+		std::ofstream m_OutputStream;
+		std::atomic<bool> m_Recording{ false };
 
-		};
+		// Buffers live as long as the Instrumentor, threads may exit before the writer drains them
+		std::mutex m_BuffersMutex;
+		std::vector<std::unique_ptr<ProfileThreadBuffer>> m_Buffers;
+
+		std::vector<ProfileEventListener*> m_Listeners;
+
+		std::thread m_Writer;
+		std::mutex m_WriterMutex;
+		std::condition_variable m_WriterWakeup;
+		bool m_WriterStop = false;
+
+		// Writer thread only
+		TraceFormat::Writer m_TraceWriter;
+		std::vector<ProfileEvent> m_DrainScratch;
+	};
 
 	class InstrumentationTimer
 	{
@@ -138,7 +235,7 @@ namespace Engine {
 		InstrumentationTimer(const char* name)
 			: m_Name(name), m_Stopped(false)
 		{
-			m_StartTimepoint = std::chrono::steady_clock::now();
+			m_Start = Instrumentor::Now();
 		}
 
 		~InstrumentationTimer()
@@ -149,20 +246,41 @@ namespace Engine {
 
 		void Stop()
 		{
-			auto endTimepoint = std::chrono::steady_clock::now();
-			auto highResStart = FloatingPointMicroseconds{ m_StartTimepoint.time_since_epoch() };
-			auto elapsedTime = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch() - std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch();
-
-			Instrumentor::Get().WriteProfile({ m_Name, highResStart, elapsedTime, std::this_thread::get_id() });
+			int64_t end = Instrumentor::Now();
+			Instrumentor::Get().Record(m_Name, m_Start, end - m_Start);
 
 			m_Stopped = true;
 		}
 	private:
 		const char* m_Name;
-		std::chrono::time_point<std::chrono::steady_clock> m_StartTimepoint;
+		int64_t m_Start;
 		bool m_Stopped;
 	};
 
+	// GE_PROFILE_SCOPE: on the thread that owns the graphics context the scope is timed on the
+	// GPU as well and shows up on the GPU track. GE_PROFILE_FUNCTION stays CPU only, function
+	// scopes are far too many for the per-frame query budget.
+	class InstrumentationScope
+	{
+	public:
+		InstrumentationScope(const char* name)
+			: m_Timer(name), m_Hooks(Instrumentor::GetGPUScopeHooks())
+		{
+			if (m_Hooks)
+				m_GPUScope = m_Hooks->Begin(name);
+		}
+
+		~InstrumentationScope()
+		{
+			if (m_Hooks)
+				m_Hooks->End(m_GPUScope);
+		}
+	private:
+		InstrumentationTimer m_Timer;
+		const GPUScopeHooks* m_Hooks;
+		uint32_t m_GPUScope = 0;
+	};
+
 	namespace InstrumentorUtils {
 
 		template <size_t N>
@@ -194,10 +312,16 @@ namespace Engine {
 }
 #define GE_PROFILE 0
 #if GE_PROFILE
+	#if defined(__GNUC__) || defined(__clang__)
+		#define GE_FUNC_SIG __PRETTY_FUNCTION__
+	#else
+		#define GE_FUNC_SIG __FUNCSIG__
+	#endif
+
 	#define GE_PROFILE_BEGIN_SESSION(name, filepath) ::Engine::Instrumentor::Get().BeginSession(name, filepath)
 	#define GE_PROFILE_END_SESSION() ::Engine::Instrumentor::Get().EndSession()
-	#define GE_PROFILE_SCOPE(name) ::Engine::InstrumentationTimer timer##__LINE__(name)
-	#define GE_PROFILE_FUNCTION() GE_PROFILE_SCOPE(__FUNCSIG__)
+	#define GE_PROFILE_SCOPE(name) ::Engine::InstrumentationScope scope##__LINE__(name)
+	#define GE_PROFILE_FUNCTION() ::Engine::InstrumentationTimer timer##__LINE__(GE_FUNC_SIG)
 #else
 	#define GE_PROFILE_BEGIN_SESSION(name, filepath)
 	#define GE_PROFILE_END_SESSION()
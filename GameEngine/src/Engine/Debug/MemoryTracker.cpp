@@ -0,0 +1,267 @@
+#include "gepch.h"
+#include "MemoryTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace Engine {
+
+	static const uint32_t s_TagCount = (uint32_t)MemoryTag::Count;
+	static const uint32_t s_GPUTypeCount = (uint32_t)GPUMemoryType::Count;
+
+	static const char* s_TagNames[] = { "Untagged", "Mesh", "Assimp", "Renderer", "Renderer2D", "Texture", "Profiler", "Scene", "Transient" };
+	static const char* s_GPUTypeNames[] = { "Buffer", "Texture", "RenderTarget" };
+
+	// Counter names have to be static strings
+	static const char* s_LiveCounterNames[] = { "Memory Untagged", "Memory Mesh", "Memory Assimp", "Memory Renderer", "Memory Renderer2D", "Memory Texture", "Memory Profiler", "Memory Scene", "Memory Transient" };
+	static const char* s_AllocationCounterNames[] = { "Allocations Untagged", "Allocations Mesh", "Allocations Assimp", "Allocations Renderer", "Allocations Renderer2D", "Allocations Texture", "Allocations Profiler", "Allocations Scene", "Allocations Transient" };
+	static const char* s_GPUCounterNames[] = { "GPU Memory Buffer", "GPU Memory Texture", "GPU Memory RenderTarget" };
+
+	static_assert(sizeof(s_TagNames) / sizeof(s_TagNames[0]) == s_TagCount, "Missing MemoryTag name");
+	static_assert(sizeof(s_LiveCounterNames) / sizeof(s_LiveCounterNames[0]) == s_TagCount, "Missing MemoryTag counter name");
+	static_assert(sizeof(s_AllocationCounterNames) / sizeof(s_AllocationCounterNames[0]) == s_TagCount, "Missing MemoryTag counter name");
+	static_assert(sizeof(s_GPUTypeNames) / sizeof(s_GPUTypeNames[0]) == s_GPUTypeCount, "Missing GPUMemoryType name");
+	static_assert(sizeof(s_GPUCounterNames) / sizeof(s_GPUCounterNames[0]) == s_GPUTypeCount, "Missing GPUMemoryType counter name");
+
+	// Updated from any thread, including inside operator new before static
+	// initialization, so everything here is zero initialized and lock free
+	struct MemoryCounters
+	{
+		std::atomic<int64_t> LiveBytes;
+		std::atomic<int64_t> PeakBytes;
+		std::atomic<int64_t> LiveCount;
+		std::atomic<int64_t> FramePeakBytes;
+		std::atomic<int64_t> FrameAllocations;
+		std::atomic<int64_t> FrameAllocatedBytes;
+	};
+
+	static MemoryCounters s_Counters[s_TagCount];
+	static MemoryCounters s_GPUCounters[s_GPUTypeCount];
+	static thread_local MemoryTag s_CurrentTag = MemoryTag::Untagged;
+
+	// Main thread only
+	static MemoryStats s_Stats[s_TagCount];
+	static MemoryStats s_GPUStats[s_GPUTypeCount];
+	static int64_t s_FrameAllocationCount = 0;
+	static ProfileThreadBuffer* s_CounterTrack = nullptr;
+
+	// Keeps the returned memory aligned like malloc
+	struct alignas(alignof(std::max_align_t)) AllocationHeader
+	{
+		uint64_t Size;
+		MemoryTag Tag;
+	};
+
+	static void UpdateMax(std::atomic<int64_t>& max, int64_t value)
+	{
+		int64_t current = max.load(std::memory_order_relaxed);
+		while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+	}
+
+	static void Record(MemoryCounters& counters, int64_t bytes)
+	{
+		int64_t live = counters.LiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		if (bytes > 0)
+		{
+			counters.LiveCount.fetch_add(1, std::memory_order_relaxed);
+			counters.FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+			counters.FrameAllocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+			UpdateMax(counters.PeakBytes, live);
+			UpdateMax(counters.FramePeakBytes, live);
+		}
+		else
+		{
+			counters.LiveCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	void* MemoryTracker::Allocate(size_t size, MemoryTag tag)
+	{
+#if GE_TRACK_MEMORY
+		AllocationHeader* header = (AllocationHeader*)malloc(sizeof(AllocationHeader) + size);
+		if (!header)
+			return nullptr;
+
+		header->Size = size;
+		header->Tag = tag;
+		Record(s_Counters[(uint32_t)tag], (int64_t)size);
+		return header + 1;
+#else
+		return malloc(size);
+#endif
+	}
+
+	void MemoryTracker::Free(void* memory)
+	{
+		if (!memory)
+			return;
+
+#if GE_TRACK_MEMORY
+		AllocationHeader* header = (AllocationHeader*)memory - 1;
+		Record(s_Counters[(uint32_t)header->Tag], -(int64_t)header->Size);
+		free(header);
+#else
+		free(memory);
+#endif
+	}
+
+	void MemoryTracker::RecordExternal(MemoryTag tag, int64_t bytes)
+	{
+		if (bytes)
+			Record(s_Counters[(uint32_t)tag], bytes);
+	}
+
+	void MemoryTracker::RecordGPU(GPUMemoryType type, int64_t bytes)
+	{
+		if (bytes)
+			Record(s_GPUCounters[(uint32_t)type], bytes);
+	}
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return s_CurrentTag;
+	}
+
+	MemoryTag MemoryTracker::SetCurrentTag(MemoryTag tag)
+	{
+		MemoryTag previous = s_CurrentTag;
+		s_CurrentTag = tag;
+		return previous;
+	}
+
+	static void Snapshot(MemoryCounters& counters, MemoryStats& stats)
+	{
+		stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+		stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+		stats.LiveCount = counters.LiveCount.load(std::memory_order_relaxed);
+		stats.FramePeakBytes = std::max(counters.FramePeakBytes.exchange(stats.LiveBytes, std::memory_order_relaxed), stats.LiveBytes);
+		stats.FrameAllocations = counters.FrameAllocations.exchange(0, std::memory_order_relaxed);
+		stats.FrameAllocatedBytes = counters.FrameAllocatedBytes.exchange(0, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::BeginFrame()
+	{
+		GE_PROFILE_FUNCTION();
+
+		s_FrameAllocationCount = 0;
+		for (uint32_t tag = 0; tag < s_TagCount; tag++)
+		{
+			Snapshot(s_Counters[tag], s_Stats[tag]);
+			s_FrameAllocationCount += s_Stats[tag].FrameAllocations;
+		}
+		for (uint32_t type = 0; type < s_GPUTypeCount; type++)
+			Snapshot(s_GPUCounters[type], s_GPUStats[type]);
+
+		Instrumentor& instrumentor = Instrumentor::Get();
+		if (!instrumentor.IsRecording())
+			return;
+
+		if (!s_CounterTrack)
+			s_CounterTrack = instrumentor.CreateTrack("Memory", ProfileTrackType::Counters);
+
+		if (IsTrackingAllocations())
+			instrumentor.RecordCounter(*s_CounterTrack, "Allocations Total", s_FrameAllocationCount);
+
+		// Only tags that saw any memory, the rest would be flat lines at zero
+		for (uint32_t tag = 0; tag < s_TagCount; tag++)
+		{
+			if (s_Stats[tag].PeakBytes == 0)
+				continue;
+
+			instrumentor.RecordCounter(*s_CounterTrack, s_LiveCounterNames[tag], s_Stats[tag].LiveBytes);
+			instrumentor.RecordCounter(*s_CounterTrack, s_AllocationCounterNames[tag], s_Stats[tag].FrameAllocations);
+		}
+		for (uint32_t type = 0; type < s_GPUTypeCount; type++)
+		{
+			if (s_GPUStats[type].PeakBytes != 0)
+				instrumentor.RecordCounter(*s_CounterTrack, s_GPUCounterNames[type], s_GPUStats[type].LiveBytes);
+		}
+	}
+
+	const MemoryStats& MemoryTracker::GetStats(MemoryTag tag)
+	{
+		return s_Stats[(uint32_t)tag];
+	}
+
+	const MemoryStats& MemoryTracker::GetGPUStats(GPUMemoryType type)
+	{
+		return s_GPUStats[(uint32_t)type];
+	}
+
+	int64_t MemoryTracker::GetFrameAllocationCount()
+	{
+		return s_FrameAllocationCount;
+	}
+
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		return s_TagNames[(uint32_t)tag];
+	}
+
+	const char* MemoryTracker::GetGPUTypeName(GPUMemoryType type)
+	{
+		return s_GPUTypeNames[(uint32_t)type];
+	}
+
+	bool MemoryTracker::IsTrackingAllocations()
+	{
+		return GE_TRACK_MEMORY != 0;
+	}
+}
+
+#if GE_TRACK_MEMORY
+
+void* operator new(size_t size)
+{
+	void* memory = Engine::MemoryTracker::Allocate(size, Engine::MemoryTracker::GetCurrentTag());
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Engine::MemoryTracker::Allocate(size, Engine::MemoryTracker::GetCurrentTag());
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Engine::MemoryTracker::Allocate(size, Engine::MemoryTracker::GetCurrentTag());
+}
+
+void operator delete(void* memory) noexcept
+{
+	Engine::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	Engine::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	Engine::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	Engine::MemoryTracker::Free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	Engine::MemoryTracker::Free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	Engine::MemoryTracker::Free(memory);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	// Subsystem an allocation is charged to
+	enum class MemoryTag : uint8_t
+	{
+		Untagged = 0,
+		Mesh,
+		Assimp,
+		Renderer,
+		Renderer2D,
+		Texture,
+		Profiler,
+		Scene,
+		// Frame and scratch arenas, see Allocator.h
+		Transient,
+		Count
+	};
+
+	enum class GPUMemoryType : uint8_t
+	{
+		Buffer = 0,
+		Texture,
+		RenderTarget,
+		Count
+	};
+
+	struct MemoryStats
+	{
+		int64_t LiveBytes = 0;
+		int64_t PeakBytes = 0;
+		int64_t LiveCount = 0;
+
+		// Since the previous frame
+		int64_t FramePeakBytes = 0;
+		int64_t FrameAllocations = 0;
+		int64_t FrameAllocatedBytes = 0;
+	};
+
+	// Per-tag heap statistics. With GE_TRACK_MEMORY the global operator new/delete charge
+	// every allocation to the tag of the calling thread (GE_MEMORY_TAG), TaggedAllocator
+	// charges a fixed tag. GPU memory is counted separately and always, it only changes
+	// when resources are created or resized.
+	// BeginFrame() snapshots the counters and emits them as counter events on the
+	// "Memory" track of the Instrumentor.
+	class MemoryTracker
+	{
+	public:
+		static void* Allocate(size_t size, MemoryTag tag);
+		static void Free(void* memory);
+
+		// Memory allocated outside the hooks (Assimp, stb_image), negative bytes release it
+		static void RecordExternal(MemoryTag tag, int64_t bytes);
+		static void RecordGPU(GPUMemoryType type, int64_t bytes);
+
+		static MemoryTag GetCurrentTag();
+		// Returns the previous tag of the calling thread
+		static MemoryTag SetCurrentTag(MemoryTag tag);
+
+		// Call at the start of every frame on the main thread
+		static void BeginFrame();
+
+		// Snapshots of the last BeginFrame()
+		static const MemoryStats& GetStats(MemoryTag tag);
+		static const MemoryStats& GetGPUStats(GPUMemoryType type);
+		// Heap allocations of all tags during the last frame, zero in a steady state
+		static int64_t GetFrameAllocationCount();
+
+		static const char* GetTagName(MemoryTag tag);
+		static const char* GetGPUTypeName(GPUMemoryType type);
+
+		static bool IsTrackingAllocations();
+	};
+
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag tag)
+			: m_Previous(MemoryTracker::SetCurrentTag(tag))
+		{
+		}
+
+		~MemoryTagScope()
+		{
+			MemoryTracker::SetCurrentTag(m_Previous);
+		}
+	private:
+		MemoryTag m_Previous;
+	};
+
+	// Standard allocator that charges a fixed tag, independent of GE_MEMORY_TAG scopes
+	template<typename T, MemoryTag Tag>
+	class TaggedAllocator
+	{
+	public:
+		using value_type = T;
+
+		template<typename U>
+		struct rebind
+		{
+			using other = TaggedAllocator<U, Tag>;
+		};
+
+		TaggedAllocator() = default;
+
+		template<typename U>
+		TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+		T* allocate(size_t count)
+		{
+			static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+			return (T*)MemoryTracker::Allocate(count * sizeof(T), Tag);
+		}
+
+		void deallocate(T* memory, size_t)
+		{
+			MemoryTracker::Free(memory);
+		}
+
+		template<typename U>
+		bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+		template<typename U>
+		bool operator!=(const TaggedAllocator<U, Tag>&) const { return false; }
+	};
+
+	template<typename T, MemoryTag Tag>
+	using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+}
+
+// Replaces the global operator new/delete, costs a 16 byte header and a few atomics per allocation
+#define GE_TRACK_MEMORY 0
+#if GE_TRACK_MEMORY
+	#define GE_MEMORY_TAG(tag) ::Engine::MemoryTagScope memoryTag##__LINE__(tag)
+#else
+	#define GE_MEMORY_TAG(tag)
+#endif
\ No newline at end of file
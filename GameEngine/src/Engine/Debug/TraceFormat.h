@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary trace written by the Instrumentor (.getrace), kept free of engine
+// dependencies so offline tools can include it on its own.
+//
+// File:    Header, then records until the end of the file
+// Header:  Magic[8], Version (uint32 little endian), Reserved (uint32)
+// Record:  RecordType (uint8) followed by its fields, integers are LEB128 varints
+//   Session: name length, name bytes
+//   String:  id, length, bytes            - defined once, before the first event using it
+//   Event:   thread, name id, start delta, duration
+//            start delta is zigzag encoded nanoseconds since the previous event start
+//            on the same thread (events arrive in end order, so deltas can be negative)
+//   Track:   thread, name length, name bytes - names a thread index that is not a CPU
+//            thread, e.g. GPU timestamps (version 2)
+//   Counter: thread, name id, time delta, value - a sample of the counter called name,
+//            time delta like the event start delta, value zigzag encoded (version 3)
+namespace Engine::TraceFormat {
+
+	static const char Magic[8] = { 'G', 'E', 'T', 'R', 'A', 'C', 'E', '\0' };
+	static const uint32_t Version = 3;
+	static const size_t HeaderSize = 16;
+
+	enum class RecordType : uint8_t
+	{
+		Session = 1,
+		String = 2,
+		Event = 3,
+		Track = 4,
+		Counter = 5
+	};
+
+	inline void WriteHeader(std::string& out)
+	{
+		out.append(Magic, sizeof(Magic));
+		uint8_t version[4] = { (uint8_t)Version, (uint8_t)(Version >> 8), (uint8_t)(Version >> 16), (uint8_t)(Version >> 24) };
+		out.append((const char*)version, 4);
+		out.append(4, '\0');
+	}
+
+	inline bool ReadHeader(const uint8_t* data, size_t size, uint32_t& version)
+	{
+		if (size < HeaderSize || memcmp(data, Magic, sizeof(Magic)) != 0)
+			return false;
+
+		version = data[8] | (data[9] << 8) | (data[10] << 16) | ((uint32_t)data[11] << 24);
+		return true;
+	}
+
+	inline void WriteVarint(std::string& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out += (char)(uint8_t)(value | 0x80);
+			value >>= 7;
+		}
+		out += (char)(uint8_t)value;
+	}
+
+	inline bool ReadVarint(const uint8_t*& cursor, const uint8_t* end, uint64_t& value)
+	{
+		value = 0;
+		for (uint32_t shift = 0; shift < 64 && cursor < end; shift += 7)
+		{
+			uint8_t byte = *cursor++;
+			value |= (uint64_t)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	inline uint64_t ZigZagEncode(int64_t value)
+	{
+		return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+	}
+
+	inline int64_t ZigZagDecode(uint64_t value)
+	{
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	}
+
+	inline void WriteString(std::string& out, const char* data, size_t length)
+	{
+		WriteVarint(out, length);
+		out.append(data, length);
+	}
+
+	inline bool ReadString(const uint8_t*& cursor, const uint8_t* end, std::string& value)
+	{
+		uint64_t length;
+		if (!ReadVarint(cursor, end, length) || length > (uint64_t)(end - cursor))
+			return false;
+
+		value.assign((const char*)cursor, (size_t)length);
+		cursor += length;
+		return true;
+	}
+
+	// Encodes a session into a byte buffer. String ids are keyed by pointer,
+	// so names have to outlive the writer (profile scope names are literals).
+	class Writer
+	{
+	public:
+		void BeginSession(const std::string& name)
+		{
+			m_StringIDs.clear();
+			m_LastStart.clear();
+			m_TrackNamed.clear();
+
+			WriteHeader(m_Buffer);
+			m_Buffer += (char)RecordType::Session;
+			WriteString(m_Buffer, name.data(), name.size());
+		}
+
+		// Only the first call per thread writes a record
+		void NameTrack(uint32_t thread, const char* name)
+		{
+			Reserve(thread);
+			if (m_TrackNamed[thread])
+				return;
+
+			m_Buffer += (char)RecordType::Track;
+			WriteVarint(m_Buffer, thread);
+			WriteString(m_Buffer, name, strlen(name));
+			m_TrackNamed[thread] = true;
+		}
+
+		void WriteEvent(uint32_t thread, const char* name, int64_t start, int64_t duration)
+		{
+			Reserve(thread);
+			uint32_t nameID = GetStringID(name);
+
+			m_Buffer += (char)RecordType::Event;
+			WriteVarint(m_Buffer, thread);
+			WriteVarint(m_Buffer, nameID);
+			WriteVarint(m_Buffer, ZigZagEncode(start - m_LastStart[thread]));
+			WriteVarint(m_Buffer, (uint64_t)duration);
+			m_LastStart[thread] = start;
+		}
+
+		void WriteCounter(uint32_t thread, const char* name, int64_t time, int64_t value)
+		{
+			Reserve(thread);
+			uint32_t nameID = GetStringID(name);
+
+			m_Buffer += (char)RecordType::Counter;
+			WriteVarint(m_Buffer, thread);
+			WriteVarint(m_Buffer, nameID);
+			WriteVarint(m_Buffer, ZigZagEncode(time - m_LastStart[thread]));
+			WriteVarint(m_Buffer, ZigZagEncode(value));
+			m_LastStart[thread] = time;
+		}
+
+		const std::string& GetBuffer() const { return m_Buffer; }
+		void ClearBuffer() { m_Buffer.clear(); }
+	private:
+		void Reserve(uint32_t thread)
+		{
+			if (thread >= m_LastStart.size())
+			{
+				m_LastStart.resize(thread + 1, 0);
+				m_TrackNamed.resize(thread + 1, false);
+			}
+		}
+
+		uint32_t GetStringID(const char* name)
+		{
+			auto it = m_StringIDs.find(name);
+			if (it != m_StringIDs.end())
+				return it->second;
+
+			// First use in this session, define it ahead of the event
+			uint32_t id = (uint32_t)m_StringIDs.size();
+			m_StringIDs.emplace(name, id);
+
+			m_Buffer += (char)RecordType::String;
+			WriteVarint(m_Buffer, id);
+			WriteString(m_Buffer, name, strlen(name));
+			return id;
+		}
+	private:
+		std::string m_Buffer;
+		std::unordered_map<const char*, uint32_t> m_StringIDs;
+		std::vector<int64_t> m_LastStart;
+		std::vector<bool> m_TrackNamed;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "gepch.h"
+#include "EventBus.h"
+
+namespace Engine {
+
+	EventBus::EventBus()
+	{
+		m_Events.reserve(256);
+		m_DispatchEvents.reserve(256);
+	}
+
+	void EventBus::Post(const QueuedEvent& event)
+	{
+		GE_CORE_ASSERT(event.Type != EventType::None && (uint32_t)event.Type < EventTypeCount, "Invalid event type");
+
+		// A burst only matters for its final position or size
+		if (!m_Events.empty() && m_Events.back().Type == event.Type && (event.Type == EventType::MouseMoved || event.Type == EventType::WindowResize))
+		{
+			m_Events.back() = event;
+			m_CoalescedCount++;
+			return;
+		}
+
+		m_Events.push_back(event);
+	}
+
+	void EventBus::Dispatch()
+	{
+		GE_PROFILE_FUNCTION();
+
+		std::swap(m_Events, m_DispatchEvents);
+		m_CoalescedCount = 0;
+
+		m_Dispatching = true;
+		for (const QueuedEvent& event : m_DispatchEvents)
+		{
+			for (const Listener& listener : m_Listeners[(uint32_t)event.Type])
+			{
+				if (listener.Fn && listener.Fn(listener.UserData, event))
+					break;
+			}
+		}
+		m_Dispatching = false;
+		m_DispatchEvents.clear();
+
+		for (const auto& [type, listener] : m_PendingListeners)
+			Insert(type, listener);
+		m_PendingListeners.clear();
+
+		if (m_PendingRemovals)
+		{
+			for (std::vector<Listener>& listeners : m_Listeners)
+				listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [](const Listener& listener) { return !listener.Fn; }), listeners.end());
+			m_PendingRemovals = false;
+		}
+	}
+
+	uint32_t EventBus::Subscribe(EventType type, ListenerFn fn, void* userData, int32_t priority)
+	{
+		GE_CORE_ASSERT(type != EventType::None && (uint32_t)type < EventTypeCount, "Invalid event type");
+
+		Listener listener = { m_NextListenerID++, fn, userData, priority };
+		if (m_Dispatching)
+			m_PendingListeners.push_back({ type, listener });
+		else
+			Insert(type, listener);
+		return listener.ID;
+	}
+
+	void EventBus::Insert(EventType type, const Listener& listener)
+	{
+		// After every listener with the same or a higher priority
+		std::vector<Listener>& listeners = m_Listeners[(uint32_t)type];
+		auto it = std::find_if(listeners.begin(), listeners.end(), [&](const Listener& other) { return other.Priority < listener.Priority; });
+		listeners.insert(it, listener);
+	}
+
+	void EventBus::Unsubscribe(uint32_t listenerID)
+	{
+		for (auto it = m_PendingListeners.begin(); it != m_PendingListeners.end(); ++it)
+		{
+			if (it->second.ID == listenerID)
+			{
+				m_PendingListeners.erase(it);
+				return;
+			}
+		}
+
+		for (std::vector<Listener>& listeners : m_Listeners)
+		{
+			for (auto it = listeners.begin(); it != listeners.end(); ++it)
+			{
+				if (it->ID != listenerID)
+					continue;
+
+				if (m_Dispatching)
+				{
+					it->Fn = nullptr;
+					m_PendingRemovals = true;
+				}
+				else
+					listeners.erase(it);
+				return;
+			}
+		}
+	}
+}
\ No newline at end of file
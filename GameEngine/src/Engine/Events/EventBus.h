@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Event.h"
+
+namespace Engine {
+
+	struct WindowResizeData { uint32_t Width, Height; };
+	// KeyPressed, KeyReleased and KeyTyped, RepeatCount is only set for KeyPressed
+	struct KeyData { int32_t KeyCode, RepeatCount; };
+	struct MouseButtonData { int32_t Button; };
+	struct MouseMovedData { float X, Y; };
+	struct MouseScrolledData { float XOffset, YOffset; };
+
+	// Plain copyable event as recorded by the window, Type selects the union member
+	struct QueuedEvent
+	{
+		EventType Type = EventType::None;
+		union
+		{
+			WindowResizeData WindowResize;
+			KeyData Key;
+			MouseButtonData MouseButton;
+			MouseMovedData MouseMoved;
+			MouseScrolledData MouseScrolled;
+		};
+
+		QueuedEvent() : Key{ 0, 0 } {}
+	};
+
+	// Events are recorded into a per-frame array while the window is polled and dispatched in
+	// one go by Dispatch(). Listeners are registered per event type and called through a
+	// function pointer, highest priority first and in registration order within a priority,
+	// until one of them returns true (handled). Layers subscribe to the types they handle with
+	// priorities that follow the layer stack (see Layer::Subscribe()).
+	// Consecutive mouse moves and window resizes are coalesced into the latest one.
+	class EventBus
+	{
+	public:
+		// Returns true when the event was handled, later listeners don't see it
+		typedef bool(*ListenerFn)(void* userData, const QueuedEvent& event);
+
+		static const uint32_t EventTypeCount = (uint32_t)EventType::MouseScrolled + 1;
+
+		EventBus();
+
+		void Post(const QueuedEvent& event);
+		// Events posted by listeners are dispatched with the next call
+		void Dispatch();
+
+		// Listeners subscribed while dispatching start with the next Dispatch()
+		uint32_t Subscribe(EventType type, ListenerFn fn, void* userData, int32_t priority = 0);
+		void Unsubscribe(uint32_t listenerID);
+
+		// Subscribes a member function, e.g. Subscribe<Application, &Application::OnWindowClose>(EventType::WindowClose, this)
+		template<typename T, bool(T::*Method)(const QueuedEvent&)>
+		uint32_t Subscribe(EventType type, T* instance, int32_t priority = 0)
+		{
+			return Subscribe(type, [](void* userData, const QueuedEvent& event) { return (((T*)userData)->*Method)(event); }, instance, priority);
+		}
+
+		inline uint32_t GetPendingCount() const { return (uint32_t)m_Events.size(); }
+		// Events merged into an earlier one since the last Dispatch()
+		inline uint32_t GetCoalescedCount() const { return m_CoalescedCount; }
+	private:
+		struct Listener
+		{
+			uint32_t ID;
+			ListenerFn Fn;
+			void* UserData;
+			int32_t Priority;
+		};
+
+		void Insert(EventType type, const Listener& listener);
+
+		// Recorded this frame and being dispatched, swapped so both keep their capacity
+		std::vector<QueuedEvent> m_Events;
+		std::vector<QueuedEvent> m_DispatchEvents;
+		std::array<std::vector<Listener>, EventTypeCount> m_Listeners;
+		// Subscribed while dispatching, inserted afterwards
+		std::vector<std::pair<EventType, Listener>> m_PendingListeners;
+
+		uint32_t m_NextListenerID = 1;
+		uint32_t m_CoalescedCount = 0;
+		// Listeners removed while dispatching are only cleared, the arrays are compacted afterwards
+		bool m_Dispatching = false;
+		bool m_PendingRemovals = false;
+	};
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "examples/imgui_impl_opengl3.h"
 
 #include "Engine/Core/Application.h"
+#include "Engine/Debug/FrameProfiler.h"
+#include "Engine/Renderer/RenderThread.h"
 
 // temporary
 #include <GLFW/glfw3.h>
@@ -13,6 +15,27 @@
 
 namespace Engine {
 
+	// Copy of a frame's draw data for the render thread, the original is rebuilt by the next NewFrame()
+	struct ImGuiDrawDataCopy
+	{
+		ImDrawData DrawData;
+		std::vector<ImDrawList*> CmdLists;
+
+		ImGuiDrawDataCopy(const ImDrawData& source)
+			: DrawData(source)
+		{
+			for (int i = 0; i < source.CmdListsCount; i++)
+				CmdLists.push_back(source.CmdLists[i]->CloneOutput());
+			DrawData.CmdLists = CmdLists.data();
+		}
+
+		~ImGuiDrawDataCopy()
+		{
+			for (ImDrawList* list : CmdLists)
+				IM_DELETE(list);
+		}
+	};
+
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{
@@ -57,6 +80,18 @@ namespace Engine {
 		// Setup Platform/Renderer bindings
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init("#version 410");
+		// Builds the font atlas while the context is still on this thread. ImGui_ImplOpenGL3_NewFrame()
+		// would do it on the first frame, but ImGui::NewFrame() needs the atlas before a render
+		// thread has run anything.
+		ImGui_ImplOpenGL3_CreateDeviceObjects();
+
+		Subscribe<ImGuiLayer, &ImGuiLayer::OnMouseEvent>(EventType::MouseButtonPressed);
+		Subscribe<ImGuiLayer, &ImGuiLayer::OnMouseEvent>(EventType::MouseButtonReleased);
+		Subscribe<ImGuiLayer, &ImGuiLayer::OnMouseEvent>(EventType::MouseMoved);
+		Subscribe<ImGuiLayer, &ImGuiLayer::OnMouseEvent>(EventType::MouseScrolled);
+		Subscribe<ImGuiLayer, &ImGuiLayer::OnKeyEvent>(EventType::KeyPressed);
+		Subscribe<ImGuiLayer, &ImGuiLayer::OnKeyEvent>(EventType::KeyReleased);
+		Subscribe<ImGuiLayer, &ImGuiLayer::OnKeyEvent>(EventType::KeyTyped);
 	}
 
 	void ImGuiLayer::OnDetach()
@@ -68,18 +103,30 @@ namespace Engine {
 		ImGui::DestroyContext();
 	}
 
-	void ImGuiLayer::OnEvent(Event& e)
+	bool ImGuiLayer::OnMouseEvent(const QueuedEvent& e)
 	{
-		ImGuiIO& io = ImGui::GetIO();
-		e.Handled |= e.IsInCategory(EventCategoryMouse) & io.WantCaptureMouse;
-		e.Handled |= e.IsInCategory(EventCategoryKeyboard) & io.WantCaptureKeyboard;
+		return ImGui::GetIO().WantCaptureMouse;
+	}
+
+	bool ImGuiLayer::OnKeyEvent(const QueuedEvent& e)
+	{
+		return ImGui::GetIO().WantCaptureKeyboard;
+	}
+
+	void ImGuiLayer::OnImGuiRender()
+	{
+		FrameProfiler::OnImGuiRender();
 	}
 
 	void ImGuiLayer::Begin()
 	{
 		GE_PROFILE_FUNCTION();
 
-		ImGui_ImplOpenGL3_NewFrame();
+		// Platform windows would need their contexts on the render thread
+		if (RenderThread::IsMultiThreaded())
+			ImGui::GetIO().ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+
+		// The OpenGL backend has nothing to do per frame once its device objects exist
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
 	}
@@ -94,7 +141,15 @@ namespace Engine {
 
 		// Rendering
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		if (RenderThread::IsMultiThreaded())
+		{
+			RenderThread::Submit([drawData = CreateScope<ImGuiDrawDataCopy>(*ImGui::GetDrawData())]()
+			{
+				ImGui_ImplOpenGL3_RenderDrawData(&drawData->DrawData);
+			});
+		}
+		else
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
@@ -2,10 +2,6 @@
 
 #include "Engine/Core/Layer.h"
 
-#include "Engine/Events/ApplicationEvent.h"
-#include "Engine/Events/KeyEvent.h"
-#include "Engine/Events/MouseEvent.h"
-
 namespace Engine {
 
 	class GE_API ImGuiLayer : public Layer
@@ -16,10 +12,15 @@ namespace Engine {
 
 		virtual void OnAttach() override;
 		virtual void OnDetach() override;
-		virtual void OnEvent(Event& e) override;
+		virtual void OnImGuiRender() override;
 
 		void Begin();
 		void End();
+	private:
+		// ImGui reads input through its own GLFW callbacks, these only keep input it is using
+		// from the layers below
+		bool OnMouseEvent(const QueuedEvent& e);
+		bool OnKeyEvent(const QueuedEvent& e);
 	private:
 		float m_Time = 0.0f;
 	};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cfloat>
+#include <glm/glm.hpp>
+
+namespace Engine {
+
+	struct AABB
+	{
+		glm::vec3 Min = glm::vec3(FLT_MAX);
+		glm::vec3 Max = glm::vec3(-FLT_MAX);
+
+		AABB() = default;
+		AABB(const glm::vec3& min, const glm::vec3& max)
+			: Min(min), Max(max) {}
+
+		inline bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+		inline void Expand(const glm::vec3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		inline void Expand(const AABB& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+
+		inline glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		// Half size
+		inline glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		inline float GetSurfaceArea() const
+		{
+			glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		inline bool Overlaps(const AABB& other) const
+		{
+			return Min.x <= other.Max.x && Max.x >= other.Min.x
+				&& Min.y <= other.Max.y && Max.y >= other.Min.y
+				&& Min.z <= other.Max.z && Max.z >= other.Min.z;
+		}
+
+		inline bool Contains(const AABB& other) const
+		{
+			return Min.x <= other.Min.x && Max.x >= other.Max.x
+				&& Min.y <= other.Min.y && Max.y >= other.Max.y
+				&& Min.z <= other.Min.z && Max.z >= other.Max.z;
+		}
+
+		static AABB Union(const AABB& a, const AABB& b)
+		{
+			return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+		}
+
+		// Box enclosing this box after the transform (Arvo's method)
+		AABB Transformed(const glm::mat4& transform) const
+		{
+			glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+			glm::vec3 extents = GetExtents();
+
+			glm::mat3 absolute = glm::mat3(transform);
+			for (int i = 0; i < 3; i++)
+				absolute[i] = glm::abs(absolute[i]);
+
+			glm::vec3 worldExtents = absolute * extents;
+			return AABB(center - worldExtents, center + worldExtents);
+		}
+	};
+
+	struct BoundingSphere
+	{
+		glm::vec3 Center = glm::vec3(0.0f);
+		float Radius = 0.0f;
+
+		BoundingSphere() = default;
+		BoundingSphere(const glm::vec3& center, float radius)
+			: Center(center), Radius(radius) {}
+
+		// Scales the radius by the largest axis scale, so it stays conservative under non-uniform scale
+		BoundingSphere Transformed(const glm::mat4& transform) const
+		{
+			float scaleX = glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0]));
+			float scaleY = glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1]));
+			float scaleZ = glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]));
+			float maxScale = glm::sqrt(glm::max(scaleX, glm::max(scaleY, scaleZ)));
+
+			return BoundingSphere(glm::vec3(transform * glm::vec4(Center, 1.0f)), Radius * maxScale);
+		}
+	};
+
+	struct Ray
+	{
+		glm::vec3 Origin;
+		glm::vec3 Direction;
+		// Precomputed for the slab test, axis parallel rays give +-inf which the test handles
+		glm::vec3 InverseDirection;
+
+		Ray(const glm::vec3& origin, const glm::vec3& direction)
+			: Origin(origin), Direction(direction), InverseDirection(1.0f / direction) {}
+
+		// Slab test, distance is the entry point along the ray (0 when the origin is inside)
+		bool Intersects(const AABB& box, float maxDistance, float& distance) const
+		{
+			glm::vec3 t1 = (box.Min - Origin) * InverseDirection;
+			glm::vec3 t2 = (box.Max - Origin) * InverseDirection;
+			glm::vec3 tMin = glm::min(t1, t2);
+			glm::vec3 tMax = glm::max(t1, t2);
+
+			float enter = glm::max(glm::max(tMin.x, tMin.y), glm::max(tMin.z, 0.0f));
+			float exit = glm::min(glm::min(tMax.x, tMax.y), glm::min(tMax.z, maxDistance));
+			distance = enter;
+			return enter <= exit;
+		}
+	};
+}
\ No newline at end of file
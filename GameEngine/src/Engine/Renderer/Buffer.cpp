@@ -2,8 +2,11 @@
 #include "Buffer.h"
 
 #include "Renderer.h"
+#include "RenderThread.h"
 
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Null/NullBuffer.h"
+#include "Platform/Software/SoftwareBuffer.h"
 
 namespace Engine {
 
@@ -12,7 +15,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLVertexBuffer>(size);
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLVertexBuffer>(size);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullVertexBuffer>(size);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareVertexBuffer>(size);
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -23,7 +28,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLVertexBuffer>(vertices, size);
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLVertexBuffer>(vertices, size);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullVertexBuffer>(vertices, size);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareVertexBuffer>(vertices, size);
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -34,7 +41,35 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLIndexBuffer>(indices, count);
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLIndexBuffer>(indices, count);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullIndexBuffer>(indices, count);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareIndexBuffer>(indices, count);
+		}
+		GE_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+
+	Ref<StorageBuffer> StorageBuffer::Create(uint32_t size)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLStorageBuffer>(size);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullStorageBuffer>(size);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareStorageBuffer>(size);
+		}
+		GE_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+
+	Ref<IndirectBuffer> IndirectBuffer::Create(uint32_t size)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLIndirectBuffer>(size);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullIndirectBuffer>(size);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareIndirectBuffer>(size);
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Renderer/RenderResource.h"
+
 namespace Engine {
 
 	enum class ShaderDataType
@@ -100,7 +102,12 @@ namespace Engine {
 		uint32_t m_Stride = 0;
 	};
 
-	class VertexBuffer
+	class VertexBuffer;
+	class IndexBuffer;
+	using VertexBufferHandle = Handle<VertexBuffer>;
+	using IndexBufferHandle = Handle<IndexBuffer>;
+
+	class VertexBuffer : public RenderResource<VertexBuffer>
 	{
 	public:
 		virtual ~VertexBuffer() = default;
@@ -118,7 +125,7 @@ namespace Engine {
 		static Ref<VertexBuffer> Create(void* vertices, uint32_t size);
 	};
 
-	class IndexBuffer
+	class IndexBuffer : public RenderResource<IndexBuffer>
 	{
 	public:
 		virtual ~IndexBuffer() = default;
@@ -130,4 +137,41 @@ namespace Engine {
 
 		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
 	};
+
+	// Shader storage buffer, read by shaders through a binding point
+	class StorageBuffer
+	{
+	public:
+		virtual ~StorageBuffer() = default;
+
+		virtual void Bind(uint32_t binding) const = 0;
+
+		// Grows the buffer if size is larger than the current capacity
+		virtual void SetData(const void* data, uint32_t size) = 0;
+
+		static Ref<StorageBuffer> Create(uint32_t size);
+	};
+
+	// Layout is fixed by glMultiDrawElementsIndirect / vkCmdDrawIndexedIndirect
+	struct DrawIndexedIndirectCommand
+	{
+		uint32_t IndexCount;
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t BaseVertex;
+		uint32_t BaseInstance;
+	};
+
+	class IndirectBuffer
+	{
+	public:
+		virtual ~IndirectBuffer() = default;
+
+		virtual void Bind() const = 0;
+
+		// Grows the buffer if size is larger than the current capacity
+		virtual void SetData(const void* data, uint32_t size) = 0;
+
+		static Ref<IndirectBuffer> Create(uint32_t size);
+	};
 }
\ No newline at end of file
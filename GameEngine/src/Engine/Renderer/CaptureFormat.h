@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Engine/Debug/TraceFormat.h"
+
+// Render command capture written by RenderCapture (.gecapture), kept free of engine
+// dependencies like the trace format, whose varint helpers it shares.
+//
+// File:    Header, then records until the end of the file
+// Header:  Magic[8], Version (uint32 little endian), API (uint32), see RendererAPI::API
+// Record:  RecordType (uint8) followed by its fields. Integers are LEB128 varints, floats are
+//          4 raw little endian bytes, byte blobs are a varint length followed by the bytes.
+//
+// Resource and state records define an id before the first command that uses it.
+// Resources are keyed by the id of the capturing API, state records by content,
+// so identical uniform values or vertex layouts are stored once.
+//   Buffer:       id, bytes                                   - contents when first referenced
+//   Texture:      id, target, internal format, width, height, levels,
+//                 min filter, mag filter, wrap s, wrap t, bytes - level 0 as RGBA8 (all faces
+//                 for cube maps), empty for depth and float formats
+//   Program:      id, stage count, { stage type, source }
+//   Framebuffer:  id, color texture, depth texture
+//   VertexInput:  id, element buffer, attribute count,
+//                 { index, buffer, size, type, normalized, integer, stride, offset, divisor }
+//   Uniforms:     id, program, count, { name, type, bytes }   - values at draw time
+//   Bindings:     id, texture count, { unit, texture }, block count, { target, binding, buffer }
+//   RenderState:  id, depth test, depth mask, depth func, blend, blend src, blend dst,
+//                 cull face, cull mode, viewport x, y, width, height
+//
+// Commands, one per RendererAPI call:
+//   Frame:        index                                       - marks the start of a captured frame
+//   Viewport:     x, y, width, height
+//   ClearColor:   r, g, b, a
+//   Clear:        framebuffer, r, g, b, a
+//   DepthTest:    enabled
+//   BindTexture:  slot, texture
+//   BufferData:   buffer, offset, bytes                       - upload made through the engine
+//   TextureData:  texture, data format, bytes
+//   Draw:         kind, framebuffer, program, vertex input, uniforms, bindings, render state,
+//                 count, first, base vertex, indirect buffer, draw count
+//   Finish
+namespace Engine::CaptureFormat {
+
+	static const char Magic[8] = { 'G', 'E', 'C', 'A', 'P', 'T', 'U', 'R' };
+	static const uint32_t Version = 1;
+	static const size_t HeaderSize = 16;
+
+	enum class RecordType : uint8_t
+	{
+		Buffer = 1,
+		Texture = 2,
+		Program = 3,
+		Framebuffer = 4,
+		VertexInput = 5,
+		Uniforms = 6,
+		Bindings = 7,
+		RenderState = 8,
+
+		Frame = 32,
+		Viewport = 33,
+		ClearColor = 34,
+		Clear = 35,
+		DepthTest = 36,
+		BindTexture = 37,
+		BufferData = 38,
+		TextureData = 39,
+		Draw = 40,
+		Finish = 41
+	};
+
+	enum class DrawKind : uint8_t
+	{
+		Indexed = 0,
+		IndexedBaseVertex = 1,
+		Arrays = 2,
+		MultiIndexedIndirect = 3
+	};
+
+	inline const char* DrawKindName(DrawKind kind)
+	{
+		switch (kind)
+		{
+			case DrawKind::Indexed:					return "DrawIndexed";
+			case DrawKind::IndexedBaseVertex:		return "DrawIndexedBaseVertex";
+			case DrawKind::Arrays:					return "DrawArrays";
+			case DrawKind::MultiIndexedIndirect:	return "MultiDrawIndexedIndirect";
+		}
+		return "Draw";
+	}
+
+	inline void WriteHeader(std::string& out, uint32_t api)
+	{
+		out.append(Magic, sizeof(Magic));
+		uint32_t fields[2] = { Version, api };
+		for (uint32_t field : fields)
+		{
+			uint8_t bytes[4] = { (uint8_t)field, (uint8_t)(field >> 8), (uint8_t)(field >> 16), (uint8_t)(field >> 24) };
+			out.append((const char*)bytes, 4);
+		}
+	}
+
+	inline bool ReadHeader(const uint8_t* data, size_t size, uint32_t& version, uint32_t& api)
+	{
+		if (size < HeaderSize || memcmp(data, Magic, sizeof(Magic)) != 0)
+			return false;
+
+		version = data[8] | (data[9] << 8) | (data[10] << 16) | ((uint32_t)data[11] << 24);
+		api = data[12] | (data[13] << 8) | (data[14] << 16) | ((uint32_t)data[15] << 24);
+		return true;
+	}
+
+	inline void WriteFloat(std::string& out, float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(float));
+		uint8_t bytes[4] = { (uint8_t)bits, (uint8_t)(bits >> 8), (uint8_t)(bits >> 16), (uint8_t)(bits >> 24) };
+		out.append((const char*)bytes, 4);
+	}
+
+	inline bool ReadFloat(const uint8_t*& cursor, const uint8_t* end, float& value)
+	{
+		if (end - cursor < 4)
+			return false;
+
+		uint32_t bits = cursor[0] | (cursor[1] << 8) | (cursor[2] << 16) | ((uint32_t)cursor[3] << 24);
+		memcpy(&value, &bits, sizeof(float));
+		cursor += 4;
+		return true;
+	}
+
+	// Blobs share the string encoding
+	inline void WriteBytes(std::string& out, const void* data, size_t size)
+	{
+		TraceFormat::WriteString(out, (const char*)data, size);
+	}
+
+	inline bool ReadBytes(const uint8_t*& cursor, const uint8_t* end, std::string& value)
+	{
+		return TraceFormat::ReadString(cursor, end, value);
+	}
+
+	using TraceFormat::WriteVarint;
+	using TraceFormat::ReadVarint;
+
+	// Reads a varint that has to fit 32 bits
+	inline bool ReadU32(const uint8_t*& cursor, const uint8_t* end, uint32_t& value)
+	{
+		uint64_t wide;
+		if (!ReadVarint(cursor, end, wide) || wide > 0xffffffffull)
+			return false;
+
+		value = (uint32_t)wide;
+		return true;
+	}
+}
\ No newline at end of file
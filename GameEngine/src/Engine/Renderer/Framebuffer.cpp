@@ -1,7 +1,10 @@
 #include "gepch.h"
 #include "Framebuffer.h"
 #include "Renderer.h"
+#include "RenderThread.h"
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
+#include "Platform/Null/NullFramebuffer.h"
+#include "Platform/Software/SoftwareFramebuffer.h"
 
 namespace Engine {
 
@@ -10,7 +13,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:		return nullptr;
-		case RendererAPI::API::OpenGL:		return std::make_shared<OpenGLFramebuffer>(width, height, format);
+		case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLFramebuffer>(width, height, format);
+		case RendererAPI::API::Null:		return CreateRenderRef<NullFramebuffer>(width, height, format);
+		case RendererAPI::API::Software:	return CreateRenderRef<SoftwareFramebuffer>(width, height, format);
 		}
 		return nullptr;
 	}
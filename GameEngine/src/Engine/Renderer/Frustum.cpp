@@ -0,0 +1,201 @@
+#include "gepch.h"
+#include "Frustum.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define GE_FRUSTUM_SSE 1
+	#include <xmmintrin.h>
+#else
+	#define GE_FRUSTUM_SSE 0
+#endif
+
+namespace Engine {
+
+	Frustum::Frustum()
+	{
+		for (int i = 0; i < Count; i++)
+			Planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection)
+	{
+		// glm is column major, row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++)
+			rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+		Frustum frustum;
+		frustum.Planes[Left] = rows[3] + rows[0];
+		frustum.Planes[Right] = rows[3] - rows[0];
+		frustum.Planes[Bottom] = rows[3] + rows[1];
+		frustum.Planes[Top] = rows[3] - rows[1];
+		frustum.Planes[Near] = rows[3] + rows[2];
+		frustum.Planes[Far] = rows[3] - rows[2];
+
+		for (int i = 0; i < Count; i++)
+			frustum.Planes[i] /= glm::length(glm::vec3(frustum.Planes[i]));
+
+		return frustum;
+	}
+
+	Frustum::Containment Frustum::Classify(const AABB& box) const
+	{
+		glm::vec3 center = box.GetCenter();
+		glm::vec3 extents = box.GetExtents();
+
+		Containment result = Containment::Inside;
+		for (int i = 0; i < Count; i++)
+		{
+			glm::vec3 normal = glm::vec3(Planes[i]);
+			float distance = glm::dot(normal, center) + Planes[i].w;
+			float radius = glm::dot(glm::abs(normal), extents);
+			if (distance < -radius)
+				return Containment::Outside;
+			if (distance < radius)
+				result = Containment::Intersects;
+		}
+		return result;
+	}
+
+	bool Frustum::Intersects(const AABB& box) const
+	{
+		glm::vec3 center = box.GetCenter();
+		glm::vec3 extents = box.GetExtents();
+
+		for (int i = 0; i < Count; i++)
+		{
+			glm::vec3 normal = glm::vec3(Planes[i]);
+			float distance = glm::dot(normal, center) + Planes[i].w;
+			float radius = glm::dot(glm::abs(normal), extents);
+			if (distance < -radius)
+				return false;
+		}
+		return true;
+	}
+
+	bool Frustum::Intersects(const BoundingSphere& sphere) const
+	{
+		for (int i = 0; i < Count; i++)
+		{
+			float distance = glm::dot(glm::vec3(Planes[i]), sphere.Center) + Planes[i].w;
+			if (distance < -sphere.Radius)
+				return false;
+		}
+		return true;
+	}
+
+	uint32_t FrustumCuller::CullSpheres(const Frustum& frustum, const float* centerX, const float* centerY, const float* centerZ, const float* radius,
+		uint32_t count, uint8_t* visible)
+	{
+		GE_PROFILE_FUNCTION();
+
+		uint32_t visibleCount = 0;
+		uint32_t i = 0;
+
+#if GE_FRUSTUM_SSE
+		__m128 planeX[Frustum::Count], planeY[Frustum::Count], planeZ[Frustum::Count], planeW[Frustum::Count];
+		for (int p = 0; p < Frustum::Count; p++)
+		{
+			planeX[p] = _mm_set1_ps(frustum.Planes[p].x);
+			planeY[p] = _mm_set1_ps(frustum.Planes[p].y);
+			planeZ[p] = _mm_set1_ps(frustum.Planes[p].z);
+			planeW[p] = _mm_set1_ps(frustum.Planes[p].w);
+		}
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(centerX + i);
+			__m128 y = _mm_loadu_ps(centerY + i);
+			__m128 z = _mm_loadu_ps(centerZ + i);
+			__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+
+			__m128 inside = _mm_cmpeq_ps(x, x);
+			for (int p = 0; p < Frustum::Count; p++)
+			{
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+					_mm_add_ps(_mm_mul_ps(planeZ[p], z), planeW[p]));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+			}
+
+			int mask = _mm_movemask_ps(inside);
+			for (uint32_t lane = 0; lane < 4; lane++)
+			{
+				uint8_t laneVisible = (mask >> lane) & 1;
+				visible[i + lane] = laneVisible;
+				visibleCount += laneVisible;
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			bool inside = frustum.Intersects(BoundingSphere({ centerX[i], centerY[i], centerZ[i] }, radius[i]));
+			visible[i] = inside ? 1 : 0;
+			visibleCount += visible[i];
+		}
+
+		return visibleCount;
+	}
+
+	uint32_t FrustumCuller::CullBoxes(const Frustum& frustum, const float* centerX, const float* centerY, const float* centerZ,
+		const float* extentX, const float* extentY, const float* extentZ, uint32_t count, uint8_t* visible)
+	{
+		GE_PROFILE_FUNCTION();
+
+		uint32_t visibleCount = 0;
+		uint32_t i = 0;
+
+#if GE_FRUSTUM_SSE
+		__m128 planeX[Frustum::Count], planeY[Frustum::Count], planeZ[Frustum::Count], planeW[Frustum::Count];
+		__m128 absX[Frustum::Count], absY[Frustum::Count], absZ[Frustum::Count];
+		for (int p = 0; p < Frustum::Count; p++)
+		{
+			planeX[p] = _mm_set1_ps(frustum.Planes[p].x);
+			planeY[p] = _mm_set1_ps(frustum.Planes[p].y);
+			planeZ[p] = _mm_set1_ps(frustum.Planes[p].z);
+			planeW[p] = _mm_set1_ps(frustum.Planes[p].w);
+			absX[p] = _mm_set1_ps(glm::abs(frustum.Planes[p].x));
+			absY[p] = _mm_set1_ps(glm::abs(frustum.Planes[p].y));
+			absZ[p] = _mm_set1_ps(glm::abs(frustum.Planes[p].z));
+		}
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(centerX + i);
+			__m128 y = _mm_loadu_ps(centerY + i);
+			__m128 z = _mm_loadu_ps(centerZ + i);
+			__m128 ex = _mm_loadu_ps(extentX + i);
+			__m128 ey = _mm_loadu_ps(extentY + i);
+			__m128 ez = _mm_loadu_ps(extentZ + i);
+
+			__m128 inside = _mm_cmpeq_ps(x, x);
+			for (int p = 0; p < Frustum::Count; p++)
+			{
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+					_mm_add_ps(_mm_mul_ps(planeZ[p], z), planeW[p]));
+				// Projected half size of the box on the plane normal
+				__m128 boxRadius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absX[p], ex), _mm_mul_ps(absY[p], ey)), _mm_mul_ps(absZ[p], ez));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, boxRadius), _mm_setzero_ps()));
+			}
+
+			int mask = _mm_movemask_ps(inside);
+			for (uint32_t lane = 0; lane < 4; lane++)
+			{
+				uint8_t laneVisible = (mask >> lane) & 1;
+				visible[i + lane] = laneVisible;
+				visibleCount += laneVisible;
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			glm::vec3 center = { centerX[i], centerY[i], centerZ[i] };
+			glm::vec3 extents = { extentX[i], extentY[i], extentZ[i] };
+			bool inside = frustum.Intersects(AABB(center - extents, center + extents));
+			visible[i] = inside ? 1 : 0;
+			visibleCount += visible[i];
+		}
+
+		return visibleCount;
+	}
+}
\ No newline at end of file
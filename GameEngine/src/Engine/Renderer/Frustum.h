@@ -0,0 +1,41 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "BoundingVolume.h"
+
+namespace Engine {
+
+	// Six planes pointing inwards, xyz = normal, w = distance.
+	// A default constructed frustum contains everything.
+	struct Frustum
+	{
+		enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+		glm::vec4 Planes[Count];
+
+		Frustum();
+
+		// Gribb/Hartmann plane extraction for a GL style (-1..1 depth) projection
+		static Frustum FromViewProjection(const glm::mat4& viewProjection);
+
+		enum class Containment { Outside, Intersects, Inside };
+		// Inside lets hierarchical culling accept a whole subtree without further tests
+		Containment Classify(const AABB& box) const;
+
+		bool Intersects(const AABB& box) const;
+		bool Intersects(const BoundingSphere& sphere) const;
+	};
+
+	// Tests batches of bounds stored as structure of arrays, four at a time with SSE.
+	// visible[i] is set to 1 or 0, the return value is the number of visible objects.
+	class FrustumCuller
+	{
+	public:
+		static uint32_t CullSpheres(const Frustum& frustum, const float* centerX, const float* centerY, const float* centerZ, const float* radius,
+			uint32_t count, uint8_t* visible);
+
+		static uint32_t CullBoxes(const Frustum& frustum, const float* centerX, const float* centerY, const float* centerZ,
+			const float* extentX, const float* extentY, const float* extentZ, uint32_t count, uint8_t* visible);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "gepch.h"
+#include "GPUProfiler.h"
+
+#include "TimerQuery.h"
+
+namespace Engine {
+
+	static const uint32_t s_QueriesPerFrame = GPUProfiler::MaxScopesPerFrame * 2;
+	static const uint32_t s_OpenQuery = 0xffffffff;
+
+	// Scope handles carry the frame they began in: frame index (24) | scope (8)
+	static const uint32_t s_ScopeBits = 8;
+	static_assert(GPUProfiler::MaxScopesPerFrame <= (1 << s_ScopeBits) - 1, "Scope index must fit the handle");
+
+	struct GPUScope
+	{
+		const char* Name;
+		uint32_t BeginQuery;
+		uint32_t EndQuery;
+	};
+
+	struct GPUFrame
+	{
+		std::vector<GPUScope> Scopes;
+		uint32_t QueryCount = 0;
+	};
+
+	struct GPUProfilerData
+	{
+		Scope<TimerQueryPool> Queries;
+		ProfileThreadBuffer* Track = nullptr;
+
+		GPUFrame Frames[GPUProfiler::FramesInFlight];
+		uint64_t FrameIndex = 0;
+
+		GPUProfiler::Statistics Stats;
+	};
+
+	static GPUProfilerData* s_Data = nullptr;
+
+	static const GPUScopeHooks s_ScopeHooks = { GPUProfiler::BeginScope, GPUProfiler::EndScope };
+
+	static uint32_t GetFrameSlot(uint64_t frameIndex)
+	{
+		return (uint32_t)(frameIndex % GPUProfiler::FramesInFlight);
+	}
+
+	static uint32_t GetFrameTag(uint64_t frameIndex)
+	{
+		return (uint32_t)frameIndex & ((1u << (32 - s_ScopeBits)) - 1);
+	}
+
+	void GPUProfiler::Init()
+	{
+		GE_PROFILE_FUNCTION();
+
+		s_Data = new GPUProfilerData();
+		s_Data->Queries = TimerQueryPool::Create(FramesInFlight * s_QueriesPerFrame);
+		s_Data->Track = Instrumentor::Get().CreateTrack("GPU");
+
+		for (GPUFrame& frame : s_Data->Frames)
+			frame.Scopes.reserve(MaxScopesPerFrame);
+		SetContextThread(true);
+	}
+
+	void GPUProfiler::Shutdown()
+	{
+		SetContextThread(false);
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void GPUProfiler::SetContextThread(bool owner)
+	{
+		Instrumentor::SetGPUScopeHooks(owner ? &s_ScopeHooks : nullptr);
+	}
+
+	static void ResolveFrame(uint32_t slot)
+	{
+		GPUFrame& frame = s_Data->Frames[slot];
+		if (frame.QueryCount == 0)
+			return;
+
+		// Timestamps complete in submission order, the last one decides
+		uint32_t base = slot * s_QueriesPerFrame;
+		if (!s_Data->Queries->IsResultAvailable(base + frame.QueryCount - 1))
+		{
+			s_Data->Stats.FramesDropped++;
+			return;
+		}
+
+		int64_t offset = Instrumentor::Now() - (int64_t)s_Data->Queries->GetCurrentTimestamp();
+		for (const GPUScope& scope : frame.Scopes)
+		{
+			// Still open when the frame ended
+			if (scope.EndQuery == s_OpenQuery)
+				continue;
+
+			int64_t begin = (int64_t)s_Data->Queries->GetResult(base + scope.BeginQuery);
+			int64_t end = (int64_t)s_Data->Queries->GetResult(base + scope.EndQuery);
+			Instrumentor::Get().Record(*s_Data->Track, scope.Name, begin + offset, std::max<int64_t>(end - begin, 0));
+			s_Data->Stats.Resolved++;
+		}
+	}
+
+	void GPUProfiler::BeginFrame()
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (!s_Data)
+			return;
+
+		s_Data->FrameIndex++;
+		uint32_t slot = GetFrameSlot(s_Data->FrameIndex);
+
+		// Written FramesInFlight frames ago
+		ResolveFrame(slot);
+		GPUFrame& frame = s_Data->Frames[slot];
+		frame.Scopes.clear();
+		frame.QueryCount = 0;
+	}
+
+	uint32_t GPUProfiler::BeginScope(const char* name)
+	{
+		if (!s_Data || !Instrumentor::Get().IsRecording())
+			return InvalidScope;
+
+		uint32_t slot = GetFrameSlot(s_Data->FrameIndex);
+		GPUFrame& frame = s_Data->Frames[slot];
+		if (frame.Scopes.size() >= MaxScopesPerFrame)
+		{
+			s_Data->Stats.ScopesDropped++;
+			return InvalidScope;
+		}
+
+		s_Data->Queries->WriteTimestamp(slot * s_QueriesPerFrame + frame.QueryCount);
+		frame.Scopes.push_back({ name, frame.QueryCount, s_OpenQuery });
+		frame.QueryCount++;
+		return (GetFrameTag(s_Data->FrameIndex) << s_ScopeBits) | ((uint32_t)frame.Scopes.size() - 1);
+	}
+
+	void GPUProfiler::EndScope(uint32_t scope)
+	{
+		if (scope == InvalidScope || !s_Data)
+			return;
+
+		// Scopes that span a frame boundary are left open and skipped on resolve
+		if ((scope >> s_ScopeBits) != GetFrameTag(s_Data->FrameIndex))
+			return;
+
+		uint32_t slot = GetFrameSlot(s_Data->FrameIndex);
+		GPUFrame& frame = s_Data->Frames[slot];
+		s_Data->Queries->WriteTimestamp(slot * s_QueriesPerFrame + frame.QueryCount);
+		frame.Scopes[scope & ((1u << s_ScopeBits) - 1)].EndQuery = frame.QueryCount;
+		frame.QueryCount++;
+	}
+
+	uint32_t GPUProfiler::GetTrackIndex()
+	{
+		return s_Data ? s_Data->Track->GetThreadIndex() : InvalidScope;
+	}
+
+	const GPUProfiler::Statistics& GPUProfiler::GetStats()
+	{
+		static Statistics s_Empty;
+		return s_Data ? s_Data->Stats : s_Empty;
+	}
+}
\ No newline at end of file
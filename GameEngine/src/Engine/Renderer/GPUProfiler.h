@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+namespace Engine {
+
+	// GPU scopes measured with timestamp queries.
+	// Each frame writes into its own slice of the query pool and is read back
+	// FramesInFlight frames later, so resolving never waits for the GPU.
+	// Resolved scopes are mapped onto the CPU clock and recorded on the "GPU" track
+	// of the Instrumentor, next to the CPU threads.
+	// GE_PROFILE_SCOPE opens a GPU scope with the same name on the thread that owns the
+	// context: Init() hooks the calling thread, the RenderThread moves the hooks with the context.
+	class GPUProfiler
+	{
+	public:
+		static const uint32_t FramesInFlight = 4;
+		static const uint32_t MaxScopesPerFrame = 128;
+		static const uint32_t InvalidScope = 0xffffffff;
+
+		static void Init();
+		static void Shutdown();
+
+		// Whether GE_PROFILE_SCOPE on the calling thread also times the GPU
+		static void SetContextThread(bool owner);
+
+		// Resolves the oldest frame and starts a new one, call once per frame before any GPU scope
+		static void BeginFrame();
+
+		// Scopes are only measured while the Instrumentor is recording
+		static uint32_t BeginScope(const char* name);
+		static void EndScope(uint32_t scope);
+
+		// Thread index of the GPU track in the Instrumentor
+		static uint32_t GetTrackIndex();
+
+		struct Statistics
+		{
+			uint32_t Resolved = 0;
+			// Frames whose queries were not ready in time
+			uint32_t FramesDropped = 0;
+			// Scopes past MaxScopesPerFrame
+			uint32_t ScopesDropped = 0;
+		};
+		static const Statistics& GetStats();
+	};
+}
\ No newline at end of file
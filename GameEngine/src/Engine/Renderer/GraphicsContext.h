@@ -7,5 +7,9 @@ namespace Engine {
 	public:
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
+
+		// Binds the context to the calling thread, it can only be current on one thread at a time
+		virtual void MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
 	};
 }
\ No newline at end of file
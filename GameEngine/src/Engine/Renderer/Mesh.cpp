@@ -1,5 +1,8 @@
 #include "gepch.h" 
 #include "Mesh.h"
+#include "Renderer.h"
+#include "Engine/Core/Allocator.h"
+#include "Engine/Core/VFS.h"
 
 #include <glad/glad.h>
 
@@ -12,14 +15,18 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/LogStream.hpp>
 
 #include "imgui.h"
 
+#include <mutex>
+
 // TMP
 #include "stb_image.h"
-#include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/OpenGL/OpenGLRenderState.h"
 
 namespace Engine {
 
@@ -34,13 +41,18 @@ namespace Engine {
 
 	struct LogStream : public Assimp::LogStream
 	{
+		// Meshes are also imported on the cook workers of the AssetDatabase
 		static void Initialize()
 		{
-			if (Assimp::DefaultLogger::isNullLogger())
+			static std::once_flag s_Initialized;
+			std::call_once(s_Initialized, []()
 			{
-				Assimp::DefaultLogger::create("", Assimp::Logger::VERBOSE);
-				Assimp::DefaultLogger::get()->attachStream(new LogStream, Assimp::Logger::Err | Assimp::Logger::Warn);
-			}
+				if (Assimp::DefaultLogger::isNullLogger())
+				{
+					Assimp::DefaultLogger::create("", Assimp::Logger::VERBOSE);
+					Assimp::DefaultLogger::get()->attachStream(new LogStream, Assimp::Logger::Err | Assimp::Logger::Warn);
+				}
+			});
 		}
 
 		virtual void write(const char* message) override
@@ -49,6 +61,84 @@ namespace Engine {
 		}
 	};
 
+	// Lets Assimp read the model and the files it references (.mtl, .bin, ...) through the VFS
+	class VFSIOStream : public Assimp::IOStream
+	{
+	public:
+		VFSIOStream(FileBuffer&& buffer)
+			: m_Buffer(std::move(buffer)) {}
+
+		virtual size_t Read(void* buffer, size_t size, size_t count) override
+		{
+			if (size == 0)
+				return 0;
+
+			count = std::min(count, (m_Buffer.GetSize() - m_Position) / size);
+			if (count > 0)
+				memcpy(buffer, m_Buffer.GetData() + m_Position, size * count);
+			m_Position += size * count;
+			return count;
+		}
+
+		virtual size_t Write(const void* buffer, size_t size, size_t count) override { return 0; }
+
+		virtual aiReturn Seek(size_t offset, aiOrigin origin) override
+		{
+			size_t base = origin == aiOrigin_CUR ? m_Position : origin == aiOrigin_END ? m_Buffer.GetSize() : 0;
+			size_t position = origin == aiOrigin_END ? base - offset : base + offset;
+			if (position > m_Buffer.GetSize())
+				return aiReturn_FAILURE;
+
+			m_Position = position;
+			return aiReturn_SUCCESS;
+		}
+
+		virtual size_t Tell() const override { return m_Position; }
+		virtual size_t FileSize() const override { return m_Buffer.GetSize(); }
+		virtual void Flush() override {}
+	private:
+		FileBuffer m_Buffer;
+		size_t m_Position = 0;
+	};
+
+	class VFSIOSystem : public Assimp::IOSystem
+	{
+	public:
+		// Records the paths of the files that were opened when opened isn't null
+		VFSIOSystem(std::vector<std::string>* opened = nullptr)
+			: m_Opened(opened) {}
+
+		virtual bool Exists(const char* file) const override { return VFS::Exists(file); }
+		virtual char getOsSeparator() const override { return '/'; }
+
+		virtual Assimp::IOStream* Open(const char* file, const char* mode) override
+		{
+			// Read only
+			if (strchr(mode, 'w') || strchr(mode, 'a'))
+				return nullptr;
+
+			FileBuffer buffer = VFS::Read(file);
+			if (!buffer)
+				return nullptr;
+
+			if (m_Opened)
+				m_Opened->push_back(file);
+			return new VFSIOStream(std::move(buffer));
+		}
+
+		virtual void Close(Assimp::IOStream* file) override { delete file; }
+	private:
+		std::vector<std::string>* m_Opened;
+	};
+
+	// Sampler type of the material textures meshes use, in binding order
+	static const std::pair<aiTextureType, const char*> s_MaterialTextures[] = {
+		{ aiTextureType_DIFFUSE, "texture_diffuse" },
+		{ aiTextureType_SPECULAR, "texture_specular" },
+		{ aiTextureType_HEIGHT, "texture_normal" },
+		{ aiTextureType_AMBIENT, "texture_height" }
+	};
+
 	static glm::mat4 aiMatrix4x4ToGlm(const aiMatrix4x4 &from)
 	{
 		glm::mat4 to;
@@ -60,20 +150,104 @@ namespace Engine {
 		return to;
 	}
 
+	static Vertex ReadVertex(const aiMesh* mesh, size_t i)
+	{
+		Vertex vertex;
+		vertex.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+		vertex.Normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
+
+		if (mesh->HasTangentsAndBitangents())
+		{
+			vertex.Tangent = { mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z };
+			vertex.Binormal = { mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z };
+		}
+
+		if (mesh->HasTextureCoords(0))
+			vertex.Texcoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
+		return vertex;
+	}
+
+	static void ComputeBounds(const aiMesh* mesh, Submesh& submesh)
+	{
+		for (size_t i = 0; i < mesh->mNumVertices; i++)
+			submesh.BoundingBox.Expand({ mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z });
+
+		float radiusSquared = 0.0f;
+		glm::vec3 center = submesh.BoundingBox.GetCenter();
+		for (size_t i = 0; i < mesh->mNumVertices; i++)
+		{
+			glm::vec3 offset = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z) - center;
+			radiusSquared = glm::max(radiusSquared, glm::dot(offset, offset));
+		}
+		submesh.Sphere = BoundingSphere(center, glm::sqrt(radiusSquared));
+	}
+
+	static void ApplyNodeTransforms(const aiNode* node, const glm::mat4& parentTransform, std::vector<Submesh>& submeshes)
+	{
+		glm::mat4 transform = parentTransform * aiMatrix4x4ToGlm(node->mTransformation);
+		for (uint32_t i = 0; i < node->mNumMeshes; i++)
+			submeshes[node->mMeshes[i]].Transform = transform;
+
+		for (uint32_t i = 0; i < node->mNumChildren; i++)
+			ApplyNodeTransforms(node->mChildren[i], transform, submeshes);
+	}
+
+	// Rough size of what Assimp keeps alive for a scene, its allocations don't go through our hooks
+	static int64_t EstimateSceneSize(const aiScene* scene)
+	{
+		int64_t size = sizeof(aiScene);
+		for (uint32_t m = 0; m < scene->mNumMeshes; m++)
+		{
+			const aiMesh* mesh = scene->mMeshes[m];
+			int64_t vertexSize = sizeof(aiVector3D) * (1 + mesh->HasNormals() + 2 * mesh->HasTangentsAndBitangents());
+			for (uint32_t channel = 0; channel < AI_MAX_NUMBER_OF_TEXTURECOORDS; channel++)
+				vertexSize += mesh->HasTextureCoords(channel) ? sizeof(aiVector3D) : 0;
+			for (uint32_t channel = 0; channel < AI_MAX_NUMBER_OF_COLOR_SETS; channel++)
+				vertexSize += mesh->HasVertexColors(channel) ? sizeof(aiColor4D) : 0;
+
+			size += sizeof(aiMesh) + vertexSize * mesh->mNumVertices;
+			size += (int64_t)mesh->mNumFaces * (sizeof(aiFace) + 3 * sizeof(uint32_t));
+			for (uint32_t b = 0; b < mesh->mNumBones; b++)
+				size += sizeof(aiBone) + (int64_t)mesh->mBones[b]->mNumWeights * sizeof(aiVertexWeight);
+		}
+
+		for (uint32_t a = 0; a < scene->mNumAnimations; a++)
+		{
+			const aiAnimation* animation = scene->mAnimations[a];
+			size += sizeof(aiAnimation);
+			for (uint32_t c = 0; c < animation->mNumChannels; c++)
+			{
+				const aiNodeAnim* channel = animation->mChannels[c];
+				size += sizeof(aiNodeAnim);
+				size += (int64_t)channel->mNumPositionKeys * sizeof(aiVectorKey);
+				size += (int64_t)channel->mNumRotationKeys * sizeof(aiQuatKey);
+				size += (int64_t)channel->mNumScalingKeys * sizeof(aiVectorKey);
+			}
+		}
+		return size;
+	}
+
 	Mesh::Mesh(const std::string& filename)
 		: m_FilePath(filename)
 	{
+		GE_MEMORY_TAG(MemoryTag::Mesh);
+
 		LogStream::Initialize();
 		m_Directory = filename.substr(0, filename.find_last_of('/'));
 
 		GE_CORE_INFO("Loading mesh: {0}", filename.c_str());
 
 		m_Importer = std::make_unique<Assimp::Importer>();
+		// The importer owns and deletes its IO handler
+		m_Importer->SetIOHandler(new VFSIOSystem);
 
 		const aiScene* scene = m_Importer->ReadFile(filename, s_MeshImportFlags);
 		if (!scene || !scene->HasMeshes())
 			GE_CORE_ERROR("Failed to load mesh file: {0}", filename);
 
+		m_SceneSize = scene ? EstimateSceneSize(scene) : 0;
+		MemoryTracker::RecordExternal(MemoryTag::Assimp, m_SceneSize);
+
 		m_IsAnimated = scene->mAnimations != nullptr;
 		m_InverseTransform = glm::inverse(aiMatrix4x4ToGlm(scene->mRootNode->mTransformation));
 
@@ -122,24 +296,13 @@ namespace Engine {
 			else
 			{
 				for (size_t i = 0; i < mesh->mNumVertices; i++)
-				{
-					Vertex vertex;
-					vertex.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
-					vertex.Normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
-
-					if (mesh->HasTangentsAndBitangents())
-					{
-						vertex.Tangent = { mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z };
-						vertex.Binormal = { mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z };
-					}
-
-					if (mesh->HasTextureCoords(0))
-						vertex.Texcoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
-
-					m_StaticVertices.push_back(vertex);
-				}
+					m_StaticVertices.push_back(ReadVertex(mesh, i));
 			}
 
+			// Bounds
+			ComputeBounds(mesh, submesh);
+			m_BoundingBox.Expand(submesh.BoundingBox);
+
 			// Indices
 			for (size_t i = 0; i < mesh->mNumFaces; i++)
 			{
@@ -150,19 +313,11 @@ namespace Engine {
 			// Materials
 			aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
-			std::vector<Tex> diffuseMaps = LoadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-			submesh.Texture.insert(submesh.Texture.end(), diffuseMaps.begin(), diffuseMaps.end());
-
-			std::vector<Tex> specularMaps = LoadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-			submesh.Texture.insert(submesh.Texture.end(), specularMaps.begin(), specularMaps.end());
+			for (const auto& [type, typeName] : s_MaterialTextures)
+				LoadMaterialTextures(material, type, typeName, submesh.Texture);
+			submesh.TextureUniforms = GetTextureUniformNames(submesh.Texture);
 
-			std::vector<Tex> normalMaps = LoadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal");
-			submesh.Texture.insert(submesh.Texture.end(), normalMaps.begin(), normalMaps.end());
-
-			std::vector<Tex> heightMaps = LoadMaterialTextures(material, aiTextureType_AMBIENT, "texture_height");
-			submesh.Texture.insert(submesh.Texture.end(), heightMaps.begin(), heightMaps.end());
-
-			m_Submeshes.push_back(submesh);
+			m_Submeshes.push_back(std::move(submesh));
 		}
 
 		GE_CORE_TRACE("NODES:");
@@ -170,6 +325,14 @@ namespace Engine {
 		TraverseNodes(scene->mRootNode);
 		GE_CORE_TRACE("-----------------------------");
 
+		// Static submeshes are placed by their nodes
+		if (!m_IsAnimated)
+		{
+			m_BoundingBox = AABB();
+			for (const Submesh& submesh : m_Submeshes)
+				m_BoundingBox.Expand(submesh.BoundingBox.Transformed(submesh.Transform));
+		}
+
 		// Bones
 		if (m_IsAnimated)
 		{
@@ -208,8 +371,141 @@ namespace Engine {
 					}
 				}
 			}
+
+			m_BoneUniformNames.reserve(m_BoneCount);
+			for (uint32_t i = 0; i < m_BoneCount; i++)
+				m_BoneUniformNames.push_back("u_BoneTransforms[" + std::to_string(i) + "]");
+
+			FlattenNodeHierarchy(scene->mAnimations[0], scene->mRootNode, -1);
+		}
+
+		CreateVertexArray();
+		m_Scene = scene;
+	}
+
+	Mesh::Mesh(const std::string& filename, MeshData&& data)
+		: m_IsAnimated(false), m_Scene(nullptr), m_FilePath(filename)
+	{
+		GE_MEMORY_TAG(MemoryTag::Mesh);
+
+		m_Directory = filename.substr(0, filename.find_last_of('/'));
+		m_StaticVertices = std::move(data.Vertices);
+		m_Indices = std::move(data.Indices);
+		m_Submeshes = std::move(data.Submeshes);
+		m_BoundingBox = data.BoundingBox;
+
+		// Same sharing as LoadMaterialTextures
+		for (Submesh& submesh : m_Submeshes)
+		{
+			for (Tex& texture : submesh.Texture)
+			{
+				auto it = std::find_if(m_TexturesLoaded.begin(), m_TexturesLoaded.end(), [&](const Tex& loaded) { return loaded.path == texture.path; });
+				if (it != m_TexturesLoaded.end())
+					texture.id = it->id;
+				else
+				{
+					texture.id = TextureFromFile(texture.path.c_str(), m_Directory);
+					m_TexturesLoaded.push_back(texture);
+				}
+			}
+			submesh.TextureUniforms = GetTextureUniformNames(submesh.Texture);
+		}
+
+		CreateVertexArray();
+	}
+
+	Mesh::~Mesh()
+	{
+		// The scene is owned by m_Importer
+		MemoryTracker::RecordExternal(MemoryTag::Assimp, -m_SceneSize);
+	}
+
+	bool Mesh::Import(const std::string& filename, MeshData& data, std::vector<std::string>& dependencies)
+	{
+		GE_PROFILE_FUNCTION();
+
+		LogStream::Initialize();
+
+		Assimp::Importer importer;
+		std::vector<std::string> opened;
+		importer.SetIOHandler(new VFSIOSystem(&opened));
+		const aiScene* scene = importer.ReadFile(filename, s_MeshImportFlags);
+		if (!scene || !scene->HasMeshes() || scene->mAnimations)
+			return false;
+
+		data = MeshData();
+		data.Submeshes.reserve(scene->mNumMeshes);
+		for (size_t m = 0; m < scene->mNumMeshes; m++)
+		{
+			const aiMesh* mesh = scene->mMeshes[m];
+			if (!mesh->HasPositions() || !mesh->HasNormals())
+				return false;
+
+			Submesh submesh;
+			submesh.BaseVertex = (uint32_t)data.Vertices.size();
+			submesh.BaseIndex = (uint32_t)data.Indices.size() * 3;
+			submesh.MaterialIndex = mesh->mMaterialIndex;
+			submesh.IndexCount = mesh->mNumFaces * 3;
+
+			for (size_t i = 0; i < mesh->mNumVertices; i++)
+				data.Vertices.push_back(ReadVertex(mesh, i));
+			ComputeBounds(mesh, submesh);
+
+			for (size_t i = 0; i < mesh->mNumFaces; i++)
+			{
+				if (mesh->mFaces[i].mNumIndices != 3)
+					return false;
+				data.Indices.push_back({ mesh->mFaces[i].mIndices[0], mesh->mFaces[i].mIndices[1], mesh->mFaces[i].mIndices[2] });
+			}
+
+			const aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+			for (const auto& [type, typeName] : s_MaterialTextures)
+			{
+				for (uint32_t i = 0; i < material->GetTextureCount(type); i++)
+				{
+					aiString path;
+					material->GetTexture(type, i, &path);
+					submesh.Texture.push_back({ 0, typeName, path.C_Str() });
+				}
+			}
+			data.Submeshes.push_back(std::move(submesh));
 		}
 
+		ApplyNodeTransforms(scene->mRootNode, glm::mat4(1.0f), data.Submeshes);
+		for (const Submesh& submesh : data.Submeshes)
+			data.BoundingBox.Expand(submesh.BoundingBox.Transformed(submesh.Transform));
+
+		dependencies.clear();
+		for (const std::string& path : opened)
+		{
+			if (path != filename && std::find(dependencies.begin(), dependencies.end(), path) == dependencies.end())
+				dependencies.push_back(path);
+		}
+		return true;
+	}
+
+	void Mesh::TraverseNodes(aiNode* node, const glm::mat4& parentTransform, int level)
+	{
+		std::string levelText;
+		for (int i = 0; i < level; i++)
+			levelText += "-";
+		GE_CORE_TRACE("{0}Node name: {1}", levelText, std::string(node->mName.data));
+		glm::mat4 transform = parentTransform * aiMatrix4x4ToGlm(node->mTransformation);
+		for (uint32_t i = 0; i < node->mNumMeshes; i++)
+		{
+			uint32_t mesh = node->mMeshes[i];
+			m_Submeshes[mesh].Transform = transform;
+		}
+
+		for (uint32_t i = 0; i < node->mNumChildren; i++)
+		{
+			aiNode* child = node->mChildren[i];
+			TraverseNodes(child, transform, level + 1);
+		}
+	}
+
+	void Mesh::CreateVertexArray()
+	{
 		m_VertexArray = VertexArray::Create();
 
 		if (m_IsAnimated)
@@ -243,35 +539,29 @@ namespace Engine {
 		// OLD: auto ib = IndexBuffer::Create(m_Indices.data(), m_Indices.size() * sizeof(Index));
 		auto ib = IndexBuffer::Create(&(m_Indices.data()->V1), m_Indices.size() * 3);
 		m_VertexArray->SetIndexBuffer(ib);
-		m_Scene = scene;
 	}
 
-	Mesh::~Mesh()
-	{
-	}
-
-	void Mesh::TraverseNodes(aiNode* node, int level)
+	std::vector<std::string> GetTextureUniformNames(const std::vector<Tex>& textures)
 	{
-		std::string levelText;
-		for (int i = 0; i < level; i++)
-			levelText += "-";
-		GE_CORE_TRACE("{0}Node name: {1}", levelText, std::string(node->mName.data));
-		for (uint32_t i = 0; i < node->mNumMeshes; i++)
-		{
-			uint32_t mesh = node->mMeshes[i];
-			m_Submeshes[mesh].Transform = aiMatrix4x4ToGlm(node->mTransformation);
-		}
+		std::vector<std::string> names;
+		names.reserve(textures.size());
 
-		for (uint32_t i = 0; i < node->mNumChildren; i++)
+		uint32_t diffuseNr = 1;
+		uint32_t specularNr = 1;
+		for (const Tex& texture : textures)
 		{
-			aiNode* child = node->mChildren[i];
-			TraverseNodes(child, level + 1);
+			std::string number;
+			if (texture.type == "texture_diffuse")
+				number = std::to_string(diffuseNr++);
+			else if (texture.type == "texture_specular")
+				number = std::to_string(specularNr++);
+			names.push_back(texture.type + number);
 		}
+		return names;
 	}
 
-	std::vector<Tex> Mesh::LoadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName)
+	void Mesh::LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const char* typeName, std::vector<Tex>& textures)
 	{
-		std::vector<Tex> textures;
 		for (unsigned int i = 0; i < mat->GetTextureCount(type); i++)
 		{
 			aiString str;
@@ -296,12 +586,70 @@ namespace Engine {
 				m_TexturesLoaded.push_back(texture);
 			}
 		}
-		return textures;
+	}
+
+	void Mesh::FlattenNodeHierarchy(const aiAnimation* animation, const aiNode* node, int32_t parent)
+	{
+		AnimatedNode animatedNode;
+		animatedNode.Node = node;
+		animatedNode.Channel = nullptr;
+		animatedNode.Parent = parent;
+		animatedNode.BoneIndex = -1;
+
+		for (uint32_t i = 0; i < animation->mNumChannels; i++)
+		{
+			if (animation->mChannels[i]->mNodeName == node->mName)
+			{
+				animatedNode.Channel = animation->mChannels[i];
+				break;
+			}
+		}
+
+		auto bone = m_BoneMapping.find(node->mName.data);
+		if (bone != m_BoneMapping.end())
+			animatedNode.BoneIndex = (int32_t)bone->second;
+
+		int32_t index = (int32_t)m_AnimatedNodes.size();
+		m_AnimatedNodes.push_back(animatedNode);
+
+		for (uint32_t i = 0; i < node->mNumChildren; i++)
+			FlattenNodeHierarchy(animation, node->mChildren[i], index);
 	}
 
 	void Mesh::BoneTransform(float time)
 	{
-		ReadNodeHierarchy(time, m_Scene->mRootNode, glm::mat4(1.0f));
+		// Global transform of every node, parents are always computed first
+		ScratchScope scratch;
+		glm::mat4* transforms = scratch.Allocate<glm::mat4>(m_AnimatedNodes.size());
+
+		for (size_t i = 0; i < m_AnimatedNodes.size(); i++)
+		{
+			const AnimatedNode& node = m_AnimatedNodes[i];
+
+			glm::mat4 nodeTransform;
+			if (node.Channel)
+			{
+				glm::vec3 translation = CalcInterpolatedPosition(time, node.Channel);
+				glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), translation);
+
+				glm::quat rotation = CalcInterpolatedRotation(time, node.Channel);
+				glm::mat4 rotationMatrix = glm::toMat4(rotation);
+
+				glm::vec3 scale = CalcInterpolatedScaling(time, node.Channel);
+				glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), scale);
+
+				nodeTransform = translationMatrix * rotationMatrix * scaleMatrix;
+			}
+			else
+			{
+				nodeTransform = aiMatrix4x4ToGlm(node.Node->mTransformation);
+			}
+
+			transforms[i] = node.Parent >= 0 ? transforms[node.Parent] * nodeTransform : nodeTransform;
+
+			if (node.BoneIndex >= 0)
+				m_BoneInfo[node.BoneIndex].FinalTransformation = m_InverseTransform * transforms[i] * m_BoneInfo[node.BoneIndex].BoneOffset;
+		}
 
 		m_BoneTransforms.resize(m_BoneCount);
 
@@ -419,50 +767,6 @@ namespace Engine {
 		return { aiVec.x, aiVec.y, aiVec.z };
 	}
 
-	void Mesh::ReadNodeHierarchy(float AnimationTime, const aiNode* pNode, const glm::mat4& ParentTransform)
-	{
-		std::string name(pNode->mName.data);
-		const aiAnimation* animation = m_Scene->mAnimations[0];
-		glm::mat4 nodeTransform(aiMatrix4x4ToGlm(pNode->mTransformation));
-		const aiNodeAnim* nodeAnim = FindNodeAnim(animation, name);
-
-		if (nodeAnim)
-		{
-			glm::vec3 translation = CalcInterpolatedPosition(AnimationTime, nodeAnim);
-			glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(translation.x, translation.y, translation.z));
-
-			glm::quat rotation = CalcInterpolatedRotation(AnimationTime, nodeAnim);
-			glm::mat4 rotationMatrix = glm::toMat4(rotation);
-
-			glm::vec3 scale = CalcInterpolatedScaling(AnimationTime, nodeAnim);
-			glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale.x, scale.y, scale.z));
-
-			nodeTransform = translationMatrix * rotationMatrix * scaleMatrix;
-		}
-
-		glm::mat4 transform = ParentTransform * nodeTransform;
-
-		if (m_BoneMapping.find(name) != m_BoneMapping.end())
-		{
-			uint32_t BoneIndex = m_BoneMapping[name];
-			m_BoneInfo[BoneIndex].FinalTransformation = m_InverseTransform * transform * m_BoneInfo[BoneIndex].BoneOffset;
-		}
-
-		for (uint32_t i = 0; i < pNode->mNumChildren; i++)
-			ReadNodeHierarchy(AnimationTime, pNode->mChildren[i], transform);
-	}
-
-	const aiNodeAnim* Mesh::FindNodeAnim(const aiAnimation* animation, const std::string& nodeName)
-	{
-		for (uint32_t i = 0; i < animation->mNumChannels; i++)
-		{
-			const aiNodeAnim* pNodeAnim = animation->mChannels[i];
-			if (std::string(pNodeAnim->mNodeName.data) == nodeName)
-				return pNodeAnim;
-		}
-		return nullptr;
-	}
-
 	void Mesh::Render(Timestep ts, const Ref<Shader>& shader, const glm::mat4& transform)
 	{
 		if (m_IsAnimated)
@@ -475,50 +779,41 @@ namespace Engine {
 			}
 
 			BoneTransform(m_AnimationTime);
+			for (size_t i = 0; i < m_BoneTransforms.size(); i++)
+				m_BoneTransforms[i] = m_BoneInfo[i].FinalTransformation;
 		}
 
-		if (shader)
-			shader->Bind();
-
-		// TODO: Sort this out
-		m_VertexArray->Bind();
+		if (!shader)
+			return;
 
-		// TODO: replace with render API calls
-		for (Submesh& submesh : m_Submeshes)
+		// Submeshes are queued, so the bones are read when the queue executes: all draws of an
+		// animated mesh in one frame share the last pose
+		RenderQueueCommand command;
+		command.Shader = shader.get();
+		command.VertexArray = m_VertexArray.get();
+		if (m_IsAnimated)
 		{
-			unsigned int diffuseNr = 1;
-			unsigned int specularNr = 1;
-			for (unsigned int i = 0; i < submesh.Texture.size(); i++)
-			{
-				glActiveTexture(GL_TEXTURE0 + i);
-				std::string number;
-				std::string name = submesh.Texture[i].type;
-				if (name == "texture_diffuse")
-					number = std::to_string(diffuseNr++);
-				else if (name == "texture_specular")
-					number = std::to_string(specularNr++);
-
-				std::dynamic_pointer_cast<Engine::OpenGLShader>(shader)->UploadUniformFloat((name + number).c_str(), i);
-
-				glBindTexture(GL_TEXTURE_2D, submesh.Texture[i].id);
-			}
-			glActiveTexture(GL_TEXTURE0);
+			command.Bones = m_BoneTransforms.data();
+			command.BoneUniforms = m_BoneUniformNames.data();
+			command.BoneCount = (uint32_t)m_BoneTransforms.size();
+		}
 
-			if (m_IsAnimated)
-			{
-				for (size_t i = 0; i < m_BoneTransforms.size(); i++)
-				{
-					m_BoneTransforms[i] = m_BoneInfo[i].FinalTransformation;
+		// Bone animation can move vertices outside the bind pose bounds, so only static meshes are culled
+		const Frustum& frustum = Renderer::GetFrustum();
+		uint32_t visibleCount = 0;
 
-					std::string uniformName = std::string("u_BoneTransforms[") + std::to_string(i) + std::string("]");
-					std::dynamic_pointer_cast<Engine::OpenGLShader>(shader)->UploadUniformMat4(uniformName.c_str(), m_BoneTransforms[i]);
-				}
-			}
+		for (const Submesh& submesh : m_Submeshes)
+		{
+			command.Transform = m_IsAnimated ? transform : transform * submesh.Transform;
+			if (!m_IsAnimated && !frustum.Intersects(submesh.BoundingBox.Transformed(command.Transform)))
+				continue;
+			visibleCount++;
 
-			std::dynamic_pointer_cast<Engine::OpenGLShader>(shader)->UploadUniformMat4("u_ModelMatrix", transform);
-			//std::dynamic_pointer_cast<Engine::OpenGLShader>(shader)->UploadUniformMat4("u_ModelMatrix", transform * submesh.Transform);
-			glDrawElementsBaseVertex(GL_TRIANGLES, submesh.IndexCount, GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * submesh.BaseIndex), submesh.BaseVertex);
+			command.Submesh = &submesh;
+			Renderer::Submit(command);
 		}
+
+		Renderer::RecordCulling(visibleCount, (uint32_t)m_Submeshes.size() - visibleCount);
 	}
 
 	void Mesh::OnImGuiRender()
@@ -545,6 +840,10 @@ namespace Engine {
 	// TMP
 	unsigned int TextureFromFile(const char* path, const std::string& directory)
 	{
+		// Meshes keep raw GL texture names, other APIs load them without textures
+		if (RendererAPI::GetAPI() != RendererAPI::API::OpenGL)
+			return 0;
+
 		std::string filename = path;
 		filename = directory + '/' + filename;
 
@@ -553,7 +852,8 @@ namespace Engine {
 
 		stbi_set_flip_vertically_on_load(0);
 		int width, height, bpp;
-		unsigned char* data = stbi_load(filename.c_str(), &width, &height, &bpp, 0);
+		FileBuffer file = VFS::Read(filename);
+		unsigned char* data = file ? stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &bpp, 0) : nullptr;
 		if (data)
 		{
 			GLenum format;
@@ -567,11 +867,14 @@ namespace Engine {
 			glBindTexture(GL_TEXTURE_2D, textureID);
 			glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
 			glGenerateMipmap(GL_TEXTURE_2D);
+			// Mip chain adds a third, the textures are never deleted
+			MemoryTracker::RecordGPU(GPUMemoryType::Texture, (int64_t)width * height * bpp * 4 / 3);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 			glBindTexture(GL_TEXTURE_2D, 0);
+			OpenGLRenderState::InvalidateTextures();
 			stbi_image_free(data);
 		}
 		else
@@ -9,6 +9,8 @@
 #include "Engine/Renderer/VertexArray.h"
 #include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/BoundingVolume.h"
+#include "Engine/Debug/MemoryTracker.h"
 
 struct aiNode;
 struct aiAnimation;
@@ -113,6 +115,9 @@ unsigned int TextureFromFile(const char* path, const std::string& directory);
 		std::string path;
 	};
 
+	// Sampler uniform of every texture: texture_diffuse1, texture_diffuse2, texture_specular1, texture_normal
+	std::vector<std::string> GetTextureUniformNames(const std::vector<Tex>& textures);
+
 	class Submesh
 	{
 	public:
@@ -121,29 +126,62 @@ unsigned int TextureFromFile(const char* path, const std::string& directory);
 		uint32_t MaterialIndex;
 		uint32_t IndexCount;
 		std::vector<Tex> Texture;
+		// Built at import so drawing doesn't format names
+		std::vector<std::string> TextureUniforms;
+
+		// Mesh space bounds, computed at import (bind pose for animated meshes)
+		AABB BoundingBox;
+		BoundingSphere Sphere;
 
-		glm::mat4 Transform;
+		// Transform of the node that holds the submesh, relative to the mesh. Static meshes apply
+		// it when drawing, skinning already moves animated vertices into mesh space.
+		glm::mat4 Transform = glm::mat4(1.0f);
+	};
+
+	// A static mesh as imported, without GPU resources. Texture ids are 0, the textures are
+	// loaded when the mesh is created from it.
+	struct MeshData
+	{
+		TaggedVector<Vertex, MemoryTag::Mesh> Vertices;
+		TaggedVector<Index, MemoryTag::Mesh> Indices;
+		std::vector<Submesh> Submeshes;
+		AABB BoundingBox;
 	};
 
 	class Mesh
 	{
 	public:
 		Mesh(const std::string& filename);
+		// Static mesh from data imported earlier, see AssetDatabase
+		Mesh(const std::string& filename, MeshData&& data);
 		~Mesh();
 
+		// Imports a static mesh without touching the renderer, so it can run on any thread.
+		// dependencies receives the other files the import read, like material libraries; the
+		// textures are in the submeshes. Returns false for animated meshes, which keep their
+		// Assimp scene for playback, and for files that can't be imported.
+		static bool Import(const std::string& filename, MeshData& data, std::vector<std::string>& dependencies);
+
 		void Render(Timestep ts, const Ref<Shader>& shader, const glm::mat4& transform = glm::mat4(1.0f));
 		void OnImGuiRender();
 
 		inline Ref<Shader> GetMeshShader() { return m_MeshShader; }
 		inline const std::string& GetFilePath() const { return m_FilePath; }
+
+		inline bool IsAnimated() const { return m_IsAnimated; }
+		inline const std::vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
+		inline const TaggedVector<Vertex, MemoryTag::Mesh>& GetStaticVertices() const { return m_StaticVertices; }
+		inline const TaggedVector<Index, MemoryTag::Mesh>& GetIndices() const { return m_Indices; }
+		inline const AABB& GetBoundingBox() const { return m_BoundingBox; }
 	private:
-		std::vector<Tex> LoadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName);
+		// Appends the textures of the material to textures
+		void LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const char* typeName, std::vector<Tex>& textures);
 
 		void BoneTransform(float time);
-		void ReadNodeHierarchy(float AnimationTime, const aiNode* pNode, const glm::mat4& ParentTransform);
+		void FlattenNodeHierarchy(const aiAnimation* animation, const aiNode* node, int32_t parent);
 
-		const aiNodeAnim* Mesh::FindNodeAnim(const aiAnimation* animation, const std::string& nodeName);
-		void TraverseNodes(aiNode* node, int level = 0);
+		void TraverseNodes(aiNode* node, const glm::mat4& parentTransform = glm::mat4(1.0f), int level = 0);
+		void CreateVertexArray();
 
 		uint32_t FindPosition(float AnimationTime, const aiNodeAnim* pNodeAnim);
 		uint32_t FindRotation(float AnimationTime, const aiNodeAnim* pNodeAnim);
@@ -162,7 +200,18 @@ unsigned int TextureFromFile(const char* path, const std::string& directory);
 		std::vector<BoneInfo> m_BoneInfo;
 		std::vector<glm::mat4> m_BoneTransforms;
 		std::unordered_map<std::string, uint32_t> m_BoneMapping;
+		std::vector<std::string> m_BoneUniformNames;
 		uint32_t m_BoneCount = 0;
+
+		// Node hierarchy with parents before children, resolved against the first animation
+		struct AnimatedNode
+		{
+			const aiNode* Node;
+			const aiNodeAnim* Channel;
+			int32_t Parent;
+			int32_t BoneIndex;
+		};
+		std::vector<AnimatedNode> m_AnimatedNodes;
 		
 		bool m_IsAnimated;
 		float m_AnimationTime = 0.0f;
@@ -171,10 +220,13 @@ unsigned int TextureFromFile(const char* path, const std::string& directory);
 
 		Ref<VertexArray> m_VertexArray;
 
-		std::vector<AnimatedVertex> m_AnimatedVertices;
-		std::vector<Vertex> m_StaticVertices;
-		std::vector<Index> m_Indices;
+		TaggedVector<AnimatedVertex, MemoryTag::Mesh> m_AnimatedVertices;
+		TaggedVector<Vertex, MemoryTag::Mesh> m_StaticVertices;
+		TaggedVector<Index, MemoryTag::Mesh> m_Indices;
+		AABB m_BoundingBox;
 		const aiScene* m_Scene;
+		// Estimated size of the imported scene, Assimp allocates in its own module
+		int64_t m_SceneSize = 0;
 
 		// Materials
 		Ref<Shader> m_MeshShader;
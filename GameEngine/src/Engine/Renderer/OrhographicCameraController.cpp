@@ -60,13 +60,16 @@ namespace Engine {
 		m_CameraTranslationSpeed = m_ZoomLevel;
 	}
 
-	void OrthographicCameraController::OnEvent(Event& e)
+	bool OrthographicCameraController::OnEvent(const QueuedEvent& e)
 	{
 		GE_PROFILE_FUNCTION();
 
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<MouseScrolledEvent>(GE_BIND_EVENT_FN(OrthographicCameraController::OnMouseScrolled));
-		dispatcher.Dispatch<WindowResizeEvent>(GE_BIND_EVENT_FN(OrthographicCameraController::OnWindowResized));
+		switch (e.Type)
+		{
+			case EventType::MouseScrolled: return OnMouseScrolled(e.MouseScrolled);
+			case EventType::WindowResize: return OnWindowResized(e.WindowResize);
+			default: return false;
+		}
 	}
 
 	void OrthographicCameraController::CalculateView()
@@ -75,21 +78,21 @@ namespace Engine {
 		m_Camera.SetProjection(m_Bounds.Left, m_Bounds.Right, m_Bounds.Bottom, m_Bounds.Top);
 	}
 
-	bool OrthographicCameraController::OnMouseScrolled(MouseScrolledEvent& e)
+	bool OrthographicCameraController::OnMouseScrolled(const MouseScrolledData& e)
 	{
 		GE_PROFILE_FUNCTION();
 
-		m_ZoomLevel -= e.GetYOffset() * 0.25f;
+		m_ZoomLevel -= e.YOffset * 0.25f;
 		m_ZoomLevel = std::max(m_ZoomLevel, 0.25f);
 		CalculateView();
 		return true;
 	}
 
-	bool OrthographicCameraController::OnWindowResized(WindowResizeEvent& e)
+	bool OrthographicCameraController::OnWindowResized(const WindowResizeData& e)
 	{
 		GE_PROFILE_FUNCTION();
 
-		m_AspectRatio = (float)e.GetWidth() / (float)e.GetHeight();
+		m_AspectRatio = (float)e.Width / (float)e.Height;
 		CalculateView();
 		return true;
 	}
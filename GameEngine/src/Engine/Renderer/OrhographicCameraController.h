@@ -2,8 +2,7 @@
 #include "OrthographicCamera.h"
 #include "Engine/Core/Timestep.h"
 
-#include "Engine/Events/ApplicationEvent.h"
-#include "Engine/Events/MouseEvent.h"
+#include "Engine/Events/EventBus.h"
 
 namespace Engine {
 
@@ -22,7 +21,8 @@ namespace Engine {
 		OrthographicCameraController(float aspectRatio, bool rotation = false);
 
 		void OnUpdate(Timestep ts);
-		void OnEvent(Event& e);
+		// Handles MouseScrolled and WindowResize, returns true when the event was used
+		bool OnEvent(const QueuedEvent& e);
 
 		OrthographicCamera& GetCamera() { return m_Camera; }
 		const OrthographicCamera& GetCamera() const { return m_Camera; }
@@ -34,8 +34,8 @@ namespace Engine {
 	private:
 		void CalculateView();
 
-		bool OnMouseScrolled(MouseScrolledEvent& e);
-		bool OnWindowResized(WindowResizeEvent& e);
+		bool OnMouseScrolled(const MouseScrolledData& e);
+		bool OnWindowResized(const WindowResizeData& e);
 	private:
 		float m_AspectRatio;
 		float m_ZoomLevel = 1.0f;
@@ -38,28 +38,31 @@ namespace Engine {
 		RecalculateViewMatrix();
 	}
 
-	void PerspectiveCamera::OnEvent(Event& e)
+	bool PerspectiveCamera::OnEvent(const QueuedEvent& e)
 	{
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<MouseMovedEvent>(GE_BIND_EVENT_FN(PerspectiveCamera::OnMouseMoved));
-		dispatcher.Dispatch<MouseScrolledEvent>(GE_BIND_EVENT_FN(PerspectiveCamera::OnMouseScrolled));
+		switch (e.Type)
+		{
+			case EventType::MouseMoved: return OnMouseMoved(e.MouseMoved);
+			case EventType::MouseScrolled: return OnMouseScrolled(e.MouseScrolled);
+			default: return false;
+		}
 	}
 
 	// Processes input received from a mouse input system. Expects the offset value in both the x and y direction.
-	bool PerspectiveCamera::OnMouseMoved(MouseMovedEvent& e)
+	bool PerspectiveCamera::OnMouseMoved(const MouseMovedData& e)
 	{
 		if (firstMouse)
 		{
-			lastX = e.GetX();
-			lastY = e.GetY();
+			lastX = e.X;
+			lastY = e.Y;
 			firstMouse = false;
 		}
 
-		float xoffset = e.GetX() - lastX;
-		float yoffset = lastY - e.GetY(); // reversed since y-coordinates range from bottom to top
+		float xoffset = e.X - lastX;
+		float yoffset = lastY - e.Y; // reversed since y-coordinates range from bottom to top
 
-		lastX = e.GetX();
-		lastY = e.GetY();
+		lastX = e.X;
+		lastY = e.Y;
 
 		xoffset *= m_MouseSensitivity;
 		yoffset *= m_MouseSensitivity;
@@ -84,9 +87,9 @@ namespace Engine {
 	}
 
 	// Processes input received from a mouse scroll-wheel event. Only requires input on the vertical wheel-axis
-	bool PerspectiveCamera::OnMouseScrolled(MouseScrolledEvent& e)
+	bool PerspectiveCamera::OnMouseScrolled(const MouseScrolledData& e)
 	{
-		m_ZoomLevel -= e.GetYOffset() * 1.5f;
+		m_ZoomLevel -= e.YOffset * 1.5f;
 		m_ZoomLevel = std::clamp(m_ZoomLevel, 1.0f, 90.0f);
 		SetProjection(m_ZoomLevel);
 		return true;
@@ -3,8 +3,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "Engine/Core/Timestep.h"
-#include "Engine/Events/ApplicationEvent.h"
-#include "Engine/Events/MouseEvent.h"
+#include "Engine/Events/EventBus.h"
 
 namespace Engine {
 
@@ -12,11 +11,12 @@ namespace Engine {
 	{
 	public:
 		PerspectiveCamera(glm::vec3 position = glm::vec3(0.0f, 0.0f, 0.0f), float aspectRatio = 16 / 9, glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = -90.0f, float pitch = 0.0f);
-		bool OnMouseMoved(MouseMovedEvent& e);
-		bool OnMouseScrolled(MouseScrolledEvent& e);
+		bool OnMouseMoved(const MouseMovedData& e);
+		bool OnMouseScrolled(const MouseScrolledData& e);
 
 		void OnUpdate(Timestep ts);
-		void OnEvent(Event& e);
+		// Handles MouseMoved and MouseScrolled, returns true when the event was used
+		bool OnEvent(const QueuedEvent& e);
 		
 		void SetProjection(float ZoomLevel);
 		void SetPosition(const glm::vec3& position) { m_Position = position; void RecalculateViewMatrix(); }
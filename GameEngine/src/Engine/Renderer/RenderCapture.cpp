@@ -0,0 +1,142 @@
+#include "gepch.h"
+#include "RenderCapture.h"
+
+#include "Renderer.h"
+#include "RenderThread.h"
+#include "Platform/OpenGL/OpenGLRenderCapture.h"
+#include "Platform/OpenGL/OpenGLRenderReplay.h"
+
+#include <fstream>
+
+namespace Engine {
+
+	struct RenderCaptureData
+	{
+		std::string PendingPath;
+		uint32_t PendingFrameCount = 0;
+
+		std::string Filepath;
+		uint32_t FrameCount = 0;
+		uint32_t FrameIndex = 0;
+		// Owned by RenderCommand while the capture runs
+		CaptureRendererAPI* Capture = nullptr;
+	};
+
+	static RenderCaptureData s_Data;
+
+	Scope<CaptureRendererAPI> CaptureRendererAPI::Create(Scope<RendererAPI> target)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
+			case RendererAPI::API::OpenGL:		return CreateScope<OpenGLCaptureRendererAPI>(std::move(target));
+			// Nothing to snapshot
+			case RendererAPI::API::Null:		return nullptr;
+			case RendererAPI::API::Software:	return nullptr;
+		}
+		GE_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+
+	Scope<RenderReplay> RenderReplay::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
+			case RendererAPI::API::OpenGL:		return CreateScope<OpenGLRenderReplay>();
+			case RendererAPI::API::Null:		return nullptr;
+			case RendererAPI::API::Software:	return nullptr;
+		}
+		GE_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+
+	void RenderCapture::Request(const std::string& filepath, uint32_t frameCount)
+	{
+		GE_CORE_ASSERT(frameCount > 0, "Capture needs at least one frame");
+		s_Data.PendingPath = filepath;
+		s_Data.PendingFrameCount = frameCount;
+	}
+
+	void RenderCapture::BeginFrame()
+	{
+		if (s_Data.Capture)
+		{
+			if (++s_Data.FrameIndex < s_Data.FrameCount)
+			{
+				s_Data.Capture->BeginFrame(s_Data.FrameIndex);
+				return;
+			}
+			Stop();
+		}
+
+		if (!s_Data.PendingPath.empty())
+			Start();
+	}
+
+	bool RenderCapture::IsCapturing()
+	{
+		return s_Data.Capture != nullptr;
+	}
+
+	void RenderCapture::RecordBufferData(uint32_t rendererID, uint32_t offset, const void* data, uint32_t size)
+	{
+		if (s_Data.Capture)
+			s_Data.Capture->RecordBufferData(rendererID, offset, data, size);
+	}
+
+	void RenderCapture::RecordTextureData(uint32_t rendererID, uint32_t dataFormat, const void* data, uint32_t size)
+	{
+		if (s_Data.Capture)
+			s_Data.Capture->RecordTextureData(rendererID, dataFormat, data, size);
+	}
+
+	void RenderCapture::Start()
+	{
+		GE_PROFILE_FUNCTION();
+
+		s_Data.Filepath = std::move(s_Data.PendingPath);
+		s_Data.FrameCount = s_Data.PendingFrameCount;
+		s_Data.FrameIndex = 0;
+		s_Data.PendingPath.clear();
+
+		if (Renderer::GetAPI() != RendererAPI::API::OpenGL)
+		{
+			GE_CORE_WARN("RenderCapture is only supported by the OpenGL RendererAPI");
+			return;
+		}
+
+		// Snapshots read GL state on the calling thread
+		if (RenderThread::IsMultiThreaded())
+		{
+			GE_CORE_WARN("RenderCapture is not supported with a render thread");
+			return;
+		}
+
+		Scope<CaptureRendererAPI> capture = CaptureRendererAPI::Create(std::move(RenderCommand::s_RendererAPI));
+		s_Data.Capture = capture.get();
+		RenderCommand::s_RendererAPI = std::move(capture);
+
+		s_Data.Capture->BeginFrame(0);
+		GE_CORE_INFO("RenderCapture started, {0} frame(s) to '{1}'", s_Data.FrameCount, s_Data.Filepath);
+	}
+
+	void RenderCapture::Stop()
+	{
+		GE_PROFILE_FUNCTION();
+
+		const std::string& encoded = s_Data.Capture->GetData();
+		std::ofstream file(s_Data.Filepath, std::ios::binary);
+		if (file.is_open())
+		{
+			file.write(encoded.data(), encoded.size());
+			GE_CORE_INFO("RenderCapture wrote '{0}' ({1} KB)", s_Data.Filepath, encoded.size() / 1024);
+		}
+		else
+			GE_CORE_ERROR("RenderCapture could not open capture file '{0}'.", s_Data.Filepath);
+
+		// Destroys the capture API
+		RenderCommand::s_RendererAPI = s_Data.Capture->ReleaseTarget();
+		s_Data.Capture = nullptr;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+#include "RendererAPI.h"
+
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	// RendererAPI that records every call into a capture before forwarding it to the
+	// real API. Draws snapshot the bound program, uniforms, vertex input, textures and
+	// fixed function state, resources are snapshotted the first time a draw uses them.
+	class CaptureRendererAPI : public RendererAPI
+	{
+	public:
+		CaptureRendererAPI(Scope<RendererAPI> target)
+			: m_Target(std::move(target)) {}
+		virtual ~CaptureRendererAPI() = default;
+
+		virtual void BeginFrame(uint32_t frameIndex) = 0;
+
+		// Uploads made outside the RendererAPI, called before the data reaches the driver
+		virtual void RecordBufferData(uint32_t rendererID, uint32_t offset, const void* data, uint32_t size) = 0;
+		virtual void RecordTextureData(uint32_t rendererID, uint32_t dataFormat, const void* data, uint32_t size) = 0;
+
+		// Encoded capture, see CaptureFormat.h
+		virtual const std::string& GetData() const = 0;
+
+		Scope<RendererAPI> ReleaseTarget() { return std::move(m_Target); }
+
+		static Scope<CaptureRendererAPI> Create(Scope<RendererAPI> target);
+	protected:
+		Scope<RendererAPI> m_Target;
+	};
+
+	// Records the render command stream of whole frames into a file that RenderReplay
+	// can execute without the game. Capturing swaps the RendererAPI behind RenderCommand,
+	// so nothing is recorded and nothing costs anything while no capture is requested.
+	class RenderCapture
+	{
+	public:
+		// Captures the next frameCount frames, starting at the next BeginFrame()
+		static void Request(const std::string& filepath, uint32_t frameCount = 1);
+
+		// Called once at the start of every frame, starts and finishes requested captures
+		static void BeginFrame();
+
+		static bool IsCapturing();
+
+		static void RecordBufferData(uint32_t rendererID, uint32_t offset, const void* data, uint32_t size);
+		static void RecordTextureData(uint32_t rendererID, uint32_t dataFormat, const void* data, uint32_t size);
+	private:
+		static void Start();
+		static void Stop();
+	};
+
+	struct ReplayCommandTiming
+	{
+		std::string Description;
+		uint32_t Frame = 0;
+		uint32_t Index = 0;
+
+		// Totals over all loops, in nanoseconds
+		uint64_t CPUTime = 0;
+		uint64_t GPUTime = 0;
+	};
+
+	// Re-executes a capture in a loop with per command CPU and GPU timing.
+	// Needs a current context of the API the capture was made with.
+	class RenderReplay
+	{
+	public:
+		virtual ~RenderReplay() = default;
+
+		// Creates all resources of the capture
+		virtual bool Load(const std::string& filepath) = 0;
+		// Executes the command stream loops times, waiting for the GPU after each loop
+		virtual void Run(uint32_t loops) = 0;
+
+		virtual uint32_t GetLoopCount() const = 0;
+		virtual const std::vector<ReplayCommandTiming>& GetTimings() const = 0;
+
+		static Scope<RenderReplay> Create();
+	};
+}
\ No newline at end of file
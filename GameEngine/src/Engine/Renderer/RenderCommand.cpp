@@ -1,9 +1,8 @@
 #include "gepch.h"
 #include "RenderCommand.h"
 
-#include "Platform/OpenGL/OpenGLRendererAPI.h"
-
 namespace Engine {
 
-	Scope<RendererAPI> RenderCommand::s_RendererAPI = CreateScope<OpenGLRendererAPI>();
+	// Created in Init(), once the application had a chance to pick the API
+	Scope<RendererAPI> RenderCommand::s_RendererAPI;
 }
\ No newline at end of file
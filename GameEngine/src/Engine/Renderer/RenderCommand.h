@@ -10,6 +10,7 @@ namespace Engine {
 	public:
 		inline static void Init()
 		{
+			s_RendererAPI = RendererAPI::Create();
 			s_RendererAPI->Init();
 		}
 
@@ -31,17 +32,49 @@ namespace Engine {
 		{
 			s_RendererAPI->DrawIndexed(vertexArray, count);
 		}
+		inline static void DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+		{
+			s_RendererAPI->DrawIndexedBaseVertex(vertexArray, indexCount, firstIndex, baseVertex);
+		}
 		inline static void DrawArrays(const Engine::Ref<VertexArray>& vertexArray)
 		{
 			s_RendererAPI->DrawArrays(vertexArray);
 		}
 
+		inline static void MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount)
+		{
+			s_RendererAPI->MultiDrawIndexedIndirect(vertexArray, indirectBuffer, firstCommand, drawCount);
+		}
+
+		inline static void BindTexture(uint32_t slot, uint32_t rendererID)
+		{
+			s_RendererAPI->BindTexture(slot, rendererID);
+		}
+
 		inline static void DepthTest(bool depthTest)
 		{
 			s_RendererAPI->DepthTest(depthTest);
 		}
 
+		inline static void Finish()
+		{
+			s_RendererAPI->Finish();
+		}
+
+		inline static RendererAPI::StateStatistics GetStateStats()
+		{
+			return s_RendererAPI->GetStateStats();
+		}
+		inline static void ResetStateStats()
+		{
+			s_RendererAPI->ResetStateStats();
+		}
+
 	private:
 		static Scope<RendererAPI> s_RendererAPI;
+
+		// Swap a recording RendererAPI in and out
+		friend class RenderCapture;
+		friend class RenderThread;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "gepch.h"
+#include "RenderCommandQueue.h"
+
+namespace Engine {
+
+	// Every allocation starts with a header, payloads keep 16 byte alignment for SIMD types
+	static const uint32_t s_Alignment = 16;
+
+	struct CommandHeader
+	{
+		RenderCommandQueue::RenderCommandFn Fn;
+		// Bytes to the next header in the chunk, including this one
+		uint32_t Stride;
+	};
+
+	static uint32_t Align(uint32_t size)
+	{
+		return (size + s_Alignment - 1) & ~(s_Alignment - 1);
+	}
+
+	static const uint32_t s_HeaderSize = Align(sizeof(CommandHeader));
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		GE_CORE_ASSERT(m_CommandCount == 0, "RenderCommandQueue destroyed with commands that never ran");
+
+		for (Chunk& chunk : m_Chunks)
+			operator delete[](chunk.Data, std::align_val_t(s_Alignment));
+	}
+
+	uint8_t* RenderCommandQueue::AllocateBytes(uint32_t size)
+	{
+		while (m_ChunkIndex < m_Chunks.size())
+		{
+			Chunk& chunk = m_Chunks[m_ChunkIndex];
+			if (chunk.Size - chunk.Used >= size)
+			{
+				uint8_t* memory = chunk.Data + chunk.Used;
+				chunk.Used += size;
+				return memory;
+			}
+			m_ChunkIndex++;
+		}
+
+		// Oversized allocations get a chunk of their own
+		uint32_t chunkSize = std::max(size, ChunkSize);
+		m_Chunks.push_back({ (uint8_t*)operator new[](chunkSize, std::align_val_t(s_Alignment)), chunkSize, size });
+		return m_Chunks.back().Data;
+	}
+
+	void* RenderCommandQueue::Allocate(RenderCommandFn fn, uint32_t size)
+	{
+		uint32_t stride = s_HeaderSize + Align(size);
+		uint8_t* memory = AllocateBytes(stride);
+
+		CommandHeader* header = (CommandHeader*)memory;
+		header->Fn = fn;
+		header->Stride = stride;
+		m_CommandCount++;
+		return memory + s_HeaderSize;
+	}
+
+	void* RenderCommandQueue::AllocateData(uint32_t size)
+	{
+		// Data is skipped like a command that does nothing
+		uint32_t stride = s_HeaderSize + Align(size);
+		uint8_t* memory = AllocateBytes(stride);
+
+		CommandHeader* header = (CommandHeader*)memory;
+		header->Fn = nullptr;
+		header->Stride = stride;
+		return memory + s_HeaderSize;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		GE_PROFILE_FUNCTION();
+
+		for (uint32_t i = 0; i < m_Chunks.size() && i <= m_ChunkIndex; i++)
+		{
+			Chunk& chunk = m_Chunks[i];
+			for (uint32_t offset = 0; offset < chunk.Used;)
+			{
+				CommandHeader* header = (CommandHeader*)(chunk.Data + offset);
+				if (header->Fn)
+					header->Fn(chunk.Data + offset + s_HeaderSize);
+				offset += header->Stride;
+			}
+			chunk.Used = 0;
+		}
+
+		m_ChunkIndex = 0;
+		m_CommandCount = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+namespace Engine {
+
+	// Linear buffer of type erased commands, recorded on one thread and executed on another.
+	// Memory is kept in chunks that are never moved, so pointers handed out by Allocate()
+	// and AllocateData() stay valid until Execute() finished. Chunks are reused after that.
+	class RenderCommandQueue
+	{
+	public:
+		typedef void(*RenderCommandFn)(void*);
+
+		static const uint32_t ChunkSize = 4 * 1024 * 1024;
+
+		RenderCommandQueue() = default;
+		~RenderCommandQueue();
+
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		// Storage for the command's payload, fn is called with it and has to destroy it
+		void* Allocate(RenderCommandFn fn, uint32_t size);
+		// Storage that commands of this queue can point at, e.g. vertex data
+		void* AllocateData(uint32_t size);
+
+		// Runs and destroys all commands in recording order, then resets the queue
+		void Execute();
+
+		inline uint32_t GetCommandCount() const { return m_CommandCount; }
+	private:
+		uint8_t* AllocateBytes(uint32_t size);
+	private:
+		struct Chunk
+		{
+			uint8_t* Data;
+			uint32_t Size;
+			uint32_t Used;
+		};
+
+		std::vector<Chunk> m_Chunks;
+		uint32_t m_ChunkIndex = 0;
+		uint32_t m_CommandCount = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "gepch.h"
+#include "RenderQueue.h"
+#include "RenderCommand.h"
+#include "RenderThread.h"
+#include "Mesh.h"
+
+namespace Engine {
+
+	// Sort key layout, most significant bits first:
+	//  Opaque:                 pass(2) | shader(12) | material(12) | depth(24)        | vertex array(14)
+	//  Transparent:            pass(2) | depth(24, inverted)       | submit index(38)
+	//  Background / Overlay:   pass(2) | submit index(24)          | shader(12) | material(12) | vertex array(14)
+	// Renderer ids are truncated, so collisions only cost an extra state change. Transparent
+	// draws at the same depth blend in submission order, so they are not grouped by state.
+	static const uint64_t s_PassBits = 2;
+	static const uint64_t s_ShaderBits = 12;
+	static const uint64_t s_MaterialBits = 12;
+	static const uint64_t s_DepthBits = 24;
+	static const uint64_t s_VertexArrayBits = 14;
+
+	static_assert(s_PassBits + s_ShaderBits + s_MaterialBits + s_DepthBits + s_VertexArrayBits == 64, "Sort key must use 64 bits");
+
+	// GPU scope names, indexed by RenderPass
+	static const char* s_PassNames[] = { "RenderPass Background", "RenderPass Opaque", "RenderPass Transparent", "RenderPass Overlay" };
+
+	static inline uint64_t MaskBits(uint64_t value, uint64_t bits)
+	{
+		return value & ((1ull << bits) - 1);
+	}
+
+	// Positive floats keep their order when compared as integers, so the top bits are a cheap quantized depth
+	static inline uint32_t QuantizeDepth(float depth)
+	{
+		if (!(depth > 0.0f))
+			return 0;
+
+		uint32_t bits;
+		memcpy(&bits, &depth, sizeof(float));
+		return bits >> (32 - s_DepthBits);
+	}
+
+	// The backends take a Ref, the queue only has the pointer and executes on the submitting
+	// thread before the resources can go away, so an empty owner skips the reference count
+	template<typename T>
+	static inline Ref<T> Borrow(T* object)
+	{
+		return Ref<T>(Ref<T>(), object);
+	}
+
+	RenderQueue::RenderQueue()
+		: m_Capacity(InitialCapacity)
+	{
+		m_CommandBufferBase = new RenderQueueCommand[m_Capacity];
+		m_SortEntries = new SortEntry[m_Capacity];
+		m_SortScratch = new SortEntry[m_Capacity];
+	}
+
+	RenderQueue::~RenderQueue()
+	{
+		delete[] m_CommandBufferBase;
+		delete[] m_SortEntries;
+		delete[] m_SortScratch;
+	}
+
+	void RenderQueue::Begin(const glm::mat4& viewProjection)
+	{
+		m_ViewProjectionMatrix = viewProjection;
+	}
+
+	void RenderQueue::Submit(const RenderQueueCommand& command)
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_CommandCount >= m_Capacity)
+			Grow();
+
+		m_CommandBufferBase[m_CommandCount] = command;
+		m_SortEntries[m_CommandCount] = { MakeSortKey(command), m_CommandCount };
+		m_CommandCount++;
+	}
+
+	void RenderQueue::Grow()
+	{
+		uint32_t capacity = m_Capacity * 2;
+		GE_CORE_WARN("RenderQueue: more than {0} commands in a frame, growing to {1}", m_Capacity, capacity);
+
+		RenderQueueCommand* commands = new RenderQueueCommand[capacity];
+		std::copy(m_CommandBufferBase, m_CommandBufferBase + m_CommandCount, commands);
+		delete[] m_CommandBufferBase;
+		m_CommandBufferBase = commands;
+
+		SortEntry* sortEntries = new SortEntry[capacity];
+		memcpy(sortEntries, m_SortEntries, m_CommandCount * sizeof(SortEntry));
+		delete[] m_SortEntries;
+		m_SortEntries = sortEntries;
+
+		delete[] m_SortScratch;
+		m_SortScratch = new SortEntry[capacity];
+
+		m_Capacity = capacity;
+	}
+
+	uint32_t RenderQueue::Flush()
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_CommandCount == 0)
+			return 0;
+
+		GE_CORE_ASSERT(!RenderThread::IsMultiThreaded(), "The 3D Renderer does not support a render thread yet");
+
+		Sort();
+		uint32_t drawCalls = Execute();
+
+		m_CommandCount = 0;
+		m_SubmitIndex = 0;
+		return drawCalls;
+	}
+
+	uint64_t RenderQueue::MakeSortKey(const RenderQueueCommand& command)
+	{
+		uint64_t pass = MaskBits((uint64_t)command.Pass, s_PassBits);
+		uint64_t shader = MaskBits(command.Shader->GetRendererID(), s_ShaderBits);
+		uint64_t texture = 0;
+		if (command.Texture)
+			texture = command.Texture->GetRendererID();
+		else if (command.Submesh && !command.Submesh->Texture.empty())
+			texture = command.Submesh->Texture[0].id;
+		uint64_t material = MaskBits(texture, s_MaterialBits);
+		uint64_t vertexArray = MaskBits(command.VertexArray->GetRendererID(), s_VertexArrayBits);
+
+		// View space distance of the object origin
+		glm::vec4 clip = m_ViewProjectionMatrix * command.Transform[3];
+		uint64_t depth = QuantizeDepth(clip.w);
+
+		uint64_t key = pass << (64 - s_PassBits);
+		switch (command.Pass)
+		{
+			case RenderPass::Opaque:
+			{
+				key |= shader << (s_MaterialBits + s_DepthBits + s_VertexArrayBits);
+				key |= material << (s_DepthBits + s_VertexArrayBits);
+				key |= depth << s_VertexArrayBits;
+				key |= vertexArray;
+				break;
+			}
+			case RenderPass::Transparent:
+			{
+				uint64_t invertedDepth = MaskBits(~depth, s_DepthBits);
+				key |= invertedDepth << (s_ShaderBits + s_MaterialBits + s_VertexArrayBits);
+				key |= MaskBits(m_SubmitIndex, s_ShaderBits + s_MaterialBits + s_VertexArrayBits);
+				break;
+			}
+			case RenderPass::Background:
+			case RenderPass::Overlay:
+			{
+				uint64_t submitIndex = MaskBits(m_SubmitIndex, s_DepthBits);
+				key |= submitIndex << (s_ShaderBits + s_MaterialBits + s_VertexArrayBits);
+				key |= shader << (s_MaterialBits + s_VertexArrayBits);
+				key |= material << s_VertexArrayBits;
+				key |= vertexArray;
+				break;
+			}
+		}
+
+		m_SubmitIndex++;
+		return key;
+	}
+
+	void RenderQueue::Sort()
+	{
+		GE_PROFILE_FUNCTION();
+
+		// LSD radix sort over 8 bit digits. All histograms are built in one pass
+		// and digits that are the same for every key are skipped.
+		const uint32_t count = m_CommandCount;
+		uint32_t histograms[8][256] = {};
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint64_t key = m_SortEntries[i].Key;
+			for (uint32_t digit = 0; digit < 8; digit++)
+				histograms[digit][(key >> (digit * 8)) & 0xff]++;
+		}
+
+		SortEntry* src = m_SortEntries;
+		SortEntry* dst = m_SortScratch;
+		for (uint32_t digit = 0; digit < 8; digit++)
+		{
+			uint32_t* histogram = histograms[digit];
+			uint64_t firstByte = (src[0].Key >> (digit * 8)) & 0xff;
+			if (histogram[firstByte] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < 256; bucket++)
+			{
+				uint32_t bucketCount = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += bucketCount;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t bucket = (src[i].Key >> (digit * 8)) & 0xff;
+				dst[histogram[bucket]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != m_SortEntries)
+			memcpy(m_SortEntries, src, count * sizeof(SortEntry));
+	}
+
+	uint32_t RenderQueue::Execute()
+	{
+		GE_PROFILE_FUNCTION();
+
+		const Shader* boundShader = nullptr;
+		const VertexArray* boundVertexArray = nullptr;
+
+		// Commands are grouped by pass, the pass is in the top bits of the key
+		uint32_t i = 0;
+		while (i < m_CommandCount)
+		{
+			RenderPass pass = m_CommandBufferBase[m_SortEntries[i].Index].Pass;
+			GE_PROFILE_SCOPE(s_PassNames[(uint32_t)pass]);
+
+			bool depthTest = pass == RenderPass::Opaque || pass == RenderPass::Transparent;
+			RenderCommand::DepthTest(depthTest);
+
+			for (; i < m_CommandCount; i++)
+			{
+				const RenderQueueCommand& command = m_CommandBufferBase[m_SortEntries[i].Index];
+				if (command.Pass != pass)
+					break;
+
+				if (command.Shader != boundShader)
+				{
+					command.Shader->Bind();
+					command.Shader->SetMat4("u_ViewProjectionMatrix", m_ViewProjectionMatrix);
+					boundShader = command.Shader;
+				}
+
+				if (command.VertexArray != boundVertexArray)
+				{
+					command.VertexArray->Bind();
+					boundVertexArray = command.VertexArray;
+				}
+
+				// Redundant binds are elided by the backend
+				if (command.Texture)
+					command.Texture->Bind();
+
+				for (uint32_t bone = 0; bone < command.BoneCount; bone++)
+					command.Shader->SetMat4(command.BoneUniforms[bone], command.Bones[bone]);
+
+				command.Shader->SetMat4("u_ModelMatrix", command.Transform);
+
+				if (const Submesh* submesh = command.Submesh)
+				{
+					for (uint32_t slot = 0; slot < submesh->Texture.size(); slot++)
+					{
+						command.Shader->SetFloat(submesh->TextureUniforms[slot], (float)slot);
+						RenderCommand::BindTexture(slot, submesh->Texture[slot].id);
+					}
+					RenderCommand::DrawIndexedBaseVertex(Borrow(command.VertexArray), submesh->IndexCount, submesh->BaseIndex, submesh->BaseVertex);
+				}
+				else if (command.VertexArray->GetIndexBuffer())
+					RenderCommand::DrawIndexed(Borrow(command.VertexArray));
+				else
+					RenderCommand::DrawArrays(Borrow(command.VertexArray));
+			}
+		}
+
+		RenderCommand::DepthTest(true);
+		return m_CommandCount;
+	}
+}
\ No newline at end of file
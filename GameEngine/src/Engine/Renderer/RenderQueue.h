@@ -0,0 +1,82 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "VertexArray.h"
+
+namespace Engine {
+
+	class Submesh;
+
+	// Passes execute in this order
+	enum class RenderPass : uint8_t
+	{
+		Background = 0,	// No depth test, submission order (skybox)
+		Opaque = 1,		// Depth test, front-to-back
+		Transparent = 2,	// Depth test, back-to-front
+		Overlay = 3		// No depth test, submission order
+	};
+
+	// The queue doesn't hold references, everything a command points to has to stay alive
+	// until the next Flush()
+	struct RenderQueueCommand
+	{
+		Engine::Shader* Shader = nullptr;
+		Engine::VertexArray* VertexArray = nullptr;
+		// Bound to slot 0, optional
+		Engine::Texture* Texture = nullptr;
+		// Draws the index range of the submesh with its textures instead of the whole vertex array
+		const Engine::Submesh* Submesh = nullptr;
+		// Uploaded before the draw, for skinned meshes
+		const glm::mat4* Bones = nullptr;
+		const std::string* BoneUniforms = nullptr;
+		uint32_t BoneCount = 0;
+
+		glm::mat4 Transform = glm::mat4(1.0f);
+		RenderPass Pass = RenderPass::Opaque;
+	};
+
+	// Deferred draw list for the 3D Renderer.
+	// Commands are recorded with a 64 bit sort key into a linear per-frame buffer,
+	// radix sorted on Flush() and executed with as few state changes as possible.
+	// The buffers grow when a frame submits more than they hold, they are never flushed early.
+	class RenderQueue
+	{
+	public:
+		static const uint32_t InitialCapacity = 10000;
+
+		RenderQueue();
+		~RenderQueue();
+
+		void Begin(const glm::mat4& viewProjection);
+		void Submit(const RenderQueueCommand& command);
+		// Returns the number of draw calls issued
+		uint32_t Flush();
+
+		inline uint32_t GetCommandCount() const { return m_CommandCount; }
+	private:
+		uint64_t MakeSortKey(const RenderQueueCommand& command);
+		void Grow();
+		void Sort();
+		uint32_t Execute();
+	private:
+		struct SortEntry
+		{
+			uint64_t Key;
+			uint32_t Index;
+		};
+
+		RenderQueueCommand* m_CommandBufferBase = nullptr;
+		SortEntry* m_SortEntries = nullptr;
+		SortEntry* m_SortScratch = nullptr;
+		uint32_t m_CommandCount = 0;
+		uint32_t m_Capacity = 0;
+		// Keeps submission order for passes without depth sorting
+		uint32_t m_SubmitIndex = 0;
+
+		glm::mat4 m_ViewProjectionMatrix = glm::mat4(1.0f);
+	};
+}
\ No newline at end of file
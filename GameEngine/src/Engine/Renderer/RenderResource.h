@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Engine/Core/Handle.h"
+
+namespace Engine {
+
+	// Base of the GPU resource interfaces. Every resource owns a slot in its type's table for
+	// its lifetime, so a 32 bit handle can stand in for a Ref<T> wherever the holder doesn't
+	// need to keep the resource alive: Get() returns nullptr once it was destroyed.
+	// The tables are only touched by the thread that owns the context. Resources are created
+	// there and released through CreateRenderRef()'s deleter, which leaves the table before the
+	// destructor starts, so Get() never returns a resource that is being destroyed.
+	template<typename T>
+	class RenderResource
+	{
+	public:
+		inline Handle<T> GetHandle() const { return m_Handle; }
+
+		static T* Get(Handle<T> handle)
+		{
+			RenderResource** resource = GetTable().Get(handle);
+			return resource ? static_cast<T*>(*resource) : nullptr;
+		}
+
+		static uint32_t GetLiveCount() { return GetTable().GetCount(); }
+
+		// Frees the slot early, later Get() calls with the handle return nullptr
+		void Unregister()
+		{
+			GetTable().Destroy(m_Handle);
+			m_Handle = Handle<T>();
+		}
+	protected:
+		RenderResource()
+			: m_Handle(GetTable().Create(this))
+		{
+		}
+
+		~RenderResource()
+		{
+			GetTable().Destroy(m_Handle);
+		}
+
+		RenderResource(const RenderResource&) = delete;
+		RenderResource& operator=(const RenderResource&) = delete;
+	private:
+		// Never destroyed, resources held by other static objects may be released after the
+		// function local statics of this translation unit are gone
+		static HandlePool<RenderResource*, T>& GetTable()
+		{
+			static auto* s_Table = new HandlePool<RenderResource*, T>;
+			return *s_Table;
+		}
+	private:
+		Handle<T> m_Handle;
+	};
+
+	template<typename T>
+	inline void UnregisterRenderResource(RenderResource<T>* resource) { resource->Unregister(); }
+	// Framebuffers and other objects without a handle
+	inline void UnregisterRenderResource(const void*) {}
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "gepch.h"
+#include "RenderThread.h"
+
+#include "RenderCommand.h"
+#include "GraphicsContext.h"
+#include "GPUProfiler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Engine {
+
+	// Records RendererAPI calls for the render thread. State statistics are copied when the
+	// render thread resets them, so they lag behind by up to two frames.
+	class ThreadedRendererAPI : public RendererAPI
+	{
+	public:
+		ThreadedRendererAPI(Scope<RendererAPI> target)
+			: m_Target(std::move(target)) {}
+
+		virtual void Init() override {}
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override
+		{
+			RenderThread::Submit([target = m_Target.get(), x, y, width, height]() { target->SetViewport(x, y, width, height); });
+		}
+
+		virtual void SetClearColor(const glm::vec4& color) override
+		{
+			RenderThread::Submit([target = m_Target.get(), color]() { target->SetClearColor(color); });
+		}
+
+		virtual void Clear() override
+		{
+			RenderThread::Submit([target = m_Target.get()]() { target->Clear(); });
+		}
+
+		virtual void DepthTest(bool depthTest) override
+		{
+			RenderThread::Submit([target = m_Target.get(), depthTest]() { target->DepthTest(depthTest); });
+		}
+
+		virtual void DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount) override
+		{
+			RenderThread::Submit([target = m_Target.get(), vertexArray, indexCount]() { target->DrawIndexed(vertexArray, indexCount); });
+		}
+
+		virtual void DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex) override
+		{
+			RenderThread::Submit([target = m_Target.get(), vertexArray, indexCount, firstIndex, baseVertex]() { target->DrawIndexedBaseVertex(vertexArray, indexCount, firstIndex, baseVertex); });
+		}
+
+		virtual void DrawArrays(const Engine::Ref<VertexArray>& vertexArray) override
+		{
+			RenderThread::Submit([target = m_Target.get(), vertexArray]() { target->DrawArrays(vertexArray); });
+		}
+
+		virtual void MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount) override
+		{
+			RenderThread::Submit([target = m_Target.get(), vertexArray, indirectBuffer, firstCommand, drawCount]() { target->MultiDrawIndexedIndirect(vertexArray, indirectBuffer, firstCommand, drawCount); });
+		}
+
+		virtual void BindTexture(uint32_t slot, uint32_t rendererID) override
+		{
+			RenderThread::Submit([target = m_Target.get(), slot, rendererID]() { target->BindTexture(slot, rendererID); });
+		}
+
+		// Waits inside the render thread, the main thread keeps going
+		virtual void Finish() override
+		{
+			RenderThread::Submit([target = m_Target.get()]() { target->Finish(); });
+		}
+
+		virtual StateStatistics GetStateStats() const override
+		{
+			StateStatistics stats;
+			stats.Issued = m_Issued.load(std::memory_order_relaxed);
+			stats.Elided = m_Elided.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		virtual void ResetStateStats() override
+		{
+			RenderThread::Submit([this]()
+			{
+				StateStatistics stats = m_Target->GetStateStats();
+				m_Issued.store(stats.Issued, std::memory_order_relaxed);
+				m_Elided.store(stats.Elided, std::memory_order_relaxed);
+				m_Target->ResetStateStats();
+			});
+		}
+
+		Scope<RendererAPI> Release() { return std::move(m_Target); }
+	private:
+		Scope<RendererAPI> m_Target;
+		std::atomic<uint32_t> m_Issued = 0;
+		std::atomic<uint32_t> m_Elided = 0;
+	};
+
+	struct RenderThreadData
+	{
+		std::thread Thread;
+		GraphicsContext* Context = nullptr;
+
+		RenderCommandQueue Queues[2];
+		uint32_t SubmitIndex = 0;
+
+		std::mutex Mutex;
+		std::condition_variable Kick;
+		std::condition_variable Done;
+		// A frame was handed over and has not finished executing
+		bool Busy = false;
+		bool Quit = false;
+	};
+
+	static RenderThreadData* s_Data = nullptr;
+	static thread_local bool s_IsRenderThread = false;
+
+	bool RenderThread::s_MultiThreaded = false;
+	RenderCommandQueue* RenderThread::s_Queue = nullptr;
+
+	static void RenderThreadMain()
+	{
+		s_IsRenderThread = true;
+
+		if (s_Data->Context)
+			s_Data->Context->MakeCurrent();
+		GPUProfiler::SetContextThread(true);
+
+		for (;;)
+		{
+			uint32_t executeIndex;
+			{
+				std::unique_lock lock(s_Data->Mutex);
+				s_Data->Kick.wait(lock, [] { return s_Data->Busy || s_Data->Quit; });
+				if (!s_Data->Busy)
+					break;
+				executeIndex = s_Data->SubmitIndex ^ 1;
+			}
+
+			s_Data->Queues[executeIndex].Execute();
+
+			std::lock_guard lock(s_Data->Mutex);
+			s_Data->Busy = false;
+			s_Data->Done.notify_one();
+		}
+
+		GPUProfiler::SetContextThread(false);
+		if (s_Data->Context)
+			s_Data->Context->ReleaseCurrent();
+	}
+
+	void RenderThread::Init(ThreadingPolicy policy, GraphicsContext* context)
+	{
+		GE_PROFILE_FUNCTION();
+		GE_CORE_ASSERT(!s_Data, "RenderThread already initialized");
+
+		if (policy == ThreadingPolicy::SingleThreaded)
+			return;
+
+		s_Data = new RenderThreadData();
+		s_Data->Context = context;
+		s_Queue = &s_Data->Queues[s_Data->SubmitIndex];
+		// Set before the thread starts and cleared after it joined
+		s_MultiThreaded = true;
+
+		RenderCommand::s_RendererAPI = CreateScope<ThreadedRendererAPI>(std::move(RenderCommand::s_RendererAPI));
+
+		GPUProfiler::SetContextThread(false);
+		if (context)
+			context->ReleaseCurrent();
+		s_Data->Thread = std::thread(RenderThreadMain);
+	}
+
+	void RenderThread::Shutdown()
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (!s_Data)
+			return;
+
+		NextFrame();
+		WaitIdle();
+		{
+			std::lock_guard lock(s_Data->Mutex);
+			s_Data->Quit = true;
+		}
+		s_Data->Kick.notify_one();
+		s_Data->Thread.join();
+
+		s_Queue = nullptr;
+		s_MultiThreaded = false;
+		RenderCommand::s_RendererAPI = ((ThreadedRendererAPI&)*RenderCommand::s_RendererAPI).Release();
+
+		if (s_Data->Context)
+			s_Data->Context->MakeCurrent();
+		GPUProfiler::SetContextThread(true);
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		return s_IsRenderThread;
+	}
+
+	void* RenderThread::AllocateFrameData(uint32_t size)
+	{
+		GE_CORE_ASSERT(s_Queue, "Frame data is only used with a render thread");
+		return s_Queue->AllocateData(size);
+	}
+
+	void RenderThread::NextFrame()
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (!s_Data)
+			return;
+
+		WaitIdle();
+		{
+			std::lock_guard lock(s_Data->Mutex);
+			s_Data->SubmitIndex ^= 1;
+			s_Data->Busy = true;
+		}
+		s_Queue = &s_Data->Queues[s_Data->SubmitIndex];
+		s_Data->Kick.notify_one();
+	}
+
+	void RenderThread::WaitIdle()
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (!s_Data)
+			return;
+
+		std::unique_lock lock(s_Data->Mutex);
+		s_Data->Done.wait(lock, [] { return !s_Data->Busy; });
+	}
+}
\ No newline at end of file
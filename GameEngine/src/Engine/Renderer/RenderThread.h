@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+#include "RenderCommandQueue.h"
+#include "RenderResource.h"
+
+namespace Engine {
+
+	class GraphicsContext;
+
+	enum class ThreadingPolicy
+	{
+		// Everything runs on the main thread, Submit() executes right away
+		SingleThreaded = 0,
+		// A render thread owns the context and executes frame N while the main thread records frame N + 1
+		MultiThreaded = 1
+	};
+
+	// Pipelines rendering behind the main thread. Work that touches the graphics API is
+	// submitted into a command queue, one queue records while the other one executes, so
+	// recording never takes a lock. NextFrame() is the only point where the threads wait.
+	//
+	// RenderCommand, Renderer2D, ImGui and the buffer swap submit their work. The 3D
+	// Renderer, resource creation and other direct API calls still expect the context on the
+	// calling thread: create resources before Init() or from inside a submitted command.
+	// Resources from the Create() functions may be released anywhere, see CreateRenderRef().
+	class RenderThread
+	{
+	public:
+		// Takes the context away from the calling thread when multithreaded
+		static void Init(ThreadingPolicy policy, GraphicsContext* context);
+		// Executes what is left and gives the context back to the calling thread
+		static void Shutdown();
+
+		// Only changes while no render thread runs, so both threads may read it
+		inline static bool IsMultiThreaded() { return s_MultiThreaded; }
+		static bool IsRenderThread();
+
+		// Runs func on the render thread at the next NextFrame(), or right away when
+		// single threaded or already on the render thread. Only the main and the render
+		// thread may submit.
+		template<typename FuncT>
+		static void Submit(FuncT&& func)
+		{
+			if (IsRenderThread() || !IsMultiThreaded())
+			{
+				func();
+				return;
+			}
+
+			using Command = std::decay_t<FuncT>;
+			auto execute = [](void* payload)
+			{
+				Command* command = (Command*)payload;
+				(*command)();
+				command->~Command();
+			};
+			new (s_Queue->Allocate(execute, sizeof(Command))) Command(std::forward<FuncT>(func));
+		}
+
+		// Memory that lives until the render thread executed the current frame,
+		// only available when multithreaded
+		static void* AllocateFrameData(uint32_t size);
+
+		// Waits for the previous frame to finish executing and hands it the one just recorded
+		static void NextFrame();
+		// Waits until everything handed over by NextFrame() has executed
+		static void WaitIdle();
+	private:
+		static bool s_MultiThreaded;
+		// Queue being recorded, only touched by the main thread
+		static RenderCommandQueue* s_Queue;
+	};
+
+	// Ref to an object that makes graphics API calls when destroyed. Releasing the last
+	// reference submits the delete, so it runs with the context and after the commands that
+	// were recorded while the object was alive. A RenderResource leaves its table first.
+	template<typename T, typename ... Args>
+	Ref<T> CreateRenderRef(Args&& ... args)
+	{
+		GE_CORE_ASSERT(!RenderThread::IsMultiThreaded() || RenderThread::IsRenderThread(), "Create resources before RenderThread::Init() or from a submitted command");
+		return Ref<T>(new T(std::forward<Args>(args)...), [](T* object)
+		{
+			RenderThread::Submit([object]()
+			{
+				UnregisterRenderResource(object);
+				delete object;
+			});
+		});
+	}
+}
\ No newline at end of file
@@ -1,23 +1,31 @@
 #include "gepch.h"
 #include "Renderer.h"
 #include "Renderer2D.h"
-
-#include "Platform/OpenGL/OpenGLShader.h"
+#include "GPUProfiler.h"
+#include "Engine/Debug/MemoryTracker.h"
 
 namespace Engine {
 
 	Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<Renderer::SceneData>();
+	Scope<RenderQueue> Renderer::s_RenderQueue;
+	Renderer::Statistics Renderer::s_Stats;
 
 	void Renderer::Init()
 	{
 		GE_PROFILE_FUNCTION();
+		GE_MEMORY_TAG(MemoryTag::Renderer);
 
 		RenderCommand::Init();
 		Renderer2D::Init();
+		GPUProfiler::Init();
+
+		s_RenderQueue = CreateScope<RenderQueue>();
 	}
 
 	void Renderer::Shutdown()
 	{
+		s_RenderQueue.reset();
+		GPUProfiler::Shutdown();
 		Renderer2D::Shutdown();
 	}
 
@@ -29,41 +37,76 @@ namespace Engine {
 	void Renderer::BeginScene(OrthographicCamera& camera)
 	{
 		s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
+		s_SceneData->ViewFrustum = Frustum::FromViewProjection(s_SceneData->ViewProjectionMatrix);
+		s_RenderQueue->Begin(s_SceneData->ViewProjectionMatrix);
 	}
 
 	void Renderer::BeginScene(PerspectiveCamera& camera)
 	{
 		s_SceneData->ViewProjectionMatrix = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+		s_SceneData->ViewFrustum = Frustum::FromViewProjection(s_SceneData->ViewProjectionMatrix);
+		s_RenderQueue->Begin(s_SceneData->ViewProjectionMatrix);
 	}
 
 	void Renderer::BeginScene(Camera& camera)
 	{
 		s_SceneData->ViewProjectionMatrix = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+		s_SceneData->ViewFrustum = Frustum::FromViewProjection(s_SceneData->ViewProjectionMatrix);
+		s_RenderQueue->Begin(s_SceneData->ViewProjectionMatrix);
 	}
 
 	void Renderer::EndScene()
 	{
+		GE_PROFILE_FUNCTION();
+
+		Flush();
+		s_SceneData->ViewFrustum = Frustum();
+	}
+
+	void Renderer::Flush()
+	{
+		s_Stats.DrawCalls += s_RenderQueue->Flush();
 	}
 
 	void Renderer::Submit(const Engine::Ref<Shader>& shader, const Engine::Ref<VertexArray>& vertexArray, const glm::mat4& transform, bool depthTest)
 	{
-		shader->Bind();
-		std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_ViewProjectionMatrix", s_SceneData->ViewProjectionMatrix);
-		std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_ModelMatrix", transform);
-
-		vertexArray->Bind();
-		//TODO: DepthTest needs to be called only with depthTest = false
-		if (vertexArray->GetIndexBuffer())
-		{
-			RenderCommand::DepthTest(depthTest);
-			RenderCommand::DrawIndexed(vertexArray);
-			RenderCommand::DepthTest(true);
-		}
-		else
-		{
-			RenderCommand::DepthTest(depthTest);
-			RenderCommand::DrawArrays(vertexArray);
-			RenderCommand::DepthTest(true);
-		}
+		Submit(shader, vertexArray, nullptr, transform, depthTest ? RenderPass::Opaque : RenderPass::Background);
+	}
+
+	void Renderer::Submit(const Engine::Ref<Shader>& shader, const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<Texture>& texture, const glm::mat4& transform, RenderPass pass)
+	{
+		RenderQueueCommand command;
+		command.Shader = shader.get();
+		command.VertexArray = vertexArray.get();
+		command.Texture = texture.get();
+		command.Transform = transform;
+		command.Pass = pass;
+		s_RenderQueue->Submit(command);
+	}
+
+	void Renderer::Submit(const RenderQueueCommand& command)
+	{
+		s_RenderQueue->Submit(command);
+	}
+
+	void Renderer::RecordCulling(uint32_t visible, uint32_t culled)
+	{
+		s_Stats.ObjectsVisible += visible;
+		s_Stats.ObjectsCulled += culled;
+	}
+
+	void Renderer::ResetStats()
+	{
+		memset(&s_Stats, 0, sizeof(Statistics));
+		RenderCommand::ResetStateStats();
+	}
+
+	Renderer::Statistics Renderer::GetStats()
+	{
+		Statistics stats = s_Stats;
+		RendererAPI::StateStatistics stateStats = RenderCommand::GetStateStats();
+		stats.StateChangesIssued = stateStats.Issued;
+		stats.StateChangesElided = stateStats.Elided;
+		return stats;
 	}
 }
\ No newline at end of file
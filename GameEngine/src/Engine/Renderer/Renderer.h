@@ -6,6 +6,9 @@
 #include "PerspectiveCamera.h"
 #include "Camera.h"
 #include "Shader.h"
+#include "Texture.h"
+#include "RenderQueue.h"
+#include "Frustum.h"
 
 namespace Engine {
 
@@ -21,16 +24,43 @@ namespace Engine {
 		static void BeginScene(PerspectiveCamera& camera);
 		static void BeginScene(Camera& camera);
 		static void EndScene();
+		// Sorts and draws everything submitted so far, needed before render target changes
+		static void Flush();
 
+		// Draws are queued and executed at EndScene(). depthTest = false submits to the background pass.
+		// Only the command is captured per draw: uniforms set on the shader between Submit() calls
+		// are not, every draw sees the values the shader has when the queue executes. The queue
+		// keeps no references, submitted resources have to outlive the next Flush().
 		static void Submit(const Engine::Ref<Shader>& shader, const Engine::Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f), bool depthTest = true);
+		static void Submit(const Engine::Ref<Shader>& shader, const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<Texture>& texture, const glm::mat4& transform = glm::mat4(1.0f), RenderPass pass = RenderPass::Opaque);
+		static void Submit(const RenderQueueCommand& command);
 
 		inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); };
+
+		// View frustum of the current scene, contains everything outside BeginScene/EndScene
+		inline static const Frustum& GetFrustum() { return s_SceneData->ViewFrustum; }
+		static void RecordCulling(uint32_t visible, uint32_t culled);
+
+		// Stats
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t StateChangesIssued = 0;
+			uint32_t StateChangesElided = 0;
+			uint32_t ObjectsVisible = 0;
+			uint32_t ObjectsCulled = 0;
+		};
+		static void ResetStats();
+		static Statistics GetStats();
 	private:
 		struct SceneData
 		{
 			glm::mat4 ViewProjectionMatrix;
+			Frustum ViewFrustum;
 		};
 
 		static Scope<SceneData> s_SceneData;
+		static Scope<RenderQueue> s_RenderQueue;
+		static Statistics s_Stats;
 	};
 }
\ No newline at end of file
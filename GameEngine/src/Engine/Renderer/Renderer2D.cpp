@@ -3,6 +3,8 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "RenderCommand.h"
+#include "RenderThread.h"
+#include "Engine/Debug/MemoryTracker.h"
 #include "glm/gtc/matrix_transform.hpp"
 
 namespace Engine {
@@ -29,10 +31,13 @@ namespace Engine {
 		Ref<Texture2D> WhiteTexture;
 
 		uint32_t QuadIndexCount = 0;
+		// Batch storage when single threaded
+		QuadVertex* QuadVertexStorage = nullptr;
 		QuadVertex* QuadVertexBufferBase = nullptr;
 		QuadVertex* QuadVertexBufferPtr = nullptr;
 
-		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
+		// Handles instead of Refs, a batch doesn't keep its textures alive
+		std::array<TextureHandle, MaxTextureSlots> TextureSlots;
 		uint32_t TextureSlotIndex = 1; // 0 = white texture
 
 		glm::vec4 QuadVertexPositions[4];
@@ -47,6 +52,7 @@ namespace Engine {
 	void Renderer2D::Init()
 	{
 		GE_PROFILE_FUNCTION();
+		GE_MEMORY_TAG(MemoryTag::Renderer2D);
 
 		s_Data.QuadVertexArray = VertexArray::Create();
 
@@ -60,7 +66,9 @@ namespace Engine {
 			});
 		s_Data.QuadVertexArray->AddVertexBuffer(s_Data.QuadVertexBuffer);
 
-		s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
+		s_Data.QuadVertexStorage = new QuadVertex[s_Data.MaxVertices];
+		s_Data.QuadVertexBufferBase = s_Data.QuadVertexStorage;
+		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
 
 		uint32_t* quadIndices = new uint32_t[s_Data.MaxIndices];
 
@@ -93,7 +101,7 @@ namespace Engine {
 		s_Data.TextureShader->Bind();
 		s_Data.TextureShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
 
-		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+		s_Data.TextureSlots[0] = s_Data.WhiteTexture->GetHandle();
 
 		s_Data.QuadVertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
 		s_Data.QuadVertexPositions[1] = {  0.5f, -0.5f, 0.0f, 1.0f };
@@ -105,29 +113,54 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
-		delete[] s_Data.QuadVertexBufferBase;
+		delete[] s_Data.QuadVertexStorage;
+		s_Data.QuadVertexStorage = nullptr;
+
+		// The resources go away with the context, not with the static data at exit
+		s_Data.QuadVertexArray.reset();
+		s_Data.QuadVertexBuffer.reset();
+		s_Data.TextureShader.reset();
+		s_Data.WhiteTexture.reset();
 	}
 
-	void Renderer2D::BeginScene(const OrthographicCamera& camera)
+	static void StartBatch()
 	{
-		GE_PROFILE_FUNCTION();
-
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjectionMatrix", camera.GetViewProjectionMatrix());
-		
 		s_Data.QuadIndexCount = 0;
+
+		// With a render thread the batch is written straight into the frame's command memory,
+		// which stays untouched until the render thread uploaded it
+		if (RenderThread::IsMultiThreaded())
+			s_Data.QuadVertexBufferBase = (QuadVertex*)RenderThread::AllocateFrameData(s_Data.MaxVertices * sizeof(QuadVertex));
+		else
+			s_Data.QuadVertexBufferBase = s_Data.QuadVertexStorage;
 		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
 
 		s_Data.TextureSlotIndex = 1;
 	}
 
+	void Renderer2D::BeginScene(const OrthographicCamera& camera)
+	{
+		GE_PROFILE_FUNCTION();
+
+		RenderThread::Submit([shader = s_Data.TextureShader.get(), viewProjection = camera.GetViewProjectionMatrix()]()
+		{
+			shader->Bind();
+			shader->SetMat4("u_ViewProjectionMatrix", viewProjection);
+		});
+
+		StartBatch();
+	}
+
 	void Renderer2D::EndScene()
 	{
 		GE_PROFILE_FUNCTION();
 
 		// uint8_t is one byte size to get dataSize as bytes
 		uint32_t dataSize = (uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase;
-		s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
+		RenderThread::Submit([vertexBuffer = s_Data.QuadVertexBuffer.get(), data = s_Data.QuadVertexBufferBase, dataSize]()
+		{
+			vertexBuffer->SetData(data, dataSize);
+		});
 
 		Flush();
 	}
@@ -137,9 +170,19 @@ namespace Engine {
 		if (s_Data.QuadIndexCount == 0)
 			return;
 
-		// Bind textures
-		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-			s_Data.TextureSlots[i]->Bind(i);
+		// Bind textures, the slots are copied since the next batch refills them
+		RenderThread::Submit([textures = s_Data.TextureSlots, count = s_Data.TextureSlotIndex]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				// Textures destroyed since they were drawn sample the white texture
+				Texture* texture = Texture::Get(textures[i]);
+				if (!texture)
+					texture = Texture::Get(textures[0]);
+				if (texture)
+					texture->Bind(i);
+			}
+		});
 
 		RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount);
 		s_Data.Stats.DrawCalls++;
@@ -148,11 +191,27 @@ namespace Engine {
 	void Renderer2D::FlushAndReset()
 	{
 		EndScene();
+		StartBatch();
+	}
 
-		s_Data.QuadIndexCount = 0;
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+	// Slot of the texture in the current batch, starts a new batch when all slots are taken
+	static float GetTextureIndex(const Texture2D& texture)
+	{
+		TextureHandle handle = texture.GetHandle();
+		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+		{
+			if (s_Data.TextureSlots[i] == handle)
+				return (float)i;
+		}
 
-		s_Data.TextureSlotIndex = 1;
+		if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+		{
+			Renderer2D::EndScene();
+			StartBatch();
+		}
+
+		s_Data.TextureSlots[s_Data.TextureSlotIndex] = handle;
+		return (float)s_Data.TextureSlotIndex++;
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
@@ -210,25 +269,7 @@ namespace Engine {
 		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
 			FlushAndReset();
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
-				FlushAndReset();
-
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
+		float textureIndex = GetTextureIndex(*texture);
 
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
@@ -260,33 +301,70 @@ namespace Engine {
 
 		constexpr size_t quadVertexCount = 4;
 		const glm::vec2* textureCoords = subtexture->GetTexCoords();
-		const Ref<Texture2D> texture = subtexture->GetTexture();
+		const Ref<Texture2D>& texture = subtexture->GetTexture();
 
 		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
 			FlushAndReset();
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+		float textureIndex = GetTextureIndex(*texture);
+
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
+			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+		for (size_t i = 0; i < quadVertexCount; i++)
 		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
-			{
-				textureIndex = (float)i;
-				break;
-			}
+			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
+			s_Data.QuadVertexBufferPtr->Color = tintColor;
+			s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
+			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
+			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
+			s_Data.QuadVertexBufferPtr++;
 		}
 
-		if (textureIndex == 0.0f)
-		{
-			if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
-				FlushAndReset();
+		s_Data.QuadIndexCount += 6;
+
+		s_Data.Stats.QuadCount++;
 
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+	{
+		GE_PROFILE_FUNCTION();
+
+		constexpr size_t quadVertexCount = 4;
+		const float textureIndex = 0.0f; // White Texture
+		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+		const float tilingFactor = 1.0f;
+
+		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+			FlushAndReset();
+
+		for (size_t i = 0; i < quadVertexCount; i++)
+		{
+			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
+			s_Data.QuadVertexBufferPtr->Color = color;
+			s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
+			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
+			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
+			s_Data.QuadVertexBufferPtr++;
 		}
 
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
-			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+		s_Data.QuadIndexCount += 6;
+
+		s_Data.Stats.QuadCount++;
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		GE_PROFILE_FUNCTION();
+
+		constexpr size_t quadVertexCount = 4;
+		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+			FlushAndReset();
+
+		float textureIndex = GetTextureIndex(*texture);
 
 		for (size_t i = 0; i < quadVertexCount; i++)
 		{
@@ -301,7 +379,6 @@ namespace Engine {
 		s_Data.QuadIndexCount += 6;
 
 		s_Data.Stats.QuadCount++;
-
 	}
 
 	// rotation in radians
@@ -363,25 +440,7 @@ namespace Engine {
 		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
 			FlushAndReset();
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
-				FlushAndReset();
-
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
+		float textureIndex = GetTextureIndex(*texture);
 
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
@@ -415,30 +474,12 @@ namespace Engine {
 
 		constexpr size_t quadVertexCount = 4;
 		const glm::vec2* textureCoords = subtexture->GetTexCoords();
-		const Ref<Texture2D> texture = subtexture->GetTexture();
+		const Ref<Texture2D>& texture = subtexture->GetTexture();
 
 		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
 			FlushAndReset();
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
-		{
-			if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
-				FlushAndReset();
-
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
-		}
+		float textureIndex = GetTextureIndex(*texture);
 
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
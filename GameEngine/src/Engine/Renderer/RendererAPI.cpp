@@ -1,7 +1,29 @@
 #include "gepch.h"
 #include "RendererAPI.h"
 
+#include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
+
 namespace Engine {
 
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
+
+	void RendererAPI::SetAPI(API api)
+	{
+		s_API = api;
+	}
+
+	Scope<RendererAPI> RendererAPI::Create()
+	{
+		switch (s_API)
+		{
+			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
+			case RendererAPI::API::OpenGL:		return CreateScope<OpenGLRendererAPI>();
+			case RendererAPI::API::Null:		return CreateScope<NullRendererAPI>();
+			case RendererAPI::API::Software:	return CreateScope<SoftwareRendererAPI>();
+		}
+		GE_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
 }
\ No newline at end of file
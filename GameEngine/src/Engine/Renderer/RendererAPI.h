@@ -10,9 +10,22 @@ namespace Engine {
 	public:
 		enum class API
 		{
-			None = 0, OpenGL = 1
+			None = 0, OpenGL = 1,
+			// Accepts and counts every call without a GPU or window, for headless runs
+			Null = 2,
+			// Multithreaded CPU rasterizer, renders without a GPU into memory
+			Software = 3
+		};
+
+		// Per-frame counters of state changes sent to the driver vs skipped as redundant
+		struct StateStatistics
+		{
+			uint32_t Issued = 0;
+			uint32_t Elided = 0;
 		};
 	public:
+		virtual ~RendererAPI() = default;
+
 		virtual void Init() = 0;
 		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 		virtual void SetClearColor(const glm::vec4& color) = 0;
@@ -20,9 +33,25 @@ namespace Engine {
 		virtual void DepthTest(bool depthTest) = 0;
 
 		virtual void DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+		// Draws indexCount indices starting at firstIndex, baseVertex is added to every index
+		virtual void DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex) = 0;
 		virtual void DrawArrays(const Engine::Ref<VertexArray>& vertexArray) = 0;
+		// Draws drawCount DrawIndexedIndirectCommands starting at firstCommand in one call
+		virtual void MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount) = 0;
+
+		virtual void BindTexture(uint32_t slot, uint32_t rendererID) = 0;
+
+		// Blocks until all submitted GPU work is complete
+		virtual void Finish() = 0;
+
+		virtual StateStatistics GetStateStats() const = 0;
+		virtual void ResetStateStats() = 0;
 
 		inline static API GetAPI() { return s_API; }
+		// Has to be called before the window and the renderer are created
+		static void SetAPI(API api);
+
+		static Scope<RendererAPI> Create();
 	private:
 		static API s_API;
 	};
@@ -2,7 +2,10 @@
 #include "Shader.h"
 
 #include "Renderer.h"
+#include "RenderThread.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Null/NullShader.h"
+#include "Platform/Software/SoftwareShader.h"
 
 
 namespace Engine {
@@ -12,7 +15,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-		case RendererAPI::API::OpenGL:		return std::make_shared<OpenGLShader>(filepath);
+		case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLShader>(filepath);
+		case RendererAPI::API::Null:		return CreateRenderRef<NullShader>(filepath);
+		case RendererAPI::API::Software:	return CreateRenderRef<SoftwareShader>(filepath);
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -23,7 +28,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-			case RendererAPI::API::OpenGL:		return std::make_shared<OpenGLShader>(name, vertexSrc, fragmentSrc);
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullShader>(name, vertexSrc, fragmentSrc);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareShader>(name, vertexSrc, fragmentSrc);
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -4,12 +4,17 @@
 #include <unordered_map>
 #include <glm/glm.hpp>
 
+#include "Engine/Renderer/RenderResource.h"
+
 namespace Engine {
+
+	class Shader;
+	using ShaderHandle = Handle<Shader>;
 	
-	class Shader
+	class Shader : public RenderResource<Shader>
 	{
 	public:
-		~Shader() = default;
+		virtual ~Shader() = default;
 
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
@@ -23,6 +28,7 @@ namespace Engine {
 
 
 		virtual const std::string& GetName() const = 0;
+		virtual uint32_t GetRendererID() const = 0;
 
 		static Ref<Shader> Create(const std::string& filepath);
 		static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
@@ -0,0 +1,256 @@
+#include "gepch.h"
+#include "StaticMeshBatch.h"
+#include "RenderCommand.h"
+#include "Frustum.h"
+#include "Renderer.h"
+#include "Engine/Debug/MemoryTracker.h"
+
+namespace Engine {
+
+	static_assert(sizeof(glm::mat4) + 4 * sizeof(uint32_t) == 80, "DrawData must match the std430 layout in the shader");
+
+	StaticMeshBatch::StaticMeshBatch()
+	{
+		m_DrawData.reserve(MaxDraws);
+		m_Commands.reserve(MaxDraws);
+		m_SortedCommands.reserve(MaxDraws);
+		m_BoundsX.reserve(MaxDraws);
+		m_BoundsY.reserve(MaxDraws);
+		m_BoundsZ.reserve(MaxDraws);
+		m_BoundsRadius.reserve(MaxDraws);
+		m_Visible.reserve(MaxDraws);
+	}
+
+	uint32_t StaticMeshBatch::AddMesh(const Ref<Mesh>& mesh)
+	{
+		GE_PROFILE_FUNCTION();
+		GE_MEMORY_TAG(MemoryTag::Renderer);
+
+		GE_CORE_ASSERT(!m_VertexArray, "StaticMeshBatch is already built");
+		GE_CORE_ASSERT(!mesh->IsAnimated(), "Animated meshes can not be batched");
+
+		MeshRange meshRange;
+		meshRange.FirstSubmesh = (uint32_t)m_Submeshes.size();
+		meshRange.SubmeshCount = (uint32_t)mesh->GetSubmeshes().size();
+
+		uint32_t vertexOffset = (uint32_t)m_Vertices.size();
+		uint32_t indexOffset = (uint32_t)m_Indices.size() * 3;
+
+		for (const Submesh& submesh : mesh->GetSubmeshes())
+		{
+			SubmeshRange range;
+			range.IndexCount = submesh.IndexCount;
+			range.FirstIndex = indexOffset + submesh.BaseIndex;
+			range.BaseVertex = vertexOffset + submesh.BaseVertex;
+			range.MaterialIndex = FindOrAddMaterial(submesh.Texture);
+			range.Sphere = submesh.Sphere;
+			range.Transform = submesh.Transform;
+			m_Submeshes.push_back(range);
+		}
+
+		const auto& vertices = mesh->GetStaticVertices();
+		const auto& indices = mesh->GetIndices();
+		m_Vertices.insert(m_Vertices.end(), vertices.begin(), vertices.end());
+		m_Indices.insert(m_Indices.end(), indices.begin(), indices.end());
+
+		m_Meshes.push_back(meshRange);
+		return (uint32_t)m_Meshes.size() - 1;
+	}
+
+	void StaticMeshBatch::Build()
+	{
+		GE_PROFILE_FUNCTION();
+		GE_MEMORY_TAG(MemoryTag::Renderer);
+
+		m_VertexArray = VertexArray::Create();
+
+		auto vb = VertexBuffer::Create(m_Vertices.data(), (uint32_t)(m_Vertices.size() * sizeof(Vertex)));
+		vb->SetLayout({
+			{ ShaderDataType::Float3, "a_Position" },
+			{ ShaderDataType::Float3, "a_Normal" },
+			{ ShaderDataType::Float2, "a_TexCoord" },
+			{ ShaderDataType::Float3, "a_Tangent" },
+			{ ShaderDataType::Float3, "a_Binormal" },
+		});
+		m_VertexArray->AddVertexBuffer(vb);
+
+		auto ib = IndexBuffer::Create(&(m_Indices.data()->V1), (uint32_t)m_Indices.size() * 3);
+		m_VertexArray->SetIndexBuffer(ib);
+
+		m_DrawDataBuffer = StorageBuffer::Create(MaxDraws * sizeof(DrawData));
+		m_IndirectBuffer = IndirectBuffer::Create(MaxDraws * sizeof(DrawIndexedIndirectCommand));
+
+		// The GPU has its own copy now
+		m_Vertices.clear();
+		m_Vertices.shrink_to_fit();
+		m_Indices.clear();
+		m_Indices.shrink_to_fit();
+	}
+
+	void StaticMeshBatch::Begin()
+	{
+		m_DrawData.clear();
+		m_Commands.clear();
+		m_BoundsX.clear();
+		m_BoundsY.clear();
+		m_BoundsZ.clear();
+		m_BoundsRadius.clear();
+		m_Stats = Statistics();
+	}
+
+	void StaticMeshBatch::Submit(uint32_t meshHandle, const glm::mat4& transform)
+	{
+		GE_CORE_ASSERT(meshHandle < m_Meshes.size(), "Invalid mesh handle");
+
+		const MeshRange& mesh = m_Meshes[meshHandle];
+		for (uint32_t i = 0; i < mesh.SubmeshCount; i++)
+		{
+			if (m_Commands.size() >= MaxDraws)
+			{
+				GE_CORE_WARN("StaticMeshBatch is full, draw discarded");
+				return;
+			}
+
+			const SubmeshRange& submesh = m_Submeshes[mesh.FirstSubmesh + i];
+			uint32_t drawIndex = (uint32_t)m_Commands.size();
+
+			DrawIndexedIndirectCommand command;
+			command.IndexCount = submesh.IndexCount;
+			command.InstanceCount = 1;
+			command.FirstIndex = submesh.FirstIndex;
+			command.BaseVertex = (int32_t)submesh.BaseVertex;
+			// Lets the shader find its DrawData through gl_BaseInstance
+			command.BaseInstance = drawIndex;
+			m_Commands.push_back(command);
+
+			glm::mat4 modelMatrix = transform * submesh.Transform;
+
+			DrawData data;
+			data.Transform = modelMatrix;
+			data.MaterialIndex = submesh.MaterialIndex;
+			m_DrawData.push_back(data);
+
+			BoundingSphere sphere = submesh.Sphere.Transformed(modelMatrix);
+			m_BoundsX.push_back(sphere.Center.x);
+			m_BoundsY.push_back(sphere.Center.y);
+			m_BoundsZ.push_back(sphere.Center.z);
+			m_BoundsRadius.push_back(sphere.Radius);
+		}
+	}
+
+	uint32_t StaticMeshBatch::Flush(const Ref<Shader>& shader, const glm::mat4& viewProjection)
+	{
+		GE_PROFILE_FUNCTION();
+
+		Cull(viewProjection);
+
+		if (m_Commands.empty())
+			return 0;
+
+		// Counting sort by material, the draw data stays in submission order
+		uint32_t materialCount = (uint32_t)m_Materials.size();
+		m_MaterialOffsets.assign(materialCount + 1, 0);
+		for (const DrawData& data : m_DrawData)
+			m_MaterialOffsets[data.MaterialIndex + 1]++;
+		for (uint32_t i = 1; i <= materialCount; i++)
+			m_MaterialOffsets[i] += m_MaterialOffsets[i - 1];
+
+		m_SortedCommands.resize(m_Commands.size());
+		m_MaterialCursors.assign(m_MaterialOffsets.begin(), m_MaterialOffsets.end() - 1);
+		for (size_t i = 0; i < m_Commands.size(); i++)
+			m_SortedCommands[m_MaterialCursors[m_DrawData[i].MaterialIndex]++] = m_Commands[i];
+
+		m_DrawDataBuffer->SetData(m_DrawData.data(), (uint32_t)(m_DrawData.size() * sizeof(DrawData)));
+		m_IndirectBuffer->SetData(m_SortedCommands.data(), (uint32_t)(m_SortedCommands.size() * sizeof(DrawIndexedIndirectCommand)));
+
+		shader->Bind();
+		shader->SetMat4("u_ViewProjectionMatrix", viewProjection);
+		m_DrawDataBuffer->Bind(DrawDataBinding);
+
+		uint32_t drawCalls = 0;
+		for (uint32_t material = 0; material < materialCount; material++)
+		{
+			uint32_t first = m_MaterialOffsets[material];
+			uint32_t count = m_MaterialOffsets[material + 1] - first;
+			if (count == 0)
+				continue;
+
+			BindMaterial(shader, material);
+			RenderCommand::MultiDrawIndexedIndirect(m_VertexArray, m_IndirectBuffer, first, count);
+			drawCalls++;
+		}
+
+		m_Stats.DrawCalls += drawCalls;
+		m_Stats.Draws += (uint32_t)m_Commands.size();
+
+		m_DrawData.clear();
+		m_Commands.clear();
+		return drawCalls;
+	}
+
+	void StaticMeshBatch::Cull(const glm::mat4& viewProjection)
+	{
+		GE_PROFILE_FUNCTION();
+
+		uint32_t count = (uint32_t)m_Commands.size();
+		m_Visible.resize(count);
+
+		Frustum frustum = Frustum::FromViewProjection(viewProjection);
+		uint32_t visibleCount = FrustumCuller::CullSpheres(frustum, m_BoundsX.data(), m_BoundsY.data(), m_BoundsZ.data(), m_BoundsRadius.data(), count, m_Visible.data());
+
+		// Compact in place, base instances have to follow their draw data
+		uint32_t write = 0;
+		for (uint32_t read = 0; read < count; read++)
+		{
+			if (!m_Visible[read])
+				continue;
+
+			m_Commands[write] = m_Commands[read];
+			m_Commands[write].BaseInstance = write;
+			m_DrawData[write] = m_DrawData[read];
+			write++;
+		}
+		m_Commands.resize(visibleCount);
+		m_DrawData.resize(visibleCount);
+
+		m_BoundsX.clear();
+		m_BoundsY.clear();
+		m_BoundsZ.clear();
+		m_BoundsRadius.clear();
+
+		m_Stats.Culled += count - visibleCount;
+		Renderer::RecordCulling(visibleCount, count - visibleCount);
+	}
+
+	uint32_t StaticMeshBatch::FindOrAddMaterial(const std::vector<Tex>& textures)
+	{
+		for (uint32_t i = 0; i < m_Materials.size(); i++)
+		{
+			const auto& material = m_Materials[i];
+			if (material.size() != textures.size())
+				continue;
+
+			bool same = true;
+			for (size_t t = 0; t < textures.size() && same; t++)
+				same = material[t].id == textures[t].id && material[t].type == textures[t].type;
+
+			if (same)
+				return i;
+		}
+
+		m_Materials.push_back(textures);
+		m_MaterialUniforms.push_back(GetTextureUniformNames(textures));
+		return (uint32_t)m_Materials.size() - 1;
+	}
+
+	void StaticMeshBatch::BindMaterial(const Ref<Shader>& shader, uint32_t materialIndex)
+	{
+		const auto& textures = m_Materials[materialIndex];
+		const auto& uniforms = m_MaterialUniforms[materialIndex];
+		for (uint32_t i = 0; i < textures.size(); i++)
+		{
+			shader->SetInt(uniforms[i], i);
+			RenderCommand::BindTexture(i, textures[i].id);
+		}
+	}
+}
\ No newline at end of file
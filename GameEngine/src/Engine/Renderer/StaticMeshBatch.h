@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Engine/Core/Base.h"
+#include "Buffer.h"
+#include "Mesh.h"
+#include "Shader.h"
+#include "VertexArray.h"
+
+namespace Engine {
+
+	// Static geometry of many meshes packed into one vertex/index buffer pair.
+	// Per-draw data lives in a storage buffer indexed by the draw's base instance,
+	// so every material bucket is drawn with a single multi-draw-indirect call.
+	// Usage: AddMesh() all meshes, Build() once, then Begin/Submit/Flush each frame.
+	class StaticMeshBatch
+	{
+	public:
+		static const uint32_t MaxDraws = 16384;
+		// Binding point of the per-draw storage buffer in the shader
+		static const uint32_t DrawDataBinding = 0;
+
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t Draws = 0;
+			uint32_t Culled = 0;
+		};
+
+		StaticMeshBatch();
+		~StaticMeshBatch() = default;
+
+		// Returns the handle passed to Submit()
+		uint32_t AddMesh(const Ref<Mesh>& mesh);
+		void Build();
+
+		void Begin();
+		void Submit(uint32_t meshHandle, const glm::mat4& transform);
+		// Culls the submitted draws against the view frustum and returns the number of draw calls issued
+		uint32_t Flush(const Ref<Shader>& shader, const glm::mat4& viewProjection);
+
+		inline const Statistics& GetStats() const { return m_Stats; }
+	private:
+		struct DrawData
+		{
+			glm::mat4 Transform;
+			uint32_t MaterialIndex;
+			uint32_t Padding[3];
+		};
+
+		struct SubmeshRange
+		{
+			uint32_t IndexCount;
+			uint32_t FirstIndex;
+			uint32_t BaseVertex;
+			uint32_t MaterialIndex;
+			BoundingSphere Sphere;
+			glm::mat4 Transform;
+		};
+
+		struct MeshRange
+		{
+			uint32_t FirstSubmesh;
+			uint32_t SubmeshCount;
+		};
+
+		void Cull(const glm::mat4& viewProjection);
+		uint32_t FindOrAddMaterial(const std::vector<Tex>& textures);
+		void BindMaterial(const Ref<Shader>& shader, uint32_t materialIndex);
+	private:
+		std::vector<Vertex> m_Vertices;
+		std::vector<Index> m_Indices;
+		std::vector<SubmeshRange> m_Submeshes;
+		std::vector<MeshRange> m_Meshes;
+		// Texture sets, identified by their position in this list
+		std::vector<std::vector<Tex>> m_Materials;
+		std::vector<std::vector<std::string>> m_MaterialUniforms;
+
+		Ref<VertexArray> m_VertexArray;
+		Ref<StorageBuffer> m_DrawDataBuffer;
+		Ref<IndirectBuffer> m_IndirectBuffer;
+
+		std::vector<DrawData> m_DrawData;
+		std::vector<DrawIndexedIndirectCommand> m_Commands;
+		// Commands reordered so each material is one contiguous range
+		std::vector<DrawIndexedIndirectCommand> m_SortedCommands;
+		std::vector<uint32_t> m_MaterialOffsets;
+		std::vector<uint32_t> m_MaterialCursors;
+
+		// World space bounding spheres of the submitted draws, as structure of arrays for the culler
+		std::vector<float> m_BoundsX, m_BoundsY, m_BoundsZ, m_BoundsRadius;
+		std::vector<uint8_t> m_Visible;
+
+		Statistics m_Stats;
+	};
+}
\ No newline at end of file
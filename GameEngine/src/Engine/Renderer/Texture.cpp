@@ -1,8 +1,11 @@
 #include "gepch.h"
 #include "Texture.h"
 #include "Renderer.h"
+#include "RenderThread.h"
 
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Null/NullTexture.h"
+#include "Platform/Software/SoftwareTexture.h"
 
 namespace Engine {
 
@@ -11,7 +14,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLTexture2D>(width, height);
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLTexture2D>(width, height);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullTexture2D>(width, height);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareTexture2D>(width, height);
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -22,7 +27,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLTexture2D>(path);
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLTexture2D>(path);
+			case RendererAPI::API::Null:		return CreateRenderRef<NullTexture2D>(path);
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareTexture2D>(path);
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -33,7 +40,10 @@ namespace Engine {
 		switch (RendererAPI::GetAPI())
 		{
 			case RendererAPI::API::None:	return nullptr;
-			case RendererAPI::API::OpenGL:	return CreateRef<OpenGLTextureCube>(faces);
+			case RendererAPI::API::OpenGL:	return CreateRenderRef<OpenGLTextureCube>(faces);
+			case RendererAPI::API::Null:	return CreateRenderRef<NullTextureCube>(faces);
+			// Only the Renderer2D program is rasterized, cube maps are never sampled
+			case RendererAPI::API::Software:	return CreateRenderRef<NullTextureCube>(faces);
 		}
 		return nullptr;
 	}
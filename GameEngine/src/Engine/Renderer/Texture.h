@@ -3,10 +3,14 @@
 #include <string>
 
 #include "Engine/Core/Base.h"
+#include "Engine/Renderer/RenderResource.h"
 
 namespace Engine {
 
-	class Texture
+	class Texture;
+	using TextureHandle = Handle<Texture>;
+
+	class Texture : public RenderResource<Texture>
 	{
 	public:
 		virtual ~Texture() = default;
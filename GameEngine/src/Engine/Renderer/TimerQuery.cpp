@@ -0,0 +1,23 @@
+#include "gepch.h"
+#include "TimerQuery.h"
+
+#include "Renderer.h"
+#include "Platform/OpenGL/OpenGLTimerQuery.h"
+#include "Platform/Null/NullTimerQuery.h"
+
+namespace Engine {
+
+	Scope<TimerQueryPool> TimerQueryPool::Create(uint32_t count)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
+			case RendererAPI::API::OpenGL:		return CreateScope<OpenGLTimerQueryPool>(count);
+			case RendererAPI::API::Null:		return CreateScope<NullTimerQueryPool>(count);
+			// Draws finish on the CPU before they return, there is no GPU time to query
+			case RendererAPI::API::Software:	return CreateScope<NullTimerQueryPool>(count);
+		}
+		GE_CORE_ASSERT(false, "Unknown RendererAPI");
+		return nullptr;
+	}
+}
\ No newline at end of file
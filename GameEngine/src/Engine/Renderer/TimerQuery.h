@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+namespace Engine {
+
+	// Fixed set of GPU timestamp queries. A timestamp is taken when the GPU reaches
+	// the query in the command stream, results become available some frames later.
+	class TimerQueryPool
+	{
+	public:
+		virtual ~TimerQueryPool() = default;
+
+		virtual void WriteTimestamp(uint32_t index) = 0;
+
+		// Never blocks
+		virtual bool IsResultAvailable(uint32_t index) const = 0;
+		// GPU time in nanoseconds, only valid once the result is available
+		virtual uint64_t GetResult(uint32_t index) const = 0;
+		// Current GPU time in nanoseconds, to map results onto the CPU clock
+		virtual uint64_t GetCurrentTimestamp() const = 0;
+
+		virtual uint32_t GetCount() const = 0;
+
+		static Scope<TimerQueryPool> Create(uint32_t count);
+	};
+}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "gepch.h"
 #include "VertexArray.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Null/NullBuffer.h"
+#include "Platform/Software/SoftwareBuffer.h"
 
 #include "Renderer.h"
+#include "RenderThread.h"
 
 namespace Engine {
 
@@ -11,7 +14,9 @@ namespace Engine {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:		GE_CORE_ASSERT(false, "RendererAPI::None"); return nullptr;
-			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLVertexArray>();
+			case RendererAPI::API::OpenGL:		return CreateRenderRef<OpenGLVertexArray>();
+			case RendererAPI::API::Null:		return CreateRenderRef<NullVertexArray>();
+			case RendererAPI::API::Software:	return CreateRenderRef<SoftwareVertexArray>();
 		}
 		GE_CORE_ASSERT(false, "Unknown RendererAPI");
 		return nullptr;
@@ -2,10 +2,14 @@
 
 #include <memory>
 #include "Engine/Renderer/Buffer.h"
+#include "Engine/Renderer/RenderResource.h"
 
 namespace Engine {
 
-	class VertexArray
+	class VertexArray;
+	using VertexArrayHandle = Handle<VertexArray>;
+
+	class VertexArray : public RenderResource<VertexArray>
 	{
 	public:
 		virtual ~VertexArray() {}
@@ -19,6 +23,8 @@ namespace Engine {
 		virtual const std::vector<Engine::Ref<VertexBuffer>>& GetVertexBuffers() const = 0;
 		virtual const Engine::Ref<IndexBuffer>& GetIndexBuffer() const = 0;
 
+		virtual uint32_t GetRendererID() const = 0;
+
 		static Ref<VertexArray> Create();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "gepch.h"
+#include "Archetype.h"
+
+#include "Engine/Debug/MemoryTracker.h"
+
+#include <mutex>
+
+namespace Engine {
+
+	struct ComponentRegistryData
+	{
+		std::mutex Mutex;
+		ComponentInfo Infos[MaxComponentTypes];
+		uint32_t Count = 0;
+	};
+
+	static ComponentRegistryData& GetRegistry()
+	{
+		static ComponentRegistryData s_Registry;
+		return s_Registry;
+	}
+
+	ComponentID ComponentRegistry::Register(const ComponentInfo& info)
+	{
+		GE_CORE_ASSERT(info.Alignment <= alignof(std::max_align_t), "Over-aligned components are not supported");
+
+		ComponentRegistryData& registry = GetRegistry();
+		std::lock_guard lock(registry.Mutex);
+		GE_CORE_ASSERT(registry.Count < MaxComponentTypes, "Too many component types");
+		registry.Infos[registry.Count] = info;
+		return registry.Count++;
+	}
+
+	const ComponentInfo& ComponentRegistry::GetInfo(ComponentID id)
+	{
+		return GetRegistry().Infos[id];
+	}
+
+	Archetype::Archetype(ComponentMask mask)
+		: m_Mask(mask)
+	{
+		uint32_t rowSize = sizeof(Entity);
+		for (ComponentID id = 0; id < MaxComponentTypes; id++)
+		{
+			if (!Has(id))
+				continue;
+			m_Components.push_back(id);
+			m_Sizes[id] = (uint32_t)ComponentRegistry::GetInfo(id).Size;
+			rowSize += m_Sizes[id];
+		}
+
+		// Padding between the arrays can push the last one past the end
+		m_ChunkCapacity = ChunkSize / rowSize;
+		while (m_ChunkCapacity > 0 && Layout(m_ChunkCapacity) > ChunkSize)
+			m_ChunkCapacity--;
+		GE_CORE_ASSERT(m_ChunkCapacity > 0, "Components don't fit in a chunk");
+	}
+
+	Archetype::~Archetype()
+	{
+		for (Chunk& chunk : m_Chunks)
+		{
+			for (ComponentID id : m_Components)
+			{
+				const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+				if (info.Trivial)
+					continue;
+				for (uint32_t row = 0; row < chunk.Count; row++)
+					info.Destroy(chunk.Data + m_Offsets[id] + row * m_Sizes[id]);
+			}
+			MemoryTracker::Free(chunk.Data);
+		}
+	}
+
+	uint32_t Archetype::Layout(uint32_t capacity)
+	{
+		uint32_t offset = capacity * sizeof(Entity);
+		for (ComponentID id : m_Components)
+		{
+			uint32_t alignment = (uint32_t)ComponentRegistry::GetInfo(id).Alignment;
+			offset = (offset + alignment - 1) & ~(alignment - 1);
+			m_Offsets[id] = offset;
+			offset += capacity * m_Sizes[id];
+		}
+		return offset;
+	}
+
+	void Archetype::AddRow(Entity entity, uint32_t& chunk, uint32_t& row)
+	{
+		if (m_Chunks.empty() || m_Chunks.back().Count == m_ChunkCapacity)
+		{
+			uint8_t* data = (uint8_t*)MemoryTracker::Allocate(ChunkSize, MemoryTag::Scene);
+			GE_CORE_ASSERT(data, "Archetype is out of memory");
+			m_Chunks.push_back({ data, 0 });
+		}
+
+		chunk = (uint32_t)m_Chunks.size() - 1;
+		row = m_Chunks.back().Count++;
+		GetEntities(m_Chunks.back())[row] = entity;
+	}
+
+	uint32_t Archetype::AddRows(uint32_t count, uint32_t& chunk, uint32_t& row)
+	{
+		if (m_Chunks.empty() || m_Chunks.back().Count == m_ChunkCapacity)
+		{
+			uint8_t* data = (uint8_t*)MemoryTracker::Allocate(ChunkSize, MemoryTag::Scene);
+			GE_CORE_ASSERT(data, "Archetype is out of memory");
+			m_Chunks.push_back({ data, 0 });
+		}
+
+		Chunk& last = m_Chunks.back();
+		uint32_t added = std::min(count, m_ChunkCapacity - last.Count);
+		chunk = (uint32_t)m_Chunks.size() - 1;
+		row = last.Count;
+		last.Count += added;
+		return added;
+	}
+
+	Entity Archetype::RemoveRow(uint32_t chunk, uint32_t row)
+	{
+		uint32_t lastChunk = (uint32_t)m_Chunks.size() - 1;
+		Chunk& last = m_Chunks[lastChunk];
+		uint32_t lastRow = last.Count - 1;
+
+		Entity moved;
+		if (chunk != lastChunk || row != lastRow)
+		{
+			for (ComponentID id : m_Components)
+			{
+				void* destination = GetComponent(chunk, row, id);
+				void* source = GetComponent(lastChunk, lastRow, id);
+				const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+				if (info.Trivial)
+					memcpy(destination, source, info.Size);
+				else
+					info.Relocate(destination, source);
+			}
+
+			moved = GetEntities(last)[lastRow];
+			GetEntities(m_Chunks[chunk])[row] = moved;
+		}
+
+		// Empty chunks are released right away, an archetype keeps no spare memory
+		if (--last.Count == 0)
+		{
+			MemoryTracker::Free(last.Data);
+			m_Chunks.pop_back();
+		}
+		return moved;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Engine/Core/Handle.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace Engine {
+
+	struct EntityTag;
+	// Generational id of an entity in a Scene, at most Handle::MaxIndex + 1 entities live at once
+	using Entity = Handle<EntityTag>;
+
+	using ComponentID = uint32_t;
+	// Bit n is set when the component with id n is present
+	using ComponentMask = uint64_t;
+	static const uint32_t MaxComponentTypes = 64;
+
+	struct ComponentInfo
+	{
+		size_t Size;
+		size_t Alignment;
+		// Trivially copyable components are moved with memcpy and never destroyed
+		bool Trivial;
+		// Move constructs destination from source and destroys source
+		void(*Relocate)(void* destination, void* source);
+		void(*Destroy)(void* component);
+	};
+
+	// Ids are handed out on first use of a component type, in no particular order
+	class ComponentRegistry
+	{
+	public:
+		template<typename T>
+		static ComponentID GetID()
+		{
+			static const ComponentID s_ID = Register({ sizeof(T), alignof(T), std::is_trivially_copyable_v<T>,
+				[](void* destination, void* source) { new(destination) T(std::move(*(T*)source)); ((T*)source)->~T(); },
+				[](void* component) { ((T*)component)->~T(); } });
+			return s_ID;
+		}
+
+		template<typename... Ts>
+		static ComponentMask GetMask()
+		{
+			return (((ComponentMask)1 << GetID<Ts>()) | ... | 0);
+		}
+
+		static const ComponentInfo& GetInfo(ComponentID id);
+	private:
+		static ComponentID Register(const ComponentInfo& info);
+	};
+
+	// Storage of the entities that have exactly the same components. Rows live in fixed size
+	// chunks: an array of entities followed by one array per component, so a loop over some
+	// components walks contiguous memory. Every chunk but the last is full, removing a row
+	// moves the archetype's last row into the hole.
+	class Archetype
+	{
+	public:
+		static const uint32_t ChunkSize = 16 * 1024;
+
+		struct Chunk
+		{
+			uint8_t* Data;
+			uint32_t Count;
+		};
+
+		Archetype(ComponentMask mask);
+		~Archetype();
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		inline ComponentMask GetMask() const { return m_Mask; }
+		inline bool Has(ComponentID id) const { return (m_Mask & ((ComponentMask)1 << id)) != 0; }
+		inline const std::vector<ComponentID>& GetComponents() const { return m_Components; }
+
+		inline uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+		inline uint32_t GetChunkCount() const { return (uint32_t)m_Chunks.size(); }
+		inline const Chunk& GetChunk(uint32_t index) const { return m_Chunks[index]; }
+		inline uint32_t GetEntityCount() const { return m_Chunks.empty() ? 0 : (GetChunkCount() - 1) * m_ChunkCapacity + m_Chunks.back().Count; }
+
+		inline Entity* GetEntities(const Chunk& chunk) const { return (Entity*)chunk.Data; }
+
+		template<typename T>
+		T* GetArray(const Chunk& chunk) const
+		{
+			return (T*)(chunk.Data + m_Offsets[ComponentRegistry::GetID<T>()]);
+		}
+
+		inline void* GetComponent(uint32_t chunk, uint32_t row, ComponentID id) const
+		{
+			return m_Chunks[chunk].Data + m_Offsets[id] + row * m_Sizes[id];
+		}
+
+		// Appends a row for the entity, its components are left unconstructed
+		void AddRow(Entity entity, uint32_t& chunk, uint32_t& row);
+		// Appends up to count rows to the last chunk, or a new one when it is full, and returns
+		// how many were added. Their entities and components are left for the caller to write.
+		uint32_t AddRows(uint32_t count, uint32_t& chunk, uint32_t& row);
+		// Fills the row with the last one. Its components must have been destroyed or moved
+		// out. Returns the entity that was moved into the row, null if it was the last row.
+		Entity RemoveRow(uint32_t chunk, uint32_t row);
+
+		// Neighbours in the archetype graph, set the first time an entity makes the move
+		inline Archetype* GetAddEdge(ComponentID id) const { return m_AddEdges[id]; }
+		inline Archetype* GetRemoveEdge(ComponentID id) const { return m_RemoveEdges[id]; }
+		inline void SetAddEdge(ComponentID id, Archetype* archetype) { m_AddEdges[id] = archetype; }
+		inline void SetRemoveEdge(ComponentID id, Archetype* archetype) { m_RemoveEdges[id] = archetype; }
+	private:
+		uint32_t Layout(uint32_t capacity);
+	private:
+		ComponentMask m_Mask;
+		std::vector<ComponentID> m_Components;
+		// Indexed by component id, only valid for the components of this archetype
+		uint32_t m_Offsets[MaxComponentTypes] = {};
+		uint32_t m_Sizes[MaxComponentTypes] = {};
+		uint32_t m_ChunkCapacity = 0;
+		std::vector<Chunk> m_Chunks;
+
+		Archetype* m_AddEdges[MaxComponentTypes] = {};
+		Archetype* m_RemoveEdges[MaxComponentTypes] = {};
+	};
+}
\ No newline at end of file
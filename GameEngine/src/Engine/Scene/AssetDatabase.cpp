@@ -0,0 +1,912 @@
+#include "gepch.h"
+#include "AssetDatabase.h"
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/LZ4.h"
+#include "Engine/Core/MappedFile.h"
+#include "Engine/Core/PakFormat.h"
+#include "Engine/Core/VFS.h"
+#include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/Mesh.h"
+
+#include "stb_image.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+// Cooked files (<cache>/<guid in hex>.gecooked), little endian:
+//   Header:     Magic[8], Version (uint32), Type (uint32, AssetType)
+//   Texture2D:  Width, Height (uint32), Compression (uint32, PakFormat::CompressionType),
+//               stored size (uint64), RGBA8 rows with the first row at v = 0
+//   Mesh:       VertexCount, TriangleCount, SubmeshCount (uint32), bounds (6 floats),
+//               vertices (Vertex layout), triangles (Index layout), then per submesh:
+//               BaseVertex, BaseIndex, MaterialIndex, IndexCount (uint32), bounds (6 floats),
+//               sphere (4 floats), transform (16 floats), texture count (uint32) and per
+//               texture its sampler type and path (uint16 length, bytes)
+namespace Engine {
+
+	static const char s_CookedMagic[8] = { 'G', 'E', 'C', 'O', 'O', 'K', 'E', 'D' };
+	static const uint32_t s_CookedVersion = 1;
+	static const uint32_t s_RegistryVersion = 1;
+	static const uint32_t s_IndexVersion = 1;
+
+	static const char* s_RegistryName = "AssetRegistry.txt";
+	static const char* s_IndexName = "CookIndex.txt";
+
+	// The cooked layouts are copied with memcpy
+	static_assert(std::is_trivially_copyable_v<Vertex> && sizeof(Vertex) == 14 * sizeof(float), "Vertex no longer matches the cooked layout");
+	static_assert(std::is_trivially_copyable_v<Index> && sizeof(Index) == 3 * sizeof(uint32_t), "Index no longer matches the cooked layout");
+
+	// FNV-1a
+	static uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static AssetType GetTypeFromExtension(std::string extension)
+	{
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)tolower(c); });
+		if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp")
+			return AssetType::Texture2D;
+		if (extension == ".glsl")
+			return AssetType::Shader;
+		if (extension == ".fbx" || extension == ".dae" || extension == ".obj" || extension == ".gltf" || extension == ".glb" || extension == ".3ds")
+			return AssetType::Mesh;
+		return AssetType::None;
+	}
+
+	static std::string GetSetting(const AssetDatabase::ImportSettings& settings, const char* key, const char* defaultValue)
+	{
+		auto it = settings.find(key);
+		return it != settings.end() ? it->second : defaultValue;
+	}
+
+	static void WriteU32(std::string& out, uint32_t value)
+	{
+		for (uint32_t i = 0; i < 4; i++)
+			out.push_back((char)(value >> (i * 8)));
+	}
+
+	static void WriteU64(std::string& out, uint64_t value)
+	{
+		for (uint32_t i = 0; i < 8; i++)
+			out.push_back((char)(value >> (i * 8)));
+	}
+
+	static void WriteFloats(std::string& out, const float* values, size_t count)
+	{
+		out.append((const char*)values, count * sizeof(float));
+	}
+
+	static void WriteString(std::string& out, const std::string& value)
+	{
+		out.push_back((char)value.size());
+		out.push_back((char)(value.size() >> 8));
+		out.append(value, 0, 0xffff);
+	}
+
+	static void WriteCookedHeader(std::string& out, AssetType type)
+	{
+		out.append(s_CookedMagic, sizeof(s_CookedMagic));
+		WriteU32(out, s_CookedVersion);
+		WriteU32(out, (uint32_t)type);
+	}
+
+	// Reads a cooked file, every read fails once the data runs out
+	struct CookedReader
+	{
+		const uint8_t* Data;
+		size_t Size;
+		size_t Position = 0;
+
+		CookedReader(const FileBuffer& file)
+			: Data(file.GetData()), Size(file.GetSize()) {}
+
+		const uint8_t* Read(size_t size)
+		{
+			if (Size - Position < size)
+				return nullptr;
+			const uint8_t* data = Data + Position;
+			Position += size;
+			return data;
+		}
+
+		bool ReadU32(uint32_t& value)
+		{
+			const uint8_t* data = Read(4);
+			if (data)
+				value = PakFormat::ReadU32(data);
+			return data != nullptr;
+		}
+
+		bool ReadU64(uint64_t& value)
+		{
+			const uint8_t* data = Read(8);
+			if (data)
+				value = PakFormat::ReadU64(data);
+			return data != nullptr;
+		}
+
+		bool ReadFloats(float* values, size_t count)
+		{
+			const uint8_t* data = Read(count * sizeof(float));
+			if (data)
+				memcpy(values, data, count * sizeof(float));
+			return data != nullptr;
+		}
+
+		bool ReadString(std::string& value)
+		{
+			const uint8_t* length = Read(2);
+			const uint8_t* data = length ? Read(length[0] | (length[1] << 8)) : nullptr;
+			if (data)
+				value.assign((const char*)data, length[0] | (length[1] << 8));
+			return data != nullptr;
+		}
+
+		bool ReadHeader(AssetType type)
+		{
+			const uint8_t* magic = Read(sizeof(s_CookedMagic));
+			uint32_t version, storedType;
+			return magic && memcmp(magic, s_CookedMagic, sizeof(s_CookedMagic)) == 0 && ReadU32(version) && version == s_CookedVersion
+				&& ReadU32(storedType) && storedType == (uint32_t)type;
+		}
+	};
+
+	static bool CookTexture(const uint8_t* data, size_t size, const AssetDatabase::ImportSettings& settings, std::string& out)
+	{
+		int width, height, channels;
+		stbi_uc* pixels = stbi_load_from_memory(data, (int)size, &width, &height, &channels, 4);
+		if (!pixels)
+			return false;
+
+		// Same orientation as Texture2D::Create(path)
+		size_t rowSize = (size_t)width * 4;
+		size_t imageSize = rowSize * height;
+		if (GetSetting(settings, "Flip", "1") != "0")
+		{
+			for (int y = 0; y < height / 2; y++)
+				std::swap_ranges(pixels + y * rowSize, pixels + (y + 1) * rowSize, pixels + (height - 1 - y) * rowSize);
+		}
+
+		std::vector<uint8_t> compressed;
+		const uint8_t* stored = pixels;
+		size_t storedSize = imageSize;
+		PakFormat::CompressionType compression = PakFormat::CompressionType::None;
+		if (GetSetting(settings, "Compress", "1") != "0")
+		{
+			compressed.resize(LZ4::CompressBound(imageSize));
+			size_t compressedSize = LZ4::Compress(pixels, imageSize, compressed.data(), compressed.size());
+			if (compressedSize > 0 && compressedSize < imageSize)
+			{
+				stored = compressed.data();
+				storedSize = compressedSize;
+				compression = PakFormat::CompressionType::LZ4;
+			}
+		}
+
+		WriteCookedHeader(out, AssetType::Texture2D);
+		WriteU32(out, width);
+		WriteU32(out, height);
+		WriteU32(out, (uint32_t)compression);
+		WriteU64(out, storedSize);
+		out.append((const char*)stored, storedSize);
+		stbi_image_free(pixels);
+		return true;
+	}
+
+	static void WriteMesh(const MeshData& data, std::string& out)
+	{
+		WriteCookedHeader(out, AssetType::Mesh);
+		WriteU32(out, (uint32_t)data.Vertices.size());
+		WriteU32(out, (uint32_t)data.Indices.size());
+		WriteU32(out, (uint32_t)data.Submeshes.size());
+		WriteFloats(out, &data.BoundingBox.Min.x, 3);
+		WriteFloats(out, &data.BoundingBox.Max.x, 3);
+		out.append((const char*)data.Vertices.data(), data.Vertices.size() * sizeof(Vertex));
+		out.append((const char*)data.Indices.data(), data.Indices.size() * sizeof(Index));
+
+		for (const Submesh& submesh : data.Submeshes)
+		{
+			WriteU32(out, submesh.BaseVertex);
+			WriteU32(out, submesh.BaseIndex);
+			WriteU32(out, submesh.MaterialIndex);
+			WriteU32(out, submesh.IndexCount);
+			WriteFloats(out, &submesh.BoundingBox.Min.x, 3);
+			WriteFloats(out, &submesh.BoundingBox.Max.x, 3);
+			WriteFloats(out, &submesh.Sphere.Center.x, 3);
+			WriteFloats(out, &submesh.Sphere.Radius, 1);
+			WriteFloats(out, &submesh.Transform[0][0], 16);
+			WriteU32(out, (uint32_t)submesh.Texture.size());
+			for (const Tex& texture : submesh.Texture)
+			{
+				WriteString(out, texture.type);
+				WriteString(out, texture.path);
+			}
+		}
+	}
+
+	static bool ReadMesh(CookedReader& reader, MeshData& data)
+	{
+		uint32_t vertexCount, triangleCount, submeshCount;
+		if (!reader.ReadHeader(AssetType::Mesh) || !reader.ReadU32(vertexCount) || !reader.ReadU32(triangleCount) || !reader.ReadU32(submeshCount)
+			|| !reader.ReadFloats(&data.BoundingBox.Min.x, 3) || !reader.ReadFloats(&data.BoundingBox.Max.x, 3))
+			return false;
+
+		const uint8_t* vertices = reader.Read((size_t)vertexCount * sizeof(Vertex));
+		const uint8_t* triangles = vertices ? reader.Read((size_t)triangleCount * sizeof(Index)) : nullptr;
+		if (!triangles)
+			return false;
+		data.Vertices.resize(vertexCount);
+		data.Indices.resize(triangleCount);
+		memcpy(data.Vertices.data(), vertices, (size_t)vertexCount * sizeof(Vertex));
+		memcpy(data.Indices.data(), triangles, (size_t)triangleCount * sizeof(Index));
+
+		for (uint32_t i = 0; i < submeshCount; i++)
+		{
+			Submesh submesh;
+			uint32_t textureCount;
+			if (!reader.ReadU32(submesh.BaseVertex) || !reader.ReadU32(submesh.BaseIndex) || !reader.ReadU32(submesh.MaterialIndex) || !reader.ReadU32(submesh.IndexCount)
+				|| !reader.ReadFloats(&submesh.BoundingBox.Min.x, 3) || !reader.ReadFloats(&submesh.BoundingBox.Max.x, 3)
+				|| !reader.ReadFloats(&submesh.Sphere.Center.x, 3) || !reader.ReadFloats(&submesh.Sphere.Radius, 1)
+				|| !reader.ReadFloats(&submesh.Transform[0][0], 16) || !reader.ReadU32(textureCount))
+				return false;
+
+			// Draws must stay inside the buffers
+			uint64_t indexCount = (uint64_t)triangleCount * 3;
+			if (submesh.BaseIndex % 3 != 0 || submesh.IndexCount % 3 != 0 || submesh.BaseIndex > indexCount || submesh.IndexCount > indexCount - submesh.BaseIndex)
+				return false;
+			for (uint32_t t = submesh.BaseIndex / 3; t < (submesh.BaseIndex + submesh.IndexCount) / 3; t++)
+			{
+				const Index& triangle = data.Indices[t];
+				if ((uint64_t)submesh.BaseVertex + std::max({ triangle.V1, triangle.V2, triangle.V3 }) >= vertexCount)
+					return false;
+			}
+
+			for (uint32_t t = 0; t < textureCount; t++)
+			{
+				Tex texture = { 0 };
+				if (!reader.ReadString(texture.type) || !reader.ReadString(texture.path))
+					return false;
+				submesh.Texture.push_back(std::move(texture));
+			}
+			data.Submeshes.push_back(std::move(submesh));
+		}
+		return true;
+	}
+
+	// Same stages OpenGLShader accepts, a vertex stage is required
+	static bool CheckShaderStages(const std::string& source)
+	{
+		bool vertex = false;
+		for (size_t pos = source.find("#type"); pos != std::string::npos; pos = source.find("#type", pos + 1))
+		{
+			size_t begin = source.find_first_not_of(" \t", pos + 5);
+			if (begin == std::string::npos)
+				return false;
+			std::string type = source.substr(begin, source.find_first_of(" \t\r\n", begin) - begin);
+			if (type != "vertex" && type != "fragment" && type != "pixel" && type != "geometry")
+				return false;
+			vertex |= type == "vertex";
+		}
+		return vertex;
+	}
+
+	AssetDatabase::AssetDatabase(const std::string& sourceDirectory, const std::string& cacheDirectory)
+		: m_SourceDirectory(sourceDirectory), m_CacheDirectory(cacheDirectory)
+	{
+	}
+
+	bool AssetDatabase::Load()
+	{
+		GE_PROFILE_FUNCTION();
+
+		return LoadRegistry() && LoadIndex();
+	}
+
+	bool AssetDatabase::Save() const
+	{
+		GE_PROFILE_FUNCTION();
+
+		// Sorted by path, so the committed file only changes where assets do
+		std::vector<std::pair<AssetID, const Asset*>> assets;
+		for (const auto& [guid, asset] : m_Assets)
+			assets.push_back({ guid, &asset });
+		std::sort(assets.begin(), assets.end(), [](const auto& a, const auto& b) { return a.second->Path < b.second->Path; });
+
+		std::ofstream file(m_SourceDirectory + "/" + s_RegistryName);
+		file << "AssetDatabase " << s_RegistryVersion << "\n";
+		for (const auto& [guid, asset] : assets)
+		{
+			file << "Asset " << std::hex << guid << std::dec << " " << AssetTypeName(asset->Type) << " " << std::quoted(asset->Path);
+			for (const auto& [key, value] : asset->Settings)
+				file << " " << key << "=" << value;
+			file << "\n";
+		}
+		return file.good();
+	}
+
+	uint32_t AssetDatabase::Scan()
+	{
+		GE_PROFILE_FUNCTION();
+
+		// Assets whose source is gone. A new file with the content a missing asset had when it
+		// was last cooked is that asset moved, and keeps its GUID.
+		std::unordered_set<AssetID> missing;
+		std::unordered_map<uint64_t, AssetID> missingHashes;
+		for (const auto& [guid, asset] : m_Assets)
+		{
+			std::error_code error;
+			if (std::filesystem::is_regular_file(GetSourcePath(asset), error))
+				continue;
+
+			missing.insert(guid);
+			auto cooked = m_Cooked.find(guid);
+			if (cooked != m_Cooked.end() && !cooked->second.Inputs.empty())
+				missingHashes[cooked->second.Inputs[0].second] = guid;
+		}
+		for (AssetID guid : missing)
+			m_GUIDs.erase(m_Assets[guid].Path);
+
+		uint32_t added = 0;
+		std::error_code error;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(m_SourceDirectory, error))
+		{
+			AssetType type = GetTypeFromExtension(entry.path().extension().string());
+			if (type == AssetType::None || !entry.is_regular_file(error))
+				continue;
+
+			std::string path = std::filesystem::relative(entry.path(), m_SourceDirectory, error).generic_string();
+			if (m_GUIDs.find(path) != m_GUIDs.end())
+				continue;
+
+			uint64_t hash;
+			auto moved = missingHashes.empty() || !HashFile(GetSourcePath({ type, path }), hash) ? missingHashes.end() : missingHashes.find(hash);
+			if (moved != missingHashes.end() && m_Assets[moved->second].Type == type)
+			{
+				GE_CORE_INFO("AssetDatabase: '{0}' moved to '{1}'.", m_Assets[moved->second].Path, path);
+				m_Assets[moved->second].Path = path;
+				m_GUIDs[path] = moved->second;
+				missing.erase(moved->second);
+				missingHashes.erase(moved);
+				continue;
+			}
+
+			if (Register(path, type) != NullAsset)
+				added++;
+		}
+
+		for (AssetID guid : missing)
+			m_Assets.erase(guid);
+		return added;
+	}
+
+	AssetID AssetDatabase::Register(const std::string& path, AssetType type, const ImportSettings& settings)
+	{
+		auto it = m_GUIDs.find(path);
+		if (it != m_GUIDs.end())
+		{
+			const Asset& asset = m_Assets[it->second];
+			if (asset.Type == type)
+				return it->second;
+
+			GE_CORE_ERROR("AssetDatabase: '{0}' is a {1}, not a {2}.", path, AssetTypeName(asset.Type), AssetTypeName(type));
+			return NullAsset;
+		}
+
+		// Same id the AssetLibrary gave the path, unless a moved asset took it
+		AssetID guid = AssetLibrary::GetID(m_SourceDirectory + "/" + path);
+		while (m_Assets.find(guid) != m_Assets.end() || guid == NullAsset)
+			guid++;
+
+		m_Assets[guid] = { type, path, settings };
+		m_GUIDs[path] = guid;
+		return guid;
+	}
+
+	CookReport AssetDatabase::Cook()
+	{
+		GE_PROFILE_FUNCTION();
+
+		auto start = std::chrono::steady_clock::now();
+		std::error_code error;
+		std::filesystem::create_directories(m_CacheDirectory, error);
+
+		// In path order, so the cook is the same on every machine
+		std::vector<AssetID> guids;
+		guids.reserve(m_Assets.size());
+		for (const auto& [guid, asset] : m_Assets)
+			guids.push_back(guid);
+		std::sort(guids.begin(), guids.end(), [&](AssetID a, AssetID b) { return m_Assets[a].Path < m_Assets[b].Path; });
+
+		struct CookJob
+		{
+			CookedAsset Cooked;
+			bool Hit = false;
+			bool Failed = false;
+		};
+		std::vector<CookJob> jobs(guids.size());
+		m_HashedFiles = 0;
+
+		// stb_image flips by a global flag, the texture cook flips by itself
+		stbi_set_flip_vertically_on_load(0);
+		JobSystem::ParallelFor((uint32_t)guids.size(), 1, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				const Asset& asset = m_Assets.at(guids[i]);
+				uint64_t key = GetKey(asset);
+				jobs[i].Hit = IsCooked(guids[i], asset, key);
+				if (!jobs[i].Hit)
+				{
+					jobs[i].Cooked.Key = key;
+					jobs[i].Failed = !CookAsset(guids[i], asset, jobs[i].Cooked);
+				}
+			}
+		});
+
+		CookReport report;
+		for (size_t i = 0; i < guids.size(); i++)
+		{
+			if (jobs[i].Hit)
+				report.Hits++;
+			else if (jobs[i].Failed)
+			{
+				GE_CORE_ERROR("AssetDatabase: could not cook '{0}'.", GetSourcePath(m_Assets[guids[i]]));
+				report.Failures++;
+				m_Cooked.erase(guids[i]);
+			}
+			else
+			{
+				report.Misses++;
+				report.CookedBytes += jobs[i].Cooked.Size;
+				m_Cooked[guids[i]] = std::move(jobs[i].Cooked);
+			}
+		}
+
+		// Cooked data of assets that were removed
+		for (auto it = m_Cooked.begin(); it != m_Cooked.end();)
+		{
+			if (m_Assets.find(it->first) != m_Assets.end())
+			{
+				it++;
+				continue;
+			}
+			std::filesystem::remove(GetCookedPath(it->first), error);
+			it = m_Cooked.erase(it);
+		}
+
+		SaveIndex();
+
+		report.HashedFiles = m_HashedFiles;
+		report.Milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		GE_CORE_INFO("AssetDatabase: cooked {0} assets in {1:.1f} ms, {2} hits, {3} misses, {4} failed, {5} files hashed, {6} KB written",
+			guids.size(), report.Milliseconds, report.Hits, report.Misses, report.Failures, report.HashedFiles, report.CookedBytes / 1024);
+		return report;
+	}
+
+	AssetID AssetDatabase::GetGUID(const std::string& path) const
+	{
+		std::string normalized = VFS::NormalizePath(path);
+		std::string directory = VFS::NormalizePath(m_SourceDirectory);
+		if (normalized.size() > directory.size() && normalized.compare(0, directory.size(), directory) == 0 && normalized[directory.size()] == '/')
+		{
+			auto it = m_GUIDs.find(normalized.substr(directory.size() + 1));
+			if (it != m_GUIDs.end())
+				return it->second;
+		}
+		return AssetLibrary::GetID(path);
+	}
+
+	std::string AssetDatabase::GetPath(AssetID guid) const
+	{
+		auto it = m_Assets.find(guid);
+		return it != m_Assets.end() ? GetSourcePath(it->second) : std::string();
+	}
+
+	Ref<Texture2D> AssetDatabase::LoadTexture2D(const std::string& path) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		AssetID guid = FindCooked(path, AssetType::Texture2D);
+		if (guid == NullAsset)
+			return nullptr;
+
+		FileBuffer file = VFS::Read(GetCookedPath(guid));
+		CookedReader reader(file);
+		uint32_t width, height, compression;
+		uint64_t storedSize;
+		const uint8_t* stored = nullptr;
+		if (reader.ReadHeader(AssetType::Texture2D) && reader.ReadU32(width) && reader.ReadU32(height) && reader.ReadU32(compression) && reader.ReadU64(storedSize))
+			stored = reader.Read((size_t)storedSize);
+
+		uint64_t imageSize = (uint64_t)width * height * 4;
+		if (!stored || imageSize > 0xffffffff)
+		{
+			GE_CORE_ERROR("AssetDatabase: cooked data of '{0}' is corrupt.", path);
+			return nullptr;
+		}
+
+		// Uncompressed pixels are uploaded straight from the mapping
+		std::vector<uint8_t> pixels;
+		if ((PakFormat::CompressionType)compression == PakFormat::CompressionType::LZ4)
+		{
+			pixels.resize((size_t)imageSize);
+			if (!LZ4::Decompress(stored, (size_t)storedSize, pixels.data(), pixels.size()))
+			{
+				GE_CORE_ERROR("AssetDatabase: cooked data of '{0}' is corrupt.", path);
+				return nullptr;
+			}
+			stored = pixels.data();
+		}
+		else if (storedSize != imageSize)
+		{
+			GE_CORE_ERROR("AssetDatabase: cooked data of '{0}' is corrupt.", path);
+			return nullptr;
+		}
+
+		Ref<Texture2D> texture = Texture2D::Create(width, height);
+		texture->SetData((void*)stored, (uint32_t)imageSize);
+		return texture;
+	}
+
+	Ref<Mesh> AssetDatabase::LoadMesh(const std::string& path) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		AssetID guid = FindCooked(path, AssetType::Mesh);
+		if (guid == NullAsset)
+			return nullptr;
+
+		FileBuffer file = VFS::Read(GetCookedPath(guid));
+		CookedReader reader(file);
+		MeshData data;
+		if (!ReadMesh(reader, data))
+		{
+			GE_CORE_ERROR("AssetDatabase: cooked data of '{0}' is corrupt.", path);
+			return nullptr;
+		}
+		return CreateRef<Mesh>(path, std::move(data));
+	}
+
+	const std::vector<std::string>& AssetDatabase::GetDependencies(const std::string& path) const
+	{
+		static const std::vector<std::string> s_None;
+		auto it = m_Cooked.find(GetGUID(path));
+		return it != m_Cooked.end() ? it->second.Dependencies : s_None;
+	}
+
+	bool AssetDatabase::LoadRegistry()
+	{
+		m_Assets.clear();
+		m_GUIDs.clear();
+
+		std::string filepath = m_SourceDirectory + "/" + s_RegistryName;
+		FileBuffer file = VFS::Read(filepath);
+		if (!file)
+			return true;
+
+		std::istringstream stream(file.ToString());
+		std::string line;
+		uint32_t lineNumber = 0;
+		while (std::getline(stream, line))
+		{
+			lineNumber++;
+			std::istringstream words(line);
+			std::string keyword;
+			if (!(words >> keyword) || keyword[0] == '#')
+				continue;
+
+			if (keyword == "AssetDatabase")
+			{
+				uint32_t version = 0;
+				if (!(words >> version) || version > s_RegistryVersion)
+				{
+					GE_CORE_ERROR("AssetDatabase: '{0}' has an unsupported version.", filepath);
+					return false;
+				}
+				continue;
+			}
+
+			AssetID guid = NullAsset;
+			std::string typeName;
+			Asset asset;
+			if (keyword == "Asset" && words >> std::hex >> guid >> std::dec >> typeName >> std::quoted(asset.Path))
+			{
+				asset.Type = AssetTypeFromName(typeName);
+				std::string setting;
+				while (words >> setting)
+				{
+					size_t equals = setting.find('=');
+					if (equals != std::string::npos)
+						asset.Settings[setting.substr(0, equals)] = setting.substr(equals + 1);
+				}
+			}
+
+			if (guid == NullAsset || asset.Type == AssetType::None || m_Assets.find(guid) != m_Assets.end() || m_GUIDs.find(asset.Path) != m_GUIDs.end())
+			{
+				GE_CORE_ERROR("AssetDatabase: '{0}' line {1} is invalid.", filepath, lineNumber);
+				return false;
+			}
+			m_GUIDs[asset.Path] = guid;
+			m_Assets[guid] = std::move(asset);
+		}
+		return true;
+	}
+
+	bool AssetDatabase::LoadIndex()
+	{
+		m_Cooked.clear();
+		m_Stamps.clear();
+
+		// A bad index only costs a full cook
+		FileBuffer file = VFS::Read(m_CacheDirectory + "/" + s_IndexName);
+		if (!file)
+			return true;
+
+		std::istringstream stream(file.ToString());
+		std::string line;
+		CookedAsset* cooked = nullptr;
+		while (std::getline(stream, line))
+		{
+			std::istringstream words(line);
+			std::string keyword;
+			words >> keyword;
+
+			bool valid = true;
+			if (keyword == "CookIndex")
+			{
+				uint32_t version = 0;
+				if (!(words >> version) || version != s_IndexVersion)
+					break;
+			}
+			else if (keyword == "Stamp")
+			{
+				FileStamp stamp;
+				std::string path;
+				valid = (bool)(words >> stamp.Size >> stamp.Time >> std::hex >> stamp.Hash >> std::dec >> std::quoted(path));
+				if (valid)
+					m_Stamps[path] = stamp;
+			}
+			else if (keyword == "Cooked")
+			{
+				AssetID guid;
+				uint64_t key, size;
+				valid = (bool)(words >> std::hex >> guid >> key >> std::dec >> size);
+				if (valid)
+				{
+					cooked = &m_Cooked[guid];
+					cooked->Key = key;
+					cooked->Size = size;
+				}
+			}
+			else if (keyword == "Input" && cooked)
+			{
+				uint64_t hash;
+				std::string path;
+				valid = (bool)(words >> std::hex >> hash >> std::dec >> std::quoted(path));
+				if (valid)
+					cooked->Inputs.push_back({ path, hash });
+			}
+			else if (keyword == "Uses" && cooked)
+			{
+				std::string path;
+				valid = (bool)(words >> std::quoted(path));
+				if (valid)
+					cooked->Dependencies.push_back(path);
+			}
+			else if (!keyword.empty())
+				valid = false;
+
+			if (!valid)
+			{
+				GE_CORE_WARN("AssetDatabase: the cook index in '{0}' is corrupt, everything is cooked again.", m_CacheDirectory);
+				m_Cooked.clear();
+				m_Stamps.clear();
+				break;
+			}
+		}
+		return true;
+	}
+
+	bool AssetDatabase::SaveIndex() const
+	{
+		std::ofstream file(m_CacheDirectory + "/" + s_IndexName);
+		file << "CookIndex " << s_IndexVersion << "\n";
+
+		// Only the stamps of files that are still inputs
+		std::unordered_set<std::string> inputs;
+		for (const auto& [guid, cooked] : m_Cooked)
+		{
+			for (const auto& [path, hash] : cooked.Inputs)
+				inputs.insert(path);
+		}
+		for (const auto& [path, stamp] : m_Stamps)
+		{
+			if (inputs.find(path) != inputs.end())
+				file << "Stamp " << stamp.Size << " " << stamp.Time << " " << std::hex << stamp.Hash << std::dec << " " << std::quoted(path) << "\n";
+		}
+
+		for (const auto& [guid, cooked] : m_Cooked)
+		{
+			file << "Cooked " << std::hex << guid << " " << cooked.Key << std::dec << " " << cooked.Size << "\n";
+			for (const auto& [path, hash] : cooked.Inputs)
+				file << "\tInput " << std::hex << hash << std::dec << " " << std::quoted(path) << "\n";
+			for (const std::string& path : cooked.Dependencies)
+				file << "\tUses " << std::quoted(path) << "\n";
+		}
+		return file.good();
+	}
+
+	uint64_t AssetDatabase::GetKey(const Asset& asset)
+	{
+		std::string key = std::string(AssetTypeName(asset.Type)) + " " + std::to_string(s_CookedVersion);
+		for (const auto& [name, value] : asset.Settings)
+			key += " " + name + "=" + value;
+		return HashBytes(key.data(), key.size());
+	}
+
+	bool AssetDatabase::IsCooked(AssetID guid, const Asset& asset, uint64_t key)
+	{
+		auto it = m_Cooked.find(guid);
+		if (it == m_Cooked.end() || it->second.Key != key || it->second.Inputs.empty() || it->second.Inputs[0].first != GetSourcePath(asset))
+			return false;
+
+		if (it->second.Size > 0)
+		{
+			std::error_code error;
+			if (std::filesystem::file_size(GetCookedPath(guid), error) != it->second.Size)
+				return false;
+		}
+
+		for (const auto& [path, hash] : it->second.Inputs)
+		{
+			uint64_t current;
+			if (!HashFile(path, current) || current != hash)
+				return false;
+		}
+		return true;
+	}
+
+	bool AssetDatabase::CookAsset(AssetID guid, const Asset& asset, CookedAsset& cooked)
+	{
+		GE_PROFILE_FUNCTION();
+
+		std::string sourcePath = GetSourcePath(asset);
+		uint64_t sourceHash;
+		Ref<MappedFile> source = MappedFile::Open(sourcePath);
+		if (!source || !HashFile(sourcePath, sourceHash))
+			return false;
+		cooked.Inputs = { { sourcePath, sourceHash } };
+		cooked.Dependencies.clear();
+
+		std::string out;
+		switch (asset.Type)
+		{
+			case AssetType::Texture2D:
+			{
+				if (!CookTexture(source->GetData(), source->GetSize(), asset.Settings, out))
+					return false;
+				break;
+			}
+			case AssetType::Shader:
+			{
+				if (!CheckShaderStages(std::string((const char*)source->GetData(), source->GetSize())))
+					return false;
+				break;
+			}
+			case AssetType::Mesh:
+			{
+				// Animated meshes and files Assimp can't read load from source
+				MeshData data;
+				std::vector<std::string> reads;
+				if (!Mesh::Import(sourcePath, data, reads))
+					break;
+
+				for (const std::string& path : reads)
+				{
+					uint64_t hash;
+					if (!HashFile(path, hash))
+						return false;
+					cooked.Inputs.push_back({ path, hash });
+				}
+
+				std::string directory = sourcePath.substr(0, sourcePath.find_last_of('/'));
+				for (const Submesh& submesh : data.Submeshes)
+				{
+					for (const Tex& texture : submesh.Texture)
+					{
+						std::string path = directory + '/' + texture.path;
+						if (std::find(cooked.Dependencies.begin(), cooked.Dependencies.end(), path) == cooked.Dependencies.end())
+							cooked.Dependencies.push_back(path);
+					}
+				}
+				WriteMesh(data, out);
+				break;
+			}
+			case AssetType::None:
+				return false;
+		}
+
+		cooked.Size = out.size();
+		std::string cookedPath = GetCookedPath(guid);
+		std::error_code error;
+		if (out.empty())
+		{
+			std::filesystem::remove(cookedPath, error);
+			return true;
+		}
+
+		// Written under another name first, an interrupted cook must not leave a valid looking file
+		std::string temporaryPath = cookedPath + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::binary);
+			file.write(out.data(), out.size());
+			if (!file.good())
+				return false;
+		}
+		std::filesystem::rename(temporaryPath, cookedPath, error);
+		return !error;
+	}
+
+	bool AssetDatabase::HashFile(const std::string& path, uint64_t& hash)
+	{
+		std::error_code error;
+		uint64_t size = std::filesystem::file_size(path, error);
+		if (error)
+			return false;
+		int64_t time = (int64_t)std::filesystem::last_write_time(path, error).time_since_epoch().count();
+		if (error)
+			return false;
+
+		{
+			std::lock_guard<std::mutex> lock(m_StampMutex);
+			auto it = m_Stamps.find(path);
+			if (it != m_Stamps.end() && it->second.Size == size && it->second.Time == time)
+			{
+				hash = it->second.Hash;
+				return true;
+			}
+		}
+
+		Ref<MappedFile> file = MappedFile::Open(path);
+		if (!file)
+			return false;
+		hash = HashBytes(file->GetData(), file->GetSize());
+
+		std::lock_guard<std::mutex> lock(m_StampMutex);
+		m_Stamps[path] = { size, time, hash };
+		m_HashedFiles++;
+		return true;
+	}
+
+	std::string AssetDatabase::GetSourcePath(const Asset& asset) const
+	{
+		return m_SourceDirectory + "/" + asset.Path;
+	}
+
+	std::string AssetDatabase::GetCookedPath(AssetID guid) const
+	{
+		std::ostringstream path;
+		path << m_CacheDirectory << "/" << std::hex << std::setw(16) << std::setfill('0') << guid << ".gecooked";
+		return path.str();
+	}
+
+	AssetID AssetDatabase::FindCooked(const std::string& path, AssetType type) const
+	{
+		AssetID guid = GetGUID(path);
+		auto asset = m_Assets.find(guid);
+		auto cooked = m_Cooked.find(guid);
+		if (asset == m_Assets.end() || asset->second.Type != type || cooked == m_Cooked.end() || cooked->second.Size == 0 || cooked->second.Key != GetKey(asset->second))
+			return NullAsset;
+		return guid;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Engine/Scene/AssetLibrary.h"
+
+#include <map>
+#include <mutex>
+
+namespace Engine {
+
+	struct CookReport
+	{
+		// Assets whose cooked output was still valid
+		uint32_t Hits = 0;
+		// Assets cooked because an input changed or nothing was cached
+		uint32_t Misses = 0;
+		uint32_t Failures = 0;
+		// Files read to hash, the others were unchanged by size and write time
+		uint32_t HashedFiles = 0;
+		uint64_t CookedBytes = 0;
+		float Milliseconds = 0.0f;
+	};
+
+	// Registry of the source assets of a directory and a cache of their cooked data.
+	//
+	// Every asset has a GUID that stays the same when it is moved, kept with its import
+	// settings in a registry file in the source directory that is committed with the assets:
+	//   AssetDatabase 1
+	//   Asset <guid in hex> <Texture2D|Shader|Mesh> "<path>" [<setting>=<value> ...]
+	// Scan() registers new files under AssetLibrary::GetID() of their path, so scenes saved
+	// before an asset was registered still find it.
+	//
+	// Cook() turns sources into what the loaders use at runtime: textures are decoded to RGBA8
+	// and stored LZ4 compressed, static meshes are stored imported and post processed. An
+	// asset is only cooked again when its settings or the content of one of its inputs changed,
+	// inputs being the source and every other file the import read, like a mesh's material
+	// library. The textures a mesh refers to are recorded as its dependencies. Cooking runs on
+	// the JobSystem, one asset per job. Cooked files and the hashes of their inputs are kept in
+	// the cache directory, which is not committed.
+	//
+	// Shaders are hashed and have their stages checked, so edits show up in the report, but
+	// still load from source: OpenGL program binaries only exist for one driver and context.
+	class AssetDatabase
+	{
+	public:
+		using ImportSettings = std::map<std::string, std::string>;
+
+		AssetDatabase(const std::string& sourceDirectory, const std::string& cacheDirectory);
+
+		// Reads the registry and the cache index, missing files leave them empty
+		bool Load();
+		bool Save() const;
+
+		// Registers the files with a known extension that aren't registered yet and drops
+		// assets whose source is gone. Returns the number of new assets.
+		uint32_t Scan();
+		// Paths are relative to the source directory. Returns the GUID, NullAsset on a type clash.
+		AssetID Register(const std::string& path, AssetType type, const ImportSettings& settings = {});
+
+		// Cooks the assets whose inputs changed and saves the cache index
+		CookReport Cook();
+
+		// GUID of a path relative to the working directory, AssetLibrary::GetID() for
+		// unregistered paths
+		AssetID GetGUID(const std::string& path) const;
+		// Current path of an asset relative to the working directory, empty for unknown GUIDs
+		std::string GetPath(AssetID guid) const;
+		// nullptr when the asset has no valid cooked data
+		Ref<Texture2D> LoadTexture2D(const std::string& path) const;
+		Ref<Mesh> LoadMesh(const std::string& path) const;
+
+		// Runtime dependencies found by the last cook, see CookedAsset
+		const std::vector<std::string>& GetDependencies(const std::string& path) const;
+
+		inline const std::string& GetSourceDirectory() const { return m_SourceDirectory; }
+		inline uint32_t GetCount() const { return (uint32_t)m_Assets.size(); }
+	private:
+		struct Asset
+		{
+			AssetType Type = AssetType::None;
+			// Relative to the source directory
+			std::string Path;
+			ImportSettings Settings;
+		};
+
+		struct CookedAsset
+		{
+			// Hash of the type, settings and cooker version
+			uint64_t Key = 0;
+			// Path and content hash of every file the cook read, the source first
+			std::vector<std::pair<std::string, uint64_t>> Inputs;
+			// Files the asset loads at runtime without them being cooked into it, like the
+			// textures of a mesh
+			std::vector<std::string> Dependencies;
+			// Of the cooked file, 0 for assets that load from source
+			uint64_t Size = 0;
+		};
+
+		// Content hash of a file, reused while its size and write time don't change
+		struct FileStamp
+		{
+			uint64_t Size = 0;
+			int64_t Time = 0;
+			uint64_t Hash = 0;
+		};
+
+		bool LoadRegistry();
+		bool LoadIndex();
+		bool SaveIndex() const;
+
+		static uint64_t GetKey(const Asset& asset);
+		bool IsCooked(AssetID guid, const Asset& asset, uint64_t key);
+		bool CookAsset(AssetID guid, const Asset& asset, CookedAsset& cooked);
+		// Hashes a file through the stamp cache, false when it can't be read
+		bool HashFile(const std::string& path, uint64_t& hash);
+
+		std::string GetSourcePath(const Asset& asset) const;
+		std::string GetCookedPath(AssetID guid) const;
+		// NullAsset unless the asset has a cooked file made with its current settings
+		AssetID FindCooked(const std::string& path, AssetType type) const;
+	private:
+		std::string m_SourceDirectory;
+		std::string m_CacheDirectory;
+
+		std::unordered_map<AssetID, Asset> m_Assets;
+		std::unordered_map<std::string, AssetID> m_GUIDs;
+		std::unordered_map<AssetID, CookedAsset> m_Cooked;
+
+		// Shared by the cook jobs
+		std::unordered_map<std::string, FileStamp> m_Stamps;
+		std::mutex m_StampMutex;
+		uint32_t m_HashedFiles = 0;
+	};
+}
\ No newline at end of file
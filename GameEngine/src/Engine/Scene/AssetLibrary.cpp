@@ -0,0 +1,196 @@
+#include "gepch.h"
+#include "AssetLibrary.h"
+
+#include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/Mesh.h"
+#include "Engine/Scene/AssetDatabase.h"
+
+namespace Engine {
+
+	const char* AssetTypeName(AssetType type)
+	{
+		switch (type)
+		{
+			case AssetType::Texture2D:	return "Texture2D";
+			case AssetType::Shader:		return "Shader";
+			case AssetType::Mesh:		return "Mesh";
+			case AssetType::None:		break;
+		}
+		return "None";
+	}
+
+	AssetType AssetTypeFromName(const std::string& name)
+	{
+		if (name == "Texture2D")
+			return AssetType::Texture2D;
+		if (name == "Shader")
+			return AssetType::Shader;
+		if (name == "Mesh")
+			return AssetType::Mesh;
+		return AssetType::None;
+	}
+
+	AssetID AssetLibrary::GetID(const std::string& path)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : path)
+		{
+			hash ^= (uint8_t)(c == '\\' ? '/' : c);
+			hash *= 1099511628211ull;
+		}
+		return hash != NullAsset ? hash : 1;
+	}
+
+	Ref<Texture2D> AssetLibrary::LoadTexture2D(const std::string& path)
+	{
+		AssetID id = GetAssetID(path);
+		return Register(id, AssetType::Texture2D, path) ? GetTexture2D(id) : nullptr;
+	}
+
+	Ref<Shader> AssetLibrary::LoadShader(const std::string& path)
+	{
+		AssetID id = GetAssetID(path);
+		return Register(id, AssetType::Shader, path) ? GetShader(id) : nullptr;
+	}
+
+	Ref<Mesh> AssetLibrary::LoadMesh(const std::string& path)
+	{
+		AssetID id = GetAssetID(path);
+		return Register(id, AssetType::Mesh, path) ? GetMesh(id) : nullptr;
+	}
+
+	AssetID AssetLibrary::Add(const std::string& path, const Ref<Texture2D>& texture)
+	{
+		return Insert(path, AssetType::Texture2D, texture);
+	}
+
+	AssetID AssetLibrary::Add(const std::string& path, const Ref<Shader>& shader)
+	{
+		return Insert(path, AssetType::Shader, shader);
+	}
+
+	AssetID AssetLibrary::Add(const std::string& path, const Ref<Mesh>& mesh)
+	{
+		return Insert(path, AssetType::Mesh, mesh);
+	}
+
+	bool AssetLibrary::Register(AssetID id, AssetType type, const std::string& path)
+	{
+		GE_CORE_ASSERT(id != NullAsset && type != AssetType::None, "Invalid asset");
+
+		auto it = m_Entries.find(id);
+		if (it != m_Entries.end())
+		{
+			if (it->second.Type == type)
+				return true;
+
+			GE_CORE_ERROR("AssetLibrary: '{0}' is a {1}, not a {2}.", it->second.Path, AssetTypeName(it->second.Type), AssetTypeName(type));
+			return false;
+		}
+
+		Entry& entry = m_Entries[id];
+		entry.Type = type;
+		entry.Path = path;
+		return true;
+	}
+
+	Ref<Texture2D> AssetLibrary::GetTexture2D(AssetID id)
+	{
+		Entry* entry = GetEntry(id, AssetType::Texture2D);
+		return entry ? std::static_pointer_cast<Texture2D>(entry->Asset) : nullptr;
+	}
+
+	Ref<Shader> AssetLibrary::GetShader(AssetID id)
+	{
+		Entry* entry = GetEntry(id, AssetType::Shader);
+		return entry ? std::static_pointer_cast<Shader>(entry->Asset) : nullptr;
+	}
+
+	Ref<Mesh> AssetLibrary::GetMesh(AssetID id)
+	{
+		Entry* entry = GetEntry(id, AssetType::Mesh);
+		return entry ? std::static_pointer_cast<Mesh>(entry->Asset) : nullptr;
+	}
+
+	AssetID AssetLibrary::Find(const void* asset) const
+	{
+		auto it = m_IDs.find(asset);
+		return it != m_IDs.end() ? it->second : NullAsset;
+	}
+
+	AssetType AssetLibrary::GetType(AssetID id) const
+	{
+		auto it = m_Entries.find(id);
+		return it != m_Entries.end() ? it->second.Type : AssetType::None;
+	}
+
+	const std::string& AssetLibrary::GetPath(AssetID id) const
+	{
+		static const std::string s_Empty;
+		auto it = m_Entries.find(id);
+		return it != m_Entries.end() ? it->second.Path : s_Empty;
+	}
+
+	AssetLibrary::Entry* AssetLibrary::GetEntry(AssetID id, AssetType type)
+	{
+		auto it = m_Entries.find(id);
+		if (it == m_Entries.end() || it->second.Type != type)
+			return nullptr;
+
+		if (!it->second.Asset)
+			Load(id, it->second);
+		return &it->second;
+	}
+
+	AssetID AssetLibrary::Insert(const std::string& path, AssetType type, const Ref<void>& asset)
+	{
+		AssetID id = GetAssetID(path);
+		if (!Register(id, type, path))
+			return NullAsset;
+
+		Entry& entry = m_Entries[id];
+		if (entry.Asset)
+			m_IDs.erase(entry.Asset.get());
+		entry.Asset = asset;
+		m_IDs[asset.get()] = id;
+		return id;
+	}
+
+	void AssetLibrary::Load(AssetID id, Entry& entry)
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_Database)
+		{
+			// Scenes keep the path an asset had when they were saved, the GUID follows moves
+			std::string path = m_Database->GetPath(id);
+			if (!path.empty())
+				entry.Path = path;
+
+			if (entry.Type == AssetType::Texture2D)
+				entry.Asset = m_Database->LoadTexture2D(entry.Path);
+			else if (entry.Type == AssetType::Mesh)
+				entry.Asset = m_Database->LoadMesh(entry.Path);
+		}
+
+		if (!entry.Asset)
+		{
+			switch (entry.Type)
+			{
+				case AssetType::Texture2D:	entry.Asset = Texture2D::Create(entry.Path); break;
+				case AssetType::Shader:		entry.Asset = Shader::Create(entry.Path); break;
+				case AssetType::Mesh:		entry.Asset = CreateRef<Mesh>(entry.Path); break;
+				case AssetType::None:		break;
+			}
+		}
+
+		if (entry.Asset)
+			m_IDs[entry.Asset.get()] = id;
+	}
+
+	AssetID AssetLibrary::GetAssetID(const std::string& path) const
+	{
+		return m_Database ? m_Database->GetGUID(path) : GetID(path);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace Engine {
+
+	class Texture2D;
+	class Shader;
+	class Mesh;
+	class AssetDatabase;
+
+	// Stable id of an asset, saved scenes refer to assets by it
+	using AssetID = uint64_t;
+	static const AssetID NullAsset = 0;
+
+	enum class AssetType : uint8_t
+	{
+		None = 0,
+		Texture2D = 1,
+		Shader = 2,
+		Mesh = 3
+	};
+
+	const char* AssetTypeName(AssetType type);
+	// AssetType::None for unknown names
+	AssetType AssetTypeFromName(const std::string& name);
+
+	// Textures, shaders and meshes shared by everything that refers to them, each loaded once.
+	// An asset's id is derived from its path, so it is the same in every run and on every
+	// machine. Main thread only, like the renderer that creates the assets.
+	class AssetLibrary
+	{
+	public:
+		// FNV-1a of the path with '/' separators
+		static AssetID GetID(const std::string& path);
+
+		Ref<Texture2D> LoadTexture2D(const std::string& path);
+		Ref<Shader> LoadShader(const std::string& path);
+		Ref<Mesh> LoadMesh(const std::string& path);
+
+		// Assets created in code, known by the path they are saved under
+		AssetID Add(const std::string& path, const Ref<Texture2D>& texture);
+		AssetID Add(const std::string& path, const Ref<Shader>& shader);
+		AssetID Add(const std::string& path, const Ref<Mesh>& mesh);
+
+		// Makes an asset known without loading it, Get*() loads it on first use. Returns false
+		// when the id already belongs to an asset of another type.
+		bool Register(AssetID id, AssetType type, const std::string& path);
+
+		// nullptr when the id is unknown or names an asset of another type
+		Ref<Texture2D> GetTexture2D(AssetID id);
+		Ref<Shader> GetShader(AssetID id);
+		Ref<Mesh> GetMesh(AssetID id);
+
+		// Id of an asset that was loaded or added here, NullAsset otherwise
+		AssetID Find(const void* asset) const;
+		AssetType GetType(AssetID id) const;
+		const std::string& GetPath(AssetID id) const;
+
+		inline uint32_t GetCount() const { return (uint32_t)m_Entries.size(); }
+
+		// Ids then come from the database's GUIDs, and assets load from its cooked data when
+		// there is any. Set before anything is loaded.
+		inline void SetDatabase(const AssetDatabase* database) { m_Database = database; }
+	private:
+		struct Entry
+		{
+			AssetType Type = AssetType::None;
+			std::string Path;
+			// Null until loaded
+			Ref<void> Asset;
+		};
+
+		Entry* GetEntry(AssetID id, AssetType type);
+		AssetID Insert(const std::string& path, AssetType type, const Ref<void>& asset);
+		void Load(AssetID id, Entry& entry);
+		AssetID GetAssetID(const std::string& path) const;
+	private:
+		std::unordered_map<AssetID, Entry> m_Entries;
+		std::unordered_map<const void*, AssetID> m_IDs;
+		const AssetDatabase* m_Database = nullptr;
+	};
+}
\ No newline at end of file
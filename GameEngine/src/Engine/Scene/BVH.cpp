@@ -0,0 +1,826 @@
+#include "gepch.h"
+#include "BVH.h"
+#include "Engine/Debug/MemoryTracker.h"
+
+namespace Engine {
+
+	// Traversal stack depth, balanced trees of a few million leaves stay far below this
+	static const uint32_t s_MaxStackDepth = 256;
+
+	struct SAHSplit
+	{
+		uint32_t LeftCount;
+		float Cost;
+	};
+
+	// Binned SAH over the centroid bounds. Reorders indices so the left side comes first.
+	// Cost is count * area summed over both sides, without the traversal cost.
+	static SAHSplit PartitionSAH(const std::vector<AABB>& boxes, const std::vector<glm::vec3>& centroids, uint32_t* indices, uint32_t count)
+	{
+		static const uint32_t BinCount = 12;
+
+		AABB centroidBounds;
+		for (uint32_t i = 0; i < count; i++)
+			centroidBounds.Expand(centroids[indices[i]]);
+
+		glm::vec3 size = centroidBounds.Max - centroidBounds.Min;
+		int axis = 0;
+		if (size.y > size[axis]) axis = 1;
+		if (size.z > size[axis]) axis = 2;
+
+		float minCentroid = centroidBounds.Min[axis];
+		if (size[axis] <= 0.0f)
+			return { count / 2, FLT_MAX };
+
+		float scale = BinCount / size[axis];
+		auto binOf = [&](uint32_t index)
+		{
+			uint32_t bin = (uint32_t)((centroids[index][axis] - minCentroid) * scale);
+			return bin < BinCount ? bin : BinCount - 1;
+		};
+
+		AABB binBoxes[BinCount];
+		uint32_t binCounts[BinCount] = {};
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t bin = binOf(indices[i]);
+			binBoxes[bin].Expand(boxes[indices[i]]);
+			binCounts[bin]++;
+		}
+
+		// Sweep from the right, then from the left, to get the cost of each of the BinCount - 1 planes
+		float rightCosts[BinCount - 1];
+		AABB accumulated;
+		uint32_t accumulatedCount = 0;
+		for (uint32_t plane = BinCount - 1; plane > 0; plane--)
+		{
+			accumulated.Expand(binBoxes[plane]);
+			accumulatedCount += binCounts[plane];
+			rightCosts[plane - 1] = accumulatedCount ? accumulatedCount * accumulated.GetSurfaceArea() : 0.0f;
+		}
+
+		SAHSplit best = { 0, FLT_MAX };
+		uint32_t bestPlane = 0;
+		accumulated = AABB();
+		accumulatedCount = 0;
+		for (uint32_t plane = 0; plane < BinCount - 1; plane++)
+		{
+			accumulated.Expand(binBoxes[plane]);
+			accumulatedCount += binCounts[plane];
+			float leftCost = accumulatedCount ? accumulatedCount * accumulated.GetSurfaceArea() : 0.0f;
+			float cost = leftCost + rightCosts[plane];
+			if (accumulatedCount > 0 && accumulatedCount < count && cost < best.Cost)
+			{
+				best = { accumulatedCount, cost };
+				bestPlane = plane;
+			}
+		}
+
+		if (best.LeftCount == 0)
+			return { count / 2, FLT_MAX };
+
+		std::partition(indices, indices + count, [&](uint32_t index) { return binOf(index) <= bestPlane; });
+		return best;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// DynamicBVH ///////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	DynamicBVH::DynamicBVH(float margin)
+		: m_Margin(margin)
+	{
+	}
+
+	uint32_t DynamicBVH::Insert(const AABB& box, uint32_t userData)
+	{
+		uint32_t leaf = AllocateNode();
+		Node& node = m_Nodes[leaf];
+		node.Box = AABB(box.Min - glm::vec3(m_Margin), box.Max + glm::vec3(m_Margin));
+		node.UserData = userData;
+		node.Height = 0;
+
+		InsertLeaf(leaf);
+		m_ProxyCount++;
+		return leaf;
+	}
+
+	void DynamicBVH::Remove(uint32_t proxy)
+	{
+		GE_CORE_ASSERT(proxy < m_Nodes.size() && m_Nodes[proxy].IsLeaf(), "Invalid BVH proxy");
+
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		m_ProxyCount--;
+	}
+
+	bool DynamicBVH::Move(uint32_t proxy, const AABB& box)
+	{
+		GE_CORE_ASSERT(proxy < m_Nodes.size() && m_Nodes[proxy].IsLeaf(), "Invalid BVH proxy");
+
+		if (m_Nodes[proxy].Box.Contains(box))
+			return false;
+
+		RemoveLeaf(proxy);
+		m_Nodes[proxy].Box = AABB(box.Min - glm::vec3(m_Margin), box.Max + glm::vec3(m_Margin));
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	void DynamicBVH::Rebuild()
+	{
+		GE_PROFILE_FUNCTION();
+		GE_MEMORY_TAG(MemoryTag::Scene);
+
+		if (m_ProxyCount < 2)
+			return;
+
+		// Keep the leaves so proxy ids stay valid, drop every inner node
+		std::vector<uint32_t> leaves;
+		leaves.reserve(m_ProxyCount);
+		for (uint32_t i = 0; i < m_Nodes.size(); i++)
+		{
+			if (m_Nodes[i].Height < 0)
+				continue;
+
+			if (m_Nodes[i].IsLeaf())
+				leaves.push_back(i);
+			else
+				FreeNode(i);
+		}
+
+		std::vector<AABB> boxes(leaves.size());
+		std::vector<glm::vec3> centroids(leaves.size());
+		std::vector<uint32_t> indices(leaves.size());
+		for (uint32_t i = 0; i < leaves.size(); i++)
+		{
+			boxes[i] = m_Nodes[leaves[i]].Box;
+			centroids[i] = boxes[i].GetCenter();
+			indices[i] = i;
+		}
+
+		m_Root = BuildSAH(leaves, boxes, centroids, indices.data(), (uint32_t)indices.size());
+		m_Nodes[m_Root].Parent = Null;
+	}
+
+	void DynamicBVH::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = Null;
+		m_FreeList = Null;
+		m_ProxyCount = 0;
+	}
+
+	void DynamicBVH::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& results) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_Root == Null)
+			return;
+
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = m_Root;
+
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+
+			Frustum::Containment containment = frustum.Classify(node.Box);
+			if (containment == Frustum::Containment::Outside)
+				continue;
+
+			if (node.IsLeaf())
+			{
+				results.push_back(node.UserData);
+			}
+			else if (containment == Frustum::Containment::Inside)
+			{
+				CollectLeaves(node.Child1, results);
+				CollectLeaves(node.Child2, results);
+			}
+			else
+			{
+				GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+				stack[stackSize++] = node.Child1;
+				stack[stackSize++] = node.Child2;
+			}
+		}
+	}
+
+	void DynamicBVH::QueryAABB(const AABB& box, std::vector<uint32_t>& results) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_Root == Null)
+			return;
+
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = m_Root;
+
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+			if (!node.Box.Overlaps(box))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				results.push_back(node.UserData);
+			}
+			else
+			{
+				GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+				stack[stackSize++] = node.Child1;
+				stack[stackSize++] = node.Child2;
+			}
+		}
+	}
+
+	bool DynamicBVH::RayCast(const Ray& ray, float maxDistance, RayCastHit& hit) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_Root == Null)
+			return false;
+
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = m_Root;
+
+		bool found = false;
+		float closest = maxDistance;
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+
+			float distance;
+			if (!ray.Intersects(node.Box, closest, distance))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				closest = distance;
+				hit.UserData = node.UserData;
+				hit.Distance = distance;
+				found = true;
+			}
+			else
+			{
+				GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+				stack[stackSize++] = node.Child1;
+				stack[stackSize++] = node.Child2;
+			}
+		}
+		return found;
+	}
+
+	uint32_t DynamicBVH::AllocateNode()
+	{
+		GE_MEMORY_TAG(MemoryTag::Scene);
+
+		uint32_t index;
+		if (m_FreeList == Null)
+		{
+			index = (uint32_t)m_Nodes.size();
+			m_Nodes.emplace_back();
+		}
+		else
+		{
+			index = m_FreeList;
+			m_FreeList = m_Nodes[index].Next;
+			m_Nodes[index] = Node();
+		}
+		return index;
+	}
+
+	void DynamicBVH::FreeNode(uint32_t node)
+	{
+		m_Nodes[node].Next = m_FreeList;
+		m_Nodes[node].Height = -1;
+		m_FreeList = node;
+	}
+
+	void DynamicBVH::InsertLeaf(uint32_t leaf)
+	{
+		if (m_Root == Null)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = Null;
+			return;
+		}
+
+		// Walk down to the sibling with the lowest surface area increase
+		AABB leafBox = m_Nodes[leaf].Box;
+		uint32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const Node& node = m_Nodes[index];
+			float area = node.Box.GetSurfaceArea();
+			float combinedArea = AABB::Union(node.Box, leafBox).GetSurfaceArea();
+
+			// Cost of a new parent for this node and the leaf
+			float cost = 2.0f * combinedArea;
+			// Minimum cost of pushing the leaf further down
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](uint32_t child)
+			{
+				const Node& childNode = m_Nodes[child];
+				float childArea = AABB::Union(childNode.Box, leafBox).GetSurfaceArea();
+				if (!childNode.IsLeaf())
+					childArea -= childNode.Box.GetSurfaceArea();
+				return childArea + inheritanceCost;
+			};
+
+			float cost1 = descendCost(node.Child1);
+			float cost2 = descendCost(node.Child2);
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? node.Child1 : node.Child2;
+		}
+
+		uint32_t sibling = index;
+		uint32_t oldParent = m_Nodes[sibling].Parent;
+		uint32_t newParent = AllocateNode();
+
+		Node& parent = m_Nodes[newParent];
+		parent.Parent = oldParent;
+		parent.Box = AABB::Union(leafBox, m_Nodes[sibling].Box);
+		parent.Height = m_Nodes[sibling].Height + 1;
+		parent.Child1 = sibling;
+		parent.Child2 = leaf;
+
+		if (oldParent != Null)
+		{
+			if (m_Nodes[oldParent].Child1 == sibling)
+				m_Nodes[oldParent].Child1 = newParent;
+			else
+				m_Nodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			m_Root = newParent;
+		}
+
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		RefitUpwards(newParent);
+	}
+
+	void DynamicBVH::RemoveLeaf(uint32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = Null;
+			return;
+		}
+
+		uint32_t parent = m_Nodes[leaf].Parent;
+		uint32_t grandParent = m_Nodes[parent].Parent;
+		uint32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		if (grandParent != Null)
+		{
+			// Replace the parent with the sibling
+			if (m_Nodes[grandParent].Child1 == parent)
+				m_Nodes[grandParent].Child1 = sibling;
+			else
+				m_Nodes[grandParent].Child2 = sibling;
+
+			m_Nodes[sibling].Parent = grandParent;
+			FreeNode(parent);
+			RefitUpwards(grandParent);
+		}
+		else
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = Null;
+			FreeNode(parent);
+		}
+	}
+
+	void DynamicBVH::RefitUpwards(uint32_t node)
+	{
+		uint32_t index = node;
+		while (index != Null)
+		{
+			index = Balance(index);
+
+			Node& current = m_Nodes[index];
+			const Node& child1 = m_Nodes[current.Child1];
+			const Node& child2 = m_Nodes[current.Child2];
+			current.Height = 1 + std::max(child1.Height, child2.Height);
+			current.Box = AABB::Union(child1.Box, child2.Box);
+
+			index = current.Parent;
+		}
+	}
+
+	// Rotates the taller child up if the subtree heights differ by more than one.
+	// Returns the node that is now at the position of nodeA.
+	uint32_t DynamicBVH::Balance(uint32_t nodeA)
+	{
+		Node& a = m_Nodes[nodeA];
+		if (a.IsLeaf() || a.Height < 2)
+			return nodeA;
+
+		uint32_t nodeB = a.Child1;
+		uint32_t nodeC = a.Child2;
+		Node& b = m_Nodes[nodeB];
+		Node& c = m_Nodes[nodeC];
+
+		int32_t balance = c.Height - b.Height;
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			uint32_t nodeF = c.Child1;
+			uint32_t nodeG = c.Child2;
+			Node& f = m_Nodes[nodeF];
+			Node& g = m_Nodes[nodeG];
+
+			c.Child1 = nodeA;
+			c.Parent = a.Parent;
+			a.Parent = nodeC;
+
+			if (c.Parent != Null)
+			{
+				if (m_Nodes[c.Parent].Child1 == nodeA)
+					m_Nodes[c.Parent].Child1 = nodeC;
+				else
+					m_Nodes[c.Parent].Child2 = nodeC;
+			}
+			else
+			{
+				m_Root = nodeC;
+			}
+
+			if (f.Height > g.Height)
+			{
+				c.Child2 = nodeF;
+				a.Child2 = nodeG;
+				g.Parent = nodeA;
+				a.Box = AABB::Union(b.Box, g.Box);
+				c.Box = AABB::Union(a.Box, f.Box);
+				a.Height = 1 + std::max(b.Height, g.Height);
+				c.Height = 1 + std::max(a.Height, f.Height);
+			}
+			else
+			{
+				c.Child2 = nodeG;
+				a.Child2 = nodeF;
+				f.Parent = nodeA;
+				a.Box = AABB::Union(b.Box, f.Box);
+				c.Box = AABB::Union(a.Box, g.Box);
+				a.Height = 1 + std::max(b.Height, f.Height);
+				c.Height = 1 + std::max(a.Height, g.Height);
+			}
+			return nodeC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			uint32_t nodeD = b.Child1;
+			uint32_t nodeE = b.Child2;
+			Node& d = m_Nodes[nodeD];
+			Node& e = m_Nodes[nodeE];
+
+			b.Child1 = nodeA;
+			b.Parent = a.Parent;
+			a.Parent = nodeB;
+
+			if (b.Parent != Null)
+			{
+				if (m_Nodes[b.Parent].Child1 == nodeA)
+					m_Nodes[b.Parent].Child1 = nodeB;
+				else
+					m_Nodes[b.Parent].Child2 = nodeB;
+			}
+			else
+			{
+				m_Root = nodeB;
+			}
+
+			if (d.Height > e.Height)
+			{
+				b.Child2 = nodeD;
+				a.Child1 = nodeE;
+				e.Parent = nodeA;
+				a.Box = AABB::Union(c.Box, e.Box);
+				b.Box = AABB::Union(a.Box, d.Box);
+				a.Height = 1 + std::max(c.Height, e.Height);
+				b.Height = 1 + std::max(a.Height, d.Height);
+			}
+			else
+			{
+				b.Child2 = nodeE;
+				a.Child1 = nodeD;
+				d.Parent = nodeA;
+				a.Box = AABB::Union(c.Box, d.Box);
+				b.Box = AABB::Union(a.Box, e.Box);
+				a.Height = 1 + std::max(c.Height, d.Height);
+				b.Height = 1 + std::max(a.Height, e.Height);
+			}
+			return nodeB;
+		}
+
+		return nodeA;
+	}
+
+	uint32_t DynamicBVH::BuildSAH(const std::vector<uint32_t>& leaves, const std::vector<AABB>& boxes, const std::vector<glm::vec3>& centroids, uint32_t* indices, uint32_t count)
+	{
+		if (count == 1)
+			return leaves[indices[0]];
+
+		SAHSplit split = PartitionSAH(boxes, centroids, indices, count);
+		if (split.Cost == FLT_MAX)
+		{
+			// No usable plane, fall back to a median split
+			int axis = 0;
+			glm::vec3 size = boxes[indices[0]].GetExtents();
+			if (size.y > size[axis]) axis = 1;
+			if (size.z > size[axis]) axis = 2;
+			std::nth_element(indices, indices + split.LeftCount, indices + count,
+				[&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+		}
+
+		uint32_t child1 = BuildSAH(leaves, boxes, centroids, indices, split.LeftCount);
+		uint32_t child2 = BuildSAH(leaves, boxes, centroids, indices + split.LeftCount, count - split.LeftCount);
+
+		uint32_t index = AllocateNode();
+		Node& node = m_Nodes[index];
+		node.Child1 = child1;
+		node.Child2 = child2;
+		node.Box = AABB::Union(m_Nodes[child1].Box, m_Nodes[child2].Box);
+		node.Height = 1 + std::max(m_Nodes[child1].Height, m_Nodes[child2].Height);
+		m_Nodes[child1].Parent = index;
+		m_Nodes[child2].Parent = index;
+		return index;
+	}
+
+	void DynamicBVH::CollectLeaves(uint32_t node, std::vector<uint32_t>& results) const
+	{
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = node;
+
+		while (stackSize > 0)
+		{
+			const Node& current = m_Nodes[stack[--stackSize]];
+			if (current.IsLeaf())
+			{
+				results.push_back(current.UserData);
+				continue;
+			}
+
+			GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+			stack[stackSize++] = current.Child1;
+			stack[stackSize++] = current.Child2;
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// StaticBVH ////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	void StaticBVH::Build(const std::vector<AABB>& boxes, const std::vector<uint32_t>& userData)
+	{
+		GE_PROFILE_FUNCTION();
+		GE_MEMORY_TAG(MemoryTag::Scene);
+
+		GE_CORE_ASSERT(userData.empty() || userData.size() == boxes.size(), "userData must be empty or match boxes");
+
+		m_Boxes = boxes;
+		m_UserData = userData;
+		m_Nodes.clear();
+
+		uint32_t count = (uint32_t)boxes.size();
+		if (count == 0)
+			return;
+
+		m_Centroids.resize(count);
+		m_Indices.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_Centroids[i] = boxes[i].GetCenter();
+			m_Indices[i] = i;
+		}
+
+		// A binary tree with n leaves has at most 2n - 1 nodes, reserving keeps Subdivide free of reallocations
+		m_Nodes.reserve(2 * count);
+		m_Nodes.emplace_back();
+		Subdivide(0, 0, count);
+
+		m_Centroids.clear();
+		m_Centroids.shrink_to_fit();
+	}
+
+	void StaticBVH::Subdivide(uint32_t nodeIndex, uint32_t first, uint32_t count)
+	{
+		Node& node = m_Nodes[nodeIndex];
+		for (uint32_t i = 0; i < count; i++)
+			node.Box.Expand(m_Boxes[m_Indices[first + i]]);
+
+		node.LeftFirst = first;
+		node.Count = count;
+		if (count == 1)
+			return;
+
+		uint32_t* indices = m_Indices.data() + first;
+		SAHSplit split = PartitionSAH(m_Boxes, m_Centroids, indices, count);
+
+		// Traversal is about as expensive as testing one primitive
+		float area = node.Box.GetSurfaceArea();
+		float leafCost = count * area;
+		float splitCost = split.Cost == FLT_MAX ? FLT_MAX : area + split.Cost;
+		if (count <= MaxLeafSize && leafCost <= splitCost)
+			return;
+
+		if (split.Cost == FLT_MAX)
+		{
+			int axis = 0;
+			glm::vec3 size = node.Box.GetExtents();
+			if (size.y > size[axis]) axis = 1;
+			if (size.z > size[axis]) axis = 2;
+			std::nth_element(indices, indices + split.LeftCount, indices + count,
+				[&](uint32_t a, uint32_t b) { return m_Centroids[a][axis] < m_Centroids[b][axis]; });
+		}
+
+		uint32_t left = (uint32_t)m_Nodes.size();
+		m_Nodes.emplace_back();
+		m_Nodes.emplace_back();
+
+		node.LeftFirst = left;
+		node.Count = 0;
+
+		Subdivide(left, first, split.LeftCount);
+		Subdivide(left + 1, first + split.LeftCount, count - split.LeftCount);
+	}
+
+	void StaticBVH::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& results) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_Nodes.empty())
+			return;
+
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			uint32_t index = stack[--stackSize];
+			const Node& node = m_Nodes[index];
+
+			Frustum::Containment containment = frustum.Classify(node.Box);
+			if (containment == Frustum::Containment::Outside)
+				continue;
+
+			if (containment == Frustum::Containment::Inside)
+			{
+				CollectPrimitives(index, results);
+			}
+			else if (node.Count > 0)
+			{
+				for (uint32_t i = 0; i < node.Count; i++)
+				{
+					uint32_t primitive = m_Indices[node.LeftFirst + i];
+					if (frustum.Intersects(m_Boxes[primitive]))
+						results.push_back(GetUserData(primitive));
+				}
+			}
+			else
+			{
+				GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+				stack[stackSize++] = node.LeftFirst;
+				stack[stackSize++] = node.LeftFirst + 1;
+			}
+		}
+	}
+
+	void StaticBVH::QueryAABB(const AABB& box, std::vector<uint32_t>& results) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_Nodes.empty())
+			return;
+
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+			if (!node.Box.Overlaps(box))
+				continue;
+
+			if (node.Count > 0)
+			{
+				for (uint32_t i = 0; i < node.Count; i++)
+				{
+					uint32_t primitive = m_Indices[node.LeftFirst + i];
+					if (m_Boxes[primitive].Overlaps(box))
+						results.push_back(GetUserData(primitive));
+				}
+			}
+			else
+			{
+				GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+				stack[stackSize++] = node.LeftFirst;
+				stack[stackSize++] = node.LeftFirst + 1;
+			}
+		}
+	}
+
+	bool StaticBVH::RayCast(const Ray& ray, float maxDistance, RayCastHit& hit) const
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_Nodes.empty())
+			return false;
+
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		bool found = false;
+		float closest = maxDistance;
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+
+			float distance;
+			if (!ray.Intersects(node.Box, closest, distance))
+				continue;
+
+			if (node.Count > 0)
+			{
+				for (uint32_t i = 0; i < node.Count; i++)
+				{
+					uint32_t primitive = m_Indices[node.LeftFirst + i];
+					if (ray.Intersects(m_Boxes[primitive], closest, distance))
+					{
+						closest = distance;
+						hit.UserData = GetUserData(primitive);
+						hit.Distance = distance;
+						found = true;
+					}
+				}
+				continue;
+			}
+
+			uint32_t left = node.LeftFirst;
+			uint32_t right = node.LeftFirst + 1;
+			float leftDistance, rightDistance;
+			bool hitLeft = ray.Intersects(m_Nodes[left].Box, closest, leftDistance);
+			bool hitRight = ray.Intersects(m_Nodes[right].Box, closest, rightDistance);
+
+			// The nearer child is pushed last so it is visited first and can prune the other one
+			GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+			if (hitLeft && hitRight)
+			{
+				bool leftFirst = leftDistance < rightDistance;
+				stack[stackSize++] = leftFirst ? right : left;
+				stack[stackSize++] = leftFirst ? left : right;
+			}
+			else if (hitLeft)
+			{
+				stack[stackSize++] = left;
+			}
+			else if (hitRight)
+			{
+				stack[stackSize++] = right;
+			}
+		}
+		return found;
+	}
+
+	void StaticBVH::CollectPrimitives(uint32_t node, std::vector<uint32_t>& results) const
+	{
+		uint32_t stack[s_MaxStackDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = node;
+
+		while (stackSize > 0)
+		{
+			const Node& current = m_Nodes[stack[--stackSize]];
+			if (current.Count > 0)
+			{
+				for (uint32_t i = 0; i < current.Count; i++)
+					results.push_back(GetUserData(m_Indices[current.LeftFirst + i]));
+				continue;
+			}
+
+			GE_CORE_ASSERT(stackSize + 2 <= s_MaxStackDepth, "BVH traversal stack overflow");
+			stack[stackSize++] = current.LeftFirst;
+			stack[stackSize++] = current.LeftFirst + 1;
+		}
+	}
+}
\ No newline at end of file
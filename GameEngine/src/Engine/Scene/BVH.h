@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+
+#include "Engine/Renderer/BoundingVolume.h"
+#include "Engine/Renderer/Frustum.h"
+
+namespace Engine {
+
+	struct RayCastHit
+	{
+		uint32_t UserData = 0;
+		float Distance = 0.0f;
+	};
+
+	// Bounding volume hierarchy for objects that move.
+	// Leaves store a box fattened by a margin, so small moves don't touch the tree.
+	// Inserts pick the sibling with the lowest surface area cost and AVL style
+	// rotations keep the tree balanced. Rebuild() rebuilds it top-down with SAH.
+	class DynamicBVH
+	{
+	public:
+		static const uint32_t Null = 0xffffffff;
+
+		DynamicBVH(float margin = 0.1f);
+
+		// Returns a proxy id for Remove() and Move()
+		uint32_t Insert(const AABB& box, uint32_t userData);
+		void Remove(uint32_t proxy);
+		// Returns true if the box left its fattened bounds and the leaf was reinserted
+		bool Move(uint32_t proxy, const AABB& box);
+		void Rebuild();
+		void Clear();
+
+		void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& results) const;
+		void QueryAABB(const AABB& box, std::vector<uint32_t>& results) const;
+		// Closest leaf box hit by the ray
+		bool RayCast(const Ray& ray, float maxDistance, RayCastHit& hit) const;
+
+		inline uint32_t GetUserData(uint32_t proxy) const { return m_Nodes[proxy].UserData; }
+		inline const AABB& GetFatAABB(uint32_t proxy) const { return m_Nodes[proxy].Box; }
+		inline uint32_t GetProxyCount() const { return m_ProxyCount; }
+		inline int32_t GetHeight() const { return m_Root == Null ? 0 : m_Nodes[m_Root].Height; }
+	private:
+		struct Node
+		{
+			AABB Box;
+			uint32_t Parent = Null;
+			uint32_t Child1 = Null;
+			uint32_t Child2 = Null;
+			// Free list link while the node is unused
+			uint32_t Next = Null;
+			uint32_t UserData = 0;
+			// Leaf = 0, free = -1
+			int32_t Height = 0;
+
+			inline bool IsLeaf() const { return Child1 == Null; }
+		};
+
+		uint32_t AllocateNode();
+		void FreeNode(uint32_t node);
+
+		void InsertLeaf(uint32_t leaf);
+		void RemoveLeaf(uint32_t leaf);
+		void RefitUpwards(uint32_t node);
+		uint32_t Balance(uint32_t node);
+		uint32_t BuildSAH(const std::vector<uint32_t>& leaves, const std::vector<AABB>& boxes, const std::vector<glm::vec3>& centroids, uint32_t* indices, uint32_t count);
+		void CollectLeaves(uint32_t node, std::vector<uint32_t>& results) const;
+	private:
+		std::vector<Node> m_Nodes;
+		uint32_t m_Root = Null;
+		uint32_t m_FreeList = Null;
+		uint32_t m_ProxyCount = 0;
+		float m_Margin;
+	};
+
+	// Flat, read-only hierarchy for geometry that never moves, built with binned SAH.
+	// Children of a node are stored next to each other for better traversal locality.
+	class StaticBVH
+	{
+	public:
+		static const uint32_t MaxLeafSize = 4;
+
+		// userData[i] is reported for boxes[i], leave it empty to report the box index
+		void Build(const std::vector<AABB>& boxes, const std::vector<uint32_t>& userData = {});
+
+		void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& results) const;
+		void QueryAABB(const AABB& box, std::vector<uint32_t>& results) const;
+		bool RayCast(const Ray& ray, float maxDistance, RayCastHit& hit) const;
+
+		inline uint32_t GetNodeCount() const { return (uint32_t)m_Nodes.size(); }
+	private:
+		struct Node
+		{
+			AABB Box;
+			// Leaf: first primitive index, inner node: index of the left child (right is +1)
+			uint32_t LeftFirst = 0;
+			// Primitive count, 0 for inner nodes
+			uint32_t Count = 0;
+		};
+
+		void Subdivide(uint32_t node, uint32_t first, uint32_t count);
+		void CollectPrimitives(uint32_t node, std::vector<uint32_t>& results) const;
+		inline uint32_t GetUserData(uint32_t primitive) const { return m_UserData.empty() ? primitive : m_UserData[primitive]; }
+	private:
+		std::vector<Node> m_Nodes;
+		std::vector<AABB> m_Boxes;
+		std::vector<glm::vec3> m_Centroids;
+		std::vector<uint32_t> m_Indices;
+		std::vector<uint32_t> m_UserData;
+	};
+}
\ No newline at end of file
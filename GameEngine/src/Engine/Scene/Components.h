@@ -0,0 +1,70 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/Mesh.h"
+
+namespace Engine {
+
+	struct TransformComponent
+	{
+		glm::vec3 Translation = { 0.0f, 0.0f, 0.0f };
+		// Euler angles in radians
+		glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
+
+		TransformComponent() = default;
+		TransformComponent(const glm::vec3& translation, const glm::vec3& rotation = glm::vec3(0.0f), const glm::vec3& scale = glm::vec3(1.0f))
+			: Translation(translation), Rotation(rotation), Scale(scale) {}
+
+		glm::mat4 GetTransform() const
+		{
+			return glm::translate(glm::mat4(1.0f), Translation)
+				* glm::mat4_cast(glm::quat(Rotation))
+				* glm::scale(glm::mat4(1.0f), Scale);
+		}
+	};
+
+	// Quad in the XY plane of the transform, drawn by Renderer2D
+	struct SpriteComponent
+	{
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		// White when null
+		Ref<Texture2D> Texture;
+		float TilingFactor = 1.0f;
+
+		SpriteComponent() = default;
+		SpriteComponent(const glm::vec4& color)
+			: Color(color) {}
+		SpriteComponent(const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tint = glm::vec4(1.0f))
+			: Color(tint), Texture(texture), TilingFactor(tilingFactor) {}
+	};
+
+	// Instance of a shared mesh, the shader gets the camera and light uniforms of the scene
+	struct MeshComponent
+	{
+		Ref<Engine::Mesh> Mesh;
+		Ref<Engine::Shader> Shader;
+
+		MeshComponent() = default;
+		MeshComponent(const Ref<Engine::Mesh>& mesh, const Ref<Engine::Shader>& shader)
+			: Mesh(mesh), Shader(shader) {}
+	};
+
+	// Point light at the translation of the entity
+	struct LightComponent
+	{
+		glm::vec3 Ambient = { 0.2f, 0.2f, 0.2f };
+		glm::vec3 Diffuse = { 0.5f, 0.5f, 0.5f };
+		glm::vec3 Specular = { 1.0f, 1.0f, 1.0f };
+
+		float Constant = 1.0f;
+		float Linear = 0.09f;
+		float Quadratic = 0.032f;
+		float Shininess = 32.0f;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "gepch.h"
+#include "Scene.h"
+
+#include "Engine/Scene/Components.h"
+#include "Engine/Renderer/Camera.h"
+#include "Engine/Renderer/Renderer2D.h"
+
+namespace Engine {
+
+	Scene::Scene()
+	{
+		// Entities without components
+		GetArchetype(0);
+	}
+
+	Scene::~Scene()
+	{
+		GE_CORE_ASSERT(m_IterationDepth == 0, "Scene destroyed while a view is iterated");
+	}
+
+	Entity Scene::CreateEntity()
+	{
+		GE_CORE_ASSERT(m_IterationDepth == 0, "Entities can't be created while a view is iterated");
+
+		Entity entity = m_Entities.Create();
+		EntityRecord& record = *m_Entities.Get(entity);
+		record.Archetype = m_Archetypes[0].get();
+		record.Archetype->AddRow(entity, record.Chunk, record.Row);
+		return entity;
+	}
+
+	uint32_t Scene::CreateEntityRows(Archetype* archetype, uint32_t count, uint32_t& chunk, uint32_t& row)
+	{
+		GE_CORE_ASSERT(m_IterationDepth == 0, "Entities can't be created while a view is iterated");
+
+		uint32_t created = archetype->AddRows(count, chunk, row);
+		Entity* entities = archetype->GetEntities(archetype->GetChunk(chunk));
+		for (uint32_t i = 0; i < created; i++)
+		{
+			Entity entity = m_Entities.Create({ archetype, chunk, row + i });
+			entities[row + i] = entity;
+		}
+		return created;
+	}
+
+	void Scene::DestroyEntity(Entity entity)
+	{
+		GE_CORE_ASSERT(m_IterationDepth == 0, "Entities can't be destroyed while a view is iterated");
+
+		EntityRecord& record = GetRecord(entity);
+		for (ComponentID id : record.Archetype->GetComponents())
+		{
+			const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+			if (!info.Trivial)
+				info.Destroy(record.Archetype->GetComponent(record.Chunk, record.Row, id));
+		}
+
+		Entity moved = record.Archetype->RemoveRow(record.Chunk, record.Row);
+		if (moved)
+		{
+			EntityRecord& movedRecord = GetRecord(moved);
+			movedRecord.Chunk = record.Chunk;
+			movedRecord.Row = record.Row;
+		}
+		if (entity.GetIndex() < m_MeshBounds.size() && m_MeshBounds[entity.GetIndex()].Owner == entity)
+			RemoveMeshBounds(entity.GetIndex());
+		m_Entities.Destroy(entity);
+	}
+
+	Scene::EntityRecord& Scene::GetRecord(Entity entity)
+	{
+		EntityRecord* record = m_Entities.Get(entity);
+		GE_CORE_ASSERT(record, "Invalid entity");
+		return *record;
+	}
+
+	Archetype* Scene::GetArchetype(ComponentMask mask)
+	{
+		auto it = m_ArchetypeLookup.find(mask);
+		if (it != m_ArchetypeLookup.end())
+			return it->second;
+
+		GE_MEMORY_TAG(MemoryTag::Scene);
+		m_Archetypes.push_back(CreateScope<Archetype>(mask));
+		Archetype* archetype = m_Archetypes.back().get();
+		m_ArchetypeLookup[mask] = archetype;
+		return archetype;
+	}
+
+	Archetype* Scene::GetAddTarget(Archetype* archetype, ComponentID id)
+	{
+		Archetype* target = archetype->GetAddEdge(id);
+		if (!target)
+		{
+			target = GetArchetype(archetype->GetMask() | ((ComponentMask)1 << id));
+			archetype->SetAddEdge(id, target);
+			target->SetRemoveEdge(id, archetype);
+		}
+		return target;
+	}
+
+	Archetype* Scene::GetRemoveTarget(Archetype* archetype, ComponentID id)
+	{
+		Archetype* target = archetype->GetRemoveEdge(id);
+		if (!target)
+		{
+			target = GetArchetype(archetype->GetMask() & ~((ComponentMask)1 << id));
+			archetype->SetRemoveEdge(id, target);
+			target->SetAddEdge(id, archetype);
+		}
+		return target;
+	}
+
+	void Scene::MoveEntity(EntityRecord& record, Archetype* target)
+	{
+		GE_CORE_ASSERT(m_IterationDepth == 0, "Components can't be added or removed while a view is iterated");
+
+		Archetype* source = record.Archetype;
+		Entity entity = source->GetEntities(source->GetChunk(record.Chunk))[record.Row];
+
+		uint32_t chunk, row;
+		target->AddRow(entity, chunk, row);
+
+		for (ComponentID id : source->GetComponents())
+		{
+			void* component = source->GetComponent(record.Chunk, record.Row, id);
+			const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+			if (target->Has(id))
+			{
+				void* destination = target->GetComponent(chunk, row, id);
+				if (info.Trivial)
+					memcpy(destination, component, info.Size);
+				else
+					info.Relocate(destination, component);
+			}
+			else if (!info.Trivial)
+				info.Destroy(component);
+		}
+
+		Entity moved = source->RemoveRow(record.Chunk, record.Row);
+		if (moved)
+		{
+			EntityRecord& movedRecord = GetRecord(moved);
+			movedRecord.Chunk = record.Chunk;
+			movedRecord.Row = record.Row;
+		}
+
+		record.Archetype = target;
+		record.Chunk = chunk;
+		record.Row = row;
+	}
+
+	ArchetypeQuery& Scene::GetQuery(ComponentMask mask)
+	{
+		auto it = m_Queries.find(mask);
+		if (it != m_Queries.end())
+			return it->second;
+
+		GE_MEMORY_TAG(MemoryTag::Scene);
+		ArchetypeQuery& query = m_Queries[mask];
+		query.Mask = mask;
+		return query;
+	}
+
+	const std::vector<Archetype*>& Scene::UpdateQuery(ArchetypeQuery& query)
+	{
+		for (; query.CheckedCount < m_Archetypes.size(); query.CheckedCount++)
+		{
+			Archetype* archetype = m_Archetypes[query.CheckedCount].get();
+			if ((archetype->GetMask() & query.Mask) == query.Mask)
+				query.Archetypes.push_back(archetype);
+		}
+		return query.Archetypes;
+	}
+
+	void Scene::OnRender2D(const OrthographicCamera& camera)
+	{
+		GE_PROFILE_FUNCTION();
+
+		Renderer2D::BeginScene(camera);
+		GetView<TransformComponent, SpriteComponent>().ForEach([](Entity, TransformComponent& transform, SpriteComponent& sprite)
+		{
+			if (sprite.Texture)
+				Renderer2D::DrawQuad(transform.GetTransform(), sprite.Texture, sprite.TilingFactor, sprite.Color);
+			else
+				Renderer2D::DrawQuad(transform.GetTransform(), sprite.Color);
+		});
+		Renderer2D::EndScene();
+	}
+
+	static void UploadLight(Shader& shader, const glm::vec3& position, const LightComponent& light)
+	{
+		shader.SetFloat3("light.position", position);
+		shader.SetFloat3("light.ambient", light.Ambient);
+		shader.SetFloat3("light.diffuse", light.Diffuse);
+		shader.SetFloat3("light.specular", light.Specular);
+		shader.SetFloat("light.constant", light.Constant);
+		shader.SetFloat("light.linear", light.Linear);
+		shader.SetFloat("light.quadratic", light.Quadratic);
+		shader.SetFloat("shininess", light.Shininess);
+	}
+
+	void Scene::OnRender(Timestep ts, const Camera& camera)
+	{
+		GE_PROFILE_FUNCTION();
+
+		const LightComponent* light = nullptr;
+		glm::vec3 lightPosition(0.0f);
+		GetView<TransformComponent, LightComponent>().ForEach([&](Entity, TransformComponent& transform, LightComponent& component)
+		{
+			if (light)
+				return;
+			light = &component;
+			lightPosition = transform.Translation;
+		});
+
+		glm::mat4 viewProjection = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+
+		UpdateMeshBounds();
+
+		// Bone animation can move vertices outside the bind pose bounds, so animated meshes skip
+		// culling like their submeshes do in Mesh::Render(), which also keeps their animation running
+		m_VisibleMeshes.clear();
+		m_MeshBVH.QueryFrustum(Frustum::FromViewProjection(viewProjection), m_VisibleMeshes);
+		m_VisibleMeshes.erase(std::remove_if(m_VisibleMeshes.begin(), m_VisibleMeshes.end(), [&](uint32_t index) { return m_MeshBounds[index].Animated; }), m_VisibleMeshes.end());
+		m_VisibleMeshes.insert(m_VisibleMeshes.end(), m_AnimatedMeshes.begin(), m_AnimatedMeshes.end());
+		std::sort(m_VisibleMeshes.begin(), m_VisibleMeshes.end());
+
+		// The scene uniforms are uploaded once for every run of meshes sharing a shader
+		const Shader* lastShader = nullptr;
+		for (uint32_t index : m_VisibleMeshes)
+		{
+			const MeshBounds& bounds = m_MeshBounds[index];
+			MeshComponent* mesh = TryGetComponent<MeshComponent>(bounds.Owner);
+			if (!mesh || !mesh->Shader)
+				continue;
+
+			if (mesh->Shader.get() != lastShader)
+			{
+				mesh->Shader->Bind();
+				mesh->Shader->SetMat4("u_ViewProjectionMatrix", viewProjection);
+				mesh->Shader->SetFloat3("viewPos", camera.GetPosition());
+				if (light)
+					UploadLight(*mesh->Shader, lightPosition, *light);
+				lastShader = mesh->Shader.get();
+			}
+
+			mesh->Mesh->Render(ts, mesh->Shader, bounds.Transform);
+		}
+	}
+
+	void Scene::UpdateMeshBounds()
+	{
+		GE_PROFILE_FUNCTION();
+
+		// Proxies of entities that lost their mesh since the last update
+		for (uint32_t index = 0; index < (uint32_t)m_MeshBounds.size(); index++)
+		{
+			const MeshBounds& bounds = m_MeshBounds[index];
+			if (bounds.Proxy == DynamicBVH::Null)
+				continue;
+			const MeshComponent* mesh = TryGetComponent<MeshComponent>(bounds.Owner);
+			if (!mesh || mesh->Mesh.get() != bounds.Mesh || !HasComponent<TransformComponent>(bounds.Owner))
+				RemoveMeshBounds(index);
+		}
+
+		m_AnimatedMeshes.clear();
+		GetView<TransformComponent, MeshComponent>().ForEach([&](Entity entity, TransformComponent& transform, MeshComponent& mesh)
+		{
+			if (!mesh.Mesh)
+				return;
+
+			uint32_t index = entity.GetIndex();
+			if (index >= m_MeshBounds.size())
+				m_MeshBounds.resize(index + 1);
+			MeshBounds& bounds = m_MeshBounds[index];
+
+			if (mesh.Mesh->IsAnimated())
+				m_AnimatedMeshes.push_back(index);
+
+			// Most entities don't move, comparing the components is cheaper than building the matrix
+			if (bounds.Proxy != DynamicBVH::Null && transform.Translation == bounds.Translation &&
+				transform.Rotation == bounds.Rotation && transform.Scale == bounds.Scale)
+				return;
+
+			bounds.Owner = entity;
+			bounds.Mesh = mesh.Mesh.get();
+			bounds.Translation = transform.Translation;
+			bounds.Rotation = transform.Rotation;
+			bounds.Scale = transform.Scale;
+			bounds.Transform = transform.GetTransform();
+			bounds.Animated = mesh.Mesh->IsAnimated();
+
+			AABB box = mesh.Mesh->GetBoundingBox().Transformed(bounds.Transform);
+			if (bounds.Proxy == DynamicBVH::Null)
+				bounds.Proxy = m_MeshBVH.Insert(box, index);
+			else
+				m_MeshBVH.Move(bounds.Proxy, box);
+		});
+	}
+
+	bool Scene::RayCast(const Ray& ray, float maxDistance, Entity& entity, float& distance) const
+	{
+		RayCastHit hit;
+		if (!m_MeshBVH.RayCast(ray, maxDistance, hit))
+			return false;
+
+		entity = m_MeshBounds[hit.UserData].Owner;
+		distance = hit.Distance;
+		return true;
+	}
+
+	void Scene::RemoveMeshBounds(uint32_t index)
+	{
+		MeshBounds& bounds = m_MeshBounds[index];
+		if (bounds.Proxy != DynamicBVH::Null)
+			m_MeshBVH.Remove(bounds.Proxy);
+		bounds = MeshBounds();
+	}
+}
\ No newline at end of file
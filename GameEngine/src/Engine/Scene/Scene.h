@@ -0,0 +1,308 @@
+#pragma once
+
+#include "Engine/Core/Allocator.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Timestep.h"
+#include "Engine/Scene/Archetype.h"
+#include "Engine/Scene/BVH.h"
+
+#include <unordered_map>
+
+namespace Engine {
+
+	class Scene;
+	class OrthographicCamera;
+	class Camera;
+	class Mesh;
+
+	struct ArchetypeQuery
+	{
+		ComponentMask Mask;
+		std::vector<Archetype*> Archetypes;
+		// Archetypes of the scene that were checked against the mask
+		uint32_t CheckedCount = 0;
+	};
+
+	// Query over the entities that have all of Ts. The matching archetypes are cached by the
+	// scene and only archetypes created since the last iteration are checked again, so a view
+	// is cheap to get every frame. Entities must not be created, destroyed or gain or lose
+	// components while a view is iterated.
+	template<typename... Ts>
+	class View
+	{
+	public:
+		// func(Entity, Ts&...)
+		template<typename Func>
+		void ForEach(Func&& func);
+
+		// func(count, const Entity*, Ts*...) once per chunk, for loops over the raw arrays
+		template<typename Func>
+		void ForEachChunk(Func&& func);
+
+		// ForEach() with the chunks spread over the JobSystem workers. func is called from
+		// several threads at once and may only write to the components it is handed.
+		template<typename Func>
+		void ParallelForEach(Func&& func);
+
+		uint32_t GetCount();
+	private:
+		View(Scene& scene, ArchetypeQuery& query)
+			: m_Scene(&scene), m_Query(&query) {}
+
+		template<typename Func>
+		static void EachInChunk(const Archetype& archetype, const Archetype::Chunk& chunk, Func& func)
+		{
+			Each(func, chunk.Count, archetype.GetEntities(chunk), archetype.GetArray<Ts>(chunk)...);
+		}
+
+		template<typename Func>
+		static void Each(Func& func, uint32_t count, const Entity* entities, Ts*... arrays)
+		{
+			for (uint32_t i = 0; i < count; i++)
+				func(entities[i], arrays[i]...);
+		}
+
+		const std::vector<Archetype*>& GetArchetypes();
+	private:
+		Scene* m_Scene;
+		ArchetypeQuery* m_Query;
+
+		friend class Scene;
+	};
+
+	// Entities and their components in archetype storage (see Archetype)
+	class Scene
+	{
+	public:
+		Scene();
+		~Scene();
+
+		Scene(const Scene&) = delete;
+		Scene& operator=(const Scene&) = delete;
+
+		Entity CreateEntity();
+		void DestroyEntity(Entity entity);
+		inline bool IsValid(Entity entity) const { return m_Entities.IsValid(entity); }
+		inline uint32_t GetEntityCount() const { return m_Entities.GetCount(); }
+		// Makes room for count more entities, so creating them doesn't grow the entity table
+		inline void ReserveEntities(uint32_t count) { m_Entities.Reserve(count); }
+
+		// Creates count entities with exactly the components in mask, which are left
+		// unconstructed, for loaders that fill whole component arrays at once.
+		// func(Archetype&, chunk, firstRow, count) is called for every run of new rows in one
+		// chunk and has to construct all of their components before it returns.
+		template<typename Func>
+		void CreateEntities(ComponentMask mask, uint32_t count, Func&& func)
+		{
+			Archetype* archetype = GetArchetype(mask);
+			while (count > 0)
+			{
+				uint32_t chunk, row;
+				uint32_t created = CreateEntityRows(archetype, count, chunk, row);
+				func(*archetype, chunk, row, created);
+				count -= created;
+			}
+		}
+
+		template<typename T, typename... Args>
+		T& AddComponent(Entity entity, Args&&... args)
+		{
+			ComponentID id = ComponentRegistry::GetID<T>();
+			EntityRecord& record = GetRecord(entity);
+			GE_CORE_ASSERT(!record.Archetype->Has(id), "Entity already has the component");
+
+			MoveEntity(record, GetAddTarget(record.Archetype, id));
+			return *new(record.Archetype->GetComponent(record.Chunk, record.Row, id)) T(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		void RemoveComponent(Entity entity)
+		{
+			ComponentID id = ComponentRegistry::GetID<T>();
+			EntityRecord& record = GetRecord(entity);
+			GE_CORE_ASSERT(record.Archetype->Has(id), "Entity doesn't have the component");
+
+			MoveEntity(record, GetRemoveTarget(record.Archetype, id));
+		}
+
+		template<typename T>
+		bool HasComponent(Entity entity) const
+		{
+			const EntityRecord* record = m_Entities.Get(entity);
+			return record && record->Archetype->Has(ComponentRegistry::GetID<T>());
+		}
+
+		template<typename T>
+		T& GetComponent(Entity entity)
+		{
+			T* component = TryGetComponent<T>(entity);
+			GE_CORE_ASSERT(component, "Entity doesn't have the component");
+			return *component;
+		}
+
+		// nullptr when the entity is invalid or doesn't have the component
+		template<typename T>
+		T* TryGetComponent(Entity entity)
+		{
+			EntityRecord* record = m_Entities.Get(entity);
+			ComponentID id = ComponentRegistry::GetID<T>();
+			if (!record || !record->Archetype->Has(id))
+				return nullptr;
+			return (T*)record->Archetype->GetComponent(record->Chunk, record->Row, id);
+		}
+
+		template<typename... Ts>
+		View<Ts...> GetView()
+		{
+			return View<Ts...>(*this, GetQuery(ComponentRegistry::GetMask<Ts...>()));
+		}
+
+		inline uint32_t GetArchetypeCount() const { return (uint32_t)m_Archetypes.size(); }
+
+		// Draws the entities with a TransformComponent and a SpriteComponent in one Renderer2D scene
+		void OnRender2D(const OrthographicCamera& camera);
+		// Draws the entities with a TransformComponent and a MeshComponent, lit by the first
+		// LightComponent. Static meshes are culled through the mesh BVH, animated ones are always
+		// drawn. Submeshes go through the render queue, call it between Renderer::BeginScene()
+		// and EndScene().
+		void OnRender(Timestep ts, const Camera& camera);
+
+		// Refits the BVH proxies of mesh entities whose transform or mesh changed since the last
+		// call. OnRender() calls it, call it before a ray cast against entities moved this frame.
+		void UpdateMeshBounds();
+		// Closest mesh entity whose bind pose bounds the ray hits
+		bool RayCast(const Ray& ray, float maxDistance, Entity& entity, float& distance) const;
+
+		// Proxy user data is the entity index
+		inline const DynamicBVH& GetMeshBVH() const { return m_MeshBVH; }
+		// Mesh entities drawn by the last OnRender()
+		inline uint32_t GetVisibleMeshCount() const { return (uint32_t)m_VisibleMeshes.size(); }
+	private:
+		// BVH proxy of a mesh entity and the state its bounds were computed from
+		struct MeshBounds
+		{
+			Entity Owner;
+			uint32_t Proxy = DynamicBVH::Null;
+			const Engine::Mesh* Mesh = nullptr;
+			glm::vec3 Translation = glm::vec3(0.0f);
+			glm::vec3 Rotation = glm::vec3(0.0f);
+			glm::vec3 Scale = glm::vec3(0.0f);
+			glm::mat4 Transform = glm::mat4(1.0f);
+			bool Animated = false;
+		};
+
+		struct EntityRecord
+		{
+			Engine::Archetype* Archetype = nullptr;
+			uint32_t Chunk = 0;
+			uint32_t Row = 0;
+		};
+
+		EntityRecord& GetRecord(Entity entity);
+		// Creates entities for the rows Archetype::AddRows() appends, returns how many
+		uint32_t CreateEntityRows(Archetype* archetype, uint32_t count, uint32_t& chunk, uint32_t& row);
+		Archetype* GetArchetype(ComponentMask mask);
+		Archetype* GetAddTarget(Archetype* archetype, ComponentID id);
+		Archetype* GetRemoveTarget(Archetype* archetype, ComponentID id);
+		// Moves the entity's row to the target archetype. Components both have are moved over,
+		// the ones the target lacks are destroyed and new ones are left unconstructed.
+		void MoveEntity(EntityRecord& record, Archetype* target);
+
+		ArchetypeQuery& GetQuery(ComponentMask mask);
+		const std::vector<Archetype*>& UpdateQuery(ArchetypeQuery& query);
+
+		void RemoveMeshBounds(uint32_t index);
+	private:
+		HandlePool<EntityRecord, EntityTag> m_Entities;
+		std::vector<Scope<Archetype>> m_Archetypes;
+		std::unordered_map<ComponentMask, Archetype*> m_ArchetypeLookup;
+		// Node based, views keep pointers to the queries
+		std::unordered_map<ComponentMask, ArchetypeQuery> m_Queries;
+		uint32_t m_IterationDepth = 0;
+
+		// Indexed by entity index
+		std::vector<MeshBounds> m_MeshBounds;
+		DynamicBVH m_MeshBVH;
+		// Entity indices, rebuilt every frame
+		std::vector<uint32_t> m_AnimatedMeshes;
+		std::vector<uint32_t> m_VisibleMeshes;
+
+		template<typename...>
+		friend class View;
+		friend class SceneSerializer;
+	};
+
+	template<typename... Ts>
+	const std::vector<Archetype*>& View<Ts...>::GetArchetypes()
+	{
+		return m_Scene->UpdateQuery(*m_Query);
+	}
+
+	template<typename... Ts>
+	template<typename Func>
+	void View<Ts...>::ForEach(Func&& func)
+	{
+		m_Scene->m_IterationDepth++;
+		for (const Archetype* archetype : GetArchetypes())
+		{
+			for (uint32_t i = 0; i < archetype->GetChunkCount(); i++)
+				EachInChunk(*archetype, archetype->GetChunk(i), func);
+		}
+		m_Scene->m_IterationDepth--;
+	}
+
+	template<typename... Ts>
+	template<typename Func>
+	void View<Ts...>::ForEachChunk(Func&& func)
+	{
+		m_Scene->m_IterationDepth++;
+		for (const Archetype* archetype : GetArchetypes())
+		{
+			for (uint32_t i = 0; i < archetype->GetChunkCount(); i++)
+			{
+				const Archetype::Chunk& chunk = archetype->GetChunk(i);
+				func(chunk.Count, (const Entity*)archetype->GetEntities(chunk), archetype->GetArray<Ts>(chunk)...);
+			}
+		}
+		m_Scene->m_IterationDepth--;
+	}
+
+	template<typename... Ts>
+	template<typename Func>
+	void View<Ts...>::ParallelForEach(Func&& func)
+	{
+		struct ChunkRef
+		{
+			const Archetype* Owner;
+			const Archetype::Chunk* Chunk;
+		};
+
+		ScratchScope scratch;
+		LinearVector<ChunkRef> chunks(scratch.GetAllocator());
+		for (const Archetype* archetype : GetArchetypes())
+		{
+			for (uint32_t i = 0; i < archetype->GetChunkCount(); i++)
+				chunks.push_back({ archetype, &archetype->GetChunk(i) });
+		}
+
+		// A few ranges per thread, so a worker that started late still gets a share
+		uint32_t grainSize = std::max((uint32_t)chunks.size() / ((JobSystem::GetWorkerCount() + 1) * 4), 1u);
+
+		m_Scene->m_IterationDepth++;
+		JobSystem::ParallelFor((uint32_t)chunks.size(), grainSize, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+				EachInChunk(*chunks[i].Owner, *chunks[i].Chunk, func);
+		});
+		m_Scene->m_IterationDepth--;
+	}
+
+	template<typename... Ts>
+	uint32_t View<Ts...>::GetCount()
+	{
+		uint32_t count = 0;
+		for (const Archetype* archetype : GetArchetypes())
+			count += archetype->GetEntityCount();
+		return count;
+	}
+}
\ No newline at end of file
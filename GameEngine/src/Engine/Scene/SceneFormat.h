@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Binary scene written by SceneSerializer (.gescenebin), made to be read a block at a time
+// straight into archetype storage (see SceneLoader).
+//
+// File:    Header, asset table, then BlockCount blocks
+// Header:  Magic[8], Version, AssetCount, EntityCount, BlockCount (uint32 little endian each)
+// Asset:   ID (uint64), Type (uint8, see AssetType), path length (uint16), path bytes
+// Block:   Components (uint32, bit n set for ComponentType n), Count (uint32, 1 to
+//          BlockCapacity), then for every component in bit order a column of Count records
+//
+// Records are fixed size and stored with the in-memory layout of a little endian host, so
+// the columns of plain components are copied into the chunks with one memcpy per run.
+// Assets are referenced by their index in the asset table, NullIndex for none; the table
+// maps them to the stable AssetIDs.
+//   Transform:  translation, rotation (euler radians), scale        - 9 floats
+//   Sprite:     color, tiling factor, texture index                 - 5 floats, uint32
+//   Mesh:       mesh index, shader index                            - 2 uint32
+//   Light:      ambient, diffuse, specular, constant, linear,
+//               quadratic, shininess                                - 13 floats
+namespace Engine::SceneFormat {
+
+	static const char Magic[8] = { 'G', 'E', 'S', 'C', 'E', 'N', 'E', 'B' };
+	static const uint32_t Version = 1;
+	static const size_t HeaderSize = 24;
+
+	// Entities of an archetype are split into blocks of at most this many
+	static const uint32_t BlockCapacity = 1024;
+	static const uint32_t NullIndex = 0xffffffff;
+
+	enum class ComponentType : uint32_t
+	{
+		Transform = 0,
+		Sprite = 1,
+		Mesh = 2,
+		Light = 3
+	};
+	static const uint32_t ComponentTypeCount = 4;
+	static const uint32_t AllComponents = (1u << ComponentTypeCount) - 1;
+
+	static const uint32_t RecordSizes[ComponentTypeCount] = { 36, 24, 8, 52 };
+
+	struct SpriteRecord
+	{
+		float Color[4];
+		float TilingFactor;
+		uint32_t Texture;
+	};
+
+	struct MeshRecord
+	{
+		uint32_t Mesh;
+		uint32_t Shader;
+	};
+
+	struct Header
+	{
+		uint32_t Version = 0;
+		uint32_t AssetCount = 0;
+		uint32_t EntityCount = 0;
+		uint32_t BlockCount = 0;
+	};
+
+	inline uint32_t GetRowSize(uint32_t components)
+	{
+		uint32_t size = 0;
+		for (uint32_t type = 0; type < ComponentTypeCount; type++)
+		{
+			if (components & (1u << type))
+				size += RecordSizes[type];
+		}
+		return size;
+	}
+
+	inline void WriteU32(std::string& out, uint32_t value)
+	{
+		uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+		out.append((const char*)bytes, 4);
+	}
+
+	inline uint32_t ReadU32(const uint8_t* data)
+	{
+		return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+	}
+
+	inline void WriteHeader(std::string& out, const Header& header)
+	{
+		out.append(Magic, sizeof(Magic));
+		WriteU32(out, Version);
+		WriteU32(out, header.AssetCount);
+		WriteU32(out, header.EntityCount);
+		WriteU32(out, header.BlockCount);
+	}
+
+	inline bool ReadHeader(const uint8_t* data, size_t size, Header& header)
+	{
+		if (size < HeaderSize || memcmp(data, Magic, sizeof(Magic)) != 0)
+			return false;
+
+		header.Version = ReadU32(data + 8);
+		header.AssetCount = ReadU32(data + 12);
+		header.EntityCount = ReadU32(data + 16);
+		header.BlockCount = ReadU32(data + 20);
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,608 @@
+#include "gepch.h"
+#include "SceneSerializer.h"
+
+#include "Engine/Scene/Components.h"
+
+#include <fstream>
+#include <iomanip>
+
+namespace Engine {
+
+	using namespace SceneFormat;
+
+	// Plain components are stored with their in-memory layout
+	static_assert(std::is_trivially_copyable_v<TransformComponent> && sizeof(TransformComponent) == 36, "TransformComponent no longer matches its record");
+	static_assert(std::is_trivially_copyable_v<LightComponent> && sizeof(LightComponent) == 52, "LightComponent no longer matches its record");
+	static_assert(sizeof(SpriteRecord) == 24 && sizeof(MeshRecord) == 8, "Unexpected record padding");
+
+	static ComponentID GetComponentID(ComponentType type)
+	{
+		switch (type)
+		{
+			case ComponentType::Transform:	return ComponentRegistry::GetID<TransformComponent>();
+			case ComponentType::Sprite:		return ComponentRegistry::GetID<SpriteComponent>();
+			case ComponentType::Mesh:		return ComponentRegistry::GetID<MeshComponent>();
+			case ComponentType::Light:		return ComponentRegistry::GetID<LightComponent>();
+		}
+		return 0;
+	}
+
+	// Saved components of the archetype as ComponentType bits
+	static uint32_t GetSavedComponents(const Archetype& archetype)
+	{
+		uint32_t components = 0;
+		for (uint32_t type = 0; type < ComponentTypeCount; type++)
+		{
+			if (archetype.Has(GetComponentID((ComponentType)type)))
+				components |= 1u << type;
+		}
+		return components;
+	}
+
+	// Calls func(chunk, row, count) for the runs of rows [first, first + count) of the
+	// archetype, every chunk but the last is full
+	template<typename Func>
+	static void ForEachRun(const Archetype& archetype, uint32_t first, uint32_t count, Func&& func)
+	{
+		uint32_t capacity = archetype.GetChunkCapacity();
+		while (count > 0)
+		{
+			uint32_t row = first % capacity;
+			uint32_t run = std::min(count, capacity - row);
+			func(archetype.GetChunk(first / capacity), row, run);
+			first += run;
+			count -= run;
+		}
+	}
+
+	// Shortest text that reads back as the same float
+	static void WriteFloat(std::ostream& out, float value)
+	{
+		char buffer[32];
+		for (int precision = 6; precision <= 9; precision++)
+		{
+			snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+			if (strtof(buffer, nullptr) == value)
+				break;
+		}
+		out << ' ' << buffer;
+	}
+
+	static void WriteFloats(std::ostream& out, const float* values, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			WriteFloat(out, values[i]);
+	}
+
+	static void WriteAssetID(std::ostream& out, AssetID id)
+	{
+		out << ' ' << std::hex << id << std::dec;
+	}
+
+	void SceneSerializer::CollectAssets(std::vector<AssetID>& assets, std::unordered_map<AssetID, uint32_t>& indices)
+	{
+		auto add = [&](const void* asset)
+		{
+			AssetID id = asset ? m_Assets->Find(asset) : NullAsset;
+			if (id != NullAsset && indices.emplace(id, (uint32_t)assets.size()).second)
+				assets.push_back(id);
+		};
+
+		m_Scene->GetView<SpriteComponent>().ForEach([&](Entity, SpriteComponent& sprite)
+		{
+			add(sprite.Texture.get());
+		});
+		m_Scene->GetView<MeshComponent>().ForEach([&](Entity, MeshComponent& mesh)
+		{
+			add(mesh.Mesh.get());
+			add(mesh.Shader.get());
+		});
+	}
+
+	bool SceneSerializer::SerializeText(const std::string& filepath)
+	{
+		GE_PROFILE_FUNCTION();
+
+		std::ofstream file(filepath);
+		if (!file.is_open())
+		{
+			GE_CORE_ERROR("SceneSerializer could not open '{0}' for writing.", filepath);
+			return false;
+		}
+
+		std::vector<AssetID> assets;
+		std::unordered_map<AssetID, uint32_t> indices;
+		CollectAssets(assets, indices);
+
+		auto getID = [&](const void* asset)
+		{
+			AssetID id = asset ? m_Assets->Find(asset) : NullAsset;
+			return indices.count(id) ? id : NullAsset;
+		};
+
+		file << "Scene " << Version << "\n";
+		for (AssetID id : assets)
+		{
+			file << "Asset";
+			WriteAssetID(file, id);
+			file << ' ' << AssetTypeName(m_Assets->GetType(id)) << ' ' << std::quoted(m_Assets->GetPath(id)) << "\n";
+		}
+
+		for (const Scope<Archetype>& archetype : m_Scene->m_Archetypes)
+		{
+			uint32_t components = GetSavedComponents(*archetype);
+			ForEachRun(*archetype, 0, archetype->GetEntityCount(), [&](const Archetype::Chunk& chunk, uint32_t first, uint32_t count)
+			{
+				for (uint32_t row = first; row < first + count; row++)
+				{
+					file << "Entity\n";
+					if (components & (1u << (uint32_t)ComponentType::Transform))
+					{
+						const TransformComponent& transform = archetype->GetArray<TransformComponent>(chunk)[row];
+						glm::vec3 rotation = glm::degrees(transform.Rotation);
+						file << "\tTransform";
+						WriteFloats(file, &transform.Translation.x, 3);
+						WriteFloats(file, &rotation.x, 3);
+						WriteFloats(file, &transform.Scale.x, 3);
+						file << "\n";
+					}
+					if (components & (1u << (uint32_t)ComponentType::Sprite))
+					{
+						const SpriteComponent& sprite = archetype->GetArray<SpriteComponent>(chunk)[row];
+						file << "\tSprite";
+						WriteFloats(file, &sprite.Color.x, 4);
+						WriteFloat(file, sprite.TilingFactor);
+						WriteAssetID(file, getID(sprite.Texture.get()));
+						file << "\n";
+					}
+					if (components & (1u << (uint32_t)ComponentType::Mesh))
+					{
+						const MeshComponent& mesh = archetype->GetArray<MeshComponent>(chunk)[row];
+						file << "\tMesh";
+						WriteAssetID(file, getID(mesh.Mesh.get()));
+						WriteAssetID(file, getID(mesh.Shader.get()));
+						file << "\n";
+					}
+					if (components & (1u << (uint32_t)ComponentType::Light))
+					{
+						const LightComponent& light = archetype->GetArray<LightComponent>(chunk)[row];
+						file << "\tLight";
+						WriteFloats(file, &light.Ambient.x, 3);
+						WriteFloats(file, &light.Diffuse.x, 3);
+						WriteFloats(file, &light.Specular.x, 3);
+						WriteFloats(file, &light.Constant, 4);
+						file << "\n";
+					}
+				}
+			});
+		}
+		return file.good();
+	}
+
+	bool SceneSerializer::SerializeBinary(const std::string& filepath)
+	{
+		GE_PROFILE_FUNCTION();
+
+		std::ofstream file(filepath, std::ios::binary);
+		if (!file.is_open())
+		{
+			GE_CORE_ERROR("SceneSerializer could not open '{0}' for writing.", filepath);
+			return false;
+		}
+
+		std::vector<AssetID> assets;
+		std::unordered_map<AssetID, uint32_t> indices;
+		CollectAssets(assets, indices);
+
+		auto getIndex = [&](const void* asset)
+		{
+			auto it = indices.find(asset ? m_Assets->Find(asset) : NullAsset);
+			return it != indices.end() ? it->second : NullIndex;
+		};
+
+		Header header;
+		header.AssetCount = (uint32_t)assets.size();
+		for (const Scope<Archetype>& archetype : m_Scene->m_Archetypes)
+		{
+			header.EntityCount += archetype->GetEntityCount();
+			header.BlockCount += (archetype->GetEntityCount() + BlockCapacity - 1) / BlockCapacity;
+		}
+
+		std::string out;
+		WriteHeader(out, header);
+		for (AssetID id : assets)
+		{
+			const std::string& path = m_Assets->GetPath(id);
+			WriteU32(out, (uint32_t)id);
+			WriteU32(out, (uint32_t)(id >> 32));
+			out.push_back((char)m_Assets->GetType(id));
+			uint16_t length = (uint16_t)std::min(path.size(), (size_t)0xffff);
+			out.push_back((char)length);
+			out.push_back((char)(length >> 8));
+			out.append(path, 0, length);
+		}
+		file.write(out.data(), out.size());
+
+		for (const Scope<Archetype>& archetype : m_Scene->m_Archetypes)
+		{
+			uint32_t components = GetSavedComponents(*archetype);
+			uint32_t entityCount = archetype->GetEntityCount();
+			for (uint32_t first = 0; first < entityCount; first += BlockCapacity)
+			{
+				uint32_t count = std::min(entityCount - first, BlockCapacity);
+				out.clear();
+				WriteU32(out, components);
+				WriteU32(out, count);
+
+				if (components & (1u << (uint32_t)ComponentType::Transform))
+				{
+					ForEachRun(*archetype, first, count, [&](const Archetype::Chunk& chunk, uint32_t row, uint32_t run)
+					{
+						out.append((const char*)(archetype->GetArray<TransformComponent>(chunk) + row), run * sizeof(TransformComponent));
+					});
+				}
+				if (components & (1u << (uint32_t)ComponentType::Sprite))
+				{
+					ForEachRun(*archetype, first, count, [&](const Archetype::Chunk& chunk, uint32_t row, uint32_t run)
+					{
+						const SpriteComponent* sprites = archetype->GetArray<SpriteComponent>(chunk) + row;
+						for (uint32_t i = 0; i < run; i++)
+						{
+							SpriteRecord record = { { sprites[i].Color.r, sprites[i].Color.g, sprites[i].Color.b, sprites[i].Color.a },
+								sprites[i].TilingFactor, getIndex(sprites[i].Texture.get()) };
+							out.append((const char*)&record, sizeof(record));
+						}
+					});
+				}
+				if (components & (1u << (uint32_t)ComponentType::Mesh))
+				{
+					ForEachRun(*archetype, first, count, [&](const Archetype::Chunk& chunk, uint32_t row, uint32_t run)
+					{
+						const MeshComponent* meshes = archetype->GetArray<MeshComponent>(chunk) + row;
+						for (uint32_t i = 0; i < run; i++)
+						{
+							MeshRecord record = { getIndex(meshes[i].Mesh.get()), getIndex(meshes[i].Shader.get()) };
+							out.append((const char*)&record, sizeof(record));
+						}
+					});
+				}
+				if (components & (1u << (uint32_t)ComponentType::Light))
+				{
+					ForEachRun(*archetype, first, count, [&](const Archetype::Chunk& chunk, uint32_t row, uint32_t run)
+					{
+						out.append((const char*)(archetype->GetArray<LightComponent>(chunk) + row), run * sizeof(LightComponent));
+					});
+				}
+				file.write(out.data(), out.size());
+			}
+		}
+		return file.good();
+	}
+
+	bool SceneSerializer::Deserialize(const std::string& filepath)
+	{
+		GE_PROFILE_FUNCTION();
+
+		FileBuffer file = VFS::Read(filepath);
+		if (!file)
+		{
+			GE_CORE_ERROR("SceneSerializer could not open '{0}'.", filepath);
+			return false;
+		}
+
+		if (file.GetSize() >= sizeof(Magic) && memcmp(file.GetData(), Magic, sizeof(Magic)) == 0)
+		{
+			SceneLoader loader(*m_Scene, *m_Assets);
+			if (!loader.Open(file, filepath))
+				return false;
+			while (loader.Load())
+				;
+			return !loader.HasFailed();
+		}
+
+		std::istringstream stream(file.ToString());
+		return DeserializeText(stream, filepath);
+	}
+
+	bool SceneSerializer::DeserializeText(std::istream& stream, const std::string& filepath)
+	{
+		struct PendingEntity
+		{
+			uint32_t Components = 0;
+			TransformComponent Transform;
+			SpriteComponent Sprite;
+			MeshComponent Mesh;
+			LightComponent Light;
+		};
+
+		PendingEntity entity;
+		bool inEntity = false;
+		auto flush = [&]()
+		{
+			if (!inEntity)
+				return;
+
+			Entity created = m_Scene->CreateEntity();
+			if (entity.Components & (1u << (uint32_t)ComponentType::Transform))
+				m_Scene->AddComponent<TransformComponent>(created, entity.Transform);
+			if (entity.Components & (1u << (uint32_t)ComponentType::Sprite))
+				m_Scene->AddComponent<SpriteComponent>(created, std::move(entity.Sprite));
+			if (entity.Components & (1u << (uint32_t)ComponentType::Mesh))
+				m_Scene->AddComponent<MeshComponent>(created, std::move(entity.Mesh));
+			if (entity.Components & (1u << (uint32_t)ComponentType::Light))
+				m_Scene->AddComponent<LightComponent>(created, entity.Light);
+			entity = PendingEntity();
+		};
+
+		uint32_t lineNumber = 0;
+		auto fail = [&](const char* reason)
+		{
+			GE_CORE_ERROR("SceneSerializer: {0}({1}): {2}", filepath, lineNumber, reason);
+			return false;
+		};
+
+		// Declared assets of the expected type, null for id 0
+		auto readAsset = [&](std::istringstream& line, AssetType type, AssetID& id)
+		{
+			line >> std::hex >> id >> std::dec;
+			return line && (id == NullAsset || m_Assets->GetType(id) == type);
+		};
+
+		std::string text;
+		while (std::getline(stream, text))
+		{
+			lineNumber++;
+			size_t comment = text.find('#');
+			if (comment != std::string::npos)
+				text.resize(comment);
+
+			std::istringstream line(text);
+			std::string keyword;
+			if (!(line >> keyword))
+				continue;
+
+			if (keyword == "Scene")
+			{
+				uint32_t version = 0;
+				if (!(line >> version) || version > Version)
+					return fail("unsupported version");
+			}
+			else if (keyword == "Asset")
+			{
+				AssetID id;
+				std::string typeName, path;
+				if (!(line >> std::hex >> id >> std::dec >> typeName >> std::quoted(path)) || id == NullAsset)
+					return fail("expected Asset <id> <type> \"<path>\"");
+
+				AssetType type = AssetTypeFromName(typeName);
+				if (type == AssetType::None)
+					return fail("unknown asset type");
+				if (!m_Assets->Register(id, type, path))
+					return fail("asset id is already used by an asset of another type");
+			}
+			else if (keyword == "Entity")
+			{
+				flush();
+				inEntity = true;
+			}
+			else if (!inEntity)
+				return fail("component outside of an entity");
+			else if (keyword == "Transform")
+			{
+				TransformComponent& transform = entity.Transform;
+				glm::vec3 rotation;
+				line >> transform.Translation.x >> transform.Translation.y >> transform.Translation.z
+					>> rotation.x >> rotation.y >> rotation.z
+					>> transform.Scale.x >> transform.Scale.y >> transform.Scale.z;
+				if (!line)
+					return fail("expected Transform <translation xyz> <rotation xyz> <scale xyz>");
+				transform.Rotation = glm::radians(rotation);
+				entity.Components |= 1u << (uint32_t)ComponentType::Transform;
+			}
+			else if (keyword == "Sprite")
+			{
+				SpriteComponent& sprite = entity.Sprite;
+				AssetID texture;
+				line >> sprite.Color.r >> sprite.Color.g >> sprite.Color.b >> sprite.Color.a >> sprite.TilingFactor;
+				if (!line || !readAsset(line, AssetType::Texture2D, texture))
+					return fail("expected Sprite <color rgba> <tiling factor> <declared Texture2D id>");
+				sprite.Texture = m_Assets->GetTexture2D(texture);
+				entity.Components |= 1u << (uint32_t)ComponentType::Sprite;
+			}
+			else if (keyword == "Mesh")
+			{
+				AssetID mesh, shader;
+				if (!readAsset(line, AssetType::Mesh, mesh) || !readAsset(line, AssetType::Shader, shader))
+					return fail("expected Mesh <declared Mesh id> <declared Shader id>");
+				entity.Mesh.Mesh = m_Assets->GetMesh(mesh);
+				entity.Mesh.Shader = m_Assets->GetShader(shader);
+				entity.Components |= 1u << (uint32_t)ComponentType::Mesh;
+			}
+			else if (keyword == "Light")
+			{
+				LightComponent& light = entity.Light;
+				line >> light.Ambient.r >> light.Ambient.g >> light.Ambient.b
+					>> light.Diffuse.r >> light.Diffuse.g >> light.Diffuse.b
+					>> light.Specular.r >> light.Specular.g >> light.Specular.b
+					>> light.Constant >> light.Linear >> light.Quadratic >> light.Shininess;
+				if (!line)
+					return fail("expected Light <ambient rgb> <diffuse rgb> <specular rgb> <constant> <linear> <quadratic> <shininess>");
+				entity.Components |= 1u << (uint32_t)ComponentType::Light;
+			}
+			else
+				return fail("unknown keyword");
+		}
+		flush();
+		return true;
+	}
+
+	bool SceneLoader::Open(const std::string& filepath)
+	{
+		FileBuffer file = VFS::Read(filepath);
+		if (!file)
+		{
+			GE_CORE_ERROR("SceneLoader could not open '{0}'.", filepath);
+			m_Failed = true;
+			return false;
+		}
+		return Open(file, filepath);
+	}
+
+	bool SceneLoader::Open(const FileBuffer& file, const std::string& filepath)
+	{
+		GE_PROFILE_FUNCTION();
+
+		m_Filepath = filepath;
+		m_File = file;
+		m_Position = 0;
+
+		const uint8_t* header = ReadBytes(HeaderSize);
+		if (!header || !ReadHeader(header, HeaderSize, m_Header) || m_Header.Version == 0 || m_Header.Version > Version)
+			return Fail("not a binary scene of a supported version");
+
+		for (uint32_t i = 0; i < m_Header.AssetCount; i++)
+		{
+			const uint8_t* entry = ReadBytes(11);
+			if (!entry)
+				return Fail("truncated asset table");
+
+			AssetID id = ReadU32(entry) | ((AssetID)ReadU32(entry + 4) << 32);
+			AssetType type = (AssetType)entry[8];
+			size_t pathLength = entry[9] | (entry[10] << 8);
+			const uint8_t* pathData = ReadBytes(pathLength);
+			if (!pathData)
+				return Fail("truncated asset table");
+			std::string path((const char*)pathData, pathLength);
+			if (id == NullAsset || type == AssetType::None || type > AssetType::Mesh || !m_Assets->Register(id, type, path))
+				return Fail("invalid asset");
+
+			m_Textures.push_back(type == AssetType::Texture2D ? m_Assets->GetTexture2D(id) : nullptr);
+			m_Shaders.push_back(type == AssetType::Shader ? m_Assets->GetShader(id) : nullptr);
+			m_Meshes.push_back(type == AssetType::Mesh ? m_Assets->GetMesh(id) : nullptr);
+		}
+
+		// The counts size the reservation, so check them against what the file can hold
+		if ((uint64_t)m_Header.EntityCount > (uint64_t)m_Header.BlockCount * BlockCapacity ||
+			(uint64_t)m_Header.BlockCount * 8 > m_File.GetSize() - m_Position)
+			return Fail("entity count does not match the blocks");
+
+		m_Scene->ReserveEntities(m_Header.EntityCount);
+		return true;
+	}
+
+	bool SceneLoader::Load(uint32_t maxEntities)
+	{
+		GE_PROFILE_FUNCTION();
+
+		uint32_t target = m_LoadedCount + std::min(maxEntities, m_Header.EntityCount);
+		while (!m_Failed && m_LoadedBlocks < m_Header.BlockCount && m_LoadedCount < target)
+			LoadBlock();
+		return !m_Failed && m_LoadedBlocks < m_Header.BlockCount;
+	}
+
+	bool SceneLoader::LoadBlock()
+	{
+		const uint8_t* blockHeader = ReadBytes(8);
+		if (!blockHeader)
+			return Fail("truncated block");
+
+		uint32_t components = ReadU32(blockHeader);
+		uint32_t count = ReadU32(blockHeader + 4);
+		if ((components & ~AllComponents) || count == 0 || count > BlockCapacity)
+			return Fail("corrupt block");
+
+		const uint8_t* cursor = ReadBytes(count * GetRowSize(components));
+		if (!cursor)
+			return Fail("truncated block");
+
+		const uint8_t* columns[ComponentTypeCount] = {};
+		ComponentMask mask = 0;
+		for (uint32_t type = 0; type < ComponentTypeCount; type++)
+		{
+			if (!(components & (1u << type)))
+				continue;
+			columns[type] = cursor;
+			cursor += count * RecordSizes[type];
+			mask |= (ComponentMask)1 << GetComponentID((ComponentType)type);
+		}
+
+		// References are checked up front, rows must not be left half constructed
+		auto validIndex = [&](uint32_t index) { return index == NullIndex || index < m_Header.AssetCount; };
+		const uint8_t* sprites = columns[(uint32_t)ComponentType::Sprite];
+		const uint8_t* meshes = columns[(uint32_t)ComponentType::Mesh];
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (sprites)
+			{
+				SpriteRecord record;
+				memcpy(&record, sprites + i * sizeof(SpriteRecord), sizeof(SpriteRecord));
+				if (!validIndex(record.Texture))
+					return Fail("asset index out of range");
+			}
+			if (meshes)
+			{
+				MeshRecord record;
+				memcpy(&record, meshes + i * sizeof(MeshRecord), sizeof(MeshRecord));
+				if (!validIndex(record.Mesh) || !validIndex(record.Shader))
+					return Fail("asset index out of range");
+			}
+		}
+
+		const uint8_t* transforms = columns[(uint32_t)ComponentType::Transform];
+		const uint8_t* lights = columns[(uint32_t)ComponentType::Light];
+		uint32_t first = 0;
+		m_Scene->CreateEntities(mask, count, [&](Archetype& archetype, uint32_t chunkIndex, uint32_t row, uint32_t run)
+		{
+			const Archetype::Chunk& chunk = archetype.GetChunk(chunkIndex);
+			if (transforms)
+				memcpy(archetype.GetArray<TransformComponent>(chunk) + row, transforms + first * sizeof(TransformComponent), run * sizeof(TransformComponent));
+			if (lights)
+				memcpy(archetype.GetArray<LightComponent>(chunk) + row, lights + first * sizeof(LightComponent), run * sizeof(LightComponent));
+
+			if (sprites)
+			{
+				SpriteComponent* destination = archetype.GetArray<SpriteComponent>(chunk) + row;
+				for (uint32_t i = 0; i < run; i++)
+				{
+					SpriteRecord record;
+					memcpy(&record, sprites + (first + i) * sizeof(SpriteRecord), sizeof(SpriteRecord));
+					new(destination + i) SpriteComponent(record.Texture != NullIndex ? m_Textures[record.Texture] : nullptr, record.TilingFactor,
+						glm::vec4(record.Color[0], record.Color[1], record.Color[2], record.Color[3]));
+				}
+			}
+			if (meshes)
+			{
+				MeshComponent* destination = archetype.GetArray<MeshComponent>(chunk) + row;
+				for (uint32_t i = 0; i < run; i++)
+				{
+					MeshRecord record;
+					memcpy(&record, meshes + (first + i) * sizeof(MeshRecord), sizeof(MeshRecord));
+					new(destination + i) MeshComponent(record.Mesh != NullIndex ? m_Meshes[record.Mesh] : nullptr,
+						record.Shader != NullIndex ? m_Shaders[record.Shader] : nullptr);
+				}
+			}
+			first += run;
+		});
+
+		m_LoadedBlocks++;
+		m_LoadedCount += count;
+		return true;
+	}
+
+	const uint8_t* SceneLoader::ReadBytes(size_t size)
+	{
+		if (m_File.GetSize() - m_Position < size)
+			return nullptr;
+
+		const uint8_t* data = m_File.GetData() + m_Position;
+		m_Position += size;
+		return data;
+	}
+
+	bool SceneLoader::Fail(const char* reason)
+	{
+		GE_CORE_ERROR("SceneLoader: '{0}' {1}.", m_Filepath, reason);
+		m_Failed = true;
+		return false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Engine/Core/VFS.h"
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/AssetLibrary.h"
+#include "Engine/Scene/SceneFormat.h"
+
+namespace Engine {
+
+	// Saves and loads the Transform, Sprite, Mesh and Light components of a scene, other
+	// components are not saved. Assets are referred to by their AssetLibrary ids, assets that
+	// weren't loaded or added through the library are saved as none.
+	//
+	// Text (.gescene) is meant for authoring. One item per line, '#' starts a comment:
+	//   Scene 1
+	//   Asset <id in hex> <Texture2D|Shader|Mesh> "<path>"
+	//   Entity
+	//       Transform <translation xyz> <rotation xyz in degrees> <scale xyz>
+	//       Sprite <color rgba> <tiling factor> <texture id, 0 for none>
+	//       Mesh <mesh id> <shader id>
+	//       Light <ambient rgb> <diffuse rgb> <specular rgb> <constant> <linear> <quadratic> <shininess>
+	// Assets are declared before they are used. Saved files use AssetLibrary::GetID() of the
+	// path, hand written ones may use any other unique id.
+	// Binary (.gescenebin) is meant for shipping, see SceneFormat.h and SceneLoader.
+	class SceneSerializer
+	{
+	public:
+		SceneSerializer(Scene& scene, AssetLibrary& assets)
+			: m_Scene(&scene), m_Assets(&assets) {}
+
+		bool SerializeText(const std::string& filepath);
+		bool SerializeBinary(const std::string& filepath);
+
+		// Adds the entities of a file in either format to the scene. On errors the entities
+		// read up to that point stay in the scene.
+		bool Deserialize(const std::string& filepath);
+	private:
+		bool DeserializeText(std::istream& stream, const std::string& filepath);
+		// Assets used by the saved components, in order of first use
+		void CollectAssets(std::vector<AssetID>& assets, std::unordered_map<AssetID, uint32_t>& indices);
+	private:
+		Scene* m_Scene;
+		AssetLibrary* m_Assets;
+	};
+
+	// Loads a binary scene a block at a time, so a level can stream in over several frames.
+	// The file is read through the VFS and blocks are copied straight from it into the
+	// archetype chunks of their entities: nothing is allocated per entity and plain
+	// components are copied a chunk at a time.
+	class SceneLoader
+	{
+	public:
+		SceneLoader(Scene& scene, AssetLibrary& assets)
+			: m_Scene(&scene), m_Assets(&assets) {}
+
+		// Reads the header and the asset table and loads the assets the scene uses
+		bool Open(const std::string& filepath);
+		bool Open(const FileBuffer& file, const std::string& filepath);
+		// Loads whole blocks until at least maxEntities entities were created or the file
+		// ends. Returns true while blocks are left.
+		bool Load(uint32_t maxEntities = 0xffffffff);
+
+		inline bool HasFailed() const { return m_Failed; }
+		inline uint32_t GetLoadedCount() const { return m_LoadedCount; }
+		inline uint32_t GetEntityCount() const { return m_Header.EntityCount; }
+	private:
+		bool LoadBlock();
+		// Returns nullptr when fewer than size bytes are left
+		const uint8_t* ReadBytes(size_t size);
+		bool Fail(const char* reason);
+	private:
+		Scene* m_Scene;
+		AssetLibrary* m_Assets;
+
+		std::string m_Filepath;
+		FileBuffer m_File;
+		size_t m_Position = 0;
+		SceneFormat::Header m_Header;
+		uint32_t m_LoadedBlocks = 0;
+		uint32_t m_LoadedCount = 0;
+		bool m_Failed = false;
+
+		// Indexed by position in the asset table, null where the asset has another type
+		std::vector<Ref<Texture2D>> m_Textures;
+		std::vector<Ref<Shader>> m_Shaders;
+		std::vector<Ref<Mesh>> m_Meshes;
+	};
+}
\ No newline at end of file
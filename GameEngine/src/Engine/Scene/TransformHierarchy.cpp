@@ -0,0 +1,294 @@
+#include "gepch.h"
+#include "TransformHierarchy.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+	#define GE_TRANSFORM_SSE 1
+	#include <xmmintrin.h>
+#else
+	#define GE_TRANSFORM_SSE 0
+#endif
+
+namespace Engine {
+
+	// worlds[i] = worlds[parents[i]] * locals[i] over [begin, end). Parents come before their
+	// children, so every parent is final by the time its children read it.
+	static void ComputeWorldTransforms(const uint32_t* parents, const glm::mat4* locals, glm::mat4* worlds, uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			if (parents[i] == TransformHierarchy::Null)
+			{
+				worlds[i] = locals[i];
+				continue;
+			}
+
+#if GE_TRANSFORM_SSE
+			// Column c of the product is the parent's columns weighted by column c of the local matrix
+			const float* parent = &worlds[parents[i]][0][0];
+			const float* local = &locals[i][0][0];
+			float* world = &worlds[i][0][0];
+
+			__m128 column0 = _mm_loadu_ps(parent);
+			__m128 column1 = _mm_loadu_ps(parent + 4);
+			__m128 column2 = _mm_loadu_ps(parent + 8);
+			__m128 column3 = _mm_loadu_ps(parent + 12);
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				__m128 result = _mm_mul_ps(column0, _mm_set1_ps(local[c * 4 + 0]));
+				result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_set1_ps(local[c * 4 + 1])));
+				result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_set1_ps(local[c * 4 + 2])));
+				result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_set1_ps(local[c * 4 + 3])));
+				_mm_storeu_ps(world + c * 4, result);
+			}
+#else
+			worlds[i] = worlds[parents[i]] * locals[i];
+#endif
+		}
+	}
+
+	TransformNode TransformHierarchy::Create(TransformNode parent, const glm::mat4& local)
+	{
+		GE_CORE_ASSERT(parent.IsNull() || IsValid(parent), "Invalid parent");
+
+		TransformNode node = m_Links.Create();
+		uint32_t index = (uint32_t)m_Nodes.size();
+		m_Links.Get(node)->Index = index;
+
+		m_Nodes.push_back(node);
+		m_Parents.push_back(Null);
+		m_SubtreeEnds.push_back(index + 1);
+		m_Locals.push_back(local);
+		m_Worlds.push_back(local);
+		m_Dirty.push_back(0);
+
+		Link(node, parent);
+		MarkDirty(index);
+
+		// A root at the end of the arrays keeps them sorted
+		if (parent)
+			m_NeedsSort = true;
+		return node;
+	}
+
+	void TransformHierarchy::Destroy(TransformNode node)
+	{
+		GE_CORE_ASSERT(IsValid(node), "Invalid transform node");
+
+		Unlink(node);
+
+		std::vector<TransformNode> stack = { node };
+		while (!stack.empty())
+		{
+			TransformNode current = stack.back();
+			stack.pop_back();
+			for (TransformNode child = m_Links.Get(current)->FirstChild; child; child = m_Links.Get(child)->NextSibling)
+				stack.push_back(child);
+			m_Links.Destroy(current);
+		}
+
+		// The arrays still hold the destroyed nodes until they are sorted
+		m_NeedsSort = true;
+	}
+
+	void TransformHierarchy::SetParent(TransformNode node, TransformNode parent)
+	{
+		GE_CORE_ASSERT(IsValid(node) && (parent.IsNull() || IsValid(parent)), "Invalid transform node");
+#ifdef GE_ENABLE_ASSERTS
+		for (TransformNode ancestor = parent; ancestor; ancestor = m_Links.Get(ancestor)->Parent)
+			GE_CORE_ASSERT(ancestor != node, "A node can't be parented to its own subtree");
+#endif
+
+		if (m_Links.Get(node)->Parent == parent)
+			return;
+
+		Unlink(node);
+		Link(node, parent);
+		MarkDirty(m_Links.Get(node)->Index);
+		m_NeedsSort = true;
+	}
+
+	TransformNode TransformHierarchy::GetParent(TransformNode node) const
+	{
+		const Links* links = m_Links.Get(node);
+		GE_CORE_ASSERT(links, "Invalid transform node");
+		return links->Parent;
+	}
+
+	void TransformHierarchy::SetLocalTransform(TransformNode node, const glm::mat4& local)
+	{
+		const Links* links = m_Links.Get(node);
+		GE_CORE_ASSERT(links, "Invalid transform node");
+		m_Locals[links->Index] = local;
+		MarkDirty(links->Index);
+	}
+
+	const glm::mat4& TransformHierarchy::GetLocalTransform(TransformNode node) const
+	{
+		const Links* links = m_Links.Get(node);
+		GE_CORE_ASSERT(links, "Invalid transform node");
+		return m_Locals[links->Index];
+	}
+
+	const glm::mat4& TransformHierarchy::GetWorldTransform(TransformNode node) const
+	{
+		const Links* links = m_Links.Get(node);
+		GE_CORE_ASSERT(links, "Invalid transform node");
+		return m_Worlds[links->Index];
+	}
+
+	void TransformHierarchy::Update()
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (m_NeedsSort)
+			Sort();
+
+		m_UpdatedCount = 0;
+		uint32_t count = (uint32_t)m_Nodes.size();
+
+		// With many dirty nodes walking the flags in order is cheaper than sorting the list
+		if (m_DirtyList.size() * 16 > count)
+		{
+			for (uint32_t i = 0; i < count;)
+			{
+				if (!m_Dirty[i])
+				{
+					i++;
+					continue;
+				}
+
+				uint32_t end = m_SubtreeEnds[i];
+				ComputeWorldTransforms(m_Parents.data(), m_Locals.data(), m_Worlds.data(), i, end);
+				memset(m_Dirty.data() + i, 0, end - i);
+				m_UpdatedCount += end - i;
+				i = end;
+			}
+		}
+		else
+		{
+			std::sort(m_DirtyList.begin(), m_DirtyList.end());
+
+			// Subtrees are nested or disjoint, a node before the end of the last one is inside it
+			uint32_t updatedEnd = 0;
+			for (uint32_t index : m_DirtyList)
+			{
+				m_Dirty[index] = 0;
+				if (index < updatedEnd)
+					continue;
+
+				uint32_t end = m_SubtreeEnds[index];
+				ComputeWorldTransforms(m_Parents.data(), m_Locals.data(), m_Worlds.data(), index, end);
+				m_UpdatedCount += end - index;
+				updatedEnd = end;
+			}
+		}
+		m_DirtyList.clear();
+	}
+
+	void TransformHierarchy::Link(TransformNode node, TransformNode parent)
+	{
+		TransformNode& head = parent ? m_Links.Get(parent)->FirstChild : m_FirstRoot;
+
+		Links& links = *m_Links.Get(node);
+		links.Parent = parent;
+		links.PrevSibling = TransformNode();
+		links.NextSibling = head;
+		if (head)
+			m_Links.Get(head)->PrevSibling = node;
+		head = node;
+	}
+
+	void TransformHierarchy::Unlink(TransformNode node)
+	{
+		Links& links = *m_Links.Get(node);
+		if (links.PrevSibling)
+			m_Links.Get(links.PrevSibling)->NextSibling = links.NextSibling;
+		else if (links.Parent)
+			m_Links.Get(links.Parent)->FirstChild = links.NextSibling;
+		else
+			m_FirstRoot = links.NextSibling;
+
+		if (links.NextSibling)
+			m_Links.Get(links.NextSibling)->PrevSibling = links.PrevSibling;
+
+		links.Parent = TransformNode();
+		links.PrevSibling = TransformNode();
+		links.NextSibling = TransformNode();
+	}
+
+	void TransformHierarchy::MarkDirty(uint32_t index)
+	{
+		if (m_Dirty[index])
+			return;
+		m_Dirty[index] = 1;
+		m_DirtyList.push_back(index);
+	}
+
+	void TransformHierarchy::Sort()
+	{
+		GE_PROFILE_FUNCTION();
+
+		uint32_t count = m_Links.GetCount();
+		std::vector<TransformNode> nodes;
+		std::vector<uint32_t> parents;
+		std::vector<glm::mat4> locals, worlds;
+		std::vector<uint8_t> dirty;
+		nodes.reserve(count);
+		parents.reserve(count);
+		locals.reserve(count);
+		worlds.reserve(count);
+		dirty.reserve(count);
+		m_DirtyList.clear();
+
+		// Depth first: a node is emitted before the subtrees of its children, which the stack
+		// emits one after the other
+		struct Entry
+		{
+			TransformNode Node;
+			uint32_t Parent;
+		};
+		std::vector<Entry> stack;
+		for (TransformNode root = m_FirstRoot; root; root = m_Links.Get(root)->NextSibling)
+		{
+			stack.push_back({ root, Null });
+			while (!stack.empty())
+			{
+				Entry entry = stack.back();
+				stack.pop_back();
+
+				Links& links = *m_Links.Get(entry.Node);
+				uint32_t index = (uint32_t)nodes.size();
+				nodes.push_back(entry.Node);
+				parents.push_back(entry.Parent);
+				locals.push_back(m_Locals[links.Index]);
+				worlds.push_back(m_Worlds[links.Index]);
+				dirty.push_back(m_Dirty[links.Index]);
+				if (dirty.back())
+					m_DirtyList.push_back(index);
+				links.Index = index;
+
+				for (TransformNode child = links.FirstChild; child; child = m_Links.Get(child)->NextSibling)
+					stack.push_back({ child, index });
+			}
+		}
+
+		// Children come after their parents, so walking backwards completes every subtree
+		// before its end is passed up
+		std::vector<uint32_t> subtreeEnds(nodes.size());
+		for (uint32_t i = (uint32_t)nodes.size(); i > 0; i--)
+		{
+			uint32_t index = i - 1;
+			subtreeEnds[index] = std::max(subtreeEnds[index], index + 1);
+			if (parents[index] != Null)
+				subtreeEnds[parents[index]] = std::max(subtreeEnds[parents[index]], subtreeEnds[index]);
+		}
+
+		m_Nodes = std::move(nodes);
+		m_Parents = std::move(parents);
+		m_SubtreeEnds = std::move(subtreeEnds);
+		m_Locals = std::move(locals);
+		m_Worlds = std::move(worlds);
+		m_Dirty = std::move(dirty);
+		m_NeedsSort = false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Engine/Core/Handle.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Engine {
+
+	struct TransformNodeTag;
+	using TransformNode = Handle<TransformNodeTag>;
+
+	// Parent relative transforms and the world matrices derived from them. The nodes are kept
+	// in structure of arrays sorted depth first, so every parent comes before its children and
+	// a subtree is one contiguous range. Setting a local transform only marks the node, Update()
+	// recomputes the world matrices of the marked subtrees and nothing else.
+	// Creating, destroying and reparenting nodes is cheap, the arrays are re-sorted once by the
+	// next Update().
+	class TransformHierarchy
+	{
+	public:
+		static constexpr uint32_t Null = 0xffffffff;
+
+		// A null parent makes a root
+		TransformNode Create(TransformNode parent = TransformNode(), const glm::mat4& local = glm::mat4(1.0f));
+		// Destroys the node and its whole subtree
+		void Destroy(TransformNode node);
+		void SetParent(TransformNode node, TransformNode parent);
+		TransformNode GetParent(TransformNode node) const;
+		inline bool IsValid(TransformNode node) const { return m_Links.IsValid(node); }
+
+		void SetLocalTransform(TransformNode node, const glm::mat4& local);
+		const glm::mat4& GetLocalTransform(TransformNode node) const;
+		// As of the last Update()
+		const glm::mat4& GetWorldTransform(TransformNode node) const;
+
+		void Update();
+
+		inline uint32_t GetNodeCount() const { return m_Links.GetCount(); }
+		// World matrices recomputed by the last Update()
+		inline uint32_t GetUpdatedCount() const { return m_UpdatedCount; }
+	private:
+		struct Links
+		{
+			// Position in the sorted arrays
+			uint32_t Index = Null;
+			TransformNode Parent;
+			TransformNode FirstChild;
+			TransformNode PrevSibling;
+			TransformNode NextSibling;
+		};
+
+		void Link(TransformNode node, TransformNode parent);
+		void Unlink(TransformNode node);
+		void MarkDirty(uint32_t index);
+		void Sort();
+	private:
+		HandlePool<Links, TransformNodeTag> m_Links;
+		TransformNode m_FirstRoot;
+
+		// Sorted depth first, indexed by Links::Index
+		std::vector<TransformNode> m_Nodes;
+		std::vector<uint32_t> m_Parents;
+		// One past the last node of the subtree
+		std::vector<uint32_t> m_SubtreeEnds;
+		std::vector<glm::mat4> m_Locals;
+		std::vector<glm::mat4> m_Worlds;
+		std::vector<uint8_t> m_Dirty;
+
+		std::vector<uint32_t> m_DirtyList;
+		bool m_NeedsSort = false;
+		uint32_t m_UpdatedCount = 0;
+	};
+}
\ No newline at end of file
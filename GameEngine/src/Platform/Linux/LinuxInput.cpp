@@ -0,0 +1,48 @@
+#include "gepch.h"
+#include "LinuxInput.h"
+#include "Engine/Core/Application.h"
+
+#include <GLFW/glfw3.h>
+
+namespace Engine {
+
+	bool LinuxInput::IsKeyPressedImpl(int keycode)
+	{
+		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+		if (!window)
+			return false;
+		auto state = glfwGetKey(window, keycode);
+		return state == GLFW_PRESS || state == GLFW_REPEAT;
+	}
+
+	bool LinuxInput::IsMouseButtonPressedImpl(int button)
+	{
+		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+		if (!window)
+			return false;
+		auto state = glfwGetMouseButton(window, button);
+		return state == GLFW_PRESS;
+	}
+
+	std::pair<float, float> LinuxInput::GetMousePosImpl()
+	{
+		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+		if (!window)
+			return { 0.0f, 0.0f };
+		double xPos, yPos;
+		glfwGetCursorPos(window, &xPos, &yPos);
+		return { (float)xPos, (float)yPos };
+	}
+
+	float LinuxInput::GetMouseXImpl()
+	{
+		auto [x, y] = GetMousePosImpl();
+		return x;
+	}
+
+	float LinuxInput::GetMouseYImpl()
+	{
+		auto[x, y] = GetMousePosImpl();
+		return y;
+	}
+}
\ No newline at end of file
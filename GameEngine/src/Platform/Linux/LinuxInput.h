@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Engine/Core/Input.h"
+
+namespace Engine {
+
+	class LinuxInput : public Input
+	{
+	protected:
+		virtual bool IsKeyPressedImpl(int keycode) override;
+		virtual bool IsMouseButtonPressedImpl(int button) override;
+		virtual std::pair<float, float> GetMousePosImpl() override;
+		virtual float GetMouseXImpl() override;
+		virtual float GetMouseYImpl() override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "gepch.h"
+#include "LinuxMappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Engine {
+
+	LinuxMappedFile::~LinuxMappedFile()
+	{
+		if (m_Data)
+			munmap((void*)m_Data, m_Size);
+	}
+
+	bool LinuxMappedFile::Map(const std::string& filepath)
+	{
+		int file = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file < 0)
+			return false;
+
+		struct stat status;
+		if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode))
+		{
+			close(file);
+			return false;
+		}
+
+		// mmap refuses empty mappings
+		if (status.st_size > 0)
+		{
+			void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (data == MAP_FAILED)
+			{
+				close(file);
+				return false;
+			}
+			m_Data = (const uint8_t*)data;
+			m_Size = (size_t)status.st_size;
+		}
+
+		// The mapping keeps its own reference to the file
+		close(file);
+		return true;
+	}
+}
\ No newline at end of file
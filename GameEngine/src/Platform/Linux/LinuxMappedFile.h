@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Engine/Core/MappedFile.h"
+
+namespace Engine {
+
+	class LinuxMappedFile : public MappedFile
+	{
+	public:
+		virtual ~LinuxMappedFile();
+
+		bool Map(const std::string& filepath);
+	};
+}
\ No newline at end of file
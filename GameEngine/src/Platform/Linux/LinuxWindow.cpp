@@ -0,0 +1,207 @@
+#include "gepch.h"
+#include "LinuxWindow.h"
+
+#include "Engine/Events/EventBus.h"
+
+#include "Platform/OpenGL/OpenGLContext.h"
+
+namespace Engine {
+
+	static uint8_t s_GLFWWindowCount = 0;
+
+	static void GLFWErrorCallback(int error, const char* description)
+	{
+		GE_CORE_ERROR("GLFW Error ({0}): {1}", error, description);
+	}
+
+	LinuxWindow::LinuxWindow(const WindowProps& props)
+	{
+		GE_PROFILE_FUNCTION();
+		Init(props);
+	}
+
+	LinuxWindow::~LinuxWindow()
+	{
+		GE_PROFILE_FUNCTION();
+		Shutdown();
+	}
+
+	void LinuxWindow::Init(const WindowProps& props)
+	{
+		GE_PROFILE_FUNCTION();
+
+		m_Data.Title = props.Title;
+		m_Data.Width = props.Width;
+		m_Data.Height = props.Height;
+
+		GE_CORE_INFO("Creating window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+
+
+		if (s_GLFWWindowCount == 0)
+		{
+			GE_PROFILE_SCOPE("glfwInit");
+
+			int success = glfwInit();
+			GE_CORE_ASSERT(success, "Could not initialize GLFW!");
+			glfwSetErrorCallback(GLFWErrorCallback);
+		}
+
+		{
+			GE_PROFILE_SCOPE("glfwCreateWindow");
+
+			// Mesa hands out a compatibility context capped below 4.5 unless core is asked for
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+			glfwWindowHint(GLFW_VISIBLE, props.Visible ? GLFW_TRUE : GLFW_FALSE);
+			m_Window = glfwCreateWindow((int)props.Width, (int)props.Height, m_Data.Title.c_str(), nullptr, nullptr);
+			++s_GLFWWindowCount;
+		}
+
+		m_Context = CreateScope<OpenGLContext>(m_Window);
+		m_Context->Init();
+
+		glfwSetWindowUserPointer(m_Window, &m_Data);
+
+		///
+		//glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+		///
+
+		SetVSync(true);
+
+		// Set GLFW callbacks, events are recorded and dispatched later by the EventBus
+		glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Width = width;
+			data.Height = height;
+
+			QueuedEvent event;
+			event.Type = EventType::WindowResize;
+			event.WindowResize = { (uint32_t)width, (uint32_t)height };
+			data.Post(event);
+		});
+
+		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			QueuedEvent event;
+			event.Type = EventType::WindowClose;
+			data.Post(event);
+		});
+
+		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int modes)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			QueuedEvent event;
+			switch (action)
+			{
+				case GLFW_PRESS:	event.Type = EventType::KeyPressed; event.Key = { key, 0 }; break;
+				case GLFW_RELEASE:	event.Type = EventType::KeyReleased; event.Key = { key, 0 }; break;
+				case GLFW_REPEAT:	event.Type = EventType::KeyPressed; event.Key = { key, 1 }; break;
+				default:			return;
+			}
+			data.Post(event);
+		});
+
+		glfwSetCharCallback(m_Window, [](GLFWwindow* window, unsigned int keycode)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			QueuedEvent event;
+			event.Type = EventType::KeyTyped;
+			event.Key = { (int32_t)keycode, 0 };
+			data.Post(event);
+		});
+
+		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			QueuedEvent event;
+			switch (action)
+			{
+				case GLFW_PRESS:	event.Type = EventType::MouseButtonPressed; break;
+				case GLFW_RELEASE:	event.Type = EventType::MouseButtonReleased; break;
+				default:			return;
+			}
+			event.MouseButton = { button };
+			data.Post(event);
+		});
+
+		glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double xOffset, double yOffset)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			QueuedEvent event;
+			event.Type = EventType::MouseScrolled;
+			event.MouseScrolled = { (float)xOffset, (float)yOffset };
+			data.Post(event);
+		});
+
+		glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double xPos, double yPos)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			QueuedEvent event;
+			event.Type = EventType::MouseMoved;
+			event.MouseMoved = { (float)xPos, (float)yPos };
+			data.Post(event);
+		});
+	}
+
+	void LinuxWindow::Shutdown()
+	{
+		GE_PROFILE_FUNCTION();
+
+		glfwDestroyWindow(m_Window);
+		--s_GLFWWindowCount;
+
+		if (s_GLFWWindowCount == 0)
+			glfwTerminate();
+	}
+
+	inline std::pair<float, float> LinuxWindow::GetWindowPos() const
+	{
+		int x, y;
+		glfwGetWindowPos(m_Window, &x, &y);
+		return { x, y };
+	}
+
+	void LinuxWindow::OnUpdate()
+	{
+		GE_PROFILE_FUNCTION();
+
+		PollEvents();
+		SwapBuffers();
+	}
+
+	void LinuxWindow::PollEvents()
+	{
+		glfwPollEvents();
+	}
+
+	void LinuxWindow::SwapBuffers()
+	{
+		m_Context->SwapBuffers();
+	}
+
+	void LinuxWindow::SetVSync(bool enabled)
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (enabled)
+			glfwSwapInterval(1);
+		else
+			glfwSwapInterval(0);
+
+		m_Data.VSync = enabled;
+	}
+
+	bool LinuxWindow::IsVSync() const
+	{
+		return m_Data.VSync;
+	}
+}
\ No newline at end of file
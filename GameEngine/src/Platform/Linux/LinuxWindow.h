@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Engine/Core/Window.h"
+#include "Engine/Events/EventBus.h"
+#include "Engine/Renderer/GraphicsContext.h"
+
+#include <GLFW/glfw3.h>
+
+
+namespace Engine {
+
+	class LinuxWindow : public Window
+	{
+	public:
+		LinuxWindow(const WindowProps& props);
+		virtual ~LinuxWindow();
+
+		void OnUpdate() override;
+		void PollEvents() override;
+		void SwapBuffers() override;
+
+		inline unsigned int GetWidth() const override { return m_Data.Width; }
+		inline unsigned int GetHeight() const override { return m_Data.Height; }
+		virtual std::pair<float, float> GetWindowPos() const override;
+		// Window attributes
+		inline void SetEventBus(EventBus* bus) override { m_Data.Bus = bus; }
+		void SetVSync(bool enabled) override;
+		bool IsVSync() const override;
+
+		inline virtual void* GetNativeWindow() const { return m_Window; };
+		inline virtual GraphicsContext* GetContext() const override { return m_Context.get(); }
+	private:
+		virtual void Init(const WindowProps& props);
+		virtual void Shutdown();
+	private:
+		GLFWwindow* m_Window;
+		Scope<GraphicsContext> m_Context;
+
+		struct WindowData
+		{
+			std::string Title;
+			unsigned int Width, Height;
+			bool VSync;
+
+			// Events are dropped without a bus
+			EventBus* Bus = nullptr;
+
+			void Post(const QueuedEvent& event) { if (Bus) Bus->Post(event); }
+		};
+
+		WindowData m_Data;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include "gepch.h"
+#include "NullBuffer.h"
+
+#include "NullRendererAPI.h"
+
+namespace Engine {
+
+	NullVertexArray::NullVertexArray()
+		: m_RendererID(NullRendererAPI::NewRendererID())
+	{
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		GE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Engine/Renderer/VertexArray.h"
+
+namespace Engine {
+
+	// Null buffers keep no contents, only what the CPU side reads back (layout, index count)
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(uint32_t size) {}
+		NullVertexBuffer(void* vertices, uint32_t size) {}
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override {}
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+	private:
+		BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(uint32_t* indices, uint32_t count)
+			: m_Count(count) {}
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual uint32_t GetCount() const override { return m_Count; }
+	private:
+		uint32_t m_Count;
+	};
+
+	class NullStorageBuffer : public StorageBuffer
+	{
+	public:
+		NullStorageBuffer(uint32_t size) {}
+
+		virtual void Bind(uint32_t binding) const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override {}
+	};
+
+	class NullIndirectBuffer : public IndirectBuffer
+	{
+	public:
+		NullIndirectBuffer(uint32_t size) {}
+
+		virtual void Bind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override {}
+	};
+
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray();
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override { m_IndexBuffer = indexBuffer; }
+
+		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
+		virtual const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+	private:
+		uint32_t m_RendererID;
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+}
\ No newline at end of file
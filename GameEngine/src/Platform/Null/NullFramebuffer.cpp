@@ -0,0 +1,13 @@
+#include "gepch.h"
+#include "NullFramebuffer.h"
+
+#include "NullRendererAPI.h"
+
+namespace Engine {
+
+	NullFramebuffer::NullFramebuffer(uint32_t width, uint32_t height, FramebufferFormat format)
+		: m_RendererID(NullRendererAPI::NewRendererID()), m_Width(width), m_Height(height), m_Format(format),
+		m_ColorAttachment(NullRendererAPI::NewRendererID()), m_DepthAttachment(NullRendererAPI::NewRendererID())
+	{
+	}
+}
\ No newline at end of file
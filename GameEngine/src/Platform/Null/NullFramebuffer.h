@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Engine/Renderer/Framebuffer.h"
+
+namespace Engine {
+
+	class NullFramebuffer : public Framebuffer
+	{
+	public:
+		NullFramebuffer(uint32_t width, uint32_t height, FramebufferFormat format);
+
+		virtual void Resize(uint32_t width, uint32_t height) override { m_Width = width; m_Height = height; }
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void BindTexture(uint32_t slot = 0) const override {}
+
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual uint32_t GetColorAttachmentRendererID() const override { return m_ColorAttachment; }
+		virtual uint32_t GetDepthAttachmentRendererID() const override { return m_DepthAttachment; }
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Width, m_Height;
+		FramebufferFormat m_Format;
+
+		uint32_t m_ColorAttachment, m_DepthAttachment;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "gepch.h"
+#include "NullRendererAPI.h"
+
+namespace Engine {
+
+	static uint64_t s_CallCounts[(size_t)NullRendererAPI::Call::Count] = {};
+	static uint64_t s_IndexCount = 0;
+	static uint32_t s_NextRendererID = 1;
+
+	static void Count(NullRendererAPI::Call call)
+	{
+		++s_CallCounts[(size_t)call];
+	}
+
+	void NullRendererAPI::Init()
+	{
+		GE_CORE_INFO("Using the null RendererAPI, nothing will be drawn");
+	}
+
+	void NullRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		Count(Call::SetViewport);
+		++m_StateCalls;
+	}
+
+	void NullRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		Count(Call::SetClearColor);
+		++m_StateCalls;
+	}
+
+	void NullRendererAPI::Clear()
+	{
+		Count(Call::Clear);
+	}
+
+	void NullRendererAPI::DepthTest(bool depthTest)
+	{
+		Count(Call::DepthTest);
+		++m_StateCalls;
+	}
+
+	void NullRendererAPI::DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	{
+		Count(Call::DrawIndexed);
+		s_IndexCount += indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+	}
+
+	void NullRendererAPI::DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+	{
+		Count(Call::DrawIndexedBaseVertex);
+		s_IndexCount += indexCount;
+	}
+
+	void NullRendererAPI::DrawArrays(const Engine::Ref<VertexArray>& vertexArray)
+	{
+		Count(Call::DrawArrays);
+	}
+
+	void NullRendererAPI::MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount)
+	{
+		Count(Call::MultiDrawIndexedIndirect);
+	}
+
+	void NullRendererAPI::BindTexture(uint32_t slot, uint32_t rendererID)
+	{
+		Count(Call::BindTexture);
+		++m_StateCalls;
+	}
+
+	void NullRendererAPI::Finish()
+	{
+		Count(Call::Finish);
+	}
+
+	RendererAPI::StateStatistics NullRendererAPI::GetStateStats() const
+	{
+		StateStatistics stats;
+		stats.Issued = m_StateCalls;
+		return stats;
+	}
+
+	void NullRendererAPI::ResetStateStats()
+	{
+		m_StateCalls = 0;
+	}
+
+	uint64_t NullRendererAPI::GetCallCount(Call call)
+	{
+		return s_CallCounts[(size_t)call];
+	}
+
+	uint64_t NullRendererAPI::GetIndexCount()
+	{
+		return s_IndexCount;
+	}
+
+	void NullRendererAPI::ResetCallCounts()
+	{
+		memset(s_CallCounts, 0, sizeof(s_CallCounts));
+		s_IndexCount = 0;
+	}
+
+	uint32_t NullRendererAPI::NewRendererID()
+	{
+		return s_NextRendererID++;
+	}
+}
\ No newline at end of file
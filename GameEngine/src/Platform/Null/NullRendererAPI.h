@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Engine/Renderer/RendererAPI.h"
+
+namespace Engine {
+
+	// Accepts every call and only counts it. Lets the CPU side of the renderer (batching,
+	// culling, queue sorting) run and be measured on machines without a GPU or a display.
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		enum class Call
+		{
+			SetViewport = 0, SetClearColor, Clear, DepthTest,
+			DrawIndexed, DrawIndexedBaseVertex, DrawArrays, MultiDrawIndexedIndirect,
+			BindTexture, Finish, Count
+		};
+	public:
+		virtual void Init() override;
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		virtual void SetClearColor(const glm::vec4& color) override;
+		virtual void Clear() override;
+		virtual void DepthTest(bool depthTest) override;
+
+		virtual void DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex) override;
+		virtual void DrawArrays(const Engine::Ref<VertexArray>& vertexArray) override;
+		virtual void MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount) override;
+
+		virtual void BindTexture(uint32_t slot, uint32_t rendererID) override;
+
+		virtual void Finish() override;
+
+		// Every state call counts as issued, nothing is cached
+		virtual StateStatistics GetStateStats() const override;
+		virtual void ResetStateStats() override;
+
+		// Totals since the last ResetCallCounts(), static so they can be read without
+		// reaching through RenderCommand
+		static uint64_t GetCallCount(Call call);
+		// Indices submitted by direct draws, indirect draw counts live in the indirect buffer
+		static uint64_t GetIndexCount();
+		static void ResetCallCounts();
+
+		// Unique non zero ids for null resources, texture batching compares them
+		static uint32_t NewRendererID();
+	private:
+		uint32_t m_StateCalls = 0;
+	};
+}
\ No newline at end of file
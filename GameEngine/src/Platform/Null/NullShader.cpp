@@ -0,0 +1,23 @@
+#include "gepch.h"
+#include "NullShader.h"
+
+#include "NullRendererAPI.h"
+
+namespace Engine {
+
+	NullShader::NullShader(const std::string& filepath)
+		: m_RendererID(NullRendererAPI::NewRendererID())
+	{
+		// Same naming as OpenGLShader, so ShaderLibrary lookups match
+		auto lastSlash = filepath.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = filepath.rfind('.');
+		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filepath.substr(lastSlash, count);
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_Name(name), m_RendererID(NullRendererAPI::NewRendererID())
+	{
+	}
+}
\ No newline at end of file
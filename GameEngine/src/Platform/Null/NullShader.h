@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Engine/Renderer/Shader.h"
+
+namespace Engine {
+
+	// Sources are neither read nor compiled, uniforms are dropped
+	class NullShader : public Shader
+	{
+	public:
+		NullShader(const std::string& filepath);
+		NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void SetInt(const std::string& name, int value) override {}
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override {}
+		virtual void SetFloat(const std::string& name, float value) override {}
+		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override {}
+		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override {}
+		virtual void SetMat4(const std::string& name, const glm::mat4& value) override {}
+
+		virtual const std::string& GetName() const override { return m_Name; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+	private:
+		std::string m_Name;
+		uint32_t m_RendererID;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "gepch.h"
+#include "NullTexture.h"
+
+#include "NullRendererAPI.h"
+
+#include "stb_image.h"
+
+namespace Engine {
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height), m_RendererID(NullRendererAPI::NewRendererID())
+	{
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path)
+		: m_RendererID(NullRendererAPI::NewRendererID())
+	{
+		GE_PROFILE_FUNCTION();
+
+		// Reads the header only
+		int width, height, channels;
+		if (stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			m_Width = width;
+			m_Height = height;
+		}
+		else
+			GE_CORE_WARN("Failed to load image {0}", path);
+	}
+
+	NullTextureCube::NullTextureCube(const std::vector<std::string>& faces)
+		: m_RendererID(NullRendererAPI::NewRendererID())
+	{
+		int width, height, channels;
+		if (!faces.empty() && stbi_info(faces[0].c_str(), &width, &height, &channels))
+		{
+			m_Width = width;
+			m_Height = height;
+		}
+	}
+}
\ No newline at end of file
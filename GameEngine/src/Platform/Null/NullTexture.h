@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Engine/Renderer/Texture.h"
+
+namespace Engine {
+
+	// Keeps the size only, images are not decoded
+	class NullTexture2D : public Texture2D
+	{
+	public:
+		NullTexture2D(uint32_t width, uint32_t height);
+		NullTexture2D(const std::string& path);
+
+		virtual uint32_t GetWidth() const override { return m_Width; }
+		virtual uint32_t GetHeight() const override { return m_Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual void SetData(void* data, uint32_t size) override {}
+
+		virtual void Bind(uint32_t slot = 0) const override {}
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+	private:
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint32_t m_RendererID;
+	};
+
+	class NullTextureCube : public TextureCube
+	{
+	public:
+		NullTextureCube(const std::vector<std::string>& faces);
+
+		virtual uint32_t GetWidth() const override { return m_Width; }
+		virtual uint32_t GetHeight() const override { return m_Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual void Bind(uint32_t slot = 0) const override {}
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+	private:
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint32_t m_RendererID;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Engine/Renderer/TimerQuery.h"
+
+namespace Engine {
+
+	// Never produces results, the GPU profiler then shows no GPU track
+	class NullTimerQueryPool : public TimerQueryPool
+	{
+	public:
+		NullTimerQueryPool(uint32_t count)
+			: m_Count(count) {}
+
+		virtual void WriteTimestamp(uint32_t index) override {}
+
+		virtual bool IsResultAvailable(uint32_t index) const override { return false; }
+		virtual uint64_t GetResult(uint32_t index) const override { return 0; }
+		virtual uint64_t GetCurrentTimestamp() const override { return 0; }
+
+		virtual uint32_t GetCount() const override { return m_Count; }
+	private:
+		uint32_t m_Count;
+	};
+}
\ No newline at end of file
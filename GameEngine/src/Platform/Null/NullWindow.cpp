@@ -0,0 +1,11 @@
+#include "gepch.h"
+#include "NullWindow.h"
+
+namespace Engine {
+
+	NullWindow::NullWindow(const WindowProps& props)
+		: m_Width(props.Width), m_Height(props.Height)
+	{
+		GE_CORE_INFO("Creating headless window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+	}
+}
\ No newline at end of file
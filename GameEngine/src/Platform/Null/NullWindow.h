@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Engine/Core/Window.h"
+
+namespace Engine {
+
+	// Window without a native window or context, created for the null RendererAPI.
+	// Never sends events, so it is only closed by the code that owns it.
+	class NullWindow : public Window
+	{
+	public:
+		NullWindow(const WindowProps& props);
+
+		virtual void OnUpdate() override {}
+		virtual void PollEvents() override {}
+		virtual void SwapBuffers() override {}
+
+		virtual unsigned int GetWidth() const override { return m_Width; }
+		virtual unsigned int GetHeight() const override { return m_Height; }
+		virtual std::pair<float, float> GetWindowPos() const override { return { 0.0f, 0.0f }; }
+
+		virtual void SetEventBus(EventBus* bus) override {}
+		virtual void SetVSync(bool enabled) override { m_VSync = enabled; }
+		virtual bool IsVSync() const override { return m_VSync; }
+
+		virtual void* GetNativeWindow() const override { return nullptr; }
+		virtual GraphicsContext* GetContext() const override { return nullptr; }
+	private:
+		unsigned int m_Width, m_Height;
+		bool m_VSync = false;
+	};
+}
\ No newline at end of file
@@ -1,30 +1,37 @@
 #include "gepch.h"
 #include "OpenGLBuffer.h"
+#include "OpenGLRenderState.h"
+#include "Engine/Debug/MemoryTracker.h"
+#include "Engine/Renderer/RenderCapture.h"
 
 #include <glad/glad.h>
 
 namespace Engine {
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+		: m_Size(size)
 	{
 		GE_PROFILE_FUNCTION();
 
 		glCreateBuffers(1, &m_RendererID);
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		OpenGLRenderState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, m_Size);
 		//glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
 	}
 
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(void* vertices, uint32_t size)
+		: m_Size(size)
 	{
 		GE_PROFILE_FUNCTION();
 
 		glCreateBuffers(1, &m_RendererID);
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		OpenGLRenderState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, m_Size);
 		// Same as two above
 		//glNamedBufferData(m_RendererID, size, vertices, GL_STATIC_DRAW);
 	}
@@ -33,26 +40,31 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
+		OpenGLRenderState::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, -(int64_t)(m_Size));
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		OpenGLRenderState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLRenderState::BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		if (RenderCapture::IsCapturing())
+			RenderCapture::RecordBufferData(m_RendererID, 0, data, size);
+
+		OpenGLRenderState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 	}
 
@@ -72,26 +84,113 @@ namespace Engine {
 		//glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 		//glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
 		glNamedBufferData(m_RendererID, m_Count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, m_Count * sizeof(uint32_t));
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
 		GE_PROFILE_FUNCTION();
 
+		OpenGLRenderState::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, -(int64_t)(m_Count * sizeof(uint32_t)));
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		OpenGLRenderState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		OpenGLRenderState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	// Storage Buffer
+	OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size)
+		: m_Size(size)
+	{
+		GE_PROFILE_FUNCTION();
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, m_Size);
+	}
+
+	OpenGLStorageBuffer::~OpenGLStorageBuffer()
+	{
+		GE_PROFILE_FUNCTION();
+
+		OpenGLRenderState::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, -(int64_t)(m_Size));
+	}
+
+	void OpenGLStorageBuffer::Bind(uint32_t binding) const
+	{
+		OpenGLRenderState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
+	}
+
+	void OpenGLStorageBuffer::SetData(const void* data, uint32_t size)
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (RenderCapture::IsCapturing())
+			RenderCapture::RecordBufferData(m_RendererID, 0, data, size);
+
+		if (size > m_Size)
+		{
+			MemoryTracker::RecordGPU(GPUMemoryType::Buffer, (int64_t)size - m_Size);
+			m_Size = size;
+			glNamedBufferData(m_RendererID, m_Size, data, GL_DYNAMIC_DRAW);
+			return;
+		}
+		glNamedBufferSubData(m_RendererID, 0, size, data);
+	}
+
+	// Indirect Buffer
+	OpenGLIndirectBuffer::OpenGLIndirectBuffer(uint32_t size)
+		: m_Size(size)
+	{
+		GE_PROFILE_FUNCTION();
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, m_Size);
+	}
+
+	OpenGLIndirectBuffer::~OpenGLIndirectBuffer()
+	{
+		GE_PROFILE_FUNCTION();
+
+		OpenGLRenderState::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+		MemoryTracker::RecordGPU(GPUMemoryType::Buffer, -(int64_t)(m_Size));
+	}
+
+	void OpenGLIndirectBuffer::Bind() const
+	{
+		OpenGLRenderState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+	}
+
+	void OpenGLIndirectBuffer::SetData(const void* data, uint32_t size)
+	{
+		GE_PROFILE_FUNCTION();
+
+		if (RenderCapture::IsCapturing())
+			RenderCapture::RecordBufferData(m_RendererID, 0, data, size);
+
+		if (size > m_Size)
+		{
+			MemoryTracker::RecordGPU(GPUMemoryType::Buffer, (int64_t)size - m_Size);
+			m_Size = size;
+			glNamedBufferData(m_RendererID, m_Size, data, GL_DYNAMIC_DRAW);
+			return;
+		}
+		glNamedBufferSubData(m_RendererID, 0, size, data);
 	}
 }
\ No newline at end of file
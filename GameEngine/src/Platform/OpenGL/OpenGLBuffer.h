@@ -20,6 +20,7 @@ namespace Engine {
 		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 	private:
 		uint32_t m_RendererID;
+		uint32_t m_Size;
 		BufferLayout m_Layout;
 	};
 
@@ -37,4 +38,32 @@ namespace Engine {
 		uint32_t m_RendererID;
 		uint32_t m_Count;
 	};
+
+	class OpenGLStorageBuffer : public StorageBuffer
+	{
+	public:
+		OpenGLStorageBuffer(uint32_t size);
+		virtual ~OpenGLStorageBuffer();
+
+		virtual void Bind(uint32_t binding) const override;
+
+		virtual void SetData(const void* data, uint32_t size) override;
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Size;
+	};
+
+	class OpenGLIndirectBuffer : public IndirectBuffer
+	{
+	public:
+		OpenGLIndirectBuffer(uint32_t size);
+		virtual ~OpenGLIndirectBuffer();
+
+		virtual void Bind() const override;
+
+		virtual void SetData(const void* data, uint32_t size) override;
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Size;
+	};
 }
\ No newline at end of file
@@ -41,4 +41,13 @@ namespace Engine {
 
 		glfwSwapBuffers(m_WindowHandle);
 	}
+	void OpenGLContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_WindowHandle);
+	}
+
+	void OpenGLContext::ReleaseCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
 }
\ No newline at end of file
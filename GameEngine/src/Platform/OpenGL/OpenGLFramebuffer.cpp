@@ -1,9 +1,17 @@
 #include "gepch.h"
 #include "OpenGLFramebuffer.h"
+#include "Platform/OpenGL/OpenGLRenderState.h"
+#include "Engine/Debug/MemoryTracker.h"
 #include <glad/glad.h>
 
 namespace Engine {
 
+	// Bytes per pixel of the color attachment plus the packed depth/stencil attachment
+	static uint32_t BytesPerPixel(FramebufferFormat format)
+	{
+		uint32_t color = format == FramebufferFormat::RGBA16F ? 8 : 4;
+		return color + 4;
+	}
 
 	OpenGLFramebuffer::OpenGLFramebuffer(uint32_t width, uint32_t height, FramebufferFormat format)
 		: m_Format(format)
@@ -13,7 +21,12 @@ namespace Engine {
 
 	OpenGLFramebuffer::~OpenGLFramebuffer()
 	{
+		OpenGLRenderState::OnTextureDeleted(m_ColorAttachment);
+		OpenGLRenderState::OnTextureDeleted(m_DepthAttachment);
 		glDeleteFramebuffers(1, &m_RendererID);
+		glDeleteTextures(1, &m_ColorAttachment);
+		glDeleteTextures(1, &m_DepthAttachment);
+		MemoryTracker::RecordGPU(GPUMemoryType::RenderTarget, -m_MemorySize);
 	}
 
 	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
@@ -25,11 +38,17 @@ namespace Engine {
 		m_Height = height;
 		if (m_RendererID)
 		{
+			OpenGLRenderState::OnTextureDeleted(m_ColorAttachment);
+			OpenGLRenderState::OnTextureDeleted(m_DepthAttachment);
 			glDeleteFramebuffers(1, &m_RendererID);
 			glDeleteTextures(1, &m_ColorAttachment);
 			glDeleteTextures(1, &m_DepthAttachment);
+			MemoryTracker::RecordGPU(GPUMemoryType::RenderTarget, -m_MemorySize);
 		}
 
+		m_MemorySize = (int64_t)m_Width * m_Height * BytesPerPixel(m_Format);
+		MemoryTracker::RecordGPU(GPUMemoryType::RenderTarget, m_MemorySize);
+
 		glGenFramebuffers(1, &m_RendererID);
 		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 
@@ -63,12 +82,15 @@ namespace Engine {
 			GE_CORE_ERROR("Framebuffer is incomplete!");
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// Attachments were bound with raw gl calls to the active unit
+		OpenGLRenderState::InvalidateTextures();
 	}
 
 	void OpenGLFramebuffer::Bind() const
 	{
 		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Width, m_Height);
+		OpenGLRenderState::SetViewport(0, 0, m_Width, m_Height);
 	}
 
 	void OpenGLFramebuffer::Unbind() const
@@ -78,7 +100,6 @@ namespace Engine {
 
 	void OpenGLFramebuffer::BindTexture(uint32_t slot) const
 	{
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, m_ColorAttachment);
+		OpenGLRenderState::BindTextureUnit(slot, m_ColorAttachment);
 	}
 }
\ No newline at end of file
@@ -30,6 +30,7 @@ namespace Engine {
 		FramebufferFormat m_Format;
 
 		uint32_t m_ColorAttachment, m_DepthAttachment;
+		int64_t m_MemorySize = 0;
 	};
 
 }
\ No newline at end of file
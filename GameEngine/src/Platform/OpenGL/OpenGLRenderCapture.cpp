@@ -0,0 +1,628 @@
+#include "gepch.h"
+#include "OpenGLRenderCapture.h"
+#include "OpenGLShader.h"
+
+#include "Engine/Renderer/CaptureFormat.h"
+
+#include <glad/glad.h>
+
+namespace Engine {
+
+	using namespace CaptureFormat;
+
+	// How a uniform value of a GL type is read back
+	struct CaptureUniformType
+	{
+		enum class BaseType : uint8_t { Float, Int, UInt };
+
+		BaseType Base;
+		uint32_t Components;
+	};
+
+	static bool GetCaptureUniformType(uint32_t type, CaptureUniformType& info)
+	{
+		using BaseType = CaptureUniformType::BaseType;
+		switch (type)
+		{
+			case GL_FLOAT:				info = { BaseType::Float, 1 }; return true;
+			case GL_FLOAT_VEC2:			info = { BaseType::Float, 2 }; return true;
+			case GL_FLOAT_VEC3:			info = { BaseType::Float, 3 }; return true;
+			case GL_FLOAT_VEC4:			info = { BaseType::Float, 4 }; return true;
+			case GL_FLOAT_MAT2:			info = { BaseType::Float, 4 }; return true;
+			case GL_FLOAT_MAT3:			info = { BaseType::Float, 9 }; return true;
+			case GL_FLOAT_MAT4:			info = { BaseType::Float, 16 }; return true;
+			case GL_INT:
+			case GL_BOOL:				info = { BaseType::Int, 1 }; return true;
+			case GL_INT_VEC2:
+			case GL_BOOL_VEC2:			info = { BaseType::Int, 2 }; return true;
+			case GL_INT_VEC3:
+			case GL_BOOL_VEC3:			info = { BaseType::Int, 3 }; return true;
+			case GL_INT_VEC4:
+			case GL_BOOL_VEC4:			info = { BaseType::Int, 4 }; return true;
+			case GL_UNSIGNED_INT:		info = { BaseType::UInt, 1 }; return true;
+			case GL_UNSIGNED_INT_VEC2:	info = { BaseType::UInt, 2 }; return true;
+			case GL_UNSIGNED_INT_VEC3:	info = { BaseType::UInt, 3 }; return true;
+			case GL_UNSIGNED_INT_VEC4:	info = { BaseType::UInt, 4 }; return true;
+
+			// Samplers hold the texture unit
+			case GL_SAMPLER_2D:
+			case GL_SAMPLER_2D_SHADOW:
+			case GL_SAMPLER_2D_ARRAY:
+			case GL_SAMPLER_CUBE:
+			case GL_INT_SAMPLER_2D:
+			case GL_UNSIGNED_INT_SAMPLER_2D:
+				info = { BaseType::Int, 1 };
+				return true;
+		}
+		return false;
+	}
+
+	static bool IsSampler(uint32_t type)
+	{
+		switch (type)
+		{
+			case GL_SAMPLER_2D:
+			case GL_SAMPLER_2D_SHADOW:
+			case GL_SAMPLER_2D_ARRAY:
+			case GL_SAMPLER_CUBE:
+			case GL_INT_SAMPLER_2D:
+			case GL_UNSIGNED_INT_SAMPLER_2D:
+				return true;
+		}
+		return false;
+	}
+
+	static GLenum SamplerBindingQuery(uint32_t type)
+	{
+		switch (type)
+		{
+			case GL_SAMPLER_2D_ARRAY:	return GL_TEXTURE_BINDING_2D_ARRAY;
+			case GL_SAMPLER_CUBE:		return GL_TEXTURE_BINDING_CUBE_MAP;
+		}
+		return GL_TEXTURE_BINDING_2D;
+	}
+
+	// Formats that read back losslessly as RGBA8
+	static bool IsReadableFormat(GLint internalFormat)
+	{
+		switch (internalFormat)
+		{
+			case GL_R8:
+			case GL_RG8:
+			case GL_RGB:
+			case GL_RGB8:
+			case GL_RGBA:
+			case GL_RGBA8:
+			case GL_SRGB8:
+			case GL_SRGB8_ALPHA8:
+				return true;
+		}
+		return false;
+	}
+
+	OpenGLCaptureRendererAPI::OpenGLCaptureRendererAPI(Scope<RendererAPI> target)
+		: CaptureRendererAPI(std::move(target))
+	{
+		WriteHeader(m_Data, (uint32_t)RendererAPI::API::OpenGL);
+	}
+
+	void OpenGLCaptureRendererAPI::Init()
+	{
+		m_Target->Init();
+	}
+
+	void OpenGLCaptureRendererAPI::BeginFrame(uint32_t frameIndex)
+	{
+		m_Data += (char)RecordType::Frame;
+		WriteVarint(m_Data, frameIndex);
+	}
+
+	void OpenGLCaptureRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		m_Data += (char)RecordType::Viewport;
+		WriteVarint(m_Data, x);
+		WriteVarint(m_Data, y);
+		WriteVarint(m_Data, width);
+		WriteVarint(m_Data, height);
+
+		m_Target->SetViewport(x, y, width, height);
+	}
+
+	void OpenGLCaptureRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		m_Data += (char)RecordType::ClearColor;
+		for (uint32_t i = 0; i < 4; i++)
+			WriteFloat(m_Data, color[i]);
+
+		m_Target->SetClearColor(color);
+	}
+
+	void OpenGLCaptureRendererAPI::Clear()
+	{
+		uint32_t framebuffer = GetDrawFramebuffer();
+		GLfloat color[4];
+		glGetFloatv(GL_COLOR_CLEAR_VALUE, color);
+
+		m_Data += (char)RecordType::Clear;
+		WriteVarint(m_Data, framebuffer);
+		for (uint32_t i = 0; i < 4; i++)
+			WriteFloat(m_Data, color[i]);
+
+		m_Target->Clear();
+	}
+
+	void OpenGLCaptureRendererAPI::DepthTest(bool depthTest)
+	{
+		m_Data += (char)RecordType::DepthTest;
+		WriteVarint(m_Data, depthTest ? 1 : 0);
+
+		m_Target->DepthTest(depthTest);
+	}
+
+	void OpenGLCaptureRendererAPI::DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	{
+		DrawParams params;
+		params.Count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		RecordDraw((uint8_t)DrawKind::Indexed, vertexArray, params);
+
+		m_Target->DrawIndexed(vertexArray, indexCount);
+	}
+
+	void OpenGLCaptureRendererAPI::DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+	{
+		DrawParams params;
+		params.Count = indexCount;
+		params.First = firstIndex;
+		params.BaseVertex = baseVertex;
+		RecordDraw((uint8_t)DrawKind::IndexedBaseVertex, vertexArray, params);
+
+		m_Target->DrawIndexedBaseVertex(vertexArray, indexCount, firstIndex, baseVertex);
+	}
+
+	void OpenGLCaptureRendererAPI::DrawArrays(const Engine::Ref<VertexArray>& vertexArray)
+	{
+		// Same fixed count as OpenGLRendererAPI::DrawArrays
+		DrawParams params;
+		params.Count = 36;
+		RecordDraw((uint8_t)DrawKind::Arrays, vertexArray, params);
+
+		m_Target->DrawArrays(vertexArray);
+	}
+
+	void OpenGLCaptureRendererAPI::MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount)
+	{
+		indirectBuffer->Bind();
+		GLint indirect = 0;
+		glGetIntegerv(GL_DRAW_INDIRECT_BUFFER_BINDING, &indirect);
+
+		DrawParams params;
+		params.First = firstCommand;
+		params.IndirectBuffer = indirect;
+		params.DrawCount = drawCount;
+		RecordDraw((uint8_t)DrawKind::MultiIndexedIndirect, vertexArray, params);
+
+		m_Target->MultiDrawIndexedIndirect(vertexArray, indirectBuffer, firstCommand, drawCount);
+	}
+
+	void OpenGLCaptureRendererAPI::BindTexture(uint32_t slot, uint32_t rendererID)
+	{
+		DefineTexture(rendererID);
+		m_Data += (char)RecordType::BindTexture;
+		WriteVarint(m_Data, slot);
+		WriteVarint(m_Data, rendererID);
+
+		m_Target->BindTexture(slot, rendererID);
+	}
+
+	void OpenGLCaptureRendererAPI::Finish()
+	{
+		m_Data += (char)RecordType::Finish;
+		m_Target->Finish();
+	}
+
+	RendererAPI::StateStatistics OpenGLCaptureRendererAPI::GetStateStats() const
+	{
+		return m_Target->GetStateStats();
+	}
+
+	void OpenGLCaptureRendererAPI::ResetStateStats()
+	{
+		m_Target->ResetStateStats();
+	}
+
+	void OpenGLCaptureRendererAPI::RecordBufferData(uint32_t rendererID, uint32_t offset, const void* data, uint32_t size)
+	{
+		// Snapshot the contents before the upload replaces them
+		DefineBuffer(rendererID);
+
+		m_Data += (char)RecordType::BufferData;
+		WriteVarint(m_Data, rendererID);
+		WriteVarint(m_Data, offset);
+		WriteBytes(m_Data, data, size);
+	}
+
+	void OpenGLCaptureRendererAPI::RecordTextureData(uint32_t rendererID, uint32_t dataFormat, const void* data, uint32_t size)
+	{
+		DefineTexture(rendererID);
+
+		m_Data += (char)RecordType::TextureData;
+		WriteVarint(m_Data, rendererID);
+		WriteVarint(m_Data, dataFormat);
+		WriteBytes(m_Data, data, size);
+	}
+
+	void OpenGLCaptureRendererAPI::RecordDraw(uint8_t kind, const Ref<VertexArray>& vertexArray, const DrawParams& params)
+	{
+		GE_PROFILE_FUNCTION();
+
+		// Attribute buffer bindings can only be queried from the bound vertex array,
+		// callers have it bound already so this is elided by the state cache
+		vertexArray->Bind();
+
+		uint32_t framebuffer = GetDrawFramebuffer();
+
+		GLint program = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+		DefineProgram(program);
+
+		uint32_t uniforms = 0, bindings = 0;
+		if (program)
+			DefineProgramState(program, uniforms, bindings);
+
+		uint32_t vertexInput = DefineVertexInput(vertexArray->GetRendererID());
+		uint32_t renderState = DefineRenderState();
+		DefineBuffer(params.IndirectBuffer);
+
+		m_Data += (char)RecordType::Draw;
+		m_Data += (char)kind;
+		WriteVarint(m_Data, framebuffer);
+		WriteVarint(m_Data, program);
+		WriteVarint(m_Data, vertexInput);
+		WriteVarint(m_Data, uniforms);
+		WriteVarint(m_Data, bindings);
+		WriteVarint(m_Data, renderState);
+		WriteVarint(m_Data, params.Count);
+		WriteVarint(m_Data, params.First);
+		WriteVarint(m_Data, params.BaseVertex);
+		WriteVarint(m_Data, params.IndirectBuffer);
+		WriteVarint(m_Data, params.DrawCount);
+	}
+
+	void OpenGLCaptureRendererAPI::DefineBuffer(uint32_t buffer)
+	{
+		if (!buffer || !m_Buffers.insert(buffer).second)
+			return;
+
+		GLint64 size = 0;
+		glGetNamedBufferParameteri64v(buffer, GL_BUFFER_SIZE, &size);
+		std::vector<uint8_t> contents((size_t)size);
+		if (size)
+			glGetNamedBufferSubData(buffer, 0, (GLsizeiptr)size, contents.data());
+
+		m_Data += (char)RecordType::Buffer;
+		WriteVarint(m_Data, buffer);
+		WriteBytes(m_Data, contents.data(), contents.size());
+	}
+
+	void OpenGLCaptureRendererAPI::DefineTexture(uint32_t texture)
+	{
+		if (!texture || !m_Textures.insert(texture).second)
+			return;
+
+		GLint target = 0, internalFormat = 0, width = 0, height = 0, levels = 0;
+		glGetTextureParameteriv(texture, GL_TEXTURE_TARGET, &target);
+		glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+		glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_WIDTH, &width);
+		glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_HEIGHT, &height);
+
+		// Mutable textures report no immutable levels, count the allocated ones
+		glGetTextureParameteriv(texture, GL_TEXTURE_IMMUTABLE_LEVELS, &levels);
+		if (!levels)
+		{
+			for (levels = 1; levels < 16; levels++)
+			{
+				GLint levelWidth = 0;
+				glGetTextureLevelParameteriv(texture, levels, GL_TEXTURE_WIDTH, &levelWidth);
+				if (!levelWidth)
+					break;
+			}
+		}
+
+		GLint parameters[4] = {};
+		glGetTextureParameteriv(texture, GL_TEXTURE_MIN_FILTER, &parameters[0]);
+		glGetTextureParameteriv(texture, GL_TEXTURE_MAG_FILTER, &parameters[1]);
+		glGetTextureParameteriv(texture, GL_TEXTURE_WRAP_S, &parameters[2]);
+		glGetTextureParameteriv(texture, GL_TEXTURE_WRAP_T, &parameters[3]);
+
+		// Cube maps read back all six faces. Render targets get whatever was in them.
+		std::vector<uint8_t> pixels;
+		uint32_t faces = target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+		if ((target == GL_TEXTURE_2D || target == GL_TEXTURE_CUBE_MAP) && IsReadableFormat(internalFormat))
+		{
+			pixels.resize((size_t)width * height * 4 * faces);
+			glGetTextureImage(texture, 0, GL_RGBA, GL_UNSIGNED_BYTE, (GLsizei)pixels.size(), pixels.data());
+		}
+
+		m_Data += (char)RecordType::Texture;
+		WriteVarint(m_Data, texture);
+		WriteVarint(m_Data, target);
+		WriteVarint(m_Data, internalFormat);
+		WriteVarint(m_Data, width);
+		WriteVarint(m_Data, height);
+		WriteVarint(m_Data, levels);
+		for (GLint parameter : parameters)
+			WriteVarint(m_Data, parameter);
+		WriteBytes(m_Data, pixels.data(), pixels.size());
+	}
+
+	void OpenGLCaptureRendererAPI::DefineProgram(uint32_t program)
+	{
+		if (!program || !m_Programs.insert(program).second)
+			return;
+
+		const auto* sources = OpenGLShader::GetProgramSources(program);
+		if (!sources)
+			GE_CORE_WARN("RenderCapture: program {0} has no known sources, its draws will be skipped on replay", program);
+
+		m_Data += (char)RecordType::Program;
+		WriteVarint(m_Data, program);
+		WriteVarint(m_Data, sources ? sources->size() : 0);
+		if (sources)
+		{
+			for (auto& [stage, source] : *sources)
+			{
+				WriteVarint(m_Data, stage);
+				WriteBytes(m_Data, source.data(), source.size());
+			}
+		}
+	}
+
+	void OpenGLCaptureRendererAPI::DefineFramebuffer(uint32_t framebuffer)
+	{
+		if (!framebuffer || !m_Framebuffers.insert(framebuffer).second)
+			return;
+
+		GLint attachments[2] = {};
+		GLenum points[2] = { GL_COLOR_ATTACHMENT0, GL_DEPTH_ATTACHMENT };
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			GLint type = GL_NONE;
+			glGetNamedFramebufferAttachmentParameteriv(framebuffer, points[i], GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type);
+			if (type != GL_TEXTURE)
+				continue;
+
+			glGetNamedFramebufferAttachmentParameteriv(framebuffer, points[i], GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &attachments[i]);
+			DefineTexture(attachments[i]);
+		}
+
+		m_Data += (char)RecordType::Framebuffer;
+		WriteVarint(m_Data, framebuffer);
+		WriteVarint(m_Data, attachments[0]);
+		WriteVarint(m_Data, attachments[1]);
+	}
+
+	uint32_t OpenGLCaptureRendererAPI::DefineState(uint8_t type, const std::string& payload)
+	{
+		std::string key;
+		key.reserve(payload.size() + 1);
+		key += (char)type;
+		key += payload;
+
+		auto it = m_States.find(key);
+		if (it != m_States.end())
+			return it->second;
+
+		uint32_t id = (uint32_t)m_States.size() + 1;
+		m_States.emplace(std::move(key), id);
+
+		m_Data += (char)type;
+		WriteVarint(m_Data, id);
+		m_Data += payload;
+		return id;
+	}
+
+	uint32_t OpenGLCaptureRendererAPI::DefineVertexInput(uint32_t vertexArray)
+	{
+		GLint elementBuffer = 0;
+		glGetVertexArrayiv(vertexArray, GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+		DefineBuffer(elementBuffer);
+
+		GLint maxAttributes = 0;
+		glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxAttributes);
+
+		std::string attributes;
+		uint32_t attributeCount = 0;
+		for (GLint i = 0; i < maxAttributes; i++)
+		{
+			GLint enabled = 0;
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+			if (!enabled)
+				continue;
+
+			GLint buffer = 0, size = 0, type = 0, normalized = 0, integer = 0, stride = 0, divisor = 0;
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &buffer);
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &size);
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &stride);
+			glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+			void* pointer = nullptr;
+			glGetVertexAttribPointerv(i, GL_VERTEX_ATTRIB_ARRAY_POINTER, &pointer);
+			DefineBuffer(buffer);
+
+			WriteVarint(attributes, i);
+			WriteVarint(attributes, buffer);
+			WriteVarint(attributes, size);
+			WriteVarint(attributes, type);
+			WriteVarint(attributes, normalized);
+			WriteVarint(attributes, integer);
+			WriteVarint(attributes, stride);
+			WriteVarint(attributes, (uint64_t)(uintptr_t)pointer);
+			WriteVarint(attributes, divisor);
+			attributeCount++;
+		}
+
+		std::string payload;
+		WriteVarint(payload, elementBuffer);
+		WriteVarint(payload, attributeCount);
+		payload += attributes;
+		return DefineState((uint8_t)RecordType::VertexInput, payload);
+	}
+
+	void OpenGLCaptureRendererAPI::DefineProgramState(uint32_t program, uint32_t& uniforms, uint32_t& bindings)
+	{
+		auto it = m_ProgramUniforms.find(program);
+		if (it == m_ProgramUniforms.end())
+		{
+			std::vector<ActiveUniform> active;
+			GLint uniformCount = 0;
+			glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+			for (GLint i = 0; i < uniformCount; i++)
+			{
+				char name[256];
+				GLsizei length = 0;
+				GLint size = 0;
+				GLenum type = 0;
+				glGetActiveUniform(program, i, sizeof(name), &length, &size, &type, name);
+
+				CaptureUniformType info;
+				if (!GetCaptureUniformType(type, info))
+					continue;
+
+				// Arrays are reported once as "name[0]"
+				std::string baseName(name, length);
+				if (size > 1 && baseName.size() > 3 && baseName.compare(baseName.size() - 3, 3, "[0]") == 0)
+					baseName.resize(baseName.size() - 3);
+
+				for (GLint element = 0; element < size; element++)
+				{
+					std::string elementName = size > 1 ? baseName + "[" + std::to_string(element) + "]" : baseName;
+					// Block members have no location, their buffers are captured as bindings
+					GLint location = glGetUniformLocation(program, elementName.c_str());
+					if (location >= 0)
+						active.push_back({ elementName, type, location });
+				}
+			}
+			it = m_ProgramUniforms.emplace(program, std::move(active)).first;
+		}
+
+		std::string values;
+		std::string textures;
+		uint32_t textureCount = 0;
+
+		GLint activeTexture = GL_TEXTURE0;
+		glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+		bool changedActiveTexture = false;
+
+		for (const ActiveUniform& uniform : it->second)
+		{
+			CaptureUniformType info;
+			GetCaptureUniformType(uniform.Type, info);
+
+			uint32_t value[16];
+			switch (info.Base)
+			{
+				case CaptureUniformType::BaseType::Float:	glGetUniformfv(program, uniform.Location, (GLfloat*)value); break;
+				case CaptureUniformType::BaseType::Int:		glGetUniformiv(program, uniform.Location, (GLint*)value); break;
+				case CaptureUniformType::BaseType::UInt:	glGetUniformuiv(program, uniform.Location, (GLuint*)value); break;
+			}
+
+			WriteBytes(values, uniform.Name.data(), uniform.Name.size());
+			WriteVarint(values, uniform.Type);
+			WriteBytes(values, value, info.Components * sizeof(uint32_t));
+
+			if (!IsSampler(uniform.Type))
+				continue;
+
+			// Texture unit bindings per target are only visible through the active unit
+			uint32_t unit = value[0];
+			glActiveTexture(GL_TEXTURE0 + unit);
+			changedActiveTexture = true;
+
+			GLint texture = 0;
+			glGetIntegerv(SamplerBindingQuery(uniform.Type), &texture);
+			DefineTexture(texture);
+
+			WriteVarint(textures, unit);
+			WriteVarint(textures, texture);
+			textureCount++;
+		}
+
+		if (changedActiveTexture)
+			glActiveTexture(activeTexture);
+
+		std::string blocks;
+		uint32_t blockCount = 0;
+		const GLenum interfaces[2] = { GL_UNIFORM_BLOCK, GL_SHADER_STORAGE_BLOCK };
+		const GLenum targets[2] = { GL_UNIFORM_BUFFER, GL_SHADER_STORAGE_BUFFER };
+		const GLenum bindingQueries[2] = { GL_UNIFORM_BUFFER_BINDING, GL_SHADER_STORAGE_BUFFER_BINDING };
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			GLint resourceCount = 0;
+			glGetProgramInterfaceiv(program, interfaces[i], GL_ACTIVE_RESOURCES, &resourceCount);
+			for (GLint resource = 0; resource < resourceCount; resource++)
+			{
+				GLenum property = GL_BUFFER_BINDING;
+				GLint binding = 0;
+				glGetProgramResourceiv(program, interfaces[i], resource, 1, &property, 1, nullptr, &binding);
+
+				GLint buffer = 0;
+				glGetIntegeri_v(bindingQueries[i], binding, &buffer);
+				DefineBuffer(buffer);
+
+				WriteVarint(blocks, targets[i]);
+				WriteVarint(blocks, binding);
+				WriteVarint(blocks, buffer);
+				blockCount++;
+			}
+		}
+
+		std::string payload;
+		WriteVarint(payload, program);
+		WriteVarint(payload, it->second.size());
+		payload += values;
+		uniforms = DefineState((uint8_t)RecordType::Uniforms, payload);
+
+		payload.clear();
+		WriteVarint(payload, textureCount);
+		payload += textures;
+		WriteVarint(payload, blockCount);
+		payload += blocks;
+		bindings = DefineState((uint8_t)RecordType::Bindings, payload);
+	}
+
+	uint32_t OpenGLCaptureRendererAPI::DefineRenderState()
+	{
+		GLboolean depthMask = GL_TRUE;
+		GLint depthFunc = 0, blendSrc = 0, blendDst = 0, cullMode = 0;
+		GLint viewport[4] = {};
+		glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+		glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+		glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrc);
+		glGetIntegerv(GL_BLEND_DST_RGB, &blendDst);
+		glGetIntegerv(GL_CULL_FACE_MODE, &cullMode);
+		glGetIntegerv(GL_VIEWPORT, viewport);
+
+		std::string payload;
+		WriteVarint(payload, glIsEnabled(GL_DEPTH_TEST));
+		WriteVarint(payload, depthMask);
+		WriteVarint(payload, depthFunc);
+		WriteVarint(payload, glIsEnabled(GL_BLEND));
+		WriteVarint(payload, blendSrc);
+		WriteVarint(payload, blendDst);
+		WriteVarint(payload, glIsEnabled(GL_CULL_FACE));
+		WriteVarint(payload, cullMode);
+		for (GLint value : viewport)
+			WriteVarint(payload, value);
+		return DefineState((uint8_t)RecordType::RenderState, payload);
+	}
+
+	uint32_t OpenGLCaptureRendererAPI::GetDrawFramebuffer()
+	{
+		GLint framebuffer = 0;
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+		DefineFramebuffer(framebuffer);
+		return framebuffer;
+	}
+}
\ No newline at end of file
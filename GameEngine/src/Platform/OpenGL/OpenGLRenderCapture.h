@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Engine/Renderer/RenderCapture.h"
+
+namespace Engine {
+
+	class OpenGLCaptureRendererAPI : public CaptureRendererAPI
+	{
+	public:
+		OpenGLCaptureRendererAPI(Scope<RendererAPI> target);
+
+		virtual void Init() override;
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		virtual void SetClearColor(const glm::vec4& color) override;
+		virtual void Clear() override;
+		virtual void DepthTest(bool depthTest) override;
+
+		virtual void DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex) override;
+		virtual void DrawArrays(const Engine::Ref<VertexArray>& vertexArray) override;
+		virtual void MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount) override;
+
+		virtual void BindTexture(uint32_t slot, uint32_t rendererID) override;
+
+		virtual void Finish() override;
+
+		virtual StateStatistics GetStateStats() const override;
+		virtual void ResetStateStats() override;
+
+		virtual void BeginFrame(uint32_t frameIndex) override;
+		virtual void RecordBufferData(uint32_t rendererID, uint32_t offset, const void* data, uint32_t size) override;
+		virtual void RecordTextureData(uint32_t rendererID, uint32_t dataFormat, const void* data, uint32_t size) override;
+
+		virtual const std::string& GetData() const override { return m_Data; }
+	private:
+		struct DrawParams
+		{
+			uint32_t Count = 0;
+			uint32_t First = 0;
+			uint32_t BaseVertex = 0;
+			uint32_t IndirectBuffer = 0;
+			uint32_t DrawCount = 0;
+		};
+
+		void RecordDraw(uint8_t kind, const Ref<VertexArray>& vertexArray, const DrawParams& params);
+
+		// Resources are written once, the first time they are referenced
+		void DefineBuffer(uint32_t buffer);
+		void DefineTexture(uint32_t texture);
+		void DefineProgram(uint32_t program);
+		void DefineFramebuffer(uint32_t framebuffer);
+
+		// State records are deduplicated by content, returns the record id
+		uint32_t DefineState(uint8_t type, const std::string& payload);
+		uint32_t DefineVertexInput(uint32_t vertexArray);
+		void DefineProgramState(uint32_t program, uint32_t& uniforms, uint32_t& bindings);
+		uint32_t DefineRenderState();
+
+		uint32_t GetDrawFramebuffer();
+	private:
+		std::string m_Data;
+
+		std::unordered_set<uint32_t> m_Buffers;
+		std::unordered_set<uint32_t> m_Textures;
+		std::unordered_set<uint32_t> m_Programs;
+		std::unordered_set<uint32_t> m_Framebuffers;
+
+		// Keyed by record type and payload
+		std::unordered_map<std::string, uint32_t> m_States;
+
+		struct ActiveUniform
+		{
+			std::string Name;
+			uint32_t Type;
+			int32_t Location;
+		};
+		// Uniforms outside of blocks, one entry per array element
+		std::unordered_map<uint32_t, std::vector<ActiveUniform>> m_ProgramUniforms;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,759 @@
+#include "gepch.h"
+#include "OpenGLRenderReplay.h"
+#include "OpenGLRenderState.h"
+
+#include "Engine/Renderer/TimerQuery.h"
+
+#include <chrono>
+#include <fstream>
+#include <glad/glad.h>
+
+namespace Engine {
+
+	using namespace CaptureFormat;
+
+	static const uint32_t s_Unknown = 0xffffffff;
+
+	// Latches the first read error so records can be parsed without checking every field
+	struct CaptureReader
+	{
+		const uint8_t*& Cursor;
+		const uint8_t* End;
+		bool Valid = true;
+
+		uint32_t U32()
+		{
+			uint32_t value = 0;
+			if (Valid && !ReadU32(Cursor, End, value))
+				Valid = false;
+			return value;
+		}
+
+		float Float()
+		{
+			float value = 0.0f;
+			if (Valid && !ReadFloat(Cursor, End, value))
+				Valid = false;
+			return value;
+		}
+
+		std::string Bytes()
+		{
+			std::string value;
+			if (Valid && !ReadBytes(Cursor, End, value))
+				Valid = false;
+			return value;
+		}
+
+		uint8_t Byte()
+		{
+			if (!Valid || Cursor >= End)
+			{
+				Valid = false;
+				return 0;
+			}
+			return *Cursor++;
+		}
+	};
+
+	// glTextureStorage2D only takes sized formats, mutable textures may report unsized ones
+	static GLenum SizedFormat(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+			case GL_RED:				return GL_R8;
+			case GL_RGB:				return GL_RGB8;
+			case GL_RGBA:				return GL_RGBA8;
+			case GL_DEPTH_COMPONENT:	return GL_DEPTH_COMPONENT24;
+			case GL_DEPTH_STENCIL:		return GL_DEPTH24_STENCIL8;
+		}
+		return internalFormat;
+	}
+
+	static uint32_t VertexTypeSize(GLenum type)
+	{
+		switch (type)
+		{
+			case GL_BYTE:
+			case GL_UNSIGNED_BYTE:		return 1;
+			case GL_SHORT:
+			case GL_UNSIGNED_SHORT:
+			case GL_HALF_FLOAT:			return 2;
+			case GL_DOUBLE:				return 8;
+		}
+		return 4;
+	}
+
+	static GLuint CompileProgram(const std::vector<std::pair<GLenum, std::string>>& stages)
+	{
+		GLuint program = glCreateProgram();
+		std::vector<GLuint> shaders;
+		for (auto& [type, source] : stages)
+		{
+			GLuint shader = glCreateShader(type);
+			const GLchar* sourceCstr = source.c_str();
+			glShaderSource(shader, 1, &sourceCstr, 0);
+			glCompileShader(shader);
+			glAttachShader(program, shader);
+			shaders.push_back(shader);
+		}
+
+		glLinkProgram(program);
+		for (GLuint shader : shaders)
+		{
+			glDetachShader(program, shader);
+			glDeleteShader(shader);
+		}
+
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			GLint maxLength = 0;
+			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+			std::vector<GLchar> infoLog(maxLength + 1);
+			glGetProgramInfoLog(program, maxLength, &maxLength, infoLog.data());
+			GE_CORE_ERROR("RenderReplay: program link failure {0}", infoLog.data());
+
+			glDeleteProgram(program);
+			return 0;
+		}
+		return program;
+	}
+
+	static void ApplyUniform(GLuint program, GLint location, GLenum type, const uint32_t* values)
+	{
+		const GLfloat* f = (const GLfloat*)values;
+		const GLint* i = (const GLint*)values;
+		const GLuint* u = (const GLuint*)values;
+		switch (type)
+		{
+			case GL_FLOAT:				glProgramUniform1fv(program, location, 1, f); return;
+			case GL_FLOAT_VEC2:			glProgramUniform2fv(program, location, 1, f); return;
+			case GL_FLOAT_VEC3:			glProgramUniform3fv(program, location, 1, f); return;
+			case GL_FLOAT_VEC4:			glProgramUniform4fv(program, location, 1, f); return;
+			case GL_FLOAT_MAT2:			glProgramUniformMatrix2fv(program, location, 1, GL_FALSE, f); return;
+			case GL_FLOAT_MAT3:			glProgramUniformMatrix3fv(program, location, 1, GL_FALSE, f); return;
+			case GL_FLOAT_MAT4:			glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, f); return;
+			case GL_UNSIGNED_INT:		glProgramUniform1uiv(program, location, 1, u); return;
+			case GL_UNSIGNED_INT_VEC2:	glProgramUniform2uiv(program, location, 1, u); return;
+			case GL_UNSIGNED_INT_VEC3:	glProgramUniform3uiv(program, location, 1, u); return;
+			case GL_UNSIGNED_INT_VEC4:	glProgramUniform4uiv(program, location, 1, u); return;
+			case GL_INT_VEC2:
+			case GL_BOOL_VEC2:			glProgramUniform2iv(program, location, 1, i); return;
+			case GL_INT_VEC3:
+			case GL_BOOL_VEC3:			glProgramUniform3iv(program, location, 1, i); return;
+			case GL_INT_VEC4:
+			case GL_BOOL_VEC4:			glProgramUniform4iv(program, location, 1, i); return;
+		}
+		// Ints, bools and samplers
+		glProgramUniform1iv(program, location, 1, i);
+	}
+
+	static void SetEnabled(GLenum capability, bool enabled)
+	{
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	OpenGLRenderReplay::~OpenGLRenderReplay()
+	{
+		for (auto& [id, buffer] : m_Buffers)
+			glDeleteBuffers(1, &buffer.RendererID);
+		for (auto& [id, texture] : m_Textures)
+			glDeleteTextures(1, &texture.RendererID);
+		for (auto& [id, program] : m_Programs)
+			glDeleteProgram(program);
+		for (auto& [id, framebuffer] : m_Framebuffers)
+			glDeleteFramebuffers(1, &framebuffer);
+		for (auto& [id, vertexArray] : m_VertexArrays)
+			glDeleteVertexArrays(1, &vertexArray);
+
+		OpenGLRenderState::Invalidate();
+	}
+
+	bool OpenGLRenderReplay::Load(const std::string& filepath)
+	{
+		GE_PROFILE_FUNCTION();
+
+		std::ifstream file(filepath, std::ios::binary);
+		if (!file.is_open())
+		{
+			GE_CORE_ERROR("RenderReplay could not open capture file '{0}'.", filepath);
+			return false;
+		}
+		std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		const uint8_t* cursor = (const uint8_t*)contents.data();
+		const uint8_t* end = cursor + contents.size();
+		uint32_t version = 0, api = 0;
+		if (!ReadHeader(cursor, contents.size(), version, api) || version > Version || api != (uint32_t)RendererAPI::API::OpenGL)
+		{
+			GE_CORE_ERROR("RenderReplay: '{0}' is not an OpenGL capture of a supported version.", filepath);
+			return false;
+		}
+		cursor += HeaderSize;
+
+		uint32_t frame = 0;
+		while (cursor < end)
+		{
+			RecordType type = (RecordType)*cursor++;
+			if (!ReadRecord(type, cursor, end, frame))
+			{
+				GE_CORE_ERROR("RenderReplay: '{0}' is truncated or corrupt at offset {1}.", filepath, cursor - (const uint8_t*)contents.data());
+				return false;
+			}
+		}
+
+		// Leave the context the way the engine expects it
+		glBindVertexArray(0);
+		OpenGLRenderState::Invalidate();
+
+		GE_CORE_INFO("RenderReplay loaded '{0}': {1} commands, {2} buffers, {3} textures, {4} programs",
+			filepath, m_Commands.size(), m_Buffers.size(), m_Textures.size(), m_Programs.size());
+		return true;
+	}
+
+	bool OpenGLRenderReplay::ReadRecord(RecordType type, const uint8_t*& cursor, const uint8_t* end, uint32_t& frame)
+	{
+		CaptureReader reader{ cursor, end };
+		ReplayCommand command;
+		command.Type = type;
+
+		switch (type)
+		{
+			case RecordType::Buffer:
+			{
+				uint32_t id = reader.U32();
+				std::string data = reader.Bytes();
+
+				ReplayBuffer& buffer = m_Buffers[id];
+				buffer.Size = (uint32_t)data.size();
+				glCreateBuffers(1, &buffer.RendererID);
+				glNamedBufferData(buffer.RendererID, buffer.Size, data.data(), GL_DYNAMIC_DRAW);
+				return reader.Valid;
+			}
+			case RecordType::Texture:
+			{
+				uint32_t id = reader.U32();
+				GLenum target = reader.U32();
+				GLenum internalFormat = SizedFormat(reader.U32());
+				uint32_t width = reader.U32();
+				uint32_t height = reader.U32();
+				uint32_t levels = reader.U32();
+				GLint parameters[4];
+				for (GLint& parameter : parameters)
+					parameter = (GLint)reader.U32();
+				std::string pixels = reader.Bytes();
+				if (!reader.Valid || !width || !height)
+					return reader.Valid;
+
+				ReplayTexture& texture = m_Textures[id];
+				texture.InternalFormat = internalFormat;
+				texture.Width = width;
+				texture.Height = height;
+
+				glCreateTextures(target, 1, &texture.RendererID);
+				glTextureStorage2D(texture.RendererID, std::max(levels, 1u), internalFormat, width, height);
+				glTextureParameteri(texture.RendererID, GL_TEXTURE_MIN_FILTER, parameters[0]);
+				glTextureParameteri(texture.RendererID, GL_TEXTURE_MAG_FILTER, parameters[1]);
+				glTextureParameteri(texture.RendererID, GL_TEXTURE_WRAP_S, parameters[2]);
+				glTextureParameteri(texture.RendererID, GL_TEXTURE_WRAP_T, parameters[3]);
+
+				if (!pixels.empty())
+				{
+					if (target == GL_TEXTURE_CUBE_MAP)
+						glTextureSubImage3D(texture.RendererID, 0, 0, 0, 0, width, height, 6, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+					else
+						glTextureSubImage2D(texture.RendererID, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+					if (levels > 1)
+						glGenerateTextureMipmap(texture.RendererID);
+				}
+				return true;
+			}
+			case RecordType::Program:
+			{
+				uint32_t id = reader.U32();
+				uint32_t stageCount = reader.U32();
+				std::vector<std::pair<GLenum, std::string>> stages;
+				for (uint32_t i = 0; i < stageCount && reader.Valid; i++)
+				{
+					GLenum stage = reader.U32();
+					stages.emplace_back(stage, reader.Bytes());
+				}
+				if (!reader.Valid)
+					return false;
+
+				m_Programs[id] = stages.empty() ? 0 : CompileProgram(stages);
+				return true;
+			}
+			case RecordType::Framebuffer:
+			{
+				uint32_t id = reader.U32();
+				uint32_t color = reader.U32();
+				uint32_t depth = reader.U32();
+
+				GLuint& framebuffer = m_Framebuffers[id];
+				glCreateFramebuffers(1, &framebuffer);
+				if (color)
+					glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, GetTexture(color), 0);
+				if (depth)
+				{
+					auto it = m_Textures.find(depth);
+					GLenum format = it != m_Textures.end() ? it->second.InternalFormat : 0;
+					bool hasStencil = format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+					glNamedFramebufferTexture(framebuffer, hasStencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT, GetTexture(depth), 0);
+				}
+				return reader.Valid;
+			}
+			case RecordType::VertexInput:
+			{
+				uint32_t id = reader.U32();
+				uint32_t elementBuffer = reader.U32();
+				uint32_t attributeCount = reader.U32();
+
+				GLuint& vertexArray = m_VertexArrays[id];
+				glCreateVertexArrays(1, &vertexArray);
+				if (elementBuffer)
+					glVertexArrayElementBuffer(vertexArray, GetBuffer(elementBuffer));
+
+				// glVertexAttribPointer maps attribute i to binding i, so does the replay
+				for (uint32_t i = 0; i < attributeCount && reader.Valid; i++)
+				{
+					uint32_t index = reader.U32();
+					uint32_t buffer = reader.U32();
+					GLint size = (GLint)reader.U32();
+					GLenum attributeType = reader.U32();
+					bool normalized = reader.U32() != 0;
+					bool integer = reader.U32() != 0;
+					uint32_t stride = reader.U32();
+					uint32_t offset = reader.U32();
+					uint32_t divisor = reader.U32();
+
+					// A stride of 0 means tightly packed for glVertexAttribPointer, but repeat for bindings
+					if (!stride)
+						stride = size * VertexTypeSize(attributeType);
+
+					glEnableVertexArrayAttrib(vertexArray, index);
+					glVertexArrayVertexBuffer(vertexArray, index, GetBuffer(buffer), offset, stride);
+					if (integer)
+						glVertexArrayAttribIFormat(vertexArray, index, size, attributeType, 0);
+					else
+						glVertexArrayAttribFormat(vertexArray, index, size, attributeType, normalized, 0);
+					glVertexArrayAttribBinding(vertexArray, index, index);
+					glVertexArrayBindingDivisor(vertexArray, index, divisor);
+				}
+				return reader.Valid;
+			}
+			case RecordType::Uniforms:
+			{
+				uint32_t id = reader.U32();
+				ReplayUniformSet set;
+				auto program = m_Programs.find(reader.U32());
+				set.Program = program != m_Programs.end() ? program->second : 0;
+
+				uint32_t count = reader.U32();
+				for (uint32_t i = 0; i < count && reader.Valid; i++)
+				{
+					std::string name = reader.Bytes();
+					ReplayUniform uniform = {};
+					uniform.Type = reader.U32();
+					std::string values = reader.Bytes();
+					memcpy(uniform.Values, values.data(), std::min(values.size(), sizeof(uniform.Values)));
+
+					uniform.Location = set.Program ? glGetUniformLocation(set.Program, name.c_str()) : -1;
+					if (uniform.Location >= 0)
+						set.Uniforms.push_back(uniform);
+				}
+
+				m_UniformSetIndices[id] = (uint32_t)m_UniformSets.size();
+				m_UniformSets.push_back(std::move(set));
+				return reader.Valid;
+			}
+			case RecordType::Bindings:
+			{
+				uint32_t id = reader.U32();
+				ReplayBindingSet set;
+				uint32_t textureCount = reader.U32();
+				for (uint32_t i = 0; i < textureCount && reader.Valid; i++)
+				{
+					uint32_t unit = reader.U32();
+					set.Textures.emplace_back(unit, GetTexture(reader.U32()));
+				}
+				uint32_t blockCount = reader.U32();
+				for (uint32_t i = 0; i < blockCount && reader.Valid; i++)
+				{
+					ReplayBindingSet::Block block;
+					block.Target = reader.U32();
+					block.Binding = reader.U32();
+					block.Buffer = GetBuffer(reader.U32());
+					set.Blocks.push_back(block);
+				}
+
+				m_BindingSetIndices[id] = (uint32_t)m_BindingSets.size();
+				m_BindingSets.push_back(std::move(set));
+				return reader.Valid;
+			}
+			case RecordType::RenderState:
+			{
+				uint32_t id = reader.U32();
+				ReplayRenderState state;
+				state.DepthTest = reader.U32() != 0;
+				state.DepthMask = reader.U32() != 0;
+				state.DepthFunc = reader.U32();
+				state.Blend = reader.U32() != 0;
+				state.BlendSrc = reader.U32();
+				state.BlendDst = reader.U32();
+				state.CullFace = reader.U32() != 0;
+				state.CullMode = reader.U32();
+				for (int32_t& value : state.Viewport)
+					value = (int32_t)reader.U32();
+
+				m_RenderStateIndices[id] = (uint32_t)m_RenderStates.size();
+				m_RenderStates.push_back(state);
+				return reader.Valid;
+			}
+
+			case RecordType::Frame:
+			{
+				frame = reader.U32();
+				return reader.Valid;
+			}
+			case RecordType::Viewport:
+			{
+				for (uint32_t i = 0; i < 4; i++)
+					command.Values[i] = reader.U32();
+				break;
+			}
+			case RecordType::ClearColor:
+			{
+				for (float& channel : command.Color)
+					channel = reader.Float();
+				break;
+			}
+			case RecordType::Clear:
+			{
+				auto framebuffer = m_Framebuffers.find(reader.U32());
+				command.Values[Framebuffer] = framebuffer != m_Framebuffers.end() ? framebuffer->second : 0;
+				for (float& channel : command.Color)
+					channel = reader.Float();
+				break;
+			}
+			case RecordType::DepthTest:
+			{
+				command.Values[0] = reader.U32();
+				break;
+			}
+			case RecordType::BindTexture:
+			{
+				command.Values[0] = reader.U32();
+				command.Values[1] = GetTexture(reader.U32());
+				break;
+			}
+			case RecordType::BufferData:
+			{
+				uint32_t id = reader.U32();
+				command.Values[0] = id;
+				command.Values[1] = reader.U32();
+				command.Data = reader.Bytes();
+				break;
+			}
+			case RecordType::TextureData:
+			{
+				command.Values[0] = reader.U32();
+				command.Values[1] = reader.U32();
+				command.Data = reader.Bytes();
+				break;
+			}
+			case RecordType::Draw:
+			{
+				command.Kind = (DrawKind)reader.Byte();
+				auto framebuffer = m_Framebuffers.find(reader.U32());
+				auto program = m_Programs.find(reader.U32());
+				auto vertexArray = m_VertexArrays.find(reader.U32());
+				command.Values[Framebuffer] = framebuffer != m_Framebuffers.end() ? framebuffer->second : 0;
+				command.Values[Program] = program != m_Programs.end() ? program->second : 0;
+				command.Values[VertexArray] = vertexArray != m_VertexArrays.end() ? vertexArray->second : 0;
+				command.Values[Uniforms] = GetSetIndex(m_UniformSetIndices, reader.U32());
+				command.Values[Bindings] = GetSetIndex(m_BindingSetIndices, reader.U32());
+				command.Values[RenderState] = GetSetIndex(m_RenderStateIndices, reader.U32());
+				command.Values[Count] = reader.U32();
+				command.Values[First] = reader.U32();
+				command.Values[BaseVertex] = reader.U32();
+				command.Values[IndirectBuffer] = GetBuffer(reader.U32());
+				command.Values[DrawCount] = reader.U32();
+				break;
+			}
+			case RecordType::Finish:
+				break;
+			default:
+				return false;
+		}
+
+		if (!reader.Valid)
+			return false;
+
+		ReplayCommandTiming timing;
+		timing.Frame = frame;
+		timing.Index = (uint32_t)m_Commands.size();
+		switch (type)
+		{
+			case RecordType::Viewport:		timing.Description = "Viewport"; break;
+			case RecordType::ClearColor:	timing.Description = "ClearColor"; break;
+			case RecordType::Clear:			timing.Description = "Clear framebuffer " + std::to_string(command.Values[Framebuffer]); break;
+			case RecordType::DepthTest:		timing.Description = command.Values[0] ? "DepthTest on" : "DepthTest off"; break;
+			case RecordType::BindTexture:	timing.Description = "BindTexture slot " + std::to_string(command.Values[0]); break;
+			case RecordType::BufferData:	timing.Description = "BufferData " + std::to_string(command.Data.size()) + " bytes"; break;
+			case RecordType::TextureData:	timing.Description = "TextureData " + std::to_string(command.Data.size()) + " bytes"; break;
+			case RecordType::Finish:		timing.Description = "Finish"; break;
+			case RecordType::Draw:
+			{
+				timing.Description = std::string(DrawKindName(command.Kind)) + " program " + std::to_string(command.Values[Program]);
+				if (command.Kind == DrawKind::MultiIndexedIndirect)
+					timing.Description += ", " + std::to_string(command.Values[DrawCount]) + " draws";
+				else
+					timing.Description += ", " + std::to_string(command.Values[Count]) + " vertices";
+				break;
+			}
+			default: break;
+		}
+
+		m_Commands.push_back(std::move(command));
+		m_Timings.push_back(std::move(timing));
+		return true;
+	}
+
+	void OpenGLRenderReplay::Run(uint32_t loops)
+	{
+		GE_PROFILE_FUNCTION();
+
+		uint32_t commandCount = (uint32_t)m_Commands.size();
+		if (!commandCount)
+			return;
+
+		// A timestamp before every command and one after the last
+		Scope<TimerQueryPool> queries = TimerQueryPool::Create(commandCount + 1);
+
+		for (uint32_t loop = 0; loop < loops; loop++)
+		{
+			m_Applied.Framebuffer = s_Unknown;
+			m_Applied.Program = s_Unknown;
+			m_Applied.VertexArray = s_Unknown;
+			m_Applied.Bindings = s_Unknown;
+			m_Applied.RenderState = s_Unknown;
+			m_Applied.ProgramUniforms.clear();
+
+			for (uint32_t i = 0; i < commandCount; i++)
+			{
+				queries->WriteTimestamp(i);
+				auto start = std::chrono::steady_clock::now();
+				Execute(m_Commands[i]);
+				auto end = std::chrono::steady_clock::now();
+				m_Timings[i].CPUTime += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+			}
+			queries->WriteTimestamp(commandCount);
+			glFinish();
+
+			for (uint32_t i = 0; i < commandCount; i++)
+			{
+				if (!queries->IsResultAvailable(i) || !queries->IsResultAvailable(i + 1))
+					continue;
+
+				uint64_t begin = queries->GetResult(i);
+				uint64_t end = queries->GetResult(i + 1);
+				if (end > begin)
+					m_Timings[i].GPUTime += end - begin;
+			}
+		}
+		m_LoopCount += loops;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glBindVertexArray(0);
+		OpenGLRenderState::Invalidate();
+	}
+
+	void OpenGLRenderReplay::Execute(const ReplayCommand& command)
+	{
+		const uint32_t* values = command.Values;
+		switch (command.Type)
+		{
+			case RecordType::Viewport:
+			{
+				glViewport(values[0], values[1], values[2], values[3]);
+				m_Applied.RenderState = s_Unknown;
+				return;
+			}
+			case RecordType::ClearColor:
+			{
+				glClearColor(command.Color[0], command.Color[1], command.Color[2], command.Color[3]);
+				return;
+			}
+			case RecordType::Clear:
+			{
+				if (m_Applied.Framebuffer != values[Framebuffer])
+				{
+					glBindFramebuffer(GL_DRAW_FRAMEBUFFER, values[Framebuffer]);
+					m_Applied.Framebuffer = values[Framebuffer];
+				}
+				glClearColor(command.Color[0], command.Color[1], command.Color[2], command.Color[3]);
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+				return;
+			}
+			case RecordType::DepthTest:
+			{
+				SetEnabled(GL_DEPTH_TEST, values[0] != 0);
+				m_Applied.RenderState = s_Unknown;
+				return;
+			}
+			case RecordType::BindTexture:
+			{
+				glBindTextureUnit(values[0], values[1]);
+				m_Applied.Bindings = s_Unknown;
+				return;
+			}
+			case RecordType::BufferData:
+			{
+				auto it = m_Buffers.find(values[0]);
+				if (it == m_Buffers.end())
+					return;
+
+				// Uploads past the end grew the buffer in the engine
+				ReplayBuffer& buffer = it->second;
+				uint32_t size = (uint32_t)command.Data.size();
+				if (values[1] == 0 && size > buffer.Size)
+				{
+					buffer.Size = size;
+					glNamedBufferData(buffer.RendererID, size, command.Data.data(), GL_DYNAMIC_DRAW);
+				}
+				else if (values[1] + size <= buffer.Size)
+					glNamedBufferSubData(buffer.RendererID, values[1], size, command.Data.data());
+				return;
+			}
+			case RecordType::TextureData:
+			{
+				auto it = m_Textures.find(values[0]);
+				if (it == m_Textures.end())
+					return;
+
+				const ReplayTexture& texture = it->second;
+				glTextureSubImage2D(texture.RendererID, 0, 0, 0, texture.Width, texture.Height, values[1], GL_UNSIGNED_BYTE, command.Data.data());
+				return;
+			}
+			case RecordType::Draw:
+			{
+				ExecuteDraw(command);
+				return;
+			}
+			case RecordType::Finish:
+			{
+				glFinish();
+				return;
+			}
+			default:
+				return;
+		}
+	}
+
+	void OpenGLRenderReplay::ExecuteDraw(const ReplayCommand& command)
+	{
+		const uint32_t* values = command.Values;
+		uint32_t program = values[Program];
+		if (!program || !values[VertexArray])
+			return;
+
+		if (m_Applied.Framebuffer != values[Framebuffer])
+		{
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, values[Framebuffer]);
+			m_Applied.Framebuffer = values[Framebuffer];
+		}
+
+		if (m_Applied.Program != program)
+		{
+			glUseProgram(program);
+			m_Applied.Program = program;
+		}
+
+		// Uniform values live in the program, so they are tracked per program
+		if (values[Uniforms])
+		{
+			uint32_t& applied = m_Applied.ProgramUniforms[program];
+			if (applied != values[Uniforms])
+			{
+				for (const ReplayUniform& uniform : m_UniformSets[values[Uniforms] - 1].Uniforms)
+					ApplyUniform(program, uniform.Location, uniform.Type, uniform.Values);
+				applied = values[Uniforms];
+			}
+		}
+
+		if (values[Bindings] && m_Applied.Bindings != values[Bindings])
+		{
+			const ReplayBindingSet& set = m_BindingSets[values[Bindings] - 1];
+			for (auto& [unit, texture] : set.Textures)
+				glBindTextureUnit(unit, texture);
+			for (const ReplayBindingSet::Block& block : set.Blocks)
+				glBindBufferBase(block.Target, block.Binding, block.Buffer);
+			m_Applied.Bindings = values[Bindings];
+		}
+
+		if (values[RenderState] && m_Applied.RenderState != values[RenderState])
+		{
+			const ReplayRenderState& state = m_RenderStates[values[RenderState] - 1];
+			SetEnabled(GL_DEPTH_TEST, state.DepthTest);
+			glDepthMask(state.DepthMask ? GL_TRUE : GL_FALSE);
+			glDepthFunc(state.DepthFunc);
+			SetEnabled(GL_BLEND, state.Blend);
+			glBlendFunc(state.BlendSrc, state.BlendDst);
+			SetEnabled(GL_CULL_FACE, state.CullFace);
+			glCullFace(state.CullMode);
+			glViewport(state.Viewport[0], state.Viewport[1], state.Viewport[2], state.Viewport[3]);
+			m_Applied.RenderState = values[RenderState];
+		}
+
+		if (m_Applied.VertexArray != values[VertexArray])
+		{
+			glBindVertexArray(values[VertexArray]);
+			m_Applied.VertexArray = values[VertexArray];
+		}
+
+		const void* indexOffset = (const void*)(intptr_t)(values[First] * sizeof(uint32_t));
+		switch (command.Kind)
+		{
+			case DrawKind::Indexed:
+				glDrawElements(GL_TRIANGLES, values[Count], GL_UNSIGNED_INT, indexOffset);
+				break;
+			case DrawKind::IndexedBaseVertex:
+				glDrawElementsBaseVertex(GL_TRIANGLES, values[Count], GL_UNSIGNED_INT, indexOffset, values[BaseVertex]);
+				break;
+			case DrawKind::Arrays:
+				glDrawArrays(GL_TRIANGLES, values[First], values[Count]);
+				break;
+			case DrawKind::MultiIndexedIndirect:
+			{
+				const void* offset = (const void*)(intptr_t)(values[First] * sizeof(DrawIndexedIndirectCommand));
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, values[IndirectBuffer]);
+				glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, values[DrawCount], 0);
+				break;
+			}
+		}
+	}
+
+	uint32_t OpenGLRenderReplay::GetBuffer(uint32_t id) const
+	{
+		auto it = m_Buffers.find(id);
+		return it != m_Buffers.end() ? it->second.RendererID : 0;
+	}
+
+	uint32_t OpenGLRenderReplay::GetTexture(uint32_t id) const
+	{
+		auto it = m_Textures.find(id);
+		return it != m_Textures.end() ? it->second.RendererID : 0;
+	}
+
+	uint32_t OpenGLRenderReplay::GetSetIndex(const std::unordered_map<uint32_t, uint32_t>& sets, uint32_t id) const
+	{
+		auto it = sets.find(id);
+		return it != sets.end() ? it->second + 1 : 0;
+	}
+}
\ No newline at end of file
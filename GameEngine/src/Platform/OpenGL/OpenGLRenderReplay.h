@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Engine/Renderer/RenderCapture.h"
+#include "Engine/Renderer/CaptureFormat.h"
+
+namespace Engine {
+
+	// Replays captures straight on the GL context. Draws re-apply their snapshotted state,
+	// skipping what the previous draw already set, and bypass OpenGLRenderState, which is
+	// invalidated after every Run().
+	class OpenGLRenderReplay : public RenderReplay
+	{
+	public:
+		OpenGLRenderReplay() = default;
+		virtual ~OpenGLRenderReplay();
+
+		virtual bool Load(const std::string& filepath) override;
+		virtual void Run(uint32_t loops) override;
+
+		virtual uint32_t GetLoopCount() const override { return m_LoopCount; }
+		virtual const std::vector<ReplayCommandTiming>& GetTimings() const override { return m_Timings; }
+	private:
+		struct ReplayBuffer
+		{
+			uint32_t RendererID = 0;
+			uint32_t Size = 0;
+		};
+
+		struct ReplayTexture
+		{
+			uint32_t RendererID = 0;
+			uint32_t InternalFormat = 0;
+			uint32_t Width = 0, Height = 0;
+		};
+
+		struct ReplayUniform
+		{
+			int32_t Location;
+			uint32_t Type;
+			uint32_t Values[16];
+		};
+
+		struct ReplayUniformSet
+		{
+			uint32_t Program = 0;
+			std::vector<ReplayUniform> Uniforms;
+		};
+
+		struct ReplayBindingSet
+		{
+			struct Block
+			{
+				uint32_t Target, Binding, Buffer;
+			};
+
+			// Texture unit and texture
+			std::vector<std::pair<uint32_t, uint32_t>> Textures;
+			std::vector<Block> Blocks;
+		};
+
+		struct ReplayRenderState
+		{
+			bool DepthTest, DepthMask, Blend, CullFace;
+			uint32_t DepthFunc, BlendSrc, BlendDst, CullMode;
+			int32_t Viewport[4];
+		};
+
+		// Draw arguments, ids are already resolved to GL names or to set index + 1
+		enum DrawValue
+		{
+			Framebuffer = 0, Program, VertexArray, Uniforms, Bindings, RenderState,
+			Count, First, BaseVertex, IndirectBuffer, DrawCount, DrawValueCount
+		};
+
+		struct ReplayCommand
+		{
+			CaptureFormat::RecordType Type;
+			CaptureFormat::DrawKind Kind = CaptureFormat::DrawKind::Indexed;
+			uint32_t Values[DrawValueCount] = {};
+			float Color[4] = {};
+			std::string Data;
+		};
+
+		bool ReadRecord(CaptureFormat::RecordType type, const uint8_t*& cursor, const uint8_t* end, uint32_t& frame);
+		void Execute(const ReplayCommand& command);
+		void ExecuteDraw(const ReplayCommand& command);
+
+		uint32_t GetBuffer(uint32_t id) const;
+		uint32_t GetTexture(uint32_t id) const;
+		uint32_t GetSetIndex(const std::unordered_map<uint32_t, uint32_t>& sets, uint32_t id) const;
+	private:
+		std::unordered_map<uint32_t, ReplayBuffer> m_Buffers;
+		std::unordered_map<uint32_t, ReplayTexture> m_Textures;
+		std::unordered_map<uint32_t, uint32_t> m_Programs;
+		std::unordered_map<uint32_t, uint32_t> m_Framebuffers;
+
+		// Capture state ids to GL vertex arrays and set indices
+		std::unordered_map<uint32_t, uint32_t> m_VertexArrays;
+		std::unordered_map<uint32_t, uint32_t> m_UniformSetIndices;
+		std::unordered_map<uint32_t, uint32_t> m_BindingSetIndices;
+		std::unordered_map<uint32_t, uint32_t> m_RenderStateIndices;
+
+		std::vector<ReplayUniformSet> m_UniformSets;
+		std::vector<ReplayBindingSet> m_BindingSets;
+		std::vector<ReplayRenderState> m_RenderStates;
+
+		std::vector<ReplayCommand> m_Commands;
+		std::vector<ReplayCommandTiming> m_Timings;
+		uint32_t m_LoopCount = 0;
+
+		// What the previous draw left bound, reset at the start of every loop
+		struct AppliedState
+		{
+			uint32_t Framebuffer, Program, VertexArray, Bindings, RenderState;
+			std::unordered_map<uint32_t, uint32_t> ProgramUniforms;
+		} m_Applied;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "gepch.h"
+#include "OpenGLRenderState.h"
+
+#include <glad/glad.h>
+
+namespace Engine {
+
+	static const uint32_t s_Unknown = 0xffffffff;
+
+	enum class CachedBufferTarget
+	{
+		Array = 0, ElementArray, Uniform, ShaderStorage, DrawIndirect, Count
+	};
+
+	static int CachedBufferTargetIndex(uint32_t target)
+	{
+		switch (target)
+		{
+			case GL_ARRAY_BUFFER:			return (int)CachedBufferTarget::Array;
+			case GL_ELEMENT_ARRAY_BUFFER:	return (int)CachedBufferTarget::ElementArray;
+			case GL_UNIFORM_BUFFER:			return (int)CachedBufferTarget::Uniform;
+			case GL_SHADER_STORAGE_BUFFER:	return (int)CachedBufferTarget::ShaderStorage;
+			case GL_DRAW_INDIRECT_BUFFER:	return (int)CachedBufferTarget::DrawIndirect;
+		}
+		return -1;
+	}
+
+	struct OpenGLRenderStateData
+	{
+		static const uint32_t MaxTextureUnits = 32;
+		static const uint32_t MaxBufferBindings = 16;
+
+		uint32_t Program = s_Unknown;
+		uint32_t VertexArray = s_Unknown;
+		std::array<uint32_t, (size_t)CachedBufferTarget::Count> Buffers;
+		std::array<uint32_t, MaxTextureUnits> TextureUnits;
+		// Indexed bindings of GL_UNIFORM_BUFFER and GL_SHADER_STORAGE_BUFFER
+		std::array<uint32_t, MaxBufferBindings> UniformBindings;
+		std::array<uint32_t, MaxBufferBindings> StorageBindings;
+
+		// 0 = disabled, 1 = enabled, s_Unknown = not known
+		uint32_t DepthTest = s_Unknown;
+		uint32_t Blend = s_Unknown;
+		uint32_t CullFace = s_Unknown;
+		uint32_t BlendSrc = s_Unknown, BlendDst = s_Unknown;
+
+		uint32_t Viewport[4] = { s_Unknown, s_Unknown, s_Unknown, s_Unknown };
+
+		RendererAPI::StateStatistics Stats;
+
+		OpenGLRenderStateData()
+		{
+			Buffers.fill(s_Unknown);
+			TextureUnits.fill(s_Unknown);
+			UniformBindings.fill(s_Unknown);
+			StorageBindings.fill(s_Unknown);
+		}
+	};
+
+	static OpenGLRenderStateData s_State;
+
+	// Returns true if the cached value changed and the driver call has to be issued
+	static bool UpdateCached(uint32_t& cached, uint32_t value)
+	{
+		if (cached == value)
+		{
+			s_State.Stats.Elided++;
+			return false;
+		}
+
+		cached = value;
+		s_State.Stats.Issued++;
+		return true;
+	}
+
+	void OpenGLRenderState::Init()
+	{
+		Invalidate();
+		ResetStats();
+	}
+
+	void OpenGLRenderState::Invalidate()
+	{
+		s_State.Program = s_Unknown;
+		s_State.VertexArray = s_Unknown;
+		s_State.Buffers.fill(s_Unknown);
+		s_State.TextureUnits.fill(s_Unknown);
+		s_State.UniformBindings.fill(s_Unknown);
+		s_State.StorageBindings.fill(s_Unknown);
+
+		s_State.DepthTest = s_Unknown;
+		s_State.Blend = s_Unknown;
+		s_State.CullFace = s_Unknown;
+		s_State.BlendSrc = s_Unknown;
+		s_State.BlendDst = s_Unknown;
+
+		for (uint32_t i = 0; i < 4; i++)
+			s_State.Viewport[i] = s_Unknown;
+	}
+
+	void OpenGLRenderState::InvalidateTextures()
+	{
+		s_State.TextureUnits.fill(s_Unknown);
+	}
+
+	void OpenGLRenderState::UseProgram(uint32_t program)
+	{
+		if (UpdateCached(s_State.Program, program))
+			glUseProgram(program);
+	}
+
+	void OpenGLRenderState::BindVertexArray(uint32_t vertexArray)
+	{
+		if (UpdateCached(s_State.VertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+			// The element array binding is part of the VAO state
+			s_State.Buffers[(size_t)CachedBufferTarget::ElementArray] = s_Unknown;
+		}
+	}
+
+	void OpenGLRenderState::BindBuffer(uint32_t target, uint32_t buffer)
+	{
+		int index = CachedBufferTargetIndex(target);
+		if (index < 0)
+		{
+			s_State.Stats.Issued++;
+			glBindBuffer(target, buffer);
+			return;
+		}
+
+		if (UpdateCached(s_State.Buffers[index], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void OpenGLRenderState::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer)
+	{
+		std::array<uint32_t, OpenGLRenderStateData::MaxBufferBindings>* bindings = nullptr;
+		if (target == GL_UNIFORM_BUFFER)
+			bindings = &s_State.UniformBindings;
+		else if (target == GL_SHADER_STORAGE_BUFFER)
+			bindings = &s_State.StorageBindings;
+
+		if (!bindings || index >= OpenGLRenderStateData::MaxBufferBindings)
+			s_State.Stats.Issued++;
+		else if (!UpdateCached((*bindings)[index], buffer))
+			return;
+
+		glBindBufferBase(target, index, buffer);
+		int generic = CachedBufferTargetIndex(target);
+		if (generic >= 0)
+			s_State.Buffers[generic] = buffer;
+	}
+
+	void OpenGLRenderState::BindTextureUnit(uint32_t slot, uint32_t texture)
+	{
+		if (slot >= OpenGLRenderStateData::MaxTextureUnits)
+		{
+			s_State.Stats.Issued++;
+			glBindTextureUnit(slot, texture);
+			return;
+		}
+
+		if (UpdateCached(s_State.TextureUnits[slot], texture))
+			glBindTextureUnit(slot, texture);
+	}
+
+	void OpenGLRenderState::SetDepthTest(bool enabled)
+	{
+		if (UpdateCached(s_State.DepthTest, enabled ? 1 : 0))
+		{
+			if (enabled)
+				glEnable(GL_DEPTH_TEST);
+			else
+				glDisable(GL_DEPTH_TEST);
+		}
+	}
+
+	void OpenGLRenderState::SetBlend(bool enabled)
+	{
+		if (UpdateCached(s_State.Blend, enabled ? 1 : 0))
+		{
+			if (enabled)
+				glEnable(GL_BLEND);
+			else
+				glDisable(GL_BLEND);
+		}
+	}
+
+	void OpenGLRenderState::SetBlendFunc(uint32_t srcFactor, uint32_t dstFactor)
+	{
+		if (s_State.BlendSrc == srcFactor && s_State.BlendDst == dstFactor)
+		{
+			s_State.Stats.Elided++;
+			return;
+		}
+
+		s_State.BlendSrc = srcFactor;
+		s_State.BlendDst = dstFactor;
+		s_State.Stats.Issued++;
+		glBlendFunc(srcFactor, dstFactor);
+	}
+
+	void OpenGLRenderState::SetCullFace(bool enabled)
+	{
+		if (UpdateCached(s_State.CullFace, enabled ? 1 : 0))
+		{
+			if (enabled)
+				glEnable(GL_CULL_FACE);
+			else
+				glDisable(GL_CULL_FACE);
+		}
+	}
+
+	void OpenGLRenderState::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		uint32_t* viewport = s_State.Viewport;
+		if (viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height)
+		{
+			s_State.Stats.Elided++;
+			return;
+		}
+
+		viewport[0] = x;
+		viewport[1] = y;
+		viewport[2] = width;
+		viewport[3] = height;
+		s_State.Stats.Issued++;
+		glViewport(x, y, width, height);
+	}
+
+	void OpenGLRenderState::OnProgramDeleted(uint32_t program)
+	{
+		if (s_State.Program == program)
+			s_State.Program = s_Unknown;
+	}
+
+	void OpenGLRenderState::OnVertexArrayDeleted(uint32_t vertexArray)
+	{
+		if (s_State.VertexArray == vertexArray)
+		{
+			s_State.VertexArray = s_Unknown;
+			s_State.Buffers[(size_t)CachedBufferTarget::ElementArray] = s_Unknown;
+		}
+	}
+
+	void OpenGLRenderState::OnBufferDeleted(uint32_t buffer)
+	{
+		for (auto* bindings : { &s_State.UniformBindings, &s_State.StorageBindings })
+		{
+			for (auto& bound : *bindings)
+			{
+				if (bound == buffer)
+					bound = s_Unknown;
+			}
+		}
+		for (auto& bound : s_State.Buffers)
+		{
+			if (bound == buffer)
+				bound = s_Unknown;
+		}
+	}
+
+	void OpenGLRenderState::OnTextureDeleted(uint32_t texture)
+	{
+		for (auto& bound : s_State.TextureUnits)
+		{
+			if (bound == texture)
+				bound = s_Unknown;
+		}
+	}
+
+	const RendererAPI::StateStatistics& OpenGLRenderState::GetStats()
+	{
+		return s_State.Stats;
+	}
+
+	void OpenGLRenderState::ResetStats()
+	{
+		memset(&s_State.Stats, 0, sizeof(RendererAPI::StateStatistics));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Engine/Renderer/RendererAPI.h"
+
+namespace Engine {
+
+	// Shadow copy of the GL context state the engine touches.
+	// Every bind/enable goes through here so redundant driver calls are skipped.
+	// Code that changes state with raw gl calls must Invalidate() afterwards.
+	class OpenGLRenderState
+	{
+	public:
+		static void Init();
+		static void Invalidate();
+		static void InvalidateTextures();
+
+		static void UseProgram(uint32_t program);
+		static void BindVertexArray(uint32_t vertexArray);
+		static void BindBuffer(uint32_t target, uint32_t buffer);
+		// Indexed binding of a uniform or shader storage buffer, also sets the generic binding
+		static void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+		static void BindTextureUnit(uint32_t slot, uint32_t texture);
+
+		static void SetDepthTest(bool enabled);
+		static void SetBlend(bool enabled);
+		static void SetBlendFunc(uint32_t srcFactor, uint32_t dstFactor);
+		static void SetCullFace(bool enabled);
+		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+		// GL silently unbinds deleted objects and reuses their names,
+		// so the cache has to forget them too
+		static void OnProgramDeleted(uint32_t program);
+		static void OnVertexArrayDeleted(uint32_t vertexArray);
+		static void OnBufferDeleted(uint32_t buffer);
+		static void OnTextureDeleted(uint32_t texture);
+
+		static const RendererAPI::StateStatistics& GetStats();
+		static void ResetStats();
+	};
+}
\ No newline at end of file
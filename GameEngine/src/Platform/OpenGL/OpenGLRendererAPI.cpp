@@ -1,5 +1,6 @@
 #include "gepch.h"
 #include "OpenGLRendererAPI.h"
+#include "OpenGLRenderState.h"
 
 #include <glad/glad.h>
 
@@ -38,15 +39,15 @@ namespace Engine {
 		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
 #endif
 
-		// TODO Depth test toggle func
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		OpenGLRenderState::Init();
+		OpenGLRenderState::SetDepthTest(true);
+		OpenGLRenderState::SetBlend(true);
+		OpenGLRenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	}
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		OpenGLRenderState::SetViewport(x, y, width, height);
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
@@ -63,7 +64,12 @@ namespace Engine {
 	{
 		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
 		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
-		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void OpenGLRendererAPI::DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+	{
+		const void* offset = (const void*)(intptr_t)(firstIndex * sizeof(uint32_t));
+		glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, offset, baseVertex);
 	}
 
 	void OpenGLRendererAPI::DrawArrays(const Engine::Ref<VertexArray>& vertexArray)
@@ -71,11 +77,37 @@ namespace Engine {
 		glDrawArrays(GL_TRIANGLES, 0, 36);
 	}
 
+	void OpenGLRendererAPI::MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount)
+	{
+		vertexArray->Bind();
+		indirectBuffer->Bind();
+
+		const void* offset = (const void*)(intptr_t)(firstCommand * sizeof(DrawIndexedIndirectCommand));
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, drawCount, 0);
+	}
+
+	void OpenGLRendererAPI::BindTexture(uint32_t slot, uint32_t rendererID)
+	{
+		OpenGLRenderState::BindTextureUnit(slot, rendererID);
+	}
+
+	void OpenGLRendererAPI::Finish()
+	{
+		glFinish();
+	}
+
 	void OpenGLRendererAPI::DepthTest(bool depthTest)
 	{
-		if (!depthTest)
-			glDisable(GL_DEPTH_TEST);
-		else
-			glEnable(GL_DEPTH_TEST);
+		OpenGLRenderState::SetDepthTest(depthTest);
+	}
+
+	RendererAPI::StateStatistics OpenGLRendererAPI::GetStateStats() const
+	{
+		return OpenGLRenderState::GetStats();
+	}
+
+	void OpenGLRendererAPI::ResetStateStats()
+	{
+		OpenGLRenderState::ResetStats();
 	}
 }
\ No newline at end of file
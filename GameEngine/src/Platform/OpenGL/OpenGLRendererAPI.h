@@ -15,6 +15,15 @@ namespace Engine {
 		virtual void DepthTest(bool depthTest) override;
 
 		virtual void DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex) override;
 		virtual void DrawArrays(const Engine::Ref<VertexArray>& vertexArray) override;
+		virtual void MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount) override;
+
+		virtual void BindTexture(uint32_t slot, uint32_t rendererID) override;
+
+		virtual void Finish() override;
+
+		virtual StateStatistics GetStateStats() const override;
+		virtual void ResetStateStats() override;
 	};
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "gepch.h"
 #include "OpenGLShader.h"
+#include "OpenGLRenderState.h"
+#include "Engine/Core/VFS.h"
 
-#include <fstream>
 #include <glad/glad.h>
 
 #include <glm/gtc/type_ptr.hpp>
@@ -20,6 +21,9 @@ namespace Engine {
 		return 0;
 	}
 
+	// Linked programs drop their shader objects, render captures need the sources to rebuild them
+	static std::unordered_map<uint32_t, std::unordered_map<GLenum, std::string>> s_ProgramSources;
+
 	OpenGLShader::OpenGLShader(const std::string& filepath)
 	{
 		GE_PROFILE_FUNCTION();
@@ -51,29 +55,29 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
+		OpenGLRenderState::OnProgramDeleted(m_RendererID);
+		s_ProgramSources.erase(m_RendererID);
 		glDeleteProgram(m_RendererID);
 	}
 
+	const std::unordered_map<GLenum, std::string>* OpenGLShader::GetProgramSources(uint32_t program)
+	{
+		auto it = s_ProgramSources.find(program);
+		return it != s_ProgramSources.end() ? &it->second : nullptr;
+	}
+
 	std::string OpenGLShader::ReadFile(const std::string& filepath)
 	{
 		GE_PROFILE_FUNCTION();
 
-		std::string result;
-		std::ifstream in(filepath, std::ios::in | std::ios::binary);
-		if (in)
-		{
-			in.seekg(0, std::ios::end);
-			result.resize(in.tellg());
-			in.seekg(0, std::ios::beg);
-			in.read(&result[0], result.size());
-			in.close();
-		}
-		else
+		FileBuffer file = VFS::Read(filepath);
+		if (!file)
 		{
 			GE_CORE_ERROR("Could not open file '{0}'", filepath);
+			return std::string();
 		}
 
-		return result;
+		return file.ToString();
 	}
 
 	std::unordered_map<GLenum, std::string> OpenGLShader::PreProcess(const std::string& source)
@@ -178,20 +182,21 @@ namespace Engine {
 		}
 
 		m_RendererID = program;
+		s_ProgramSources[program] = shaderSources;
 	}
 
 	void OpenGLShader::Bind() const
 	{
 		GE_PROFILE_FUNCTION();
 
-		glUseProgram(m_RendererID);
+		OpenGLRenderState::UseProgram(m_RendererID);
 	}
 
 	void OpenGLShader::Unbind() const
 	{
 		GE_PROFILE_FUNCTION();
 
-		glUseProgram(0);
+		OpenGLRenderState::UseProgram(0);
 	}
 
 	void OpenGLShader::SetInt(const std::string& name, int value)
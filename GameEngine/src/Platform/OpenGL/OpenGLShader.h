@@ -26,6 +26,7 @@ namespace Engine {
 		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
 
 		virtual const std::string& GetName() const override { return m_Name; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
 
 		void UploadUniformInt(const std::string& name, int value);
 		void UploadUniformIntArray(const std::string& name, int* values, uint32_t count);
@@ -35,6 +36,9 @@ namespace Engine {
 		void UploadUniformFloat4(const std::string& name, const glm::vec4& values);
 		void UploadUniformMat3(const std::string& name, const glm::mat3& matrix);
 		void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
+
+		// Stage sources of a program created by an OpenGLShader, nullptr for other programs
+		static const std::unordered_map<GLenum, std::string>* GetProgramSources(uint32_t program);
 		uint32_t m_RendererID;
 	private:
 		std::string ReadFile(const std::string& filepath);
@@ -1,5 +1,9 @@
 #include "gepch.h"
 #include "OpenGLTexture.h"
+#include "OpenGLRenderState.h"
+#include "Engine/Core/VFS.h"
+#include "Engine/Debug/MemoryTracker.h"
+#include "Engine/Renderer/RenderCapture.h"
 
 #include "stb_image.h"
 
@@ -15,6 +19,8 @@ namespace Engine {
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
 		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		m_MemorySize = (int64_t)m_Width * m_Height * 4;
+		MemoryTracker::RecordGPU(GPUMemoryType::Texture, m_MemorySize);
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -27,17 +33,23 @@ namespace Engine {
 		: m_Path(path)
 	{
 		GE_PROFILE_FUNCTION();
+		GE_MEMORY_TAG(MemoryTag::Texture);
 
 		stbi_set_flip_vertically_on_load(1);
 		int width, height, channels;
 		stbi_uc* data = nullptr;
 		{
 			GE_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&) stbi_load");
-			data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+			FileBuffer file = VFS::Read(path);
+			if (file)
+				data = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, 0);
 		}
 		GE_CORE_ASSERT(data, "Failed to load image");
 		m_Width = width;
 		m_Height = height;
+		// stb_image allocates with malloc, which the operator new hooks don't see
+		int64_t imageSize = (int64_t)width * height * channels;
+		MemoryTracker::RecordExternal(MemoryTag::Texture, imageSize);
 
 		GLenum internalFormat = 0, dataFormat = 0;
 		if (channels == 4)
@@ -58,6 +70,8 @@ namespace Engine {
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
 		glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+		m_MemorySize = (int64_t)m_Width * m_Height * channels;
+		MemoryTracker::RecordGPU(GPUMemoryType::Texture, m_MemorySize);
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -68,13 +82,16 @@ namespace Engine {
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
 
 		stbi_image_free(data);
+		MemoryTracker::RecordExternal(MemoryTag::Texture, -imageSize);
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
 		GE_PROFILE_FUNCTION();
 
+		OpenGLRenderState::OnTextureDeleted(m_RendererID);
 		glDeleteTextures(1, &m_RendererID);
+		MemoryTracker::RecordGPU(GPUMemoryType::Texture, -m_MemorySize);
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
@@ -83,6 +100,8 @@ namespace Engine {
 
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		GE_CORE_ASSERT(size == m_Width * m_Height * bpp, "");
+		if (RenderCapture::IsCapturing())
+			RenderCapture::RecordTextureData(m_RendererID, m_DataFormat, data, size);
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 	}
 
@@ -91,7 +110,7 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindTextureUnit(slot, m_RendererID);
+		OpenGLRenderState::BindTextureUnit(slot, m_RendererID);
 		//glActiveTexture(GL_TEXTURE0 + slot);
 		//glBindTexture(GL_TEXTURE_2D, m_RendererID);
 	}
@@ -107,10 +126,12 @@ namespace Engine {
 		int width, height, nrComponents;
 		for (unsigned int i = 0; i < faces.size(); i++)
 		{
-			unsigned char *data = stbi_load(faces[i].c_str(), &width, &height, &nrComponents, 0);
+			FileBuffer file = VFS::Read(faces[i]);
+			unsigned char *data = file ? stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &nrComponents, 0) : nullptr;
 			if (data)
 			{
 				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+				m_MemorySize += (int64_t)width * height * 3;
 				stbi_image_free(data);
 			}
 			else
@@ -121,22 +142,26 @@ namespace Engine {
 		}
 		m_Width = width;
 		m_Height = height;
+		MemoryTracker::RecordGPU(GPUMemoryType::Texture, m_MemorySize);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		// Bound with raw gl calls to the active unit
+		OpenGLRenderState::InvalidateTextures();
 	}
 
 	OpenGLTextureCube::~OpenGLTextureCube()
 	{
+		OpenGLRenderState::OnTextureDeleted(m_RendererID);
 		glDeleteTextures(1, &m_RendererID);
+		MemoryTracker::RecordGPU(GPUMemoryType::Texture, -m_MemorySize);
 	}
 
 	void OpenGLTextureCube::Bind(uint32_t slot) const
 	{
-		//glBindTextureUnit(slot, m_RendererID);
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+		OpenGLRenderState::BindTextureUnit(slot, m_RendererID);
 	}
 }
\ No newline at end of file
@@ -31,6 +31,7 @@ namespace Engine {
 		uint32_t m_Height;
 		uint32_t m_RendererID;
 		GLenum m_InternalFormat, m_DataFormat;
+		int64_t m_MemorySize = 0;
 	};
 
 	class OpenGLTextureCube : public TextureCube
@@ -53,5 +54,6 @@ namespace Engine {
 		uint32_t m_RendererID;
 		uint32_t m_Width;
 		uint32_t m_Height;
+		int64_t m_MemorySize = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "gepch.h"
+#include "OpenGLTimerQuery.h"
+
+#include <glad/glad.h>
+
+namespace Engine {
+
+	OpenGLTimerQueryPool::OpenGLTimerQueryPool(uint32_t count)
+		: m_Queries(count)
+	{
+		GE_PROFILE_FUNCTION();
+
+		glCreateQueries(GL_TIMESTAMP, count, m_Queries.data());
+	}
+
+	OpenGLTimerQueryPool::~OpenGLTimerQueryPool()
+	{
+		GE_PROFILE_FUNCTION();
+
+		glDeleteQueries((GLsizei)m_Queries.size(), m_Queries.data());
+	}
+
+	void OpenGLTimerQueryPool::WriteTimestamp(uint32_t index)
+	{
+		glQueryCounter(m_Queries[index], GL_TIMESTAMP);
+	}
+
+	bool OpenGLTimerQueryPool::IsResultAvailable(uint32_t index) const
+	{
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(m_Queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+		return available == GL_TRUE;
+	}
+
+	uint64_t OpenGLTimerQueryPool::GetResult(uint32_t index) const
+	{
+		GLuint64 timestamp = 0;
+		glGetQueryObjectui64v(m_Queries[index], GL_QUERY_RESULT, &timestamp);
+		return timestamp;
+	}
+
+	uint64_t OpenGLTimerQueryPool::GetCurrentTimestamp() const
+	{
+		GLint64 timestamp = 0;
+		glGetInteger64v(GL_TIMESTAMP, &timestamp);
+		return (uint64_t)timestamp;
+	}
+}
\ No newline at end of file
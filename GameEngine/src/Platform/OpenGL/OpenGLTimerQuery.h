@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Engine/Renderer/TimerQuery.h"
+
+namespace Engine {
+
+	class OpenGLTimerQueryPool : public TimerQueryPool
+	{
+	public:
+		OpenGLTimerQueryPool(uint32_t count);
+		virtual ~OpenGLTimerQueryPool();
+
+		virtual void WriteTimestamp(uint32_t index) override;
+
+		virtual bool IsResultAvailable(uint32_t index) const override;
+		virtual uint64_t GetResult(uint32_t index) const override;
+		virtual uint64_t GetCurrentTimestamp() const override;
+
+		virtual uint32_t GetCount() const override { return (uint32_t)m_Queries.size(); }
+	private:
+		std::vector<uint32_t> m_Queries;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "gepch.h"
 #include "OpenGLVertexArray.h"
+#include "OpenGLRenderState.h"
 
 #include <glad/glad.h>
 
@@ -37,6 +38,7 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
+		OpenGLRenderState::OnVertexArrayDeleted(m_RendererID);
 		glDeleteVertexArrays(1, &m_RendererID);
 	}
 
@@ -44,14 +46,14 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		OpenGLRenderState::BindVertexArray(m_RendererID);
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindVertexArray(0);
+		OpenGLRenderState::BindVertexArray(0);
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Engine::Ref<VertexBuffer>& vertexBuffer)
@@ -60,7 +62,7 @@ namespace Engine {
 
 		GE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout");
 
-		glBindVertexArray(m_RendererID);
+		OpenGLRenderState::BindVertexArray(m_RendererID);
 		vertexBuffer->Bind();
 
 		const auto& layout = vertexBuffer->GetLayout();
@@ -92,7 +94,7 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		OpenGLRenderState::BindVertexArray(m_RendererID);
 		indexBuffer->Bind();
 
 		m_IndexBuffer = indexBuffer;
@@ -0,0 +1,53 @@
+#include "gepch.h"
+#include "SoftwareBuffer.h"
+
+#include "SoftwareRasterizer.h"
+
+namespace Engine {
+
+	SoftwareVertexBuffer::SoftwareVertexBuffer(uint32_t size)
+		: m_Data(size)
+	{
+	}
+
+	SoftwareVertexBuffer::SoftwareVertexBuffer(void* vertices, uint32_t size)
+		: m_Data((uint8_t*)vertices, (uint8_t*)vertices + size)
+	{
+	}
+
+	void SoftwareVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		if (size > m_Data.size())
+			m_Data.resize(size);
+		memcpy(m_Data.data(), data, size);
+	}
+
+	SoftwareIndexBuffer::SoftwareIndexBuffer(uint32_t* indices, uint32_t count)
+		: m_Indices(indices, indices + count)
+	{
+	}
+
+	SoftwareIndirectBuffer::SoftwareIndirectBuffer(uint32_t size)
+		: m_Commands(size / sizeof(DrawIndexedIndirectCommand))
+	{
+	}
+
+	void SoftwareIndirectBuffer::SetData(const void* data, uint32_t size)
+	{
+		uint32_t count = size / sizeof(DrawIndexedIndirectCommand);
+		if (count > m_Commands.size())
+			m_Commands.resize(count);
+		memcpy(m_Commands.data(), data, count * sizeof(DrawIndexedIndirectCommand));
+	}
+
+	SoftwareVertexArray::SoftwareVertexArray()
+		: m_RendererID(SoftwareRasterizer::NewRendererID())
+	{
+	}
+
+	void SoftwareVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		GE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Engine/Renderer/VertexArray.h"
+
+namespace Engine {
+
+	// Buffers live in system memory, the rasterizer reads them at draw time
+
+	class SoftwareVertexBuffer : public VertexBuffer
+	{
+	public:
+		SoftwareVertexBuffer(uint32_t size);
+		SoftwareVertexBuffer(void* vertices, uint32_t size);
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+		const std::vector<uint8_t>& GetData() const { return m_Data; }
+	private:
+		std::vector<uint8_t> m_Data;
+		BufferLayout m_Layout;
+	};
+
+	class SoftwareIndexBuffer : public IndexBuffer
+	{
+	public:
+		SoftwareIndexBuffer(uint32_t* indices, uint32_t count);
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual uint32_t GetCount() const override { return (uint32_t)m_Indices.size(); }
+
+		const uint32_t* GetIndices() const { return m_Indices.data(); }
+	private:
+		std::vector<uint32_t> m_Indices;
+	};
+
+	// Not read by the Renderer2D program
+	class SoftwareStorageBuffer : public StorageBuffer
+	{
+	public:
+		SoftwareStorageBuffer(uint32_t size) {}
+
+		virtual void Bind(uint32_t binding) const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override {}
+	};
+
+	class SoftwareIndirectBuffer : public IndirectBuffer
+	{
+	public:
+		SoftwareIndirectBuffer(uint32_t size);
+
+		virtual void Bind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		const std::vector<DrawIndexedIndirectCommand>& GetCommands() const { return m_Commands; }
+	private:
+		std::vector<DrawIndexedIndirectCommand> m_Commands;
+	};
+
+	class SoftwareVertexArray : public VertexArray
+	{
+	public:
+		SoftwareVertexArray();
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override { m_IndexBuffer = indexBuffer; }
+
+		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
+		virtual const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+	private:
+		uint32_t m_RendererID;
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+}
\ No newline at end of file
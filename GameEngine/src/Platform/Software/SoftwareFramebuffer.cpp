@@ -0,0 +1,39 @@
+#include "gepch.h"
+#include "SoftwareFramebuffer.h"
+
+namespace Engine {
+
+	SoftwareFramebuffer::SoftwareFramebuffer(uint32_t width, uint32_t height, FramebufferFormat format)
+		: m_RendererID(SoftwareRasterizer::NewRendererID()), m_Format(format),
+		m_ColorAttachment(SoftwareRasterizer::NewRendererID()), m_DepthAttachment(SoftwareRasterizer::NewRendererID())
+	{
+		m_Target.Resize(width, height);
+		SoftwareRasterizer::RegisterImage(m_ColorAttachment, &m_Target.Color);
+	}
+
+	SoftwareFramebuffer::~SoftwareFramebuffer()
+	{
+		SoftwareRasterizer::UnregisterImage(m_ColorAttachment);
+	}
+
+	void SoftwareFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		m_Target.Resize(width, height);
+	}
+
+	void SoftwareFramebuffer::Bind() const
+	{
+		SoftwareRasterizer::BindTarget(&m_Target);
+		SoftwareRasterizer::SetViewport(0, 0, m_Target.Color.Width, m_Target.Color.Height);
+	}
+
+	void SoftwareFramebuffer::Unbind() const
+	{
+		SoftwareRasterizer::BindTarget(nullptr);
+	}
+
+	void SoftwareFramebuffer::BindTexture(uint32_t slot) const
+	{
+		SoftwareRasterizer::BindTexture(slot, m_ColorAttachment);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Engine/Renderer/Framebuffer.h"
+#include "SoftwareRasterizer.h"
+
+namespace Engine {
+
+	// Every format is stored as RGBA8, the color attachment can be bound as a texture
+	class SoftwareFramebuffer : public Framebuffer
+	{
+	public:
+		SoftwareFramebuffer(uint32_t width, uint32_t height, FramebufferFormat format);
+		virtual ~SoftwareFramebuffer();
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void BindTexture(uint32_t slot = 0) const override;
+
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual uint32_t GetColorAttachmentRendererID() const override { return m_ColorAttachment; }
+		virtual uint32_t GetDepthAttachmentRendererID() const override { return m_DepthAttachment; }
+
+		const SoftwareTarget& GetTarget() const { return m_Target; }
+	private:
+		uint32_t m_RendererID;
+		FramebufferFormat m_Format;
+
+		uint32_t m_ColorAttachment, m_DepthAttachment;
+		// Bind() is const like the GL one, the rasterizer still draws into the target
+		mutable SoftwareTarget m_Target;
+	};
+}
\ No newline at end of file
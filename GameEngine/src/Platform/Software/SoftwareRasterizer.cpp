@@ -0,0 +1,710 @@
+#include "gepch.h"
+#include "SoftwareRasterizer.h"
+#include "SoftwareShader.h"
+
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// SSE2 is part of every x64 target
+#include <emmintrin.h>
+
+namespace Engine {
+
+	// Vertex after the vertex program, X and Y in window coordinates, Z in [0, 1]
+	struct ShadedVertex
+	{
+		float X, Y, Z, InvW;
+		glm::vec4 Color;
+		glm::vec2 TexCoord;
+		float TexIndex;
+		float TilingFactor;
+	};
+
+	struct SetupTriangle
+	{
+		// Edge i is opposite to vertex i, E(x, y) = A * x + B * y + C is positive inside
+		float A[3], B[3], C[3];
+		// Bit i set when pixel centers exactly on edge i belong to this triangle
+		uint32_t OwnedEdges;
+		float InvArea;
+		int32_t MinX, MinY, MaxX, MaxY;
+		// Into SoftwareRasterizerData::Vertices
+		uint32_t Vertices[3];
+		// Minified textures are filtered linearly, magnified ones take the nearest texel (GL_LINEAR / GL_NEAREST)
+		bool Bilinear;
+	};
+
+	struct SoftwareRasterizerData
+	{
+		uint32_t ThreadCount = 1;
+		std::vector<std::thread> Workers;
+
+		std::mutex Mutex;
+		std::condition_variable WorkReady;
+		std::condition_variable WorkDone;
+		const std::function<void(uint32_t)>* Job = nullptr;
+		uint32_t JobCount = 0;
+		std::atomic<uint32_t> NextJob{ 0 };
+		uint32_t Generation = 0;
+		uint32_t BusyWorkers = 0;
+		bool Quit = false;
+
+		SoftwareTarget DefaultTarget;
+		SoftwareTarget* Target = &DefaultTarget;
+		int32_t Viewport[4] = {};
+		glm::vec4 ClearColor = { 0.0f, 0.0f, 0.0f, 0.0f };
+		bool DepthTest = false;
+		const SoftwareShader* Shader = nullptr;
+
+		std::unordered_map<uint32_t, const SoftwareImage*> Images;
+		std::array<const SoftwareImage*, SoftwareRasterizer::MaxTextureSlots> TextureSlots = {};
+		uint32_t NextRendererID = 1;
+
+		// Per draw scratch, kept between draws to reuse the allocations
+		std::vector<ShadedVertex> Vertices;
+		std::vector<std::vector<SetupTriangle>> Triangles;
+		// SetupJobCount * tile count, indexed by job * tile count + tile
+		std::vector<std::vector<uint32_t>> Bins;
+		uint32_t SetupJobCount = 0;
+		uint32_t TilesX = 0, TilesY = 0;
+	};
+
+	static SoftwareRasterizerData* s_Data = nullptr;
+
+	void SoftwareTarget::Resize(uint32_t width, uint32_t height)
+	{
+		Color.Width = width;
+		Color.Height = height;
+		Color.Texels.assign((size_t)width * height, 0);
+
+		DepthStride = (width + 3) & ~3u;
+		Depth.assign((size_t)DepthStride * height, 1.0f);
+	}
+
+	// Thread pool
+
+	static void RunJobs()
+	{
+		const std::function<void(uint32_t)>& job = *s_Data->Job;
+		for (uint32_t index = s_Data->NextJob.fetch_add(1); index < s_Data->JobCount; index = s_Data->NextJob.fetch_add(1))
+			job(index);
+	}
+
+	static void WorkerMain()
+	{
+		uint32_t generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock lock(s_Data->Mutex);
+				s_Data->WorkReady.wait(lock, [&] { return s_Data->Quit || s_Data->Generation != generation; });
+				if (s_Data->Quit)
+					return;
+				generation = s_Data->Generation;
+			}
+
+			RunJobs();
+
+			std::lock_guard lock(s_Data->Mutex);
+			if (--s_Data->BusyWorkers == 0)
+				s_Data->WorkDone.notify_one();
+		}
+	}
+
+	// Runs job(0) .. job(jobCount - 1) on the workers and the calling thread, returns when all finished
+	static void Dispatch(uint32_t jobCount, const std::function<void(uint32_t)>& job)
+	{
+		if (s_Data->Workers.empty() || jobCount <= 1)
+		{
+			for (uint32_t i = 0; i < jobCount; i++)
+				job(i);
+			return;
+		}
+
+		{
+			std::lock_guard lock(s_Data->Mutex);
+			s_Data->Job = &job;
+			s_Data->JobCount = jobCount;
+			s_Data->NextJob.store(0);
+			s_Data->BusyWorkers = (uint32_t)s_Data->Workers.size();
+			s_Data->Generation++;
+		}
+		s_Data->WorkReady.notify_all();
+
+		RunJobs();
+
+		std::unique_lock lock(s_Data->Mutex);
+		s_Data->WorkDone.wait(lock, [] { return s_Data->BusyWorkers == 0; });
+	}
+
+	static void StopWorkers()
+	{
+		{
+			std::lock_guard lock(s_Data->Mutex);
+			s_Data->Quit = true;
+		}
+		s_Data->WorkReady.notify_all();
+
+		for (std::thread& worker : s_Data->Workers)
+			worker.join();
+		s_Data->Workers.clear();
+		s_Data->Quit = false;
+	}
+
+	// Pixel helpers
+
+	static inline glm::vec4 Unpack(uint32_t texel)
+	{
+		return glm::vec4((float)(texel & 0xff), (float)((texel >> 8) & 0xff), (float)((texel >> 16) & 0xff), (float)(texel >> 24)) * (1.0f / 255.0f);
+	}
+
+	static inline uint32_t Pack(const glm::vec4& color)
+	{
+		glm::vec4 scaled = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+		return (uint32_t)scaled.r | ((uint32_t)scaled.g << 8) | ((uint32_t)scaled.b << 16) | ((uint32_t)scaled.a << 24);
+	}
+
+	// Fraction in [0, 1) for GL_REPEAT, NaN ends up at 0
+	static inline float Repeat(float coordinate)
+	{
+		float fraction = coordinate - std::floor(coordinate);
+		return fraction >= 0.0f && fraction < 1.0f ? fraction : 0.0f;
+	}
+
+	static glm::vec4 Sample(const SoftwareImage& image, const glm::vec2& texCoord, bool bilinear)
+	{
+		const int32_t width = (int32_t)image.Width, height = (int32_t)image.Height;
+		if (width == 0 || height == 0)
+			return { 0.0f, 0.0f, 0.0f, 1.0f };
+
+		float u = Repeat(texCoord.x) * width;
+		float v = Repeat(texCoord.y) * height;
+		if (!bilinear)
+		{
+			int32_t x = std::min((int32_t)u, width - 1);
+			int32_t y = std::min((int32_t)v, height - 1);
+			return Unpack(image.Texels[(size_t)y * width + x]);
+		}
+
+		u -= 0.5f;
+		v -= 0.5f;
+		float x0f = std::floor(u), y0f = std::floor(v);
+		float fx = u - x0f, fy = v - y0f;
+
+		// Texel -1 wraps to the last one
+		int32_t x0 = (int32_t)x0f < 0 ? width - 1 : (int32_t)x0f;
+		int32_t y0 = (int32_t)y0f < 0 ? height - 1 : (int32_t)y0f;
+		int32_t x1 = x0 + 1 == width ? 0 : x0 + 1;
+		int32_t y1 = y0 + 1 == height ? 0 : y0 + 1;
+
+		const uint32_t* row0 = &image.Texels[(size_t)y0 * width];
+		const uint32_t* row1 = &image.Texels[(size_t)y1 * width];
+		glm::vec4 bottom = glm::mix(Unpack(row0[x0]), Unpack(row0[x1]), fx);
+		glm::vec4 top = glm::mix(Unpack(row1[x0]), Unpack(row1[x1]), fx);
+		return glm::mix(bottom, top, fy);
+	}
+
+	// Vertex stage
+
+	static void ReadAttribute(const SoftwareVertexInput& input, uint32_t vertex, float* out)
+	{
+		// Generic attribute default of disabled GL arrays
+		out[0] = 0.0f; out[1] = 0.0f; out[2] = 0.0f; out[3] = 1.0f;
+		if (!input.Data || vertex >= input.VertexCount)
+			return;
+
+		const float* data = (const float*)(input.Data + (size_t)vertex * input.Stride);
+		for (uint32_t i = 0; i < input.Components && i < 4; i++)
+			out[i] = data[i];
+	}
+
+	static void ShadeVertices(const SoftwareVertexInput* inputs, const glm::mat4& viewProjection, uint32_t firstVertex, uint32_t begin, uint32_t end)
+	{
+		const int32_t* viewport = s_Data->Viewport;
+		for (uint32_t i = begin; i < end; i++)
+		{
+			uint32_t vertex = firstVertex + i;
+			float attribute[SoftwareRasterizer::AttributeCount][4];
+			for (uint32_t location = 0; location < SoftwareRasterizer::AttributeCount; location++)
+				ReadAttribute(inputs[location], vertex, attribute[location]);
+
+			glm::vec4 clip = viewProjection * glm::vec4(attribute[0][0], attribute[0][1], attribute[0][2], 1.0f);
+
+			ShadedVertex& out = s_Data->Vertices[i];
+			// InvW of 0 marks a vertex behind the eye
+			out.InvW = clip.w > 0.0f ? 1.0f / clip.w : 0.0f;
+			out.X = (clip.x * out.InvW * 0.5f + 0.5f) * viewport[2] + viewport[0];
+			out.Y = (clip.y * out.InvW * 0.5f + 0.5f) * viewport[3] + viewport[1];
+			out.Z = clip.z * out.InvW * 0.5f + 0.5f;
+			out.Color = { attribute[1][0], attribute[1][1], attribute[1][2], attribute[1][3] };
+			out.TexCoord = { attribute[2][0], attribute[2][1] };
+			out.TexIndex = attribute[3][0];
+			out.TilingFactor = attribute[4][0];
+		}
+	}
+
+	// Setup stage
+
+	// Rounds the interpolated index, where the shader's int() would truncate 2.9999 to 2
+	static const SoftwareImage* GetTexture(float texIndex)
+	{
+		int32_t slot = (int32_t)(texIndex + 0.5f);
+		return slot >= 0 && slot < (int32_t)SoftwareRasterizer::MaxTextureSlots ? s_Data->TextureSlots[slot] : nullptr;
+	}
+
+	static bool Setup(uint32_t i0, uint32_t i1, uint32_t i2, int32_t clipMinX, int32_t clipMinY, int32_t clipMaxX, int32_t clipMaxY, SetupTriangle& triangle)
+	{
+		const ShadedVertex* v[3] = { &s_Data->Vertices[i0], &s_Data->Vertices[i1], &s_Data->Vertices[i2] };
+		if (v[0]->InvW == 0.0f || v[1]->InvW == 0.0f || v[2]->InvW == 0.0f)
+			return false;
+
+		float area = (v[1]->X - v[0]->X) * (v[2]->Y - v[0]->Y) - (v[2]->X - v[0]->X) * (v[1]->Y - v[0]->Y);
+		if (!(area != 0.0f) || !std::isfinite(area))
+			return false;
+
+		// Nothing is culled, clockwise triangles are turned around
+		uint32_t indices[3] = { i0, i1, i2 };
+		if (area < 0.0f)
+		{
+			std::swap(v[1], v[2]);
+			std::swap(indices[1], indices[2]);
+			area = -area;
+		}
+
+		float minX = std::min({ v[0]->X, v[1]->X, v[2]->X });
+		float maxX = std::max({ v[0]->X, v[1]->X, v[2]->X });
+		float minY = std::min({ v[0]->Y, v[1]->Y, v[2]->Y });
+		float maxY = std::max({ v[0]->Y, v[1]->Y, v[2]->Y });
+
+		// Pixels whose centers can be inside, clipped to the viewport
+		triangle.MinX = std::max(clipMinX, (int32_t)std::max(std::floor(minX - 0.5f), -1.0f));
+		triangle.MinY = std::max(clipMinY, (int32_t)std::max(std::floor(minY - 0.5f), -1.0f));
+		triangle.MaxX = std::min(clipMaxX, (int32_t)std::min(std::ceil(maxX - 0.5f), 65536.0f));
+		triangle.MaxY = std::min(clipMaxY, (int32_t)std::min(std::ceil(maxY - 0.5f), 65536.0f));
+		if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+			return false;
+
+		triangle.OwnedEdges = 0;
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			const ShadedVertex& a = *v[(i + 1) % 3];
+			const ShadedVertex& b = *v[(i + 2) % 3];
+			triangle.A[i] = a.Y - b.Y;
+			triangle.B[i] = b.X - a.X;
+			triangle.C[i] = a.X * b.Y - b.X * a.Y;
+
+			// A shared edge runs in opposite directions in its two triangles, so exactly one owns it
+			if (triangle.A[i] > 0.0f || (triangle.A[i] == 0.0f && triangle.B[i] < 0.0f))
+				triangle.OwnedEdges |= 1 << i;
+
+			triangle.Vertices[i] = indices[i];
+		}
+		triangle.InvArea = 1.0f / area;
+
+		// Texel footprint of a pixel, constant over the triangle for affine (orthographic) mappings
+		triangle.Bilinear = false;
+		if (const SoftwareImage* image = GetTexture(v[0]->TexIndex))
+		{
+			glm::vec2 dx(0.0f), dy(0.0f);
+			for (uint32_t i = 0; i < 3; i++)
+			{
+				glm::vec2 texel = v[i]->TexCoord * v[i]->TilingFactor * glm::vec2(image->Width, image->Height);
+				dx += texel * triangle.A[i];
+				dy += texel * triangle.B[i];
+			}
+			dx *= triangle.InvArea;
+			dy *= triangle.InvArea;
+			triangle.Bilinear = std::max(glm::dot(dx, dx), glm::dot(dy, dy)) > 1.0f;
+		}
+		return true;
+	}
+
+	// Appends the triangle to the bins of all tiles its edges don't reject
+	static void BinTriangle(const SetupTriangle& triangle, uint32_t index, std::vector<uint32_t>* bins)
+	{
+		const int32_t tileSize = (int32_t)SoftwareRasterizer::TileSize;
+		int32_t tileMinX = triangle.MinX / tileSize, tileMaxX = triangle.MaxX / tileSize;
+		int32_t tileMinY = triangle.MinY / tileSize, tileMaxY = triangle.MaxY / tileSize;
+
+		for (int32_t ty = tileMinY; ty <= tileMaxY; ty++)
+		{
+			for (int32_t tx = tileMinX; tx <= tileMaxX; tx++)
+			{
+				// The tile is outside when one edge is negative at the tile corner most inside it
+				bool outside = false;
+				if (tileMinX != tileMaxX || tileMinY != tileMaxY)
+				{
+					float x0 = tx * tileSize + 0.5f, x1 = x0 + tileSize - 1.0f;
+					float y0 = ty * tileSize + 0.5f, y1 = y0 + tileSize - 1.0f;
+					for (uint32_t i = 0; i < 3 && !outside; i++)
+					{
+						float x = triangle.A[i] > 0.0f ? x1 : x0;
+						float y = triangle.B[i] > 0.0f ? y1 : y0;
+						outside = triangle.A[i] * x + triangle.B[i] * y + triangle.C[i] < 0.0f;
+					}
+				}
+
+				if (!outside)
+					bins[ty * s_Data->TilesX + tx].push_back(index);
+			}
+		}
+	}
+
+	// Raster stage
+
+	static void ShadePixel(const SetupTriangle& triangle, float l1, float l2, bool depthTest, float z, uint32_t& color, float& depth)
+	{
+		const ShadedVertex& v0 = s_Data->Vertices[triangle.Vertices[0]];
+		const ShadedVertex& v1 = s_Data->Vertices[triangle.Vertices[1]];
+		const ShadedVertex& v2 = s_Data->Vertices[triangle.Vertices[2]];
+
+		// Perspective correct weights
+		float w0 = (1.0f - l1 - l2) * v0.InvW, w1 = l1 * v1.InvW, w2 = l2 * v2.InvW;
+		float normalize = 1.0f / (w0 + w1 + w2);
+		w0 *= normalize; w1 *= normalize; w2 *= normalize;
+
+		glm::vec4 source = v0.Color * w0 + v1.Color * w1 + v2.Color * w2;
+		float texIndex = v0.TexIndex * w0 + v1.TexIndex * w1 + v2.TexIndex * w2;
+		if (const SoftwareImage* image = GetTexture(texIndex))
+		{
+			float tilingFactor = v0.TilingFactor * w0 + v1.TilingFactor * w1 + v2.TilingFactor * w2;
+			glm::vec2 texCoord = (v0.TexCoord * w0 + v1.TexCoord * w1 + v2.TexCoord * w2) * tilingFactor;
+			source *= Sample(*image, texCoord, triangle.Bilinear);
+		}
+		else
+			// Unbound sampler
+			source *= glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+		glm::vec4 destination = Unpack(color);
+		color = Pack(source * source.a + destination * (1.0f - source.a));
+		if (depthTest)
+			depth = z;
+	}
+
+	static void RasterizeTriangle(const SetupTriangle& triangle, int32_t minX, int32_t minY, int32_t maxX, int32_t maxY)
+	{
+		SoftwareTarget& target = *s_Data->Target;
+		const bool depthTest = s_Data->DepthTest;
+
+		const ShadedVertex& v0 = s_Data->Vertices[triangle.Vertices[0]];
+		const ShadedVertex& v1 = s_Data->Vertices[triangle.Vertices[1]];
+		const ShadedVertex& v2 = s_Data->Vertices[triangle.Vertices[2]];
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+		__m128 a[3], step[3], owned[3];
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			a[i] = _mm_set1_ps(triangle.A[i]);
+			step[i] = _mm_set1_ps(triangle.A[i] * 4.0f);
+			owned[i] = _mm_castsi128_ps(_mm_set1_epi32(triangle.OwnedEdges & (1 << i) ? -1 : 0));
+		}
+
+		const __m128 invArea = _mm_set1_ps(triangle.InvArea);
+		const __m128 z0 = _mm_set1_ps(v0.Z);
+		const __m128 dz1 = _mm_set1_ps(v1.Z - v0.Z);
+		const __m128 dz2 = _mm_set1_ps(v2.Z - v0.Z);
+
+		// 4 pixel groups start on multiples of 4, which tiles also do
+		const int32_t startX = minX & ~3;
+		// Lanes are inside when minX <= pixel <= maxX, compared on the pixel centers
+		const __m128 firstPixel = _mm_set1_ps((float)minX);
+		const __m128 lastPixel = _mm_set1_ps((float)maxX + 1.0f);
+
+		for (int32_t y = minY; y <= maxY; y++)
+		{
+			const float py = y + 0.5f;
+			__m128 px = _mm_add_ps(_mm_set1_ps((float)startX), laneOffsets);
+
+			__m128 e[3];
+			for (uint32_t i = 0; i < 3; i++)
+				e[i] = _mm_add_ps(_mm_mul_ps(a[i], px), _mm_set1_ps(triangle.B[i] * py + triangle.C[i]));
+
+			uint32_t* colorRow = &target.Color.Texels[(size_t)y * target.Color.Width];
+			float* depthRow = &target.Depth[(size_t)y * target.DepthStride];
+
+			for (int32_t x = startX; x <= maxX; x += 4)
+			{
+				__m128 inside = _mm_and_ps(_mm_cmpgt_ps(px, firstPixel), _mm_cmplt_ps(px, lastPixel));
+				for (uint32_t i = 0; i < 3; i++)
+				{
+					__m128 edge = _mm_or_ps(_mm_cmpgt_ps(e[i], zero), _mm_and_ps(_mm_cmpeq_ps(e[i], zero), owned[i]));
+					inside = _mm_and_ps(inside, edge);
+				}
+
+				if (_mm_movemask_ps(inside))
+				{
+					__m128 l1 = _mm_mul_ps(e[1], invArea);
+					__m128 l2 = _mm_mul_ps(e[2], invArea);
+					__m128 z = _mm_add_ps(z0, _mm_add_ps(_mm_mul_ps(l1, dz1), _mm_mul_ps(l2, dz2)));
+
+					// Depth clipping, then the GL_LESS test
+					inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(z, zero), _mm_cmple_ps(z, one)));
+					if (depthTest)
+						inside = _mm_and_ps(inside, _mm_cmplt_ps(z, _mm_loadu_ps(depthRow + x)));
+
+					int mask = _mm_movemask_ps(inside);
+					if (mask)
+					{
+						alignas(16) float l1s[4], l2s[4], zs[4];
+						_mm_store_ps(l1s, l1);
+						_mm_store_ps(l2s, l2);
+						_mm_store_ps(zs, z);
+						for (int32_t lane = 0; lane < 4; lane++)
+						{
+							if (mask & (1 << lane))
+								ShadePixel(triangle, l1s[lane], l2s[lane], depthTest, zs[lane], colorRow[x + lane], depthRow[x + lane]);
+						}
+					}
+				}
+
+				px = _mm_add_ps(px, _mm_set1_ps(4.0f));
+				for (uint32_t i = 0; i < 3; i++)
+					e[i] = _mm_add_ps(e[i], step[i]);
+			}
+		}
+	}
+
+	static void RasterizeTile(uint32_t tile)
+	{
+		const SoftwareTarget& target = *s_Data->Target;
+		const int32_t tileSize = (int32_t)SoftwareRasterizer::TileSize;
+		int32_t tileMinX = (int32_t)(tile % s_Data->TilesX) * tileSize;
+		int32_t tileMinY = (int32_t)(tile / s_Data->TilesX) * tileSize;
+		int32_t tileMaxX = std::min(tileMinX + tileSize, (int32_t)target.Color.Width) - 1;
+		int32_t tileMaxY = std::min(tileMinY + tileSize, (int32_t)target.Color.Height) - 1;
+
+		const uint32_t tileCount = s_Data->TilesX * s_Data->TilesY;
+		for (uint32_t job = 0; job < s_Data->SetupJobCount; job++)
+		{
+			const std::vector<SetupTriangle>& triangles = s_Data->Triangles[job];
+			for (uint32_t index : s_Data->Bins[job * tileCount + tile])
+			{
+				const SetupTriangle& triangle = triangles[index];
+				RasterizeTriangle(triangle, std::max(triangle.MinX, tileMinX), std::max(triangle.MinY, tileMinY),
+					std::min(triangle.MaxX, tileMaxX), std::min(triangle.MaxY, tileMaxY));
+			}
+		}
+	}
+
+	// SoftwareRasterizer
+
+	void SoftwareRasterizer::Init()
+	{
+		GE_PROFILE_FUNCTION();
+
+		s_Data = new SoftwareRasterizerData();
+		SetThreadCount(0);
+	}
+
+	void SoftwareRasterizer::Shutdown()
+	{
+		GE_PROFILE_FUNCTION();
+
+		StopWorkers();
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void SoftwareRasterizer::SetThreadCount(uint32_t count)
+	{
+		if (count == 0)
+			count = std::max(std::thread::hardware_concurrency(), 1u);
+
+		StopWorkers();
+		s_Data->ThreadCount = count;
+		for (uint32_t i = 1; i < count; i++)
+			s_Data->Workers.emplace_back(WorkerMain);
+	}
+
+	uint32_t SoftwareRasterizer::GetThreadCount()
+	{
+		return s_Data->ThreadCount;
+	}
+
+	void SoftwareRasterizer::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		s_Data->Viewport[0] = (int32_t)x;
+		s_Data->Viewport[1] = (int32_t)y;
+		s_Data->Viewport[2] = (int32_t)width;
+		s_Data->Viewport[3] = (int32_t)height;
+
+		SoftwareTarget& target = s_Data->DefaultTarget;
+		if (s_Data->Target == &target && (target.Color.Width != x + width || target.Color.Height != y + height))
+			target.Resize(x + width, y + height);
+	}
+
+	void SoftwareRasterizer::SetClearColor(const glm::vec4& color)
+	{
+		s_Data->ClearColor = color;
+	}
+
+	void SoftwareRasterizer::Clear()
+	{
+		GE_PROFILE_FUNCTION();
+
+		SoftwareTarget& target = *s_Data->Target;
+		std::fill(target.Color.Texels.begin(), target.Color.Texels.end(), Pack(s_Data->ClearColor));
+		std::fill(target.Depth.begin(), target.Depth.end(), 1.0f);
+	}
+
+	void SoftwareRasterizer::SetDepthTest(bool enabled)
+	{
+		s_Data->DepthTest = enabled;
+	}
+
+	void SoftwareRasterizer::BindTarget(SoftwareTarget* target)
+	{
+		s_Data->Target = target ? target : &s_Data->DefaultTarget;
+	}
+
+	const SoftwareTarget& SoftwareRasterizer::GetDefaultTarget()
+	{
+		return s_Data->DefaultTarget;
+	}
+
+	void SoftwareRasterizer::BindShader(const SoftwareShader* shader)
+	{
+		s_Data->Shader = shader;
+	}
+
+	void SoftwareRasterizer::UnbindShader(const SoftwareShader* shader)
+	{
+		if (s_Data && s_Data->Shader == shader)
+			s_Data->Shader = nullptr;
+	}
+
+	uint32_t SoftwareRasterizer::NewRendererID()
+	{
+		return s_Data->NextRendererID++;
+	}
+
+	void SoftwareRasterizer::RegisterImage(uint32_t rendererID, const SoftwareImage* image)
+	{
+		s_Data->Images[rendererID] = image;
+	}
+
+	void SoftwareRasterizer::UnregisterImage(uint32_t rendererID)
+	{
+		// Resources can outlive the renderer
+		if (!s_Data)
+			return;
+
+		auto it = s_Data->Images.find(rendererID);
+		if (it == s_Data->Images.end())
+			return;
+
+		for (const SoftwareImage*& slot : s_Data->TextureSlots)
+		{
+			if (slot == it->second)
+				slot = nullptr;
+		}
+		s_Data->Images.erase(it);
+	}
+
+	void SoftwareRasterizer::BindTexture(uint32_t slot, uint32_t rendererID)
+	{
+		GE_CORE_ASSERT(slot < MaxTextureSlots, "Texture slot out of range");
+		auto it = s_Data->Images.find(rendererID);
+		s_Data->TextureSlots[slot] = it != s_Data->Images.end() ? it->second : nullptr;
+	}
+
+	void SoftwareRasterizer::DrawTriangles(const SoftwareVertexInput* inputs, const uint32_t* indices, uint32_t count, int32_t baseVertex)
+	{
+		GE_PROFILE_FUNCTION();
+
+		const SoftwareTarget& target = *s_Data->Target;
+		const uint32_t triangleCount = count / 3;
+		if (triangleCount == 0 || !s_Data->Shader || target.Color.Width == 0 || target.Color.Height == 0)
+			return;
+
+		// Only the referenced vertex range goes through the vertex program
+		uint32_t firstVertex = (uint32_t)baseVertex, lastVertex = (uint32_t)baseVertex + count - 1;
+		if (indices)
+		{
+			uint32_t minIndex = UINT32_MAX, maxIndex = 0;
+			for (uint32_t i = 0; i < triangleCount * 3; i++)
+			{
+				minIndex = std::min(minIndex, indices[i]);
+				maxIndex = std::max(maxIndex, indices[i]);
+			}
+			firstVertex = minIndex + baseVertex;
+			lastVertex = maxIndex + baseVertex;
+		}
+
+		const uint32_t vertexCount = lastVertex - firstVertex + 1;
+		const uint32_t threadCount = s_Data->ThreadCount;
+		{
+			GE_PROFILE_SCOPE("SoftwareRasterizer - Vertex");
+
+			s_Data->Vertices.resize(vertexCount);
+			const glm::mat4 viewProjection = s_Data->Shader->GetViewProjection();
+
+			const uint32_t chunkSize = 4096;
+			Dispatch((vertexCount + chunkSize - 1) / chunkSize, [&](uint32_t chunk)
+			{
+				uint32_t begin = chunk * chunkSize;
+				ShadeVertices(inputs, viewProjection, firstVertex, begin, std::min(begin + chunkSize, vertexCount));
+			});
+		}
+
+		const int32_t* viewport = s_Data->Viewport;
+		const int32_t clipMinX = std::max(viewport[0], 0);
+		const int32_t clipMinY = std::max(viewport[1], 0);
+		const int32_t clipMaxX = std::min(viewport[0] + viewport[2], (int32_t)target.Color.Width) - 1;
+		const int32_t clipMaxY = std::min(viewport[1] + viewport[3], (int32_t)target.Color.Height) - 1;
+		if (clipMinX > clipMaxX || clipMinY > clipMaxY)
+			return;
+
+		s_Data->TilesX = (target.Color.Width + TileSize - 1) / TileSize;
+		s_Data->TilesY = (target.Color.Height + TileSize - 1) / TileSize;
+		const uint32_t tileCount = s_Data->TilesX * s_Data->TilesY;
+		{
+			GE_PROFILE_SCOPE("SoftwareRasterizer - Setup");
+
+			// Small draws are not worth splitting
+			const uint32_t minTrianglesPerJob = 512;
+			s_Data->SetupJobCount = std::max(std::min(threadCount, triangleCount / minTrianglesPerJob), 1u);
+			if (s_Data->Triangles.size() < s_Data->SetupJobCount)
+				s_Data->Triangles.resize(s_Data->SetupJobCount);
+			if (s_Data->Bins.size() < (size_t)s_Data->SetupJobCount * tileCount)
+				s_Data->Bins.resize((size_t)s_Data->SetupJobCount * tileCount);
+
+			const uint32_t jobCount = s_Data->SetupJobCount;
+			Dispatch(jobCount, [&](uint32_t job)
+			{
+				std::vector<SetupTriangle>& triangles = s_Data->Triangles[job];
+				std::vector<uint32_t>* bins = &s_Data->Bins[(size_t)job * tileCount];
+				triangles.clear();
+				for (uint32_t tile = 0; tile < tileCount; tile++)
+					bins[tile].clear();
+
+				uint32_t begin = (uint32_t)((uint64_t)triangleCount * job / jobCount);
+				uint32_t end = (uint32_t)((uint64_t)triangleCount * (job + 1) / jobCount);
+				for (uint32_t t = begin; t < end; t++)
+				{
+					uint32_t i0 = indices ? indices[t * 3 + 0] + baseVertex : baseVertex + t * 3 + 0;
+					uint32_t i1 = indices ? indices[t * 3 + 1] + baseVertex : baseVertex + t * 3 + 1;
+					uint32_t i2 = indices ? indices[t * 3 + 2] + baseVertex : baseVertex + t * 3 + 2;
+
+					SetupTriangle triangle;
+					if (!Setup(i0 - firstVertex, i1 - firstVertex, i2 - firstVertex, clipMinX, clipMinY, clipMaxX, clipMaxY, triangle))
+						continue;
+
+					BinTriangle(triangle, (uint32_t)triangles.size(), bins);
+					triangles.push_back(triangle);
+				}
+			});
+		}
+
+		{
+			GE_PROFILE_SCOPE("SoftwareRasterizer - Raster");
+			Dispatch(tileCount, RasterizeTile);
+		}
+	}
+}
\ No newline at end of file
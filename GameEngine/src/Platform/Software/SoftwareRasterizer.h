@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+namespace Engine {
+
+	class SoftwareShader;
+
+	// RGBA8 texels, one uint32_t per texel with red in the lowest byte. Rows go from
+	// bottom to top like GL textures and glReadPixels.
+	struct SoftwareImage
+	{
+		uint32_t Width = 0, Height = 0;
+		std::vector<uint32_t> Texels;
+	};
+
+	// Color and depth buffer drawn into, the default target or a SoftwareFramebuffer
+	struct SoftwareTarget
+	{
+		SoftwareImage Color;
+		// Rows padded to a multiple of 4 so the depth test can always load 4 pixels
+		std::vector<float> Depth;
+		uint32_t DepthStride = 0;
+
+		void Resize(uint32_t width, uint32_t height);
+	};
+
+	// Vertex attribute read by the fixed vertex program, see SoftwareRasterizer
+	struct SoftwareVertexInput
+	{
+		const uint8_t* Data = nullptr;
+		uint32_t Stride = 0;
+		uint32_t Components = 0;
+		uint32_t VertexCount = 0;
+	};
+
+	// Multithreaded tile binned rasterizer behind SoftwareRendererAPI. Every draw runs
+	//   vertex:  the referenced index range is transformed in parallel chunks
+	//   setup:   triangles are split into contiguous chunks, every chunk computes edge
+	//            equations and appends its triangles to the bins of the tiles they touch
+	//   raster:  tiles are rasterized in parallel, each walks the bins of all chunks in
+	//            chunk order, so triangles blend in submission order without locks
+	// Coverage and depth are evaluated for 4 pixels at a time with SSE edge functions.
+	//
+	// Only the Renderer2D texture program is implemented, whatever shader is bound:
+	// attribute locations 0-4 are position, color, texture coordinate, texture index and
+	// tiling factor, the fragment is color * texture, blended with src alpha / 1 - src alpha.
+	// Triangles with a vertex behind the eye are dropped instead of clipped.
+	class SoftwareRasterizer
+	{
+	public:
+		static const uint32_t TileSize = 64;
+		static const uint32_t MaxTextureSlots = 32;
+		static const uint32_t AttributeCount = 5;
+
+		static void Init();
+		static void Shutdown();
+
+		// 0 uses every hardware thread, the calling thread counts as one of them
+		static void SetThreadCount(uint32_t count);
+		static uint32_t GetThreadCount();
+
+		// While the default target is bound it is sized to the viewport extent, there is no window to size it
+		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		static void SetClearColor(const glm::vec4& color);
+		// Clears color and depth of the whole bound target
+		static void Clear();
+		static void SetDepthTest(bool enabled);
+
+		// nullptr binds the default target
+		static void BindTarget(SoftwareTarget* target);
+		static const SoftwareTarget& GetDefaultTarget();
+
+		// Reads the view projection matrix from the bound shader at draw time
+		static void BindShader(const SoftwareShader* shader);
+		static void UnbindShader(const SoftwareShader* shader);
+
+		// Textures are looked up by renderer id, like the GL texture units
+		static uint32_t NewRendererID();
+		static void RegisterImage(uint32_t rendererID, const SoftwareImage* image);
+		static void UnregisterImage(uint32_t rendererID);
+		static void BindTexture(uint32_t slot, uint32_t rendererID);
+
+		// Draws a triangle list. inputs holds AttributeCount locations, missing attributes have
+		// no data. Without indices the vertices are used in order.
+		static void DrawTriangles(const SoftwareVertexInput* inputs, const uint32_t* indices, uint32_t count, int32_t baseVertex);
+	};
+}
\ No newline at end of file
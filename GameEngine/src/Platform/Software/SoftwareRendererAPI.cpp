@@ -0,0 +1,137 @@
+#include "gepch.h"
+#include "SoftwareRendererAPI.h"
+#include "SoftwareBuffer.h"
+
+namespace Engine {
+
+	// Maps the layouts of the vertex buffers onto attribute locations, the way
+	// OpenGLVertexArray numbers them
+	static void GetVertexInputs(const Ref<VertexArray>& vertexArray, SoftwareVertexInput* inputs)
+	{
+		uint32_t location = 0;
+		for (const Ref<VertexBuffer>& vertexBuffer : vertexArray->GetVertexBuffers())
+		{
+			const auto& data = ((const SoftwareVertexBuffer&)*vertexBuffer).GetData();
+			const BufferLayout& layout = vertexBuffer->GetLayout();
+			for (const BufferElement& element : layout)
+			{
+				if (location < SoftwareRasterizer::AttributeCount && element.Type >= ShaderDataType::Float && element.Type <= ShaderDataType::Float4)
+				{
+					SoftwareVertexInput& input = inputs[location];
+					input.Data = data.data() + element.Offset;
+					input.Stride = layout.GetStride();
+					input.Components = element.GetComponentCount();
+					input.VertexCount = layout.GetStride() ? (uint32_t)data.size() / layout.GetStride() : 0;
+				}
+				location++;
+			}
+		}
+	}
+
+	SoftwareRendererAPI::SoftwareRendererAPI()
+	{
+		SoftwareRasterizer::Init();
+	}
+
+	SoftwareRendererAPI::~SoftwareRendererAPI()
+	{
+		SoftwareRasterizer::Shutdown();
+	}
+
+	void SoftwareRendererAPI::Init()
+	{
+		GE_PROFILE_FUNCTION();
+
+		GE_CORE_INFO("Using the software RendererAPI on {0} thread(s)", SoftwareRasterizer::GetThreadCount());
+
+		// Same defaults as OpenGLRendererAPI, blending is always on
+		SoftwareRasterizer::SetDepthTest(true);
+	}
+
+	void SoftwareRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		SoftwareRasterizer::SetViewport(x, y, width, height);
+		m_StateCalls++;
+	}
+
+	void SoftwareRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		SoftwareRasterizer::SetClearColor(color);
+		m_StateCalls++;
+	}
+
+	void SoftwareRendererAPI::Clear()
+	{
+		SoftwareRasterizer::Clear();
+	}
+
+	void SoftwareRendererAPI::DepthTest(bool depthTest)
+	{
+		SoftwareRasterizer::SetDepthTest(depthTest);
+		m_StateCalls++;
+	}
+
+	void SoftwareRendererAPI::DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	{
+		const auto& indexBuffer = (const SoftwareIndexBuffer&)*vertexArray->GetIndexBuffer();
+		uint32_t count = indexCount ? std::min(indexCount, indexBuffer.GetCount()) : indexBuffer.GetCount();
+
+		SoftwareVertexInput inputs[SoftwareRasterizer::AttributeCount];
+		GetVertexInputs(vertexArray, inputs);
+		SoftwareRasterizer::DrawTriangles(inputs, indexBuffer.GetIndices(), count, 0);
+	}
+
+	void SoftwareRendererAPI::DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+	{
+		const auto& indexBuffer = (const SoftwareIndexBuffer&)*vertexArray->GetIndexBuffer();
+		if (firstIndex >= indexBuffer.GetCount())
+			return;
+
+		SoftwareVertexInput inputs[SoftwareRasterizer::AttributeCount];
+		GetVertexInputs(vertexArray, inputs);
+		uint32_t count = std::min(indexCount, indexBuffer.GetCount() - firstIndex);
+		SoftwareRasterizer::DrawTriangles(inputs, indexBuffer.GetIndices() + firstIndex, count, (int32_t)baseVertex);
+	}
+
+	void SoftwareRendererAPI::DrawArrays(const Engine::Ref<VertexArray>& vertexArray)
+	{
+		SoftwareVertexInput inputs[SoftwareRasterizer::AttributeCount];
+		GetVertexInputs(vertexArray, inputs);
+		SoftwareRasterizer::DrawTriangles(inputs, nullptr, inputs[0].VertexCount, 0);
+	}
+
+	void SoftwareRendererAPI::MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount)
+	{
+		const auto& commands = ((const SoftwareIndirectBuffer&)*indirectBuffer).GetCommands();
+		for (uint32_t i = firstCommand; i < firstCommand + drawCount && i < (uint32_t)commands.size(); i++)
+		{
+			// Instances would all land on the same spot without the per instance data of the 3D shaders
+			const DrawIndexedIndirectCommand& command = commands[i];
+			if (command.InstanceCount)
+				DrawIndexedBaseVertex(vertexArray, command.IndexCount, command.FirstIndex, (uint32_t)command.BaseVertex);
+		}
+	}
+
+	void SoftwareRendererAPI::BindTexture(uint32_t slot, uint32_t rendererID)
+	{
+		SoftwareRasterizer::BindTexture(slot, rendererID);
+		m_StateCalls++;
+	}
+
+	RendererAPI::StateStatistics SoftwareRendererAPI::GetStateStats() const
+	{
+		StateStatistics stats;
+		stats.Issued = m_StateCalls;
+		return stats;
+	}
+
+	void SoftwareRendererAPI::ResetStateStats()
+	{
+		m_StateCalls = 0;
+	}
+
+	const SoftwareImage& SoftwareRendererAPI::GetColorBuffer()
+	{
+		return SoftwareRasterizer::GetDefaultTarget().Color;
+	}
+}
\ No newline at end of file
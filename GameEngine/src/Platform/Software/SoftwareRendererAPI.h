@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Engine/Renderer/RendererAPI.h"
+#include "SoftwareRasterizer.h"
+
+namespace Engine {
+
+	// CPU rendering for machines without a GPU, see SoftwareRasterizer for what is supported.
+	// Draws are complete when the call returns, so Finish() has nothing to wait for.
+	class SoftwareRendererAPI : public RendererAPI
+	{
+	public:
+		SoftwareRendererAPI();
+		virtual ~SoftwareRendererAPI();
+
+		virtual void Init() override;
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		virtual void SetClearColor(const glm::vec4& color) override;
+		virtual void Clear() override;
+		virtual void DepthTest(bool depthTest) override;
+
+		virtual void DrawIndexed(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedBaseVertex(const Engine::Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex) override;
+		virtual void DrawArrays(const Engine::Ref<VertexArray>& vertexArray) override;
+		virtual void MultiDrawIndexedIndirect(const Engine::Ref<VertexArray>& vertexArray, const Engine::Ref<IndirectBuffer>& indirectBuffer, uint32_t firstCommand, uint32_t drawCount) override;
+
+		virtual void BindTexture(uint32_t slot, uint32_t rendererID) override;
+
+		virtual void Finish() override {}
+
+		// Every state call counts as issued, nothing is cached
+		virtual StateStatistics GetStateStats() const override;
+		virtual void ResetStateStats() override;
+
+		// Color buffer of the default target, bottom row first
+		static const SoftwareImage& GetColorBuffer();
+	private:
+		uint32_t m_StateCalls = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "gepch.h"
+#include "SoftwareShader.h"
+
+#include "SoftwareRasterizer.h"
+
+namespace Engine {
+
+	SoftwareShader::SoftwareShader(const std::string& filepath)
+		: m_RendererID(SoftwareRasterizer::NewRendererID())
+	{
+		// Same naming as OpenGLShader, so ShaderLibrary lookups match
+		auto lastSlash = filepath.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = filepath.rfind('.');
+		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filepath.substr(lastSlash, count);
+	}
+
+	SoftwareShader::SoftwareShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_Name(name), m_RendererID(SoftwareRasterizer::NewRendererID())
+	{
+	}
+
+	SoftwareShader::~SoftwareShader()
+	{
+		SoftwareRasterizer::UnbindShader(this);
+	}
+
+	void SoftwareShader::Bind() const
+	{
+		SoftwareRasterizer::BindShader(this);
+	}
+
+	void SoftwareShader::Unbind() const
+	{
+		SoftwareRasterizer::UnbindShader(this);
+	}
+
+	void SoftwareShader::SetMat4(const std::string& name, const glm::mat4& value)
+	{
+		if (name == "u_ViewProjectionMatrix")
+			m_ViewProjection = value;
+	}
+}
\ No newline at end of file
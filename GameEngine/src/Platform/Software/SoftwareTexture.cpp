@@ -0,0 +1,62 @@
+#include "gepch.h"
+#include "SoftwareTexture.h"
+#include "Engine/Core/VFS.h"
+
+#include "stb_image.h"
+
+namespace Engine {
+
+	SoftwareTexture2D::SoftwareTexture2D(uint32_t width, uint32_t height)
+		: m_RendererID(SoftwareRasterizer::NewRendererID())
+	{
+		m_Image.Width = width;
+		m_Image.Height = height;
+		m_Image.Texels.resize((size_t)width * height);
+		SoftwareRasterizer::RegisterImage(m_RendererID, &m_Image);
+	}
+
+	SoftwareTexture2D::SoftwareTexture2D(const std::string& path)
+		: m_RendererID(SoftwareRasterizer::NewRendererID())
+	{
+		GE_PROFILE_FUNCTION();
+
+		// Same orientation as OpenGLTexture2D, the first row is v = 0
+		stbi_set_flip_vertically_on_load(1);
+		int width, height, channels;
+		stbi_uc* data = nullptr;
+		{
+			GE_PROFILE_SCOPE("stbi_load - SoftwareTexture2D::SoftwareTexture2D(const std::string&) stbi_load");
+			FileBuffer file = VFS::Read(path);
+			if (file)
+				data = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, 4);
+		}
+		GE_CORE_ASSERT(data, "Failed to load image");
+		if (data)
+		{
+			m_Image.Width = width;
+			m_Image.Height = height;
+			m_Image.Texels.resize((size_t)width * height);
+			memcpy(m_Image.Texels.data(), data, m_Image.Texels.size() * sizeof(uint32_t));
+			stbi_image_free(data);
+		}
+		SoftwareRasterizer::RegisterImage(m_RendererID, &m_Image);
+	}
+
+	SoftwareTexture2D::~SoftwareTexture2D()
+	{
+		SoftwareRasterizer::UnregisterImage(m_RendererID);
+	}
+
+	void SoftwareTexture2D::SetData(void* data, uint32_t size)
+	{
+		GE_PROFILE_FUNCTION();
+
+		GE_CORE_ASSERT(size == m_Image.Width * m_Image.Height * 4, "");
+		memcpy(m_Image.Texels.data(), data, std::min<size_t>(size, m_Image.Texels.size() * sizeof(uint32_t)));
+	}
+
+	void SoftwareTexture2D::Bind(uint32_t slot) const
+	{
+		SoftwareRasterizer::BindTexture(slot, m_RendererID);
+	}
+}
\ No newline at end of file
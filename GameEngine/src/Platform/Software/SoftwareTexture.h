@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Engine/Renderer/Texture.h"
+#include "SoftwareRasterizer.h"
+
+namespace Engine {
+
+	// Stored as RGBA8 whatever the source has, sampled with GL_REPEAT
+	class SoftwareTexture2D : public Texture2D
+	{
+	public:
+		SoftwareTexture2D(uint32_t width, uint32_t height);
+		SoftwareTexture2D(const std::string& path);
+		virtual ~SoftwareTexture2D();
+
+		virtual uint32_t GetWidth() const override { return m_Image.Width; }
+		virtual uint32_t GetHeight() const override { return m_Image.Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+
+		virtual void Bind(uint32_t slot = 0) const override;
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+	private:
+		uint32_t m_RendererID;
+		SoftwareImage m_Image;
+	};
+}
\ No newline at end of file
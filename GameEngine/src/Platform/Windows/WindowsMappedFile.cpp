@@ -0,0 +1,50 @@
+#include "gepch.h"
+#include "WindowsMappedFile.h"
+
+namespace Engine {
+
+	WindowsMappedFile::~WindowsMappedFile()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+	}
+
+	bool WindowsMappedFile::Map(const std::string& filepath)
+	{
+		HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		// CreateFileMapping refuses empty files
+		if (size.QuadPart > 0)
+		{
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping)
+			{
+				CloseHandle(file);
+				return false;
+			}
+
+			void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			// The view keeps its own references to the mapping and the file
+			CloseHandle(mapping);
+			if (!data)
+			{
+				CloseHandle(file);
+				return false;
+			}
+			m_Data = (const uint8_t*)data;
+			m_Size = (size_t)size.QuadPart;
+		}
+
+		CloseHandle(file);
+		return true;
+	}
+}
\ No newline at end of file
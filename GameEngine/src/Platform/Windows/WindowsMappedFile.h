@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Engine/Core/MappedFile.h"
+
+namespace Engine {
+
+	class WindowsMappedFile : public MappedFile
+	{
+	public:
+		virtual ~WindowsMappedFile();
+
+		bool Map(const std::string& filepath);
+	};
+}
\ No newline at end of file
@@ -1,9 +1,7 @@
 #include "gepch.h"
 #include "WindowsWindow.h"
 
-#include "Engine/Events/ApplicationEvent.h"
-#include "Engine/Events/KeyEvent.h"
-#include "Engine/Events/MouseEvent.h"
+#include "Engine/Events/EventBus.h"
 
 #include "Platform/OpenGL/OpenGLContext.h"
 
@@ -16,11 +14,6 @@ namespace Engine {
 		GE_CORE_ERROR("GLFW Error ({0}): {1}", error, description);
 	}
 
-	Scope<Window> Window::Create(const WindowProps& props)
-	{
-		return CreateScope<WindowsWindow>(props);
-	}
-
 	WindowsWindow::WindowsWindow(const WindowProps& props)
 	{
 		GE_PROFILE_FUNCTION();
@@ -56,6 +49,7 @@ namespace Engine {
 		{
 			GE_PROFILE_SCOPE("glfwCreateWindow");
 
+			glfwWindowHint(GLFW_VISIBLE, props.Visible ? GLFW_TRUE : GLFW_FALSE);
 			m_Window = glfwCreateWindow((int)props.Width, (int)props.Height, m_Data.Title.c_str(), nullptr, nullptr);
 			++s_GLFWWindowCount;
 		}
@@ -71,95 +65,86 @@ namespace Engine {
 
 		SetVSync(true);
 
-		// Set GLFW callbacks
+		// Set GLFW callbacks, events are recorded and dispatched later by the EventBus
 		glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 			data.Width = width;
 			data.Height = height;
 
-			WindowResizeEvent event(width, height);
-			
-			// It calls Application::OnEvent(event)
-			data.EventCallback(event);
+			QueuedEvent event;
+			event.Type = EventType::WindowResize;
+			event.WindowResize = { (uint32_t)width, (uint32_t)height };
+			data.Post(event);
 		});
 
 		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
-			WindowCloseEvent event;
-			data.EventCallback(event);
+
+			QueuedEvent event;
+			event.Type = EventType::WindowClose;
+			data.Post(event);
 		});
 
 		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int modes)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
+			QueuedEvent event;
 			switch (action)
 			{
-				case GLFW_PRESS:
-				{
-					KeyPressedEvent event(key, 0);
-					data.EventCallback(event);
-					break;
-				}
-				case GLFW_RELEASE:
-				{
-					KeyReleasedEvent event(key);
-					data.EventCallback(event);
-					break;
-				}
-				case GLFW_REPEAT:
-				{
-					KeyPressedEvent event(key, 1);
-					data.EventCallback(event);
-					break;
-				}
+				case GLFW_PRESS:	event.Type = EventType::KeyPressed; event.Key = { key, 0 }; break;
+				case GLFW_RELEASE:	event.Type = EventType::KeyReleased; event.Key = { key, 0 }; break;
+				case GLFW_REPEAT:	event.Type = EventType::KeyPressed; event.Key = { key, 1 }; break;
+				default:			return;
 			}
+			data.Post(event);
 		});
 
 		glfwSetCharCallback(m_Window, [](GLFWwindow* window, unsigned int keycode)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			KeyTypedEvent event(keycode);
-			data.EventCallback(event);
+			QueuedEvent event;
+			event.Type = EventType::KeyTyped;
+			event.Key = { (int32_t)keycode, 0 };
+			data.Post(event);
 		});
 
 		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			QueuedEvent event;
 			switch (action)
 			{
-				case GLFW_PRESS:
-				{
-					MouseButtonPressedEvent event(button);
-					data.EventCallback(event);
-					break;
-				}
-				case GLFW_RELEASE:
-				{
-					MouseButtonReleasedEvent event(button);
-					data.EventCallback(event);
-					break;
-				}
+				case GLFW_PRESS:	event.Type = EventType::MouseButtonPressed; break;
+				case GLFW_RELEASE:	event.Type = EventType::MouseButtonReleased; break;
+				default:			return;
 			}
+			event.MouseButton = { button };
+			data.Post(event);
 		});
 
 		glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double xOffset, double yOffset)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			MouseScrolledEvent event((float)xOffset, (float)yOffset);
-			data.EventCallback(event);
+			QueuedEvent event;
+			event.Type = EventType::MouseScrolled;
+			event.MouseScrolled = { (float)xOffset, (float)yOffset };
+			data.Post(event);
 		});
 
 		glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double xPos, double yPos)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			MouseMovedEvent event((float)xPos, (float)yPos);
-			data.EventCallback(event);
+			QueuedEvent event;
+			event.Type = EventType::MouseMoved;
+			event.MouseMoved = { (float)xPos, (float)yPos };
+			data.Post(event);
 		});
 	}
 
@@ -185,7 +170,17 @@ namespace Engine {
 	{
 		GE_PROFILE_FUNCTION();
 
+		PollEvents();
+		SwapBuffers();
+	}
+
+	void WindowsWindow::PollEvents()
+	{
 		glfwPollEvents();
+	}
+
+	void WindowsWindow::SwapBuffers()
+	{
 		m_Context->SwapBuffers();
 	}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Core/Window.h"
+#include "Engine/Events/EventBus.h"
 #include "Engine/Renderer/GraphicsContext.h"
 
 #include <GLFW/glfw3.h>
@@ -15,16 +16,19 @@ namespace Engine {
 		virtual ~WindowsWindow();
 
 		void OnUpdate() override;
+		void PollEvents() override;
+		void SwapBuffers() override;
 
 		inline unsigned int GetWidth() const override { return m_Data.Width; }
 		inline unsigned int GetHeight() const override { return m_Data.Height; }
 		virtual std::pair<float, float> GetWindowPos() const override;
 		// Window attributes
-		inline void SetEventCallback(EventCallbackFn&& callback) override { m_Data.EventCallback = callback; }
+		inline void SetEventBus(EventBus* bus) override { m_Data.Bus = bus; }
 		void SetVSync(bool enabled) override;
 		bool IsVSync() const override;
 
 		inline virtual void* GetNativeWindow() const { return m_Window; };
+		inline virtual GraphicsContext* GetContext() const override { return m_Context.get(); }
 	private:
 		virtual void Init(const WindowProps& props);
 		virtual void Shutdown();
@@ -38,7 +42,10 @@ namespace Engine {
 			unsigned int Width, Height;
 			bool VSync;
 
-			EventCallbackFn EventCallback;
+			// Events are dropped without a bus
+			EventBus* Bus = nullptr;
+
+			void Post(const QueuedEvent& event) { if (Bus) Bus->Post(event); }
 		};
 
 		WindowData m_Data;
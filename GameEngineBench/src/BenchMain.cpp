@@ -0,0 +1,267 @@
+#include "Benchmark.h"
+#include "Scenarios.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+// Headless benchmark runner.
+//   GameEngineBench [--filter <text>] [--output <file>] [--assets <dir>] [--baseline <file>] [--tolerance <fraction>] [--api opengl|null|software] [--threads <count>] [--scaling] [--list]
+//   GameEngineBench --compare <baseline.json> <current.json> [--tolerance <fraction>]
+//   GameEngineBench --replay <capture> [--loops <count>]
+// Runs from the project directory like the sandboxes, assets are looked up relative to the repository root.
+// The exit code is 1 when a scenario regressed against the baseline, so CI can fail the build on it.
+// --api null runs without a GPU or display, the timings then cover the CPU side of the renderer only.
+// --api software rasterizes on the CPU with --threads threads, all hardware threads by default.
+// --scaling runs the scenarios with the software API on 1, 2, 4 ... hardware threads and reports
+// each as <scenario>.Threads<count> with its speedup over one thread.
+
+struct BenchOptions
+{
+	std::string Filter;
+	std::string Output = "BenchResults.json";
+	std::string AssetRoot = "..";
+	std::string Baseline;
+	std::string CompareCurrent;
+	std::string Replay;
+	float Tolerance = 0.1f;
+	uint32_t Loops = 100;
+	Engine::RendererAPI::API API = Engine::RendererAPI::API::OpenGL;
+	uint32_t Threads = 0;
+	bool Scaling = false;
+	bool List = false;
+};
+
+static void PrintUsage()
+{
+	printf("Usage: GameEngineBench [--filter <text>] [--output <file>] [--assets <dir>] [--baseline <file>] [--tolerance <fraction>] [--api opengl|null|software] [--threads <count>] [--scaling] [--list]\n");
+	printf("       GameEngineBench --compare <baseline.json> <current.json> [--tolerance <fraction>]\n");
+	printf("       GameEngineBench --replay <capture> [--loops <count>]\n");
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (strcmp(arg, "--filter") == 0 && hasValue)
+			options.Filter = argv[++i];
+		else if (strcmp(arg, "--output") == 0 && hasValue)
+			options.Output = argv[++i];
+		else if (strcmp(arg, "--assets") == 0 && hasValue)
+			options.AssetRoot = argv[++i];
+		else if (strcmp(arg, "--baseline") == 0 && hasValue)
+			options.Baseline = argv[++i];
+		else if (strcmp(arg, "--tolerance") == 0 && hasValue)
+			options.Tolerance = (float)atof(argv[++i]);
+		else if (strcmp(arg, "--compare") == 0 && i + 2 < argc)
+		{
+			options.Baseline = argv[++i];
+			options.CompareCurrent = argv[++i];
+		}
+		else if (strcmp(arg, "--replay") == 0 && hasValue)
+			options.Replay = argv[++i];
+		else if (strcmp(arg, "--loops") == 0 && hasValue)
+			options.Loops = (uint32_t)std::max(atoi(argv[++i]), 1);
+		else if (strcmp(arg, "--api") == 0 && hasValue)
+		{
+			const char* api = argv[++i];
+			if (strcmp(api, "opengl") == 0)
+				options.API = Engine::RendererAPI::API::OpenGL;
+			else if (strcmp(api, "null") == 0)
+				options.API = Engine::RendererAPI::API::Null;
+			else if (strcmp(api, "software") == 0)
+				options.API = Engine::RendererAPI::API::Software;
+			else
+				return false;
+		}
+		else if (strcmp(arg, "--threads") == 0 && hasValue)
+			options.Threads = (uint32_t)std::max(atoi(argv[++i]), 0);
+		else if (strcmp(arg, "--scaling") == 0)
+			options.Scaling = true;
+		else if (strcmp(arg, "--list") == 0)
+			options.List = true;
+		else
+			return false;
+	}
+	return true;
+}
+
+static int CompareFiles(const std::string& baselinePath, const std::vector<BenchmarkResult>& current, float tolerance)
+{
+	std::vector<BenchmarkResult> baseline;
+	if (!BenchmarkRunner::ReadResults(baselinePath, baseline))
+	{
+		fprintf(stderr, "Could not read baseline '%s'\n", baselinePath.c_str());
+		return 2;
+	}
+	return BenchmarkRunner::Compare(baseline, current, tolerance) ? 1 : 0;
+}
+
+// Replays a render capture and prints the most expensive commands
+static int ReplayCapture(const std::string& filepath, uint32_t loops)
+{
+	Engine::Scope<Engine::RenderReplay> replay = Engine::RenderReplay::Create();
+	if (!replay)
+	{
+		fprintf(stderr, "Replay is not supported by this RendererAPI\n");
+		return 2;
+	}
+	if (!replay->Load(filepath))
+		return 2;
+
+	replay->Run(loops);
+
+	std::vector<Engine::ReplayCommandTiming> timings = replay->GetTimings();
+	uint64_t totalCPU = 0, totalGPU = 0;
+	for (const auto& timing : timings)
+	{
+		totalCPU += timing.CPUTime;
+		totalGPU += timing.GPUTime;
+	}
+
+	std::sort(timings.begin(), timings.end(), [](const auto& a, const auto& b) { return a.GPUTime + a.CPUTime > b.GPUTime + b.CPUTime; });
+
+	double perLoop = 1.0 / (1000.0 * replay->GetLoopCount());
+	printf("%u commands, %u loops, per loop: CPU %.3f us  GPU %.3f us\n", (uint32_t)timings.size(), replay->GetLoopCount(), totalCPU * perLoop, totalGPU * perLoop);
+	printf("%-6s %-6s %12s %12s  %s\n", "frame", "index", "CPU us", "GPU us", "command");
+
+	size_t shown = std::min<size_t>(timings.size(), 30);
+	for (size_t i = 0; i < shown; i++)
+	{
+		const auto& timing = timings[i];
+		printf("%-6u %-6u %12.3f %12.3f  %s\n", timing.Frame, timing.Index, timing.CPUTime * perLoop, timing.GPUTime * perLoop, timing.Description.c_str());
+	}
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	BenchOptions options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	// Compare mode only reads result files, no window or context needed
+	if (!options.CompareCurrent.empty())
+	{
+		std::vector<BenchmarkResult> current;
+		if (!BenchmarkRunner::ReadResults(options.CompareCurrent, current))
+		{
+			fprintf(stderr, "Could not read results '%s'\n", options.CompareCurrent.c_str());
+			return 2;
+		}
+		return CompareFiles(options.Baseline, current, options.Tolerance);
+	}
+
+	if (options.Scaling)
+		options.API = Engine::RendererAPI::API::Software;
+
+	std::vector<Engine::Scope<Benchmark>> benchmarks = CreateBenchmarks(options.AssetRoot);
+	if (options.List)
+	{
+		for (const auto& benchmark : benchmarks)
+			printf("%s\n", benchmark->GetName().c_str());
+		return 0;
+	}
+
+	Engine::Log::Init();
+	Engine::JobSystem::Init();
+	Engine::RendererAPI::SetAPI(options.API);
+
+	Engine::WindowProps props("GameEngineBench", 1280, 720);
+	props.Visible = false;
+	Engine::Scope<Engine::Window> window = Engine::Window::Create(props);
+	window->SetVSync(false);
+
+	Engine::Renderer::Init();
+	// Sizes the software backbuffer, which has no window behind it
+	Engine::RenderCommand::SetViewport(0, 0, props.Width, props.Height);
+
+	std::vector<uint32_t> threadCounts = { 0 };
+	if (options.API == Engine::RendererAPI::API::Software)
+	{
+		if (options.Scaling)
+		{
+			uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+			threadCounts.clear();
+			for (uint32_t count = 1; count < hardwareThreads; count *= 2)
+				threadCounts.push_back(count);
+			threadCounts.push_back(hardwareThreads);
+		}
+		else
+			threadCounts[0] = options.Threads;
+	}
+
+	if (!options.Replay.empty())
+	{
+		int result = ReplayCapture(options.Replay, options.Loops);
+		Engine::Renderer::Shutdown();
+		Engine::JobSystem::Shutdown();
+		return result;
+	}
+
+	std::vector<BenchmarkResult> results;
+	for (const auto& benchmark : benchmarks)
+	{
+		if (!options.Filter.empty() && benchmark->GetName().find(options.Filter) == std::string::npos)
+			continue;
+
+		printf("%s\n", benchmark->GetName().c_str());
+		double singleThreadMedian = 0.0;
+		for (uint32_t threadCount : threadCounts)
+		{
+			if (options.API == Engine::RendererAPI::API::Software)
+				Engine::SoftwareRasterizer::SetThreadCount(threadCount);
+
+			BenchmarkResult result = BenchmarkRunner::Run(*benchmark, *window);
+			if (options.Scaling)
+			{
+				result.Name += ".Threads" + std::to_string(threadCount);
+				printf("  %2u threads", threadCount);
+			}
+
+			if (result.Skipped)
+				printf("  skipped\n");
+			else if (result.ItemsPerFrame)
+				printf("  median %.3f ms  p99 %.3f ms  %.1f ns/item", result.Median, result.P99, result.NsPerItem);
+			else
+				printf("  median %.3f ms  p99 %.3f ms", result.Median, result.P99);
+
+			if (result.AllocationsPerFrame >= 0.0)
+				printf("  %.1f allocs/frame", result.AllocationsPerFrame);
+
+			if (options.Scaling && !result.Skipped)
+			{
+				if (threadCount == 1)
+					singleThreadMedian = result.Median;
+				printf("  %.2fx", result.Median > 0.0 ? singleThreadMedian / result.Median : 0.0);
+			}
+			if (!result.Skipped)
+				printf("\n");
+			results.push_back(result);
+
+			// Scenarios that skip do so for every thread count
+			if (result.Skipped)
+				break;
+		}
+	}
+
+	Engine::Renderer::Shutdown();
+	Engine::JobSystem::Shutdown();
+
+	if (!BenchmarkRunner::WriteResults(options.Output, results))
+	{
+		fprintf(stderr, "Could not write '%s'\n", options.Output.c_str());
+		return 2;
+	}
+	printf("Results written to %s\n", options.Output.c_str());
+
+	if (!options.Baseline.empty())
+		return CompareFiles(options.Baseline, results, options.Tolerance);
+	return 0;
+}
\ No newline at end of file
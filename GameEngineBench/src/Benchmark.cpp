@@ -0,0 +1,226 @@
+#include "Benchmark.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+static double Percentile(const std::vector<double>& sorted, double percentile)
+{
+	// Nearest rank
+	size_t rank = (size_t)std::ceil(percentile * sorted.size());
+	return sorted[std::min(std::max(rank, (size_t)1), sorted.size()) - 1];
+}
+
+BenchmarkResult BenchmarkRunner::Run(Benchmark& benchmark, Engine::Window& window)
+{
+	BenchmarkResult result;
+	result.Name = benchmark.GetName();
+
+	benchmark.SetWindow(&window);
+	if (!benchmark.OnSetup())
+	{
+		result.Skipped = true;
+		return result;
+	}
+
+	const Engine::Timestep ts(FixedTimestep);
+	const uint32_t warmupFrames = benchmark.GetWarmupFrameCount();
+	const uint32_t totalFrames = warmupFrames + benchmark.GetFrameCount();
+
+	std::vector<double> frameTimes;
+	frameTimes.reserve(benchmark.GetFrameCount());
+	int64_t allocations = 0;
+	for (uint32_t frame = 0; frame < totalFrames; frame++)
+	{
+		Engine::RenderThread::Submit([]() { Engine::GPUProfiler::BeginFrame(); });
+		Engine::MemoryTracker::BeginFrame();
+		// The snapshot counts the previous frame
+		if (frame > warmupFrames)
+			allocations += Engine::MemoryTracker::GetFrameAllocationCount();
+
+		int64_t start = Engine::Instrumentor::Now();
+		benchmark.OnFrame(ts);
+		Engine::RenderCommand::Finish();
+		// Single threaded this does nothing. Otherwise it waits for the previous frame, so in
+		// steady state the frame time is the slower of recording and executing.
+		Engine::RenderThread::NextFrame();
+		int64_t end = Engine::Instrumentor::Now();
+
+		// Swap and poll are outside the measurement, the window is hidden
+		benchmark.OnFrameEnd();
+		window.PollEvents();
+		Engine::RenderThread::Submit([&window]() { window.SwapBuffers(); });
+		Engine::FrameAllocator::Reset();
+
+		if (frame >= warmupFrames)
+			frameTimes.push_back((end - start) / 1000000.0);
+	}
+	Engine::MemoryTracker::BeginFrame();
+	if (totalFrames > warmupFrames)
+		allocations += Engine::MemoryTracker::GetFrameAllocationCount();
+	benchmark.OnTeardown();
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	double total = 0.0;
+	for (double time : frameTimes)
+		total += time;
+
+	result.Frames = (uint32_t)frameTimes.size();
+	result.ItemsPerFrame = benchmark.GetItemCount();
+	if (!frameTimes.empty())
+	{
+		result.Mean = total / frameTimes.size();
+		result.Median = Percentile(frameTimes, 0.5);
+		result.Min = frameTimes.front();
+		result.Max = frameTimes.back();
+		result.P95 = Percentile(frameTimes, 0.95);
+		result.P99 = Percentile(frameTimes, 0.99);
+		if (result.ItemsPerFrame)
+			result.NsPerItem = result.Median * 1000000.0 / result.ItemsPerFrame;
+		if (Engine::MemoryTracker::IsTrackingAllocations())
+			result.AllocationsPerFrame = (double)allocations / frameTimes.size();
+	}
+	return result;
+}
+
+bool BenchmarkRunner::WriteResults(const std::string& filepath, const std::vector<BenchmarkResult>& results)
+{
+	FILE* file = fopen(filepath.c_str(), "w");
+	if (!file)
+		return false;
+
+	// One scenario per line keeps diffs between result files readable
+	fprintf(file, "{\n\t\"version\": 1,\n\t\"timestep\": %.6f,\n\t\"scenarios\": [\n", FixedTimestep);
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const BenchmarkResult& result = results[i];
+		fprintf(file, "\t\t{ \"name\": \"%s\", \"skipped\": %s, \"frames\": %u, \"items_per_frame\": %u, "
+			"\"mean_ms\": %.6f, \"median_ms\": %.6f, \"min_ms\": %.6f, \"max_ms\": %.6f, \"p95_ms\": %.6f, \"p99_ms\": %.6f, \"ns_per_item\": %.3f, \"allocs_per_frame\": %.2f }%s\n",
+			result.Name.c_str(), result.Skipped ? "true" : "false", result.Frames, result.ItemsPerFrame,
+			result.Mean, result.Median, result.Min, result.Max, result.P95, result.P99, result.NsPerItem, result.AllocationsPerFrame,
+			i + 1 < results.size() ? "," : "");
+	}
+	fprintf(file, "\t]\n}\n");
+
+	fclose(file);
+	return true;
+}
+
+// Just enough JSON for the flat objects WriteResults() produces
+static bool FindValue(const std::string& object, const char* key, std::string& value)
+{
+	std::string pattern = std::string("\"") + key + "\"";
+	size_t position = object.find(pattern);
+	if (position == std::string::npos)
+		return false;
+
+	position = object.find(':', position + pattern.size());
+	if (position == std::string::npos)
+		return false;
+	position = object.find_first_not_of(" \t\r\n", position + 1);
+	if (position == std::string::npos)
+		return false;
+
+	if (object[position] == '"')
+	{
+		size_t end = object.find('"', position + 1);
+		if (end == std::string::npos)
+			return false;
+		value = object.substr(position + 1, end - position - 1);
+		return true;
+	}
+
+	size_t end = object.find_first_of(",} \t\r\n", position);
+	value = object.substr(position, end - position);
+	return !value.empty();
+}
+
+static double FindNumber(const std::string& object, const char* key)
+{
+	std::string value;
+	return FindValue(object, key, value) ? atof(value.c_str()) : 0.0;
+}
+
+bool BenchmarkRunner::ReadResults(const std::string& filepath, std::vector<BenchmarkResult>& results)
+{
+	std::ifstream input(filepath);
+	if (!input)
+		return false;
+	std::string json((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+	size_t position = json.find("\"scenarios\"");
+	if (position == std::string::npos)
+		return false;
+
+	while ((position = json.find('{', position)) != std::string::npos)
+	{
+		size_t end = json.find('}', position);
+		if (end == std::string::npos)
+			return false;
+		std::string object = json.substr(position, end - position + 1);
+		position = end + 1;
+
+		BenchmarkResult result;
+		if (!FindValue(object, "name", result.Name))
+			return false;
+
+		std::string skipped;
+		result.Skipped = FindValue(object, "skipped", skipped) && skipped == "true";
+		result.Frames = (uint32_t)FindNumber(object, "frames");
+		result.ItemsPerFrame = (uint32_t)FindNumber(object, "items_per_frame");
+		result.Mean = FindNumber(object, "mean_ms");
+		result.Median = FindNumber(object, "median_ms");
+		result.Min = FindNumber(object, "min_ms");
+		result.Max = FindNumber(object, "max_ms");
+		result.P95 = FindNumber(object, "p95_ms");
+		result.P99 = FindNumber(object, "p99_ms");
+		result.NsPerItem = FindNumber(object, "ns_per_item");
+		// Missing in files written before allocations were counted
+		std::string allocations;
+		if (FindValue(object, "allocs_per_frame", allocations))
+			result.AllocationsPerFrame = atof(allocations.c_str());
+		results.push_back(result);
+	}
+	return true;
+}
+
+uint32_t BenchmarkRunner::Compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, float tolerance)
+{
+	uint32_t regressions = 0;
+
+	printf("%-40s %12s %12s %9s\n", "Scenario", "Baseline ms", "Current ms", "Change");
+	for (const BenchmarkResult& result : current)
+	{
+		auto it = std::find_if(baseline.begin(), baseline.end(), [&](const BenchmarkResult& other) { return other.Name == result.Name; });
+		if (it == baseline.end() || it->Skipped || result.Skipped || it->Median <= 0.0)
+		{
+			printf("%-40s %12s %12s %9s\n", result.Name.c_str(), "-", result.Skipped ? "skipped" : "-", it == baseline.end() ? "new" : "");
+			continue;
+		}
+
+		double change = result.Median / it->Median - 1.0;
+		const char* verdict = "";
+		if (change > tolerance)
+		{
+			verdict = "REGRESSION";
+			regressions++;
+		}
+		else if (change < -tolerance)
+		{
+			verdict = "improved";
+		}
+		printf("%-40s %12.3f %12.3f %+8.1f%% %s\n", result.Name.c_str(), it->Median, result.Median, change * 100.0, verdict);
+	}
+
+	for (const BenchmarkResult& result : baseline)
+	{
+		auto it = std::find_if(current.begin(), current.end(), [&](const BenchmarkResult& other) { return other.Name == result.Name; });
+		if (it == current.end())
+			printf("%-40s %12.3f %12s %9s\n", result.Name.c_str(), result.Median, "-", "missing");
+	}
+
+	printf("%u regression(s) beyond %.0f%%\n", regressions, tolerance * 100.0f);
+	return regressions;
+}
\ No newline at end of file
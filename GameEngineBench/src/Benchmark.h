@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Engine.h>
+
+// A scenario run by GameEngineBench.
+// Every frame gets the same fixed timestep and scenarios seed their own random
+// numbers, so two runs on the same machine do exactly the same work.
+class Benchmark
+{
+public:
+	Benchmark(const std::string& name, uint32_t frames, uint32_t warmupFrames = 10)
+		: m_Name(name), m_Frames(frames), m_WarmupFrames(warmupFrames) {}
+	virtual ~Benchmark() = default;
+
+	// Returning false skips the scenario, e.g. when an asset is missing
+	virtual bool OnSetup() { return true; }
+	virtual void OnFrame(Engine::Timestep ts) = 0;
+	// Runs after every frame, outside the measurement
+	virtual void OnFrameEnd() {}
+	virtual void OnTeardown() {}
+
+	inline const std::string& GetName() const { return m_Name; }
+	inline uint32_t GetFrameCount() const { return m_Frames; }
+	inline uint32_t GetWarmupFrameCount() const { return m_WarmupFrames; }
+	// Work items per frame (quads, queries, probes), reported as time per item
+	inline uint32_t GetItemCount() const { return m_ItemCount; }
+
+	// Set by BenchmarkRunner before OnSetup()
+	inline void SetWindow(Engine::Window* window) { m_Window = window; }
+protected:
+	uint32_t m_ItemCount = 0;
+	Engine::Window* m_Window = nullptr;
+private:
+	std::string m_Name;
+	uint32_t m_Frames;
+	uint32_t m_WarmupFrames;
+};
+
+struct BenchmarkResult
+{
+	std::string Name;
+	bool Skipped = false;
+	uint32_t Frames = 0;
+	uint32_t ItemsPerFrame = 0;
+
+	// Frame times in milliseconds
+	double Mean = 0.0;
+	double Median = 0.0;
+	double Min = 0.0;
+	double Max = 0.0;
+	double P95 = 0.0;
+	double P99 = 0.0;
+	// Median frame time divided by the items per frame
+	double NsPerItem = 0.0;
+	// Mean heap allocations per measured frame, -1 when MemoryTracker doesn't hook the heap
+	double AllocationsPerFrame = -1.0;
+};
+
+class BenchmarkRunner
+{
+public:
+	static constexpr float FixedTimestep = 1.0f / 60.0f;
+
+	// Frames are timed from the start of OnFrame() until the GPU has finished them. When a
+	// scenario starts the render thread, the time runs until the previous frame has executed.
+	static BenchmarkResult Run(Benchmark& benchmark, Engine::Window& window);
+
+	static bool WriteResults(const std::string& filepath, const std::vector<BenchmarkResult>& results);
+	// Reads files written by WriteResults()
+	static bool ReadResults(const std::string& filepath, std::vector<BenchmarkResult>& results);
+
+	// A scenario regresses when its median is more than tolerance (0.1 = 10%) slower than the baseline.
+	// Prints a table and returns the number of regressions.
+	static uint32_t Compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, float tolerance);
+};
\ No newline at end of file
@@ -0,0 +1,887 @@
+#include "Scenarios.h"
+
+#include "ParticleSystem.h"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Engine/Core/PakFormat.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+
+static const uint32_t s_Seed = 1337;
+
+static bool FileExists(const std::string& filepath)
+{
+	std::ifstream file(filepath);
+	if (!file)
+		printf("  missing '%s'\n", filepath.c_str());
+	return (bool)file;
+}
+
+// Objects scattered through a cube, sizes between 0.5 and 4 units
+static std::vector<Engine::AABB> RandomBoxes(uint32_t count, float worldSize, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> position(-worldSize * 0.5f, worldSize * 0.5f);
+	std::uniform_real_distribution<float> size(0.25f, 2.0f);
+
+	std::vector<Engine::AABB> boxes(count);
+	for (Engine::AABB& box : boxes)
+	{
+		glm::vec3 center(position(random), position(random), position(random));
+		glm::vec3 extents(size(random), size(random), size(random));
+		box = Engine::AABB(center - extents, center + extents);
+	}
+	return boxes;
+}
+
+// Camera circling the origin, one revolution every 10 seconds of simulated time
+static Engine::Frustum OrbitFrustum(float time, float distance)
+{
+	float angle = time * glm::two_pi<float>() / 10.0f;
+	glm::vec3 eye(glm::cos(angle) * distance, distance * 0.25f, glm::sin(angle) * distance);
+	glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, distance * 2.0f);
+	return Engine::Frustum::FromViewProjection(projection * view);
+}
+
+// Renderer2D batching with 100k rotated quads a frame
+class QuadStressBenchmark : public Benchmark
+{
+public:
+	QuadStressBenchmark(const std::string& name = "Renderer2D.Quads.100k")
+		: Benchmark(name, 300), m_Camera(-160.0f, 160.0f, -90.0f, 90.0f)
+	{
+		m_ItemCount = 100000;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		m_Time += ts;
+
+		Engine::Renderer2D::ResetStats();
+		Engine::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+		Engine::RenderCommand::Clear();
+
+		Engine::Renderer2D::BeginScene(m_Camera);
+		const uint32_t columns = 400;
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			float x = (float)(i % columns) * 0.8f - 160.0f;
+			float y = (float)(i / columns) * 0.72f - 90.0f;
+			glm::vec4 color((i % columns) / (float)columns, (i / columns) / 250.0f, 0.5f, 1.0f);
+			Engine::Renderer2D::DrawRotatedQuad({ x, y }, { 0.6f, 0.6f }, m_Time + i * 0.01f, color);
+		}
+		Engine::Renderer2D::EndScene();
+	}
+private:
+	Engine::OrthographicCamera m_Camera;
+	float m_Time = 0.0f;
+};
+
+// The quad stress load with the render thread set to the given policy. Both variants
+// go through RenderThread, so the difference between them is the pipelining alone.
+class RenderThreadBenchmark : public QuadStressBenchmark
+{
+public:
+	RenderThreadBenchmark(Engine::ThreadingPolicy policy)
+		: QuadStressBenchmark(policy == Engine::ThreadingPolicy::MultiThreaded ? "RenderThread.Quads.100k.MultiThreaded" : "RenderThread.Quads.100k.SingleThreaded"),
+		m_Policy(policy)
+	{
+	}
+
+	virtual bool OnSetup() override
+	{
+		Engine::RenderThread::Init(m_Policy, m_Window->GetContext());
+		return true;
+	}
+
+	virtual void OnTeardown() override
+	{
+		Engine::RenderThread::Shutdown();
+	}
+private:
+	Engine::ThreadingPolicy m_Policy;
+};
+
+// Fill rate bound Renderer2D work, 500 large translucent quads layered over the whole
+// screen. Mostly measures the software rasterizer, the OpenGL cost is tiny.
+class OverdrawBenchmark : public Benchmark
+{
+public:
+	OverdrawBenchmark()
+		: Benchmark("Renderer2D.Overdraw.500", 120), m_Camera(-16.0f, 16.0f, -9.0f, 9.0f)
+	{
+		m_ItemCount = 500;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		m_Time += ts;
+
+		Engine::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+		Engine::RenderCommand::Clear();
+
+		Engine::Renderer2D::BeginScene(m_Camera);
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			float angle = m_Time + i * 0.37f;
+			glm::vec4 color((i % 7) / 7.0f, (i % 5) / 5.0f, (i % 3) / 3.0f, 0.1f);
+			Engine::Renderer2D::DrawRotatedQuad({ glm::cos(angle) * 4.0f, glm::sin(angle) * 2.0f, i * 0.001f }, { 24.0f, 14.0f }, angle * 0.1f, color);
+		}
+		Engine::Renderer2D::EndScene();
+	}
+private:
+	Engine::OrthographicCamera m_Camera;
+	float m_Time = 0.0f;
+};
+
+// Sandbox2D's particle system, emitting until the 100k pool is saturated.
+// Its random generator is never seeded, so the particles are the same every run.
+class ParticleStressBenchmark : public Benchmark
+{
+public:
+	ParticleStressBenchmark()
+		: Benchmark("Particles.100k", 600, 120), m_Particles(100000), m_Camera(-16.0f, 16.0f, -9.0f, 9.0f)
+	{
+		m_Props.ColorBegin = { 254 / 255.0f, 212 / 255.0f, 123 / 255.0f, 1.0f };
+		m_Props.ColorEnd = { 254 / 255.0f, 109 / 255.0f, 41 / 255.0f, 1.0f };
+		m_Props.SizeBegin = 0.5f, m_Props.SizeVariation = 0.3f, m_Props.SizeEnd = 0.0f;
+		m_Props.LifeTime = 2.0f;
+		m_Props.Velocity = { 0.0f, 0.0f };
+		m_Props.VelocityVariation = { 3.0f, 1.0f };
+		m_Props.Position = { 0.0f, 0.0f };
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		for (uint32_t i = 0; i < 1000; i++)
+			m_Particles.Emit(m_Props);
+
+		Engine::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+		Engine::RenderCommand::Clear();
+
+		m_Particles.OnUpdate(ts);
+		m_Particles.OnRender(m_Camera);
+	}
+private:
+	ParticleSystem m_Particles;
+	ParticleProps m_Props;
+	Engine::OrthographicCamera m_Camera;
+};
+
+// CPU bone evaluation and skinned draws for a grid of animated characters
+class SkinnedCrowdBenchmark : public Benchmark
+{
+public:
+	SkinnedCrowdBenchmark(const std::string& assetRoot)
+		: Benchmark("SkinnedCrowd.64", 300), m_AssetRoot(assetRoot), m_Camera(glm::vec3(0.0f, 10.0f, 40.0f), 16.0f / 9.0f)
+	{
+		m_ItemCount = 64;
+	}
+
+	virtual bool OnSetup() override
+	{
+		std::string meshPath = m_AssetRoot + "/Sandbox3D/res/models/model/model.dae";
+		std::string shaderPath = m_AssetRoot + "/Sandbox3D/res/shaders/ModelAnim.glsl";
+		if (!FileExists(meshPath) || !FileExists(shaderPath))
+			return false;
+
+		m_Mesh = Engine::CreateRef<Engine::Mesh>(meshPath);
+		m_Shader = Engine::Shader::Create(shaderPath);
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		Engine::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+		Engine::RenderCommand::Clear();
+
+		Engine::Renderer::BeginScene(m_Camera);
+		m_Shader->Bind();
+		m_Shader->SetMat4("u_ViewProjectionMatrix", m_Camera.GetViewProjectionMatrix());
+
+		// Each Render() advances the shared animation clock, so the step is split between them
+		Engine::Timestep step(ts / m_ItemCount);
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			glm::vec3 position((float)(i % 8) * 4.0f - 14.0f, 0.0f, (float)(i / 8) * -4.0f);
+			m_Mesh->Render(step, m_Shader, glm::translate(glm::mat4(1.0f), position));
+		}
+		Engine::Renderer::EndScene();
+	}
+
+	virtual void OnTeardown() override
+	{
+		m_Mesh.reset();
+		m_Shader.reset();
+	}
+private:
+	std::string m_AssetRoot;
+	Engine::PerspectiveCamera m_Camera;
+	Engine::Ref<Engine::Mesh> m_Mesh;
+	Engine::Ref<Engine::Shader> m_Shader;
+};
+
+// Full Assimp import, processing and GPU upload of a mesh
+class MeshImportBenchmark : public Benchmark
+{
+public:
+	MeshImportBenchmark(const std::string& name, const std::string& filepath)
+		: Benchmark(name, 10, 1), m_Filepath(filepath)
+	{
+		m_ItemCount = 1;
+	}
+
+	virtual bool OnSetup() override { return FileExists(m_Filepath); }
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		// Destroyed right away, so every frame pays for the full import
+		Engine::CreateScope<Engine::Mesh>(m_Filepath);
+	}
+private:
+	std::string m_Filepath;
+};
+
+// Compiling and linking every shader the sandboxes use
+class ShaderCompileBenchmark : public Benchmark
+{
+public:
+	ShaderCompileBenchmark(const std::string& assetRoot)
+		: Benchmark("ShaderCompile", 20, 2)
+	{
+		const char* shaders[] = { "ModelAnim.glsl", "ModelStatic.glsl", "ModelStaticIndirect.glsl", "Skybox.glsl", "QuadPostprocess.glsl" };
+		for (const char* shader : shaders)
+			m_Filepaths.push_back(assetRoot + "/Sandbox3D/res/shaders/" + shader);
+		m_Filepaths.push_back(assetRoot + "/Sandbox2D/assets/Shaders/Texture.glsl");
+		m_ItemCount = (uint32_t)m_Filepaths.size();
+	}
+
+	virtual bool OnSetup() override
+	{
+		for (const std::string& filepath : m_Filepaths)
+		{
+			if (!FileExists(filepath))
+				return false;
+		}
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		for (const std::string& filepath : m_Filepaths)
+			Engine::Shader::Create(filepath);
+	}
+private:
+	std::vector<std::string> m_Filepaths;
+};
+
+// SIMD frustum test over structure of arrays bounds, boxes or spheres
+class FrustumCullingBenchmark : public Benchmark
+{
+public:
+	FrustumCullingBenchmark(bool spheres)
+		: Benchmark(spheres ? "Culling.FrustumSpheres.100k" : "Culling.FrustumBoxes.100k", 600), m_Spheres(spheres)
+	{
+		m_ItemCount = 100000;
+	}
+
+	virtual bool OnSetup() override
+	{
+		std::vector<Engine::AABB> boxes = RandomBoxes(m_ItemCount, 1000.0f, s_Seed);
+		for (const Engine::AABB& box : boxes)
+		{
+			glm::vec3 center = box.GetCenter();
+			glm::vec3 extents = box.GetExtents();
+			m_CenterX.push_back(center.x);
+			m_CenterY.push_back(center.y);
+			m_CenterZ.push_back(center.z);
+			m_ExtentX.push_back(extents.x);
+			m_ExtentY.push_back(extents.y);
+			m_ExtentZ.push_back(extents.z);
+			m_Radius.push_back(glm::length(extents));
+		}
+		m_Visible.resize(m_ItemCount);
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		m_Time += ts;
+		Engine::Frustum frustum = OrbitFrustum(m_Time, 600.0f);
+
+		uint32_t visible;
+		if (m_Spheres)
+			visible = Engine::FrustumCuller::CullSpheres(frustum, m_CenterX.data(), m_CenterY.data(), m_CenterZ.data(), m_Radius.data(), m_ItemCount, m_Visible.data());
+		else
+			visible = Engine::FrustumCuller::CullBoxes(frustum, m_CenterX.data(), m_CenterY.data(), m_CenterZ.data(),
+				m_ExtentX.data(), m_ExtentY.data(), m_ExtentZ.data(), m_ItemCount, m_Visible.data());
+		Engine::Renderer::RecordCulling(visible, m_ItemCount - visible);
+	}
+private:
+	bool m_Spheres;
+	float m_Time = 0.0f;
+	std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+	std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+	std::vector<float> m_Radius;
+	std::vector<uint8_t> m_Visible;
+};
+
+enum class BVHQuery { Frustum, Overlap, RayCast };
+
+static const char* s_BVHQueryNames[] = { "Frustum", "Overlap", "RayCast" };
+
+static std::string CountName(uint32_t count)
+{
+	return count >= 1000000 ? std::to_string(count / 1000000) + "M" : std::to_string(count / 1000) + "k";
+}
+
+// Query throughput of the static SAH tree. The world grows with the object count so the
+// density, and with it the number of hits per query, stays the same.
+class StaticBVHBenchmark : public Benchmark
+{
+public:
+	static const uint32_t QueriesPerFrame = 1024;
+
+	StaticBVHBenchmark(BVHQuery query, uint32_t objectCount)
+		: Benchmark(std::string("BVH.Static.") + s_BVHQueryNames[(int)query] + "." + CountName(objectCount), objectCount >= 1000000 ? 60 : 300),
+		m_Query(query), m_ObjectCount(objectCount), m_WorldSize(100.0f * std::cbrt(objectCount / 1000.0f))
+	{
+		m_ItemCount = query == BVHQuery::Frustum ? 1 : QueriesPerFrame;
+	}
+
+	virtual bool OnSetup() override
+	{
+		m_Tree.Build(RandomBoxes(m_ObjectCount, m_WorldSize, s_Seed));
+		m_Random.seed(s_Seed);
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		m_Time += ts;
+
+		std::uniform_real_distribution<float> position(-m_WorldSize * 0.5f, m_WorldSize * 0.5f);
+		std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+		switch (m_Query)
+		{
+			case BVHQuery::Frustum:
+			{
+				m_Results.clear();
+				m_Tree.QueryFrustum(OrbitFrustum(m_Time, m_WorldSize * 0.6f), m_Results);
+				break;
+			}
+			case BVHQuery::Overlap:
+			{
+				for (uint32_t i = 0; i < QueriesPerFrame; i++)
+				{
+					glm::vec3 center(position(m_Random), position(m_Random), position(m_Random));
+					m_Results.clear();
+					m_Tree.QueryAABB(Engine::AABB(center - glm::vec3(5.0f), center + glm::vec3(5.0f)), m_Results);
+				}
+				break;
+			}
+			case BVHQuery::RayCast:
+			{
+				for (uint32_t i = 0; i < QueriesPerFrame; i++)
+				{
+					glm::vec3 origin(position(m_Random), position(m_Random), position(m_Random));
+					glm::vec3 dir = glm::normalize(glm::vec3(direction(m_Random), direction(m_Random), direction(m_Random)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+					Engine::RayCastHit hit;
+					m_Tree.RayCast(Engine::Ray(origin, dir), m_WorldSize, hit);
+				}
+				break;
+			}
+		}
+	}
+
+	virtual void OnTeardown() override
+	{
+		m_Tree = Engine::StaticBVH();
+		m_Results = std::vector<uint32_t>();
+	}
+private:
+	BVHQuery m_Query;
+	uint32_t m_ObjectCount;
+	float m_WorldSize;
+	float m_Time = 0.0f;
+	Engine::StaticBVH m_Tree;
+	std::vector<uint32_t> m_Results;
+	std::mt19937 m_Random;
+};
+
+// Dynamic tree with a tenth of the objects moving every frame, followed by a frustum query
+class DynamicBVHBenchmark : public Benchmark
+{
+public:
+	DynamicBVHBenchmark(uint32_t objectCount)
+		: Benchmark("BVH.Dynamic.MoveAndQuery." + CountName(objectCount), objectCount >= 1000000 ? 60 : 300),
+		m_ObjectCount(objectCount), m_WorldSize(100.0f * std::cbrt(objectCount / 1000.0f))
+	{
+		m_ItemCount = objectCount / 10;
+	}
+
+	virtual bool OnSetup() override
+	{
+		m_Boxes = RandomBoxes(m_ObjectCount, m_WorldSize, s_Seed);
+		m_Proxies.reserve(m_ObjectCount);
+		for (uint32_t i = 0; i < m_ObjectCount; i++)
+			m_Proxies.push_back(m_Tree.Insert(m_Boxes[i], i));
+		m_Tree.Rebuild();
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		m_Time += ts;
+
+		// Objects drift on circles, enough to leave the fattened bounds now and then
+		for (uint32_t i = m_Frame % 10; i < m_ObjectCount; i += 10)
+		{
+			float phase = m_Time + i * 0.1f;
+			glm::vec3 offset(glm::cos(phase), 0.0f, glm::sin(phase));
+			m_Tree.Move(m_Proxies[i], Engine::AABB(m_Boxes[i].Min + offset, m_Boxes[i].Max + offset));
+		}
+		m_Frame++;
+
+		m_Results.clear();
+		m_Tree.QueryFrustum(OrbitFrustum(m_Time, m_WorldSize * 0.6f), m_Results);
+	}
+
+	virtual void OnTeardown() override
+	{
+		m_Tree.Clear();
+		m_Boxes = std::vector<Engine::AABB>();
+		m_Proxies = std::vector<uint32_t>();
+	}
+private:
+	uint32_t m_ObjectCount;
+	float m_WorldSize;
+	float m_Time = 0.0f;
+	uint32_t m_Frame = 0;
+	Engine::DynamicBVH m_Tree;
+	std::vector<Engine::AABB> m_Boxes;
+	std::vector<uint32_t> m_Proxies;
+	std::vector<uint32_t> m_Results;
+};
+
+enum class SceneIteration { Entity, Chunk, Parallel };
+
+static const char* s_SceneIterationNames[] = { "Entity", "Chunk", "Parallel" };
+
+struct VelocityComponent
+{
+	glm::vec3 Velocity;
+};
+
+// Tags that split the entities over four archetypes
+struct GroupAComponent {};
+struct GroupBComponent {};
+
+// Moves every entity of a scene by its velocity, through a view in one of three ways:
+// an entity at a time, over the raw chunk arrays, or with the chunks spread over the JobSystem
+class SceneIterateBenchmark : public Benchmark
+{
+public:
+	SceneIterateBenchmark(SceneIteration iteration, uint32_t entityCount)
+		: Benchmark(std::string("Scene.Iterate.") + s_SceneIterationNames[(int)iteration] + "." + CountName(entityCount), 120),
+		m_Iteration(iteration)
+	{
+		m_ItemCount = entityCount;
+	}
+
+	virtual bool OnSetup() override
+	{
+		m_Scene = Engine::CreateScope<Engine::Scene>();
+
+		std::mt19937 random(s_Seed);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> velocity(-1.0f, 1.0f);
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			Engine::Entity entity = m_Scene->CreateEntity();
+			m_Scene->AddComponent<Engine::TransformComponent>(entity, glm::vec3(position(random), position(random), position(random)));
+			m_Scene->AddComponent<VelocityComponent>(entity, VelocityComponent{ { velocity(random), velocity(random), velocity(random) } });
+			if (i & 1)
+				m_Scene->AddComponent<GroupAComponent>(entity);
+			if (i & 2)
+				m_Scene->AddComponent<GroupBComponent>(entity);
+		}
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		float time = ts;
+		auto view = m_Scene->GetView<Engine::TransformComponent, VelocityComponent>();
+		switch (m_Iteration)
+		{
+			case SceneIteration::Entity:
+			{
+				view.ForEach([time](Engine::Entity, Engine::TransformComponent& transform, VelocityComponent& velocity)
+				{
+					transform.Translation += velocity.Velocity * time;
+				});
+				break;
+			}
+			case SceneIteration::Chunk:
+			{
+				view.ForEachChunk([time](uint32_t count, const Engine::Entity*, Engine::TransformComponent* transforms, VelocityComponent* velocities)
+				{
+					for (uint32_t i = 0; i < count; i++)
+						transforms[i].Translation += velocities[i].Velocity * time;
+				});
+				break;
+			}
+			case SceneIteration::Parallel:
+			{
+				view.ParallelForEach([time](Engine::Entity, Engine::TransformComponent& transform, VelocityComponent& velocity)
+				{
+					transform.Translation += velocity.Velocity * time;
+				});
+				break;
+			}
+		}
+	}
+
+	virtual void OnTeardown() override
+	{
+		m_Scene.reset();
+	}
+private:
+	SceneIteration m_Iteration;
+	Engine::Scope<Engine::Scene> m_Scene;
+};
+
+// Renderer2D fed by the sprite entities of a scene, comparable to Renderer2D.Quads.100k
+class SceneSpritesBenchmark : public Benchmark
+{
+public:
+	SceneSpritesBenchmark()
+		: Benchmark("Scene.Sprites.100k", 300), m_Camera(-160.0f, 160.0f, -90.0f, 90.0f)
+	{
+		m_ItemCount = 100000;
+	}
+
+	virtual bool OnSetup() override
+	{
+		m_Scene = Engine::CreateScope<Engine::Scene>();
+
+		const uint32_t columns = 400;
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			glm::vec3 position((float)(i % columns) * 0.8f - 160.0f, (float)(i / columns) * 0.72f - 90.0f, 0.0f);
+			glm::vec4 color((i % columns) / (float)columns, (i / columns) / 250.0f, 0.5f, 1.0f);
+
+			Engine::Entity entity = m_Scene->CreateEntity();
+			m_Scene->AddComponent<Engine::TransformComponent>(entity, position, glm::vec3(0.0f, 0.0f, i * 0.01f), glm::vec3(0.6f, 0.6f, 1.0f));
+			m_Scene->AddComponent<Engine::SpriteComponent>(entity, color);
+		}
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		Engine::Renderer2D::ResetStats();
+		Engine::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+		Engine::RenderCommand::Clear();
+
+		m_Scene->OnRender2D(m_Camera);
+	}
+
+	virtual void OnTeardown() override
+	{
+		m_Scene.reset();
+	}
+private:
+	Engine::OrthographicCamera m_Camera;
+	Engine::Scope<Engine::Scene> m_Scene;
+};
+
+// World matrix update of a transform hierarchy with four children per node (9 levels
+// for 100k nodes) when a share of the local transforms changes every frame
+class TransformHierarchyBenchmark : public Benchmark
+{
+public:
+	TransformHierarchyBenchmark(uint32_t nodeCount, uint32_t changedPercent)
+		: Benchmark("Transform.Update." + CountName(nodeCount) + "." + std::to_string(changedPercent) + "%", 300),
+		m_NodeCount(nodeCount)
+	{
+		m_ItemCount = std::max(nodeCount * changedPercent / 100, 1u);
+	}
+
+	virtual bool OnSetup() override
+	{
+		m_Nodes.reserve(m_NodeCount);
+		for (uint32_t i = 0; i < m_NodeCount; i++)
+		{
+			Engine::TransformNode parent = i > 0 ? m_Nodes[(i - 1) / 4] : Engine::TransformNode();
+			glm::mat4 local = glm::translate(glm::mat4(1.0f), glm::vec3((float)(i % 4), 1.0f, 0.0f));
+			m_Nodes.push_back(m_Hierarchy.Create(parent, local));
+		}
+		m_Hierarchy.Update();
+		m_Random.seed(s_Seed);
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		m_Time += ts;
+
+		std::uniform_int_distribution<uint32_t> node(0, m_NodeCount - 1);
+		bool all = m_ItemCount == m_NodeCount;
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			Engine::TransformNode changed = m_Nodes[all ? i : node(m_Random)];
+			glm::mat4 local = m_Hierarchy.GetLocalTransform(changed);
+			local[3].z = glm::sin(m_Time + i);
+			m_Hierarchy.SetLocalTransform(changed, local);
+		}
+		m_Hierarchy.Update();
+	}
+
+	virtual void OnTeardown() override
+	{
+		m_Hierarchy = Engine::TransformHierarchy();
+		m_Nodes.clear();
+	}
+private:
+	uint32_t m_NodeCount;
+	float m_Time = 0.0f;
+	std::mt19937 m_Random;
+	Engine::TransformHierarchy m_Hierarchy;
+	std::vector<Engine::TransformNode> m_Nodes;
+};
+
+// Level load time of a 100k entity scene saved during setup and loaded into an empty scene
+// every frame. The textures stay in the asset library, so only the entities are measured.
+class SceneLoadBenchmark : public Benchmark
+{
+public:
+	SceneLoadBenchmark(bool binary)
+		: Benchmark(std::string("Scene.Load.") + (binary ? "Binary" : "Text") + ".100k", binary ? 100 : 20, binary ? 10 : 2),
+		m_Filepath(binary ? "GameEngineBench-Scene.gescenebin" : "GameEngineBench-Scene.gescene"), m_Binary(binary)
+	{
+		m_ItemCount = 100000;
+	}
+
+	virtual bool OnSetup() override
+	{
+		Engine::Ref<Engine::Texture2D> textures[4];
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			uint32_t white = 0xffffffff;
+			textures[i] = Engine::Texture2D::Create(1, 1);
+			textures[i]->SetData(&white, sizeof(uint32_t));
+			m_Assets.Add("GameEngineBench/Texture" + std::to_string(i), textures[i]);
+		}
+
+		std::mt19937 random(s_Seed);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		Engine::Scene scene;
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			Engine::Entity entity = scene.CreateEntity();
+			scene.AddComponent<Engine::TransformComponent>(entity, glm::vec3(position(random), position(random), 0.0f),
+				glm::vec3(0.0f, 0.0f, unit(random) * glm::two_pi<float>()), glm::vec3(unit(random) + 0.5f));
+			if (i % 2 == 0)
+				scene.AddComponent<Engine::SpriteComponent>(entity, textures[i / 2 % 4], 1.0f + i % 3);
+			else
+				scene.AddComponent<Engine::SpriteComponent>(entity, glm::vec4(unit(random), unit(random), unit(random), 1.0f));
+			if (i % 1000 == 0)
+				scene.AddComponent<Engine::LightComponent>(entity);
+		}
+
+		Engine::SceneSerializer serializer(scene, m_Assets);
+		return m_Binary ? serializer.SerializeBinary(m_Filepath) : serializer.SerializeText(m_Filepath);
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		m_Scene = Engine::CreateScope<Engine::Scene>();
+		Engine::SceneSerializer(*m_Scene, m_Assets).Deserialize(m_Filepath);
+	}
+
+	virtual void OnFrameEnd() override
+	{
+		// Unloading is not part of the load time
+		m_Scene.reset();
+	}
+
+	virtual void OnTeardown() override
+	{
+		m_Scene.reset();
+		m_Assets = Engine::AssetLibrary();
+		std::remove(m_Filepath.c_str());
+	}
+private:
+	std::string m_Filepath;
+	bool m_Binary;
+	Engine::AssetLibrary m_Assets;
+	Engine::Scope<Engine::Scene> m_Scene;
+};
+
+// Reads 1000 small files through the VFS, as loose files or from one pak archive with a
+// mount over the same paths. The files stay in the OS cache, so this measures the per file
+// open and map cost, not the disk.
+class VFSReadBenchmark : public Benchmark
+{
+public:
+	VFSReadBenchmark(bool pak)
+		: Benchmark(std::string("VFS.SmallFiles.") + (pak ? "Pak" : "Loose") + ".1000", 50, 5), m_Pak(pak)
+	{
+		m_ItemCount = 1000;
+	}
+
+	virtual bool OnSetup() override
+	{
+		std::mt19937 random(s_Seed);
+		std::error_code error;
+		std::filesystem::create_directories(s_Directory, error);
+
+		Engine::PakFormat::PakWriter writer;
+		if (m_Pak && !writer.Open(s_PakPath))
+			return false;
+
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			// Shader sized text, compresses about like source does
+			std::string text;
+			while (text.size() < 2048 + random() % 4096)
+				text += "uniform vec4 u_Value" + std::to_string(random() % 64) + ";\n";
+
+			std::string name = "File" + std::to_string(i) + ".glsl";
+			m_Paths.push_back(std::string(s_Directory) + "/" + name);
+			if (m_Pak)
+				writer.Add(name, (const uint8_t*)text.data(), text.size(), true);
+			else
+				std::ofstream(m_Paths.back(), std::ios::binary).write(text.data(), text.size());
+		}
+
+		if (m_Pak)
+			return writer.Finish() && Engine::VFS::Mount(s_Directory, s_PakPath);
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		uint64_t checksum = 0;
+		for (const std::string& path : m_Paths)
+		{
+			Engine::FileBuffer file = Engine::VFS::Read(path);
+			for (size_t i = 0; i < file.GetSize(); i += 64)
+				checksum += file.GetData()[i];
+		}
+		m_Checksum = checksum;
+	}
+
+	virtual void OnTeardown() override
+	{
+		Engine::VFS::UnmountAll();
+		std::error_code error;
+		std::filesystem::remove_all(s_Directory, error);
+		std::remove(s_PakPath);
+	}
+private:
+	static constexpr const char* s_Directory = "GameEngineBench-VFS";
+	static constexpr const char* s_PakPath = "GameEngineBench-VFS.pak";
+
+	bool m_Pak;
+	std::vector<std::string> m_Paths;
+	uint64_t m_Checksum = 0;
+};
+
+// Cost of one profile scope. Uses InstrumentationTimer directly so it is measured
+// even when GE_PROFILE compiles the macros out.
+class ProbeOverheadBenchmark : public Benchmark
+{
+public:
+	ProbeOverheadBenchmark(bool recording)
+		: Benchmark(recording ? "Profiler.Probe.Recording" : "Profiler.Probe.Idle", 300), m_Recording(recording)
+	{
+		// Half a ring per frame, OnFrameEnd() gives the writer time to drain it so no events are dropped
+		m_ItemCount = Engine::ProfileThreadBuffer::Capacity / 2;
+	}
+
+	virtual bool OnSetup() override
+	{
+		if (m_Recording)
+			Engine::Instrumentor::Get().BeginSession("ProbeOverhead", "GameEngineBench-Probe.getrace");
+		return true;
+	}
+
+	virtual void OnFrame(Engine::Timestep ts) override
+	{
+		for (uint32_t i = 0; i < m_ItemCount; i++)
+		{
+			Engine::InstrumentationTimer timer("Probe");
+		}
+	}
+
+	virtual void OnFrameEnd() override
+	{
+		// Longer than the writer's drain interval
+		if (m_Recording)
+			std::this_thread::sleep_for(std::chrono::milliseconds(15));
+	}
+
+	virtual void OnTeardown() override
+	{
+		if (m_Recording)
+		{
+			Engine::Instrumentor::Get().EndSession();
+			std::remove("GameEngineBench-Probe.getrace");
+		}
+	}
+private:
+	bool m_Recording;
+};
+
+std::vector<Engine::Scope<Benchmark>> CreateBenchmarks(const std::string& assetRoot)
+{
+	std::vector<Engine::Scope<Benchmark>> benchmarks;
+	benchmarks.push_back(Engine::CreateScope<QuadStressBenchmark>());
+	benchmarks.push_back(Engine::CreateScope<RenderThreadBenchmark>(Engine::ThreadingPolicy::SingleThreaded));
+	benchmarks.push_back(Engine::CreateScope<RenderThreadBenchmark>(Engine::ThreadingPolicy::MultiThreaded));
+	benchmarks.push_back(Engine::CreateScope<OverdrawBenchmark>());
+	benchmarks.push_back(Engine::CreateScope<ParticleStressBenchmark>());
+	benchmarks.push_back(Engine::CreateScope<SkinnedCrowdBenchmark>(assetRoot));
+	benchmarks.push_back(Engine::CreateScope<MeshImportBenchmark>("MeshImport.Character", assetRoot + "/Sandbox3D/res/models/model/model.dae"));
+	benchmarks.push_back(Engine::CreateScope<MeshImportBenchmark>("MeshImport.Tree", assetRoot + "/Sandbox3D/res/models/tree/tree1.fbx"));
+	benchmarks.push_back(Engine::CreateScope<ShaderCompileBenchmark>(assetRoot));
+
+	benchmarks.push_back(Engine::CreateScope<FrustumCullingBenchmark>(false));
+	benchmarks.push_back(Engine::CreateScope<FrustumCullingBenchmark>(true));
+
+	for (uint32_t count : { 10000u, 100000u, 1000000u })
+	{
+		benchmarks.push_back(Engine::CreateScope<StaticBVHBenchmark>(BVHQuery::Frustum, count));
+		benchmarks.push_back(Engine::CreateScope<StaticBVHBenchmark>(BVHQuery::Overlap, count));
+		benchmarks.push_back(Engine::CreateScope<StaticBVHBenchmark>(BVHQuery::RayCast, count));
+		benchmarks.push_back(Engine::CreateScope<DynamicBVHBenchmark>(count));
+	}
+
+	for (SceneIteration iteration : { SceneIteration::Entity, SceneIteration::Chunk, SceneIteration::Parallel })
+		benchmarks.push_back(Engine::CreateScope<SceneIterateBenchmark>(iteration, 1000000));
+	benchmarks.push_back(Engine::CreateScope<SceneSpritesBenchmark>());
+
+	benchmarks.push_back(Engine::CreateScope<TransformHierarchyBenchmark>(100000, 1));
+	benchmarks.push_back(Engine::CreateScope<TransformHierarchyBenchmark>(100000, 100));
+	benchmarks.push_back(Engine::CreateScope<SceneLoadBenchmark>(false));
+	benchmarks.push_back(Engine::CreateScope<SceneLoadBenchmark>(true));
+	benchmarks.push_back(Engine::CreateScope<VFSReadBenchmark>(false));
+	benchmarks.push_back(Engine::CreateScope<VFSReadBenchmark>(true));
+
+	benchmarks.push_back(Engine::CreateScope<ProbeOverheadBenchmark>(false));
+	benchmarks.push_back(Engine::CreateScope<ProbeOverheadBenchmark>(true));
+	return benchmarks;
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// assetRoot is the repository root, meshes and shaders are loaded from the sandbox projects
+std::vector<Engine::Scope<Benchmark>> CreateBenchmarks(const std::string& assetRoot);
\ No newline at end of file
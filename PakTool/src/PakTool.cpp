@@ -0,0 +1,103 @@
+// Packs a directory into a pak archive for the VFS (see Engine/Core/PakFormat.h).
+// Usage: PakTool <directory> <output.pak> [--store]
+// Entries are LZ4 compressed unless --store is given or compression doesn't pay off. Paths in
+// the archive are relative to the directory, so "PakTool res res.pak" with
+// VFS::Mount("res", "res.pak") serves "res/..." paths from the archive.
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/PakFormat.h"
+
+using namespace Engine;
+
+// Formats that are compressed already, LZ4 would only spend time on them
+static bool IsCompressed(const std::string& path)
+{
+	std::string extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)tolower(c); });
+	return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".pak";
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: PakTool <directory> <output.pak> [--store]\n");
+		return 1;
+	}
+
+	std::filesystem::path root = argv[1];
+	std::string output = argv[2];
+	bool compress = !(argc > 3 && std::string(argv[3]) == "--store");
+
+	std::error_code error;
+	if (!std::filesystem::is_directory(root, error))
+	{
+		fprintf(stderr, "'%s' is not a directory\n", argv[1]);
+		return 1;
+	}
+
+	// Sorted so the same directory always gives the same archive
+	std::vector<std::string> paths;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error))
+	{
+		if (!entry.is_regular_file())
+			continue;
+		std::string path = std::filesystem::relative(entry.path(), root).generic_string();
+		if (!std::filesystem::equivalent(entry.path(), output, error))
+			paths.push_back(path);
+	}
+	std::sort(paths.begin(), paths.end());
+
+	PakFormat::PakWriter writer;
+	if (!writer.Open(output))
+	{
+		fprintf(stderr, "Could not write '%s'\n", output.c_str());
+		return 1;
+	}
+
+	uint64_t totalSize = 0;
+	for (const std::string& path : paths)
+	{
+		std::ifstream input(root / path, std::ios::binary);
+		if (!input)
+		{
+			fprintf(stderr, "Could not open '%s'\n", path.c_str());
+			return 1;
+		}
+		std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+		if (!writer.Add(path, data.data(), data.size(), compress && !IsCompressed(path)))
+		{
+			if (path.size() > PakFormat::MaxPathLength)
+				fprintf(stderr, "Path too long: '%s'\n", path.c_str());
+			else
+				fprintf(stderr, "Could not write '%s' to '%s'\n", path.c_str(), output.c_str());
+			return 1;
+		}
+		totalSize += data.size();
+	}
+
+	if (!writer.Finish())
+	{
+		fprintf(stderr, "Could not write '%s'\n", output.c_str());
+		return 1;
+	}
+
+	uint64_t storedSize = 0;
+	size_t compressedCount = 0;
+	for (const PakFormat::IndexEntry& entry : writer.GetEntries())
+	{
+		storedSize += entry.StoredSize;
+		compressedCount += entry.Compression != PakFormat::CompressionType::None;
+	}
+	printf("%zu files (%zu compressed), %llu bytes -> %llu bytes -> %s\n", paths.size(), compressedCount,
+		(unsigned long long)totalSize, (unsigned long long)storedSize, output.c_str());
+	return 0;
+}
\ No newline at end of file
@@ -169,11 +169,8 @@ public:
 
 		auto textureShader = m_ShaderLibrary.Get("Texture");
 
-		m_Texture->Bind();
-		Engine::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.5f)));
-
-		m_EarthTexture->Bind();
-		Engine::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.5f)));
+		Engine::Renderer::Submit(textureShader, m_SquareVA, m_Texture, glm::scale(glm::mat4(1.0f), glm::vec3(1.5f)), Engine::RenderPass::Transparent);
+		Engine::Renderer::Submit(textureShader, m_SquareVA, m_EarthTexture, glm::scale(glm::mat4(1.0f), glm::vec3(1.5f)), Engine::RenderPass::Transparent);
 
 		Engine::Renderer::EndScene();
 	}
@@ -185,9 +182,15 @@ public:
 		ImGui::End();
 	}
 
-	void OnEvent(Engine::Event& e) override
+	void OnAttach() override
+	{
+		Subscribe<ExampleLayer, &ExampleLayer::OnCameraEvent>(Engine::EventType::MouseScrolled);
+		Subscribe<ExampleLayer, &ExampleLayer::OnCameraEvent>(Engine::EventType::WindowResize);
+	}
+
+	bool OnCameraEvent(const Engine::QueuedEvent& e)
 	{
-		m_CameraController.OnEvent(e);
+		return m_CameraController.OnEvent(e);
 	}
 
 private:
@@ -222,5 +225,8 @@ public:
 
 Engine::Application* Engine::CreateApplication()
 {
-	return new Sandbox({"Sandbox app", 1280, 720});
+	Engine::ApplicationProps props = { "Sandbox app", 1280, 720 };
+	// Sandbox2D only draws through Renderer2D and ImGui, so it can render on its own thread
+	props.Threading = Engine::ThreadingPolicy::MultiThreaded;
+	return new Sandbox(props);
 }
\ No newline at end of file
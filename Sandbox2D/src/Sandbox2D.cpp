@@ -14,6 +14,9 @@ void Sandbox2D::OnAttach()
 	GE_PROFILE_FUNCTION();
 
 	m_CheckerboardTexture = Engine::Texture2D::Create("assets/Textures/Checkerboard.png");
+
+	Subscribe<Sandbox2D, &Sandbox2D::OnCameraEvent>(Engine::EventType::MouseScrolled);
+	Subscribe<Sandbox2D, &Sandbox2D::OnCameraEvent>(Engine::EventType::WindowResize);
 }
 
 void Sandbox2D::OnDetach()
@@ -30,6 +33,7 @@ void Sandbox2D::OnUpdate(Engine::Timestep ts)
 
 	// Render
 	Engine::Renderer2D::ResetStats();
+	Engine::Renderer::ResetStats();
 	{
 		GE_PROFILE_SCOPE("Renderer Prep");
 		Engine::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
@@ -130,6 +134,10 @@ void Sandbox2D::OnImGuiRender()
     ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
     ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
 
+    auto rendererStats = Engine::Renderer::GetStats();
+    ImGui::Text("State Changes: %d", rendererStats.StateChangesIssued);
+    ImGui::Text("State Changes Elided: %d", rendererStats.StateChangesElided);
+
     ImGui::ColorEdit4("Square Color", glm::value_ptr(m_SquareColor));
 
     uint32_t textureID = m_CheckerboardTexture->GetRendererID();
@@ -139,7 +147,7 @@ void Sandbox2D::OnImGuiRender()
     ImGui::End();
 }
 
-void Sandbox2D::OnEvent(Engine::Event& e)
+bool Sandbox2D::OnCameraEvent(const Engine::QueuedEvent& e)
 {
-	m_CameraController.OnEvent(e);
+	return m_CameraController.OnEvent(e);
 }
\ No newline at end of file
@@ -14,7 +14,8 @@ public:
 
 	virtual void OnUpdate(Engine::Timestep ts) override;
 	virtual void OnImGuiRender() override;
-	virtual void OnEvent(Engine::Event& e) override;
+private:
+	bool OnCameraEvent(const Engine::QueuedEvent& e);
 private:
 	Engine::OrthographicCameraController m_CameraController;
 
@@ -44,9 +44,19 @@ public:
 		planeVBO->SetLayout(layout);
 		m_PlaneVAO->AddVertexBuffer(planeVBO);
 
+		// Assets, development builds cook what changed since the last run
+		m_AssetDatabase.Load();
+	#ifndef GE_DIST
+		m_AssetDatabase.Scan();
+		m_CookReport = m_AssetDatabase.Cook();
+		m_AssetDatabase.Save();
+	#endif
+		m_Assets.SetDatabase(&m_AssetDatabase);
+
 		// Shader
 		m_SimpleShader = Engine::Shader::Create("res/shaders/ModelStatic.glsl");
-		m_ModelShader = Engine::Shader::Create("res/shaders/ModelAnim.glsl");
+		m_StaticIndirectShader = Engine::Shader::Create("res/shaders/ModelStaticIndirect.glsl");
+		m_ModelShader = m_Assets.LoadShader("res/shaders/ModelAnim.glsl");
 		m_SkyboxShader = Engine::Shader::Create("res/shaders/Skybox.glsl");
 		m_QuadShader = Engine::Shader::Create("res/shaders/QuadPostprocess.glsl");
 
@@ -54,10 +64,29 @@ public:
 		m_TextureTest = Engine::Texture2D::Create("res/textures/Checkerboard.png");
 
 		// Model
-		m_ModelCharacter.reset(new Engine::Mesh("res/models/model/model.dae"));
-		m_ModelM1911.reset(new Engine::Mesh("res/models/m1911/m1911.fbx"));
 		m_ModelSphere.reset(new Engine::Mesh("res/models/Sphere1m.fbx"));
 
+		// Scene, the character, the M1911 and the light
+		Engine::SceneSerializer(m_Scene, m_Assets).Deserialize(s_ScenePath);
+		m_Scene.GetView<Engine::LightComponent>().ForEach([&](Engine::Entity entity, Engine::LightComponent&)
+		{
+			if (!m_LightEntity)
+				m_LightEntity = entity;
+		});
+		if (!m_LightEntity)
+		{
+			m_LightEntity = m_Scene.CreateEntity();
+			m_Scene.AddComponent<Engine::TransformComponent>(m_LightEntity, glm::vec3(-3.0f, 6.0f, 2.0f));
+			m_Scene.AddComponent<Engine::LightComponent>(m_LightEntity);
+		}
+
+		// Static meshes
+		m_SphereHandle = m_StaticBatch.AddMesh(m_ModelSphere);
+		m_StaticBatch.Build();
+
+		// The light sphere isn't an entity, the scene keeps its meshes in its own BVH
+		m_SphereProxy = m_SceneBVH.Insert(m_ModelSphere->GetBoundingBox().Transformed(glm::translate(glm::mat4(1.0f), GetLightPosition())), SphereObject);
+
 		// CubeMap
 		std::vector<std::string> faces
 		{
@@ -143,105 +172,156 @@ public:
 		};
 		quadVB->SetLayout(quadLayout);
 		m_FinalQuad->AddVertexBuffer(quadVB);
+
+		Subscribe<TestLayer, &TestLayer::OnMouseButtonPressed>(Engine::EventType::MouseButtonPressed);
 	}
 
 	virtual void OnUpdate(Engine::Timestep ts) 
 	{
+		Engine::Renderer::ResetStats();
+
 		//m_Camera.OnUpdate(ts);
 		m_Camera.Update(ts);
 		auto projection = m_Camera.GetProjectionMatrix();
 		auto view = m_Camera.GetViewMatrix();
 		auto viewProjection = projection * view;
 
+		GE_PROFILE_SCOPE("Sandbox3D");
 		m_Framebuffer->Bind();
 		Engine::RenderCommand::SetClearColor(glm::vec4(0.1, 0.2, 0.3, 0.4));
 		Engine::RenderCommand::Clear();
 
 		Engine::Renderer::BeginScene(m_Camera);
 
+		glm::mat4 sphereTransform = glm::translate(glm::mat4(1.0f), GetLightPosition());
+		m_SceneBVH.Move(m_SphereProxy, m_ModelSphere->GetBoundingBox().Transformed(sphereTransform));
+
+		m_VisibleObjects.clear();
+		m_SceneBVH.QueryFrustum(Engine::Renderer::GetFrustum(), m_VisibleObjects);
+		bool sphereVisible = std::find(m_VisibleObjects.begin(), m_VisibleObjects.end(), (uint32_t)SphereObject) != m_VisibleObjects.end();
+
 		// TODO skybox should be rendered last with GL_LEQUAL not glDisable(GL_DEPTH_TEST)
 		m_SkyboxShader->Bind();
 		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SkyboxShader)->UploadUniformMat4("u_View", glm::mat4(glm::mat3(view)));
 		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SkyboxShader)->UploadUniformMat4("u_Projection", projection);
 		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SkyboxShader)->UploadUniformInt("skybox", 0);
-		m_CubeMap->Bind();
 		// TODO glDepthFunc(GL_LEQUAL) before drawing skybox
-		Engine::Renderer::Submit(m_SkyboxShader, m_Skybox, glm::mat4(1.0f), false);
+		Engine::Renderer::Submit(m_SkyboxShader, m_Skybox, m_CubeMap, glm::mat4(1.0f), Engine::RenderPass::Background);
 
 		m_SimpleShader->Bind();
 		//m_SimpleShader->SetMat4("u_ViewProjectionMatrix", viewProjection);
 		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformMat4("u_ViewProjectionMatrix", viewProjection);
 
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat3("viewPos", m_Camera.GetPosition());
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat3("light.position", m_Light.Pos);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat3("light.ambient", m_Light.Ambient);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat3("light.diffuse", m_Light.Diffuse);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat3("light.specular", m_Light.Specular);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat("light.constant", m_Light.Constant);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat("light.linear", m_Light.Linear);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat("light.quadratic", m_Light.Quadratic);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_SimpleShader)->UploadUniformFloat("shininess", m_Light.Shininess);
+		UploadLight(m_SimpleShader);
 
 		// Plane and light texture
-		m_TextureTest->Bind();
-		Engine::Renderer::Submit(m_SimpleShader, m_PlaneVAO, glm::scale(glm::mat4(1.0f), glm::vec3(100.0f, 0.0f, 100.0f)));
-
-		// Light sphere
-		m_ModelSphere->Render(ts, m_SimpleShader, glm::translate(glm::mat4(1.0f), m_Light.Pos));
+		Engine::Renderer::Submit(m_SimpleShader, m_PlaneVAO, m_TextureTest, glm::scale(glm::mat4(1.0f), glm::vec3(100.0f, 0.0f, 100.0f)));
 
-		m_ModelShader->Bind();	
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformMat4("u_ViewProjectionMatrix", viewProjection);
-	
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat3("viewPos", m_Camera.GetPosition());
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat3("light.position", m_Light.Pos);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat3("light.ambient", m_Light.Ambient);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat3("light.diffuse", m_Light.Diffuse);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat3("light.specular", m_Light.Specular);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat("light.constant", m_Light.Constant);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat("light.linear", m_Light.Linear);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat("light.quadratic", m_Light.Quadratic);
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_ModelShader)->UploadUniformFloat("shininess", m_Light.Shininess);
+		// Character and M1911, static meshes culled through the scene BVH and static submeshes by the mesh
+		m_Scene.OnRender(ts, m_Camera);
 
-		m_ModelCharacter->Render(ts, m_ModelShader, glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1, 0, 0)));
+		Engine::Renderer::EndScene();
 
-		m_ModelM1911->Render(ts, m_ModelShader, glm::translate(glm::scale(glm::mat4(1.0f), glm::vec3(2,2,2)), glm::vec3(-3.5f, 3.0f, 3.5f)));
+		// Light sphere, static meshes are drawn with one multi-draw per material. The batch draws
+		// immediately, so it goes after the queue to stay in front of the background.
+		m_StaticIndirectShader->Bind();
+		UploadLight(m_StaticIndirectShader);
+		m_StaticBatch.Begin();
+		if (sphereVisible)
+			m_StaticBatch.Submit(m_SphereHandle, sphereTransform);
+		m_StaticBatch.Flush(m_StaticIndirectShader, viewProjection);
 
 		// Binds default framebuffer slot 0
 		m_Framebuffer->Unbind();
 
-		// Postprocess
-		Engine::RenderCommand::SetClearColor(glm::vec4(0.1, 0.2, 0.3, 0.4));
-		Engine::RenderCommand::Clear();
-
-		m_Framebuffer->BindTexture();
-		m_QuadShader->Bind();
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_QuadShader)->UploadUniformInt("u_Blur", m_Blur);
-		// default value for sampler2D is always 0
-		std::dynamic_pointer_cast<Engine::OpenGLShader>(m_QuadShader)->UploadUniformInt("u_Texture", 0);
-		Engine::Renderer::Submit(m_QuadShader, m_FinalQuad, glm::mat4(1.0f), false);
-		Engine::Renderer::EndScene();
+		// Postprocess, the quad is drawn by EndScene()
+		{
+			GE_PROFILE_SCOPE("Postprocess");
+			Engine::Renderer::BeginScene(m_Camera);
+			Engine::RenderCommand::SetClearColor(glm::vec4(0.1, 0.2, 0.3, 0.4));
+			Engine::RenderCommand::Clear();
+
+			m_Framebuffer->BindTexture();
+			m_QuadShader->Bind();
+			std::dynamic_pointer_cast<Engine::OpenGLShader>(m_QuadShader)->UploadUniformInt("u_Blur", m_Blur);
+			// default value for sampler2D is always 0
+			std::dynamic_pointer_cast<Engine::OpenGLShader>(m_QuadShader)->UploadUniformInt("u_Texture", 0);
+			Engine::Renderer::Submit(m_QuadShader, m_FinalQuad, glm::mat4(1.0f), false);
+			Engine::Renderer::EndScene();
+		}
 	}
 
 	virtual void OnImGuiRender()
 	{
-		if (m_ModelCharacter)
-			m_ModelCharacter->OnImGuiRender();
-
-		if (m_ModelM1911)
-			m_ModelM1911->OnImGuiRender();
+		m_Scene.GetView<Engine::MeshComponent>().ForEach([](Engine::Entity, Engine::MeshComponent& mesh)
+		{
+			mesh.Mesh->OnImGuiRender();
+		});
 
 		ImGui::Begin("Scene Debug");
+		if (ImGui::CollapsingHeader("Renderer Stats"))
+		{
+			auto stats = Engine::Renderer::GetStats();
+			ImGui::Text("Draw Calls: %d", stats.DrawCalls);
+			ImGui::Text("State Changes: %d", stats.StateChangesIssued);
+			ImGui::Text("State Changes Elided: %d", stats.StateChangesElided);
+			ImGui::Text("Objects Visible: %d", stats.ObjectsVisible);
+			ImGui::Text("Objects Culled: %d", stats.ObjectsCulled);
+			ImGui::Text("Scene Meshes Drawn: %d / %d", m_Scene.GetVisibleMeshCount(), m_Scene.GetMeshBVH().GetProxyCount());
+
+			auto& batchStats = m_StaticBatch.GetStats();
+			ImGui::Text("Static Batch Draw Calls: %d", batchStats.DrawCalls);
+			ImGui::Text("Static Batch Draws: %d", batchStats.Draws);
+		}
 		if (ImGui::CollapsingHeader("Light"))
 		{
-			ImGui::SliderFloat3("Position", &m_Light.Pos.x, -50.0f, 50.0f);
-			ImGui::SliderFloat3("Ambient Color", &m_Light.Ambient.x, 0.0f, 1.0f);
-			ImGui::SliderFloat3("Diffuse Color", &m_Light.Diffuse.x, 0.0f, 1.0f);
-			ImGui::SliderFloat3("Specular Color", &m_Light.Specular.x, 0.0f, 1.0f);
-
-			ImGui::SliderFloat("Constant", &m_Light.Constant, 0.0f, 1.0f);
-			ImGui::SliderFloat("Linear", &m_Light.Linear, 0.0f, 1.0f);
-			ImGui::SliderFloat("Quadratic", &m_Light.Quadratic, 0.0f, 1.0f);
-			ImGui::SliderFloat("Shininess", &m_Light.Shininess, 0.0f, 64.0f);
+			auto& transform = m_Scene.GetComponent<Engine::TransformComponent>(m_LightEntity);
+			auto& light = m_Scene.GetComponent<Engine::LightComponent>(m_LightEntity);
+			ImGui::SliderFloat3("Position", &transform.Translation.x, -50.0f, 50.0f);
+			ImGui::SliderFloat3("Ambient Color", &light.Ambient.x, 0.0f, 1.0f);
+			ImGui::SliderFloat3("Diffuse Color", &light.Diffuse.x, 0.0f, 1.0f);
+			ImGui::SliderFloat3("Specular Color", &light.Specular.x, 0.0f, 1.0f);
+
+			ImGui::SliderFloat("Constant", &light.Constant, 0.0f, 1.0f);
+			ImGui::SliderFloat("Linear", &light.Linear, 0.0f, 1.0f);
+			ImGui::SliderFloat("Quadratic", &light.Quadratic, 0.0f, 1.0f);
+			ImGui::SliderFloat("Shininess", &light.Shininess, 0.0f, 64.0f);
+		}
+		if (ImGui::CollapsingHeader("Picking"))
+		{
+			const char* picked = "None";
+			const Engine::MeshComponent* mesh = m_Scene.TryGetComponent<Engine::MeshComponent>(m_PickedEntity);
+			if (m_PickedSphere)
+				picked = "Sphere";
+			else if (mesh && mesh->Mesh)
+				picked = mesh->Mesh->GetFilePath().c_str();
+			ImGui::Text("Picked: %s", picked);
+		}
+		if (ImGui::CollapsingHeader("Scene"))
+		{
+			ImGui::Text("Entities: %d", m_Scene.GetEntityCount());
+			if (ImGui::Button("Save"))
+				Engine::SceneSerializer(m_Scene, m_Assets).SerializeText(s_ScenePath);
+			ImGui::SameLine();
+			if (ImGui::Button("Save Binary"))
+				Engine::SceneSerializer(m_Scene, m_Assets).SerializeBinary("res/scenes/Sandbox3D.gescenebin");
+		}
+		if (ImGui::CollapsingHeader("Assets"))
+		{
+			ImGui::Text("Registered: %d", m_AssetDatabase.GetCount());
+			ImGui::Text("Cook Hits: %d", m_CookReport.Hits);
+			ImGui::Text("Cook Misses: %d", m_CookReport.Misses);
+			ImGui::Text("Cook Failures: %d", m_CookReport.Failures);
+			ImGui::Text("Files Hashed: %d", m_CookReport.HashedFiles);
+			ImGui::Text("Cook Time: %.1f ms", m_CookReport.Milliseconds);
+		#ifndef GE_DIST
+			if (ImGui::Button("Cook"))
+			{
+				m_AssetDatabase.Scan();
+				m_CookReport = m_AssetDatabase.Cook();
+				m_AssetDatabase.Save();
+			}
+		#endif
 		}
 		if (ImGui::CollapsingHeader("Postprocess"))
 		{
@@ -252,11 +332,54 @@ public:
 
 	}
 
-	virtual void OnEvent(Engine::Event& event) 
+	bool OnMouseButtonPressed(const Engine::QueuedEvent& e)
 	{
-		//m_Camera.OnEvent(event);
+		// Alt + mouse is camera control
+		if (e.MouseButton.Button != GE_MOUSE_BUTTON_LEFT || Engine::Input::IsKeyPressed(GE_KEY_LEFT_ALT))
+			return false;
+
+		auto& window = Engine::Application::Get().GetWindow();
+		auto [mouseX, mouseY] = Engine::Input::GetMousePos();
+		float x = 2.0f * mouseX / window.GetWidth() - 1.0f;
+		float y = 1.0f - 2.0f * mouseY / window.GetHeight();
+
+		glm::mat4 inverseViewProjection = glm::inverse(m_Camera.GetProjectionMatrix() * m_Camera.GetViewMatrix());
+		glm::vec4 nearPoint = inverseViewProjection * glm::vec4(x, y, -1.0f, 1.0f);
+		glm::vec4 farPoint = inverseViewProjection * glm::vec4(x, y, 1.0f, 1.0f);
+		glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+		glm::vec3 direction = glm::normalize(glm::vec3(farPoint) / farPoint.w - origin);
+
+		// Whichever of the light sphere and the closest scene mesh the ray hits first
+		Engine::Ray ray(origin, direction);
+		Engine::RayCastHit hit;
+		float sphereDistance = m_SceneBVH.RayCast(ray, FLT_MAX, hit) ? hit.Distance : FLT_MAX;
+		float meshDistance;
+		m_Scene.UpdateMeshBounds();
+		if (!m_Scene.RayCast(ray, sphereDistance, m_PickedEntity, meshDistance))
+			m_PickedEntity = Engine::Entity();
+		m_PickedSphere = !m_Scene.IsValid(m_PickedEntity) && sphereDistance < FLT_MAX;
+		return false;
 	}
 
+private:
+	const glm::vec3& GetLightPosition()
+	{
+		return m_Scene.GetComponent<Engine::TransformComponent>(m_LightEntity).Translation;
+	}
+
+	void UploadLight(const Engine::Ref<Engine::Shader>& shader)
+	{
+		auto& light = m_Scene.GetComponent<Engine::LightComponent>(m_LightEntity);
+		shader->SetFloat3("viewPos", m_Camera.GetPosition());
+		shader->SetFloat3("light.position", GetLightPosition());
+		shader->SetFloat3("light.ambient", light.Ambient);
+		shader->SetFloat3("light.diffuse", light.Diffuse);
+		shader->SetFloat3("light.specular", light.Specular);
+		shader->SetFloat("light.constant", light.Constant);
+		shader->SetFloat("light.linear", light.Linear);
+		shader->SetFloat("light.quadratic", light.Quadratic);
+		shader->SetFloat("shininess", light.Shininess);
+	}
 private:
 	glm::vec3 CameraStartingPos = glm::vec3(0.0f, 0.0f, 3.0f);
 	//Engine::PerspectiveCamera m_Camera;
@@ -268,22 +391,25 @@ private:
 	Engine::Ref<Engine::Texture2D> m_TextureTest;
 	Engine::Ref<Engine::Texture2D> m_MeshDiffuse;
 
-	Engine::Ref<Engine::Shader> m_ModelShader, m_SkyboxShader, m_QuadShader, m_SimpleShader;
-	Engine::Ref<Engine::Mesh> m_ModelCharacter, m_ModelM1911, m_ModelSphere;
-	
-	struct Light
-	{
-		glm::vec3 Pos =	{ -3.0f, 6.0f, 2.0f };
-		glm::vec3 Ambient = { 0.2f, 0.2f, 0.2f };
-		glm::vec3 Diffuse = { 0.5f, 0.5f, 0.5f };
-		glm::vec3 Specular = { 1.0f, 1.0f, 1.0f };
-
-		float Constant = 1.0f;
-		float Linear = 0.09f;
-		float Quadratic = 0.0f; //0.032f;
-		float Shininess = 32.0f;
-	};
-	Light m_Light;
+	Engine::Ref<Engine::Shader> m_ModelShader, m_SkyboxShader, m_QuadShader, m_SimpleShader, m_StaticIndirectShader;
+	Engine::Ref<Engine::Mesh> m_ModelSphere;
+
+	static constexpr const char* s_ScenePath = "res/scenes/Sandbox3D.gescene";
+	Engine::AssetDatabase m_AssetDatabase{ "res", "cache" };
+	Engine::CookReport m_CookReport;
+	Engine::AssetLibrary m_Assets;
+	Engine::Scene m_Scene;
+	Engine::Entity m_LightEntity;
+
+	Engine::StaticMeshBatch m_StaticBatch;
+	uint32_t m_SphereHandle = 0;
+
+	static const int SphereObject = 0;
+	Engine::DynamicBVH m_SceneBVH;
+	uint32_t m_SphereProxy = 0;
+	std::vector<uint32_t> m_VisibleObjects;
+	bool m_PickedSphere = false;
+	Engine::Entity m_PickedEntity;
 
 	float m_Blur = false;
 	Engine::Ref<Engine::TextureCube> m_CubeMap;
@@ -297,6 +423,12 @@ public:
 	Test(const Engine::ApplicationProps& props)
 		: Application(props)
 	{
+	#ifdef GE_DIST
+		// Shipping builds read the assets from the archives made by "PakTool res res.pak" and
+		// "PakTool cache cache.pak"
+		Engine::VFS::Mount("res", "res.pak");
+		Engine::VFS::Mount("cache", "cache.pak");
+	#endif
 		PushLayer(new TestLayer());
 	}
 
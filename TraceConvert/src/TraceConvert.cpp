@@ -0,0 +1,436 @@
+// Offline converter for Instrumentor traces (.getrace).
+// Usage: TraceConvert <input.getrace> <output> [--chrome | --perfetto]
+// The output format follows the extension (.json = Chrome traceEvents, anything else = Perfetto)
+// unless it is given explicitly.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Engine/Debug/TraceFormat.h"
+
+using namespace Engine;
+
+struct TraceEvent
+{
+	uint32_t Thread;
+	uint32_t Name;
+	int64_t Start;
+	int64_t Duration;
+};
+
+struct TraceCounter
+{
+	uint32_t Thread;
+	uint32_t Name;
+	int64_t Time;
+	int64_t Value;
+};
+
+struct Trace
+{
+	std::string SessionName;
+	std::vector<std::string> Strings;
+	std::vector<TraceEvent> Events;
+	std::vector<TraceCounter> Counters;
+	// Empty for CPU threads
+	std::vector<std::string> ThreadNames;
+	uint32_t ThreadCount = 0;
+
+	std::string GetThreadName(uint32_t thread) const
+	{
+		if (thread < ThreadNames.size() && !ThreadNames[thread].empty())
+			return ThreadNames[thread];
+		return "Thread " + std::to_string(thread);
+	}
+};
+
+static bool ReadTrace(const std::vector<uint8_t>& data, Trace& trace)
+{
+	uint32_t version;
+	if (!TraceFormat::ReadHeader(data.data(), data.size(), version))
+	{
+		fprintf(stderr, "Not a trace file\n");
+		return false;
+	}
+	// Newer versions only added record types
+	if (version == 0 || version > TraceFormat::Version)
+	{
+		fprintf(stderr, "Unsupported trace version %u\n", version);
+		return false;
+	}
+
+	std::vector<int64_t> lastStart;
+	const uint8_t* cursor = data.data() + TraceFormat::HeaderSize;
+	const uint8_t* end = data.data() + data.size();
+	while (cursor < end)
+	{
+		TraceFormat::RecordType type = (TraceFormat::RecordType)*cursor++;
+		switch (type)
+		{
+			case TraceFormat::RecordType::Session:
+			{
+				if (!TraceFormat::ReadString(cursor, end, trace.SessionName))
+					return false;
+				break;
+			}
+			case TraceFormat::RecordType::String:
+			{
+				uint64_t id;
+				std::string value;
+				if (!TraceFormat::ReadVarint(cursor, end, id) || !TraceFormat::ReadString(cursor, end, value))
+					return false;
+				if (id >= trace.Strings.size())
+					trace.Strings.resize((size_t)id + 1);
+				trace.Strings[(size_t)id] = std::move(value);
+				break;
+			}
+			case TraceFormat::RecordType::Event:
+			{
+				uint64_t thread, name, delta, duration;
+				if (!TraceFormat::ReadVarint(cursor, end, thread) || !TraceFormat::ReadVarint(cursor, end, name)
+					|| !TraceFormat::ReadVarint(cursor, end, delta) || !TraceFormat::ReadVarint(cursor, end, duration))
+					return false;
+
+				if (thread >= lastStart.size())
+					lastStart.resize((size_t)thread + 1, 0);
+
+				int64_t start = lastStart[(size_t)thread] + TraceFormat::ZigZagDecode(delta);
+				lastStart[(size_t)thread] = start;
+
+				trace.Events.push_back({ (uint32_t)thread, (uint32_t)name, start, (int64_t)duration });
+				trace.ThreadCount = std::max(trace.ThreadCount, (uint32_t)thread + 1);
+				break;
+			}
+			case TraceFormat::RecordType::Track:
+			{
+				uint64_t thread;
+				std::string name;
+				if (!TraceFormat::ReadVarint(cursor, end, thread) || !TraceFormat::ReadString(cursor, end, name))
+					return false;
+				if (thread >= trace.ThreadNames.size())
+					trace.ThreadNames.resize((size_t)thread + 1);
+				trace.ThreadNames[(size_t)thread] = std::move(name);
+				trace.ThreadCount = std::max(trace.ThreadCount, (uint32_t)thread + 1);
+				break;
+			}
+			case TraceFormat::RecordType::Counter:
+			{
+				uint64_t thread, name, delta, value;
+				if (!TraceFormat::ReadVarint(cursor, end, thread) || !TraceFormat::ReadVarint(cursor, end, name)
+					|| !TraceFormat::ReadVarint(cursor, end, delta) || !TraceFormat::ReadVarint(cursor, end, value))
+					return false;
+
+				if (thread >= lastStart.size())
+					lastStart.resize((size_t)thread + 1, 0);
+
+				int64_t time = lastStart[(size_t)thread] + TraceFormat::ZigZagDecode(delta);
+				lastStart[(size_t)thread] = time;
+
+				trace.Counters.push_back({ (uint32_t)thread, (uint32_t)name, time, TraceFormat::ZigZagDecode(value) });
+				trace.ThreadCount = std::max(trace.ThreadCount, (uint32_t)thread + 1);
+				break;
+			}
+			default:
+			{
+				fprintf(stderr, "Unknown record type %u at offset %zu\n", (uint32_t)type, (size_t)(cursor - data.data() - 1));
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static std::string EscapeJson(const std::string& value)
+{
+	std::string escaped;
+	escaped.reserve(value.size());
+	for (char c : value)
+	{
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+static bool WriteChrome(const Trace& trace, const char* filepath)
+{
+	FILE* file = fopen(filepath, "wb");
+	if (!file)
+		return false;
+
+	std::vector<std::string> names(trace.Strings.size());
+	std::transform(trace.Strings.begin(), trace.Strings.end(), names.begin(), EscapeJson);
+
+	fprintf(file, "{\"otherData\": {\"session\":\"%s\"},\"traceEvents\":[{}", EscapeJson(trace.SessionName).c_str());
+	for (uint32_t thread = 0; thread < trace.ThreadCount; thread++)
+	{
+		fprintf(file, ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+			thread, EscapeJson(trace.GetThreadName(thread)).c_str());
+	}
+	for (const TraceEvent& event : trace.Events)
+	{
+		fprintf(file, ",{\"cat\":\"function\",\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+			event.Name < names.size() ? names[event.Name].c_str() : "?", event.Thread, event.Start / 1000.0, event.Duration / 1000.0);
+	}
+	for (const TraceCounter& counter : trace.Counters)
+	{
+		fprintf(file, ",{\"name\":\"%s\",\"ph\":\"C\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+			counter.Name < names.size() ? names[counter.Name].c_str() : "?", counter.Thread, counter.Time / 1000.0, (long long)counter.Value);
+	}
+	fprintf(file, "]}");
+
+	fclose(file);
+	return true;
+}
+
+// Minimal protobuf encoding of the perfetto.protos.Trace messages we need
+namespace Proto {
+
+	static void WriteTag(std::string& out, uint32_t field, uint32_t wireType)
+	{
+		TraceFormat::WriteVarint(out, ((uint64_t)field << 3) | wireType);
+	}
+
+	static void WriteUInt(std::string& out, uint32_t field, uint64_t value)
+	{
+		WriteTag(out, field, 0);
+		TraceFormat::WriteVarint(out, value);
+	}
+
+	static void WriteBytes(std::string& out, uint32_t field, const std::string& value)
+	{
+		WriteTag(out, field, 2);
+		TraceFormat::WriteVarint(out, value.size());
+		out += value;
+	}
+
+	// Field numbers from perfetto/protos/perfetto/trace
+	enum Field : uint32_t
+	{
+		Trace_Packet = 1,
+
+		TracePacket_Timestamp = 8,
+		TracePacket_TrustedPacketSequenceID = 10,
+		TracePacket_TrackEvent = 11,
+		TracePacket_TrackDescriptor = 60,
+
+		TrackDescriptor_UUID = 1,
+		TrackDescriptor_Name = 2,
+		TrackDescriptor_Thread = 4,
+		TrackDescriptor_Counter = 8,
+
+		ThreadDescriptor_PID = 1,
+		ThreadDescriptor_TID = 2,
+		ThreadDescriptor_ThreadName = 5,
+
+		TrackEvent_Type = 9,
+		TrackEvent_TrackUUID = 11,
+		TrackEvent_Name = 23,
+		TrackEvent_CounterValue = 30
+	};
+
+	enum TrackEventType : uint32_t
+	{
+		SliceBegin = 1,
+		SliceEnd = 2,
+		Counter = 4
+	};
+}
+
+static const uint32_t s_SequenceID = 1;
+static const uint64_t s_TrackUUIDBase = 1000;
+// Counter tracks are keyed by name id, one track per counter name
+static const uint64_t s_CounterTrackUUIDBase = 1000000;
+
+static void WritePacket(FILE* file, const std::string& packet)
+{
+	std::string framed;
+	Proto::WriteBytes(framed, Proto::Trace_Packet, packet);
+	fwrite(framed.data(), 1, framed.size(), file);
+}
+
+static void WriteSlicePacket(FILE* file, uint32_t thread, int64_t timestamp, Proto::TrackEventType type, const std::string* name)
+{
+	std::string trackEvent;
+	Proto::WriteUInt(trackEvent, Proto::TrackEvent_Type, type);
+	Proto::WriteUInt(trackEvent, Proto::TrackEvent_TrackUUID, s_TrackUUIDBase + thread);
+	if (name)
+		Proto::WriteBytes(trackEvent, Proto::TrackEvent_Name, *name);
+
+	std::string packet;
+	Proto::WriteUInt(packet, Proto::TracePacket_Timestamp, (uint64_t)timestamp);
+	Proto::WriteUInt(packet, Proto::TracePacket_TrustedPacketSequenceID, s_SequenceID);
+	Proto::WriteBytes(packet, Proto::TracePacket_TrackEvent, trackEvent);
+	WritePacket(file, packet);
+}
+
+static void WriteCounters(FILE* file, Trace& trace)
+{
+	std::vector<bool> described(trace.Strings.size(), false);
+	for (const TraceCounter& counter : trace.Counters)
+	{
+		if (counter.Name >= described.size() || described[counter.Name])
+			continue;
+		described[counter.Name] = true;
+
+		// An empty CounterDescriptor is enough to make it a counter track
+		std::string trackDescriptor;
+		Proto::WriteUInt(trackDescriptor, Proto::TrackDescriptor_UUID, s_CounterTrackUUIDBase + counter.Name);
+		Proto::WriteBytes(trackDescriptor, Proto::TrackDescriptor_Name, trace.Strings[counter.Name]);
+		Proto::WriteBytes(trackDescriptor, Proto::TrackDescriptor_Counter, std::string());
+
+		std::string packet;
+		Proto::WriteUInt(packet, Proto::TracePacket_TrustedPacketSequenceID, s_SequenceID);
+		Proto::WriteBytes(packet, Proto::TracePacket_TrackDescriptor, trackDescriptor);
+		WritePacket(file, packet);
+	}
+
+	std::stable_sort(trace.Counters.begin(), trace.Counters.end(), [](const TraceCounter& a, const TraceCounter& b)
+	{
+		return a.Time < b.Time;
+	});
+
+	for (const TraceCounter& counter : trace.Counters)
+	{
+		if (counter.Name >= described.size())
+			continue;
+
+		std::string trackEvent;
+		Proto::WriteUInt(trackEvent, Proto::TrackEvent_Type, Proto::Counter);
+		Proto::WriteUInt(trackEvent, Proto::TrackEvent_TrackUUID, s_CounterTrackUUIDBase + counter.Name);
+		Proto::WriteUInt(trackEvent, Proto::TrackEvent_CounterValue, (uint64_t)counter.Value);
+
+		std::string packet;
+		Proto::WriteUInt(packet, Proto::TracePacket_Timestamp, (uint64_t)counter.Time);
+		Proto::WriteUInt(packet, Proto::TracePacket_TrustedPacketSequenceID, s_SequenceID);
+		Proto::WriteBytes(packet, Proto::TracePacket_TrackEvent, trackEvent);
+		WritePacket(file, packet);
+	}
+}
+
+static bool WritePerfetto(Trace& trace, const char* filepath)
+{
+	FILE* file = fopen(filepath, "wb");
+	if (!file)
+		return false;
+
+	for (uint32_t thread = 0; thread < trace.ThreadCount; thread++)
+	{
+		std::string threadName = trace.GetThreadName(thread);
+
+		std::string threadDescriptor;
+		Proto::WriteUInt(threadDescriptor, Proto::ThreadDescriptor_PID, 1);
+		Proto::WriteUInt(threadDescriptor, Proto::ThreadDescriptor_TID, thread + 1);
+		Proto::WriteBytes(threadDescriptor, Proto::ThreadDescriptor_ThreadName, threadName);
+
+		std::string trackDescriptor;
+		Proto::WriteUInt(trackDescriptor, Proto::TrackDescriptor_UUID, s_TrackUUIDBase + thread);
+		Proto::WriteBytes(trackDescriptor, Proto::TrackDescriptor_Name, threadName);
+		Proto::WriteBytes(trackDescriptor, Proto::TrackDescriptor_Thread, threadDescriptor);
+
+		std::string packet;
+		Proto::WriteUInt(packet, Proto::TracePacket_TrustedPacketSequenceID, s_SequenceID);
+		Proto::WriteBytes(packet, Proto::TracePacket_TrackDescriptor, trackDescriptor);
+		WritePacket(file, packet);
+	}
+
+	// Perfetto wants properly nested begin/end pairs in time order per track.
+	// Parents sort before their children: same start, longer duration first.
+	std::sort(trace.Events.begin(), trace.Events.end(), [](const TraceEvent& a, const TraceEvent& b)
+	{
+		if (a.Thread != b.Thread)
+			return a.Thread < b.Thread;
+		if (a.Start != b.Start)
+			return a.Start < b.Start;
+		return a.Duration > b.Duration;
+	});
+
+	static const std::string s_Unknown = "?";
+	std::vector<int64_t> openEnds;
+	for (size_t i = 0; i < trace.Events.size(); i++)
+	{
+		const TraceEvent& event = trace.Events[i];
+		if (i > 0 && trace.Events[i - 1].Thread != event.Thread)
+		{
+			// Close everything left on the previous thread
+			for (auto it = openEnds.rbegin(); it != openEnds.rend(); ++it)
+				WriteSlicePacket(file, trace.Events[i - 1].Thread, *it, Proto::SliceEnd, nullptr);
+			openEnds.clear();
+		}
+
+		while (!openEnds.empty() && openEnds.back() <= event.Start)
+		{
+			WriteSlicePacket(file, event.Thread, openEnds.back(), Proto::SliceEnd, nullptr);
+			openEnds.pop_back();
+		}
+
+		const std::string& name = event.Name < trace.Strings.size() ? trace.Strings[event.Name] : s_Unknown;
+		WriteSlicePacket(file, event.Thread, event.Start, Proto::SliceBegin, &name);
+
+		// Clamp children that overrun their parent by rounding, nesting must be strict
+		int64_t eventEnd = event.Start + event.Duration;
+		if (!openEnds.empty())
+			eventEnd = std::min(eventEnd, openEnds.back());
+		openEnds.push_back(eventEnd);
+	}
+	if (!trace.Events.empty())
+	{
+		for (auto it = openEnds.rbegin(); it != openEnds.rend(); ++it)
+			WriteSlicePacket(file, trace.Events.back().Thread, *it, Proto::SliceEnd, nullptr);
+	}
+
+	WriteCounters(file, trace);
+
+	fclose(file);
+	return true;
+}
+
+static bool EndsWith(const std::string& value, const std::string& suffix)
+{
+	return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: TraceConvert <input.getrace> <output> [--chrome | --perfetto]\n");
+		return 1;
+	}
+
+	std::string output = argv[2];
+	bool perfetto = !EndsWith(output, ".json");
+	if (argc > 3)
+		perfetto = std::string(argv[3]) == "--perfetto";
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input)
+	{
+		fprintf(stderr, "Could not open '%s'\n", argv[1]);
+		return 1;
+	}
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+	Trace trace;
+	if (!ReadTrace(data, trace))
+	{
+		fprintf(stderr, "Failed to read '%s'\n", argv[1]);
+		return 1;
+	}
+
+	bool written = perfetto ? WritePerfetto(trace, output.c_str()) : WriteChrome(trace, output.c_str());
+	if (!written)
+	{
+		fprintf(stderr, "Could not write '%s'\n", output.c_str());
+		return 1;
+	}
+
+	printf("%s: %zu events, %zu counter samples, %u threads, %zu bytes -> %s (%s)\n", trace.SessionName.c_str(), trace.Events.size(), trace.Counters.size(), trace.ThreadCount,
+		data.size(), output.c_str(), perfetto ? "perfetto" : "chrome");
+	return 0;
+}
\ No newline at end of file
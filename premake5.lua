@@ -53,8 +53,7 @@ project "GameEngine"
 	defines
 	{
 		"_CRT_SECURE_NO_WARNINGS",
-		"GLFW_INCLUDE_NONE",
-		"GE_PLATFORM_WINDOWS"
+		"GLFW_INCLUDE_NONE"
 	}
 
 	includedirs
@@ -75,9 +74,7 @@ project "GameEngine"
 	{
 		"GLFW",
 		"GLAD",
-		"ImGui",
-		"opengl32.lib"
-
+		"ImGui"
 	}
 
 	filter "system:windows"
@@ -85,6 +82,36 @@ project "GameEngine"
 
 		defines
 		{
+			"GE_PLATFORM_WINDOWS"
+		}
+
+		links
+		{
+			"opengl32.lib"
+		}
+
+		removefiles
+		{
+			"%{prj.name}/src/Platform/Linux/**"
+		}
+
+	filter "system:linux"
+		defines
+		{
+			"GE_PLATFORM_LINUX"
+		}
+
+		links
+		{
+			"GL",
+			"X11",
+			"pthread",
+			"dl"
+		}
+
+		removefiles
+		{
+			"%{prj.name}/src/Platform/Windows/**"
 		}
 
 	filter "configurations:Debug"
@@ -139,6 +166,23 @@ project "Sandbox2D"
 			"GE_PLATFORM_WINDOWS"
 		}
 
+	filter "system:linux"
+		defines
+		{
+			"GE_PLATFORM_LINUX"
+		}
+
+		links
+		{
+			"GLFW",
+			"GLAD",
+			"ImGui",
+			"GL",
+			"X11",
+			"pthread",
+			"dl"
+		}
+
 	filter "configurations:Debug"
 		defines "GE_DEBUG"
 		runtime "Debug"
@@ -193,34 +237,221 @@ project "Sandbox3D"
 			"GE_PLATFORM_WINDOWS"
 		}
 
+	filter "system:linux"
+		defines
+		{
+			"GE_PLATFORM_LINUX"
+		}
+
+		links
+		{
+			"GLFW",
+			"GLAD",
+			"ImGui",
+			"GL",
+			"X11",
+			"pthread",
+			"dl",
+			"assimp"
+		}
+
 	filter "configurations:Debug"
 		defines "GE_DEBUG"
 		runtime "Debug"
 		symbols "on"
 
+	filter { "system:windows", "configurations:Debug" }
 		links
-        {
-            "GameEngine/vendor/assimp/bin/Debug/assimp-vc141-mtd.lib"
-        }
+		{
+			"GameEngine/vendor/assimp/bin/Debug/assimp-vc141-mtd.lib"
+		}
 
 	filter "configurations:Release"
 		defines "GE_RELEASE"
 		runtime "Release"
 		optimize "on"
 
+	filter { "system:windows", "configurations:Release" }
+		links
+		{
+			"GameEngine/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
+		}
+
+
+	filter "configurations:Dist"
+		defines "GE_DIST"
+		runtime "Release"
+		optimize "on"
+
+	filter { "system:windows", "configurations:Dist" }
+		links
+		{
+			"GameEngine/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
+		}
+
+
+project "GameEngineBench"
+	location "GameEngineBench"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	-- The particle scenario runs Sandbox2D's particle system as is
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp",
+		"Sandbox2D/src/ParticleSystem.h",
+		"Sandbox2D/src/ParticleSystem.cpp"
+	}
+
+	includedirs
+	{
+		"GameEngine/vendor/spdlog/include",
+		"GameEngine/src",
+		"GameEngine/vendor",
+		"%{IncludeDir.glm}",
+		"Sandbox2D/src"
+	}
+
+	links
+	{
+		"GameEngine"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"GE_PLATFORM_WINDOWS"
+		}
+
+	filter "system:linux"
+		defines
+		{
+			"GE_PLATFORM_LINUX"
+		}
+
 		links
-        {
-            "GameEngine/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
-        }
+		{
+			"GLFW",
+			"GLAD",
+			"ImGui",
+			"GL",
+			"X11",
+			"pthread",
+			"dl",
+			"assimp"
+		}
 
+	filter "configurations:Debug"
+		defines "GE_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter { "system:windows", "configurations:Debug" }
+		links
+		{
+			"GameEngine/vendor/assimp/bin/Debug/assimp-vc141-mtd.lib"
+		}
+
+	filter "configurations:Release"
+		defines "GE_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+	filter { "system:windows", "configurations:Release" }
+		links
+		{
+			"GameEngine/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
+		}
 
 	filter "configurations:Dist"
 		defines "GE_DIST"
 		runtime "Release"
 		optimize "on"
 
+	filter { "system:windows", "configurations:Dist" }
 		links
-        {
-            "GameEngine/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
-        }
+		{
+			"GameEngine/vendor/assimp/bin/Release/assimp-vc141-mt.lib"
+		}
+
+project "TraceConvert"
+	location "TraceConvert"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp"
+	}
+
+	-- Only needs the header only trace format, no engine link
+	includedirs
+	{
+		"GameEngine/src"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
 
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		runtime "Release"
+		optimize "on"
+
+project "PakTool"
+	location "PakTool"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp"
+	}
+
+	-- Only needs the header only pak format, no engine link
+	includedirs
+	{
+		"GameEngine/src"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		runtime "Release"
+		optimize "on"